@@ -459,7 +459,8 @@ void ComplexGeoData::Save(Base::Writer& writer) const
     writer.Stream() << writer.ind() << "<ElementMap2";
 
     if (!_persistenceName.empty()) {
-        writer.Stream() << " file=\"" << writer.addFile((_persistenceName + ".txt").c_str(), this)
+        const char* ext = writer.getMode("BinaryElementMap") ? ".bin" : ".txt";
+        writer.Stream() << " file=\"" << writer.addFile((_persistenceName + ext).c_str(), this)
                         << "\"/>\n";
         return;
     }
@@ -632,8 +633,14 @@ void ComplexGeoData::SaveDocFile(Base::Writer& writer) const
 {
     flushElementMap();
     if (_elementMap) {
-        writer.Stream() << "BeginElementMap v1\n";
-        _elementMap->save(writer.Stream());
+        if (writer.getMode("BinaryElementMap")) {
+            writer.Stream() << "BeginElementMap v2\n";
+            _elementMap->saveBinary(writer.Stream());
+        }
+        else {
+            writer.Stream() << "BeginElementMap v1\n";
+            _elementMap->save(writer.Stream());
+        }
     }
 }
 
@@ -645,14 +652,19 @@ void ComplexGeoData::RestoreDocFile(Base::Reader& reader)
     if (boost::equals(marker, "BeginElementMap")) {
         resetElementMap();
         reader >> ver;
-        if (ver != "v1") {
-            FC_WARN("Unknown element map format");  // NOLINT
-        }
-        else {
+        if (ver == "v1") {
             resetElementMap(std::make_shared<ElementMap>());
             _elementMap = _elementMap->restore(Hasher, reader);
             return;
         }
+        if (ver == "v2") {
+            // skip the line end, the binary data starts right after it
+            reader.get();
+            resetElementMap(std::make_shared<ElementMap>());
+            _elementMap = _elementMap->restoreBinary(Hasher, reader);
+            return;
+        }
+        FC_WARN("Unknown element map format");  // NOLINT
     }
     auto count = atoll(marker.c_str());  // Try to prevent UB if the number is unreasonably large
     if (count < 0 || count > std::numeric_limits<int>::max()) {
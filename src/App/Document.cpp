@@ -1820,6 +1820,9 @@ bool Document::saveToFile(const char* filename) const
         if (hGrp->GetBool("SaveBinaryBrep", false)) {
             writer.setMode("BinaryBrep");
         }
+        if (hGrp->GetBool("SaveBinaryElementMap", false)) {
+            writer.setMode("BinaryElementMap");
+        }
 
         writer.Stream() << "<?xml version='1.0' encoding='utf-8'?>" << '\n'
                         << "<!--" << '\n'
@@ -95,6 +95,16 @@ Property* DynamicProperty::getDynamicPropertyByName(const char* name) const
     return nullptr;
 }
 
+Property* DynamicProperty::getDynamicPropertyByName(const HashedName& name) const
+{
+    auto& index = props.get<0>();
+    auto it = index.find(name, HashedNameHasher(), HashedNameHasher());
+    if (it != index.end()) {
+        return it->property;
+    }
+    return nullptr;
+}
+
 std::vector<std::string> DynamicProperty::getDynamicPropertyNames() const
 {
     std::vector<std::string> names;
@@ -26,6 +26,7 @@
 
 #include <map>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <utility>
 
@@ -53,12 +54,16 @@ namespace bmi = boost::multi_index;
 
 struct CStringHasher
 {
-    inline std::size_t operator()(const char* s) const
+    static inline std::size_t hash(const char* s)
     {
         if (!s) {
             return 0;
         }
-        return boost::hash_range(s, s + std::strlen(s));
+        return std::hash<std::string_view>()(s);
+    }
+    inline std::size_t operator()(const char* s) const
+    {
+        return hash(s);
     }
     inline bool operator()(const char* a, const char* b) const
     {
@@ -72,6 +77,38 @@ struct CStringHasher
     }
 };
 
+/** A property name together with its CStringHasher hash
+ *
+ * Used to look up the same name in several property tables, e.g. the dynamic
+ * and the static properties of a container, while hashing it only once.
+ */
+struct HashedName
+{
+    explicit HashedName(const char* name)
+        : name(name)
+        , hash(CStringHasher::hash(name))
+    {}
+    const char* name;
+    std::size_t hash;
+};
+
+/// Hash and equality for looking up a HashedName in a CStringHasher index
+struct HashedNameHasher
+{
+    inline std::size_t operator()(const HashedName& key) const
+    {
+        return key.hash;
+    }
+    inline bool operator()(const HashedName& a, const char* b) const
+    {
+        return CStringHasher()(a.name, b);
+    }
+    inline bool operator()(const char* a, const HashedName& b) const
+    {
+        return CStringHasher()(a, b.name);
+    }
+};
+
 /** This class implements an interface to add properties at run-time to an object
  * derived from PropertyContainer. The additional properties are made persistent.
  * @author Werner Mayer
@@ -94,6 +131,8 @@ public:
     void getPropertyMap(std::map<std::string, Property*>& Map) const;
     /// Find a dynamic property by its name
     Property* getDynamicPropertyByName(const char* name) const;
+    /// Same as above with a pre-hashed name
+    Property* getDynamicPropertyByName(const HashedName& name) const;
     /*!
       Add a dynamic property of the type @a type and with the name @a name.
       @a Group gives the grouping name which appears in the property editor and
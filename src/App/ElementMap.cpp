@@ -1,3 +1,7 @@
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <sstream>
 #include <unordered_map>
 #ifndef FC_DEBUG
 #include <random>
@@ -497,6 +501,445 @@ ElementMapPtr ElementMap::restore(::App::StringHasherRef hasherRef,
     return shared_from_this();
 }
 
+namespace
+{
+
+// Helpers of the binary element map format. Unsigned integers are written as
+// little endian base 128 varints, signed ones are zigzag encoded first, and
+// strings are prefixed by their byte count.
+
+// Marker of the entries in a mapped name chain
+enum BinaryNameKind : unsigned
+{
+    BinaryNameEnd = 0,
+    BinaryNameIndexed = 1,
+    BinaryNamePrefixed = 2,
+    BinaryNamePlain = 3,
+};
+
+void writeVarint(std::ostream& stream, std::uint64_t value)
+{
+    constexpr std::uint64_t lowBits {0x7f};
+    constexpr std::uint64_t moreBit {0x80};
+    while (value > lowBits) {
+        stream.put(static_cast<char>((value & lowBits) | moreBit));
+        value >>= 7;
+    }
+    stream.put(static_cast<char>(value));
+}
+
+void writeSigned(std::ostream& stream, std::int64_t value)
+{
+    writeVarint(stream,
+                (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63));
+}
+
+void writeBytes(std::ostream& stream, const char* data, std::size_t size)
+{
+    writeVarint(stream, size);
+    stream.write(data, static_cast<std::streamsize>(size));
+}
+
+void writeBytes(std::ostream& stream, const QByteArray& bytes)
+{
+    writeBytes(stream, bytes.constData(), static_cast<std::size_t>(bytes.size()));
+}
+
+std::uint64_t readVarint(std::istream& stream)
+{
+    constexpr int lowBits {0x7f};
+    constexpr int moreBit {0x80};
+    std::uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        int byte = stream.get();
+        if (byte == std::char_traits<char>::eof()) {
+            FC_THROWM(Base::RuntimeError, "unexpected end of binary element map");  // NOLINT
+        }
+        value |= static_cast<std::uint64_t>(byte & lowBits) << shift;
+        if ((byte & moreBit) == 0) {
+            return value;
+        }
+    }
+    FC_THROWM(Base::RuntimeError, "Invalid integer in binary element map");  // NOLINT
+}
+
+// Read an unsigned integer that must not exceed maximum
+int readCount(std::istream& stream, int maximum, const char* msg)
+{
+    std::uint64_t value = readVarint(stream);
+    if (value > static_cast<std::uint64_t>(maximum)) {
+        FC_THROWM(Base::RuntimeError, msg);  // NOLINT
+    }
+    return static_cast<int>(value);
+}
+
+long readSigned(std::istream& stream)
+{
+    std::uint64_t value = readVarint(stream);
+    return static_cast<long>(static_cast<std::int64_t>(value >> 1)
+                             ^ -static_cast<std::int64_t>(value & 1));
+}
+
+QByteArray readBytes(std::istream& stream)
+{
+    constexpr int practicalMaximum {1 << 30};
+    int size = readCount(stream, practicalMaximum, "Invalid string in binary element map");
+    QByteArray bytes(size, Qt::Uninitialized);
+    if (!stream.read(bytes.data(), size)) {
+        FC_THROWM(Base::RuntimeError, "unexpected end of binary element map");  // NOLINT
+    }
+    return bytes;
+}
+
+}  // namespace
+
+void ElementMap::saveBinary(std::ostream& stream,
+                            const std::map<const ElementMap*, int>& childMapSet,
+                            const std::map<QByteArray, int>& postfixMap) const
+{
+    writeVarint(stream, this->indexedNames.size());
+
+    for (auto& indexedName : this->indexedNames) {
+        writeBytes(stream, indexedName.first, qstrlen(indexedName.first));
+
+        writeVarint(stream, indexedName.second.children.size());
+        for (auto& vv : indexedName.second.children) {
+            auto& child = vv.second;
+            int mapIndex = 0;
+            if (child.elementMap) {
+                auto it = childMapSet.find(child.elementMap.get());
+                if (it == childMapSet.end() || it->second == 0) {
+                    FC_ERR("Invalid child element map");  // NOLINT
+                }
+                else {
+                    mapIndex = it->second;
+                }
+            }
+            writeVarint(stream, child.indexedName.getIndex());
+            writeVarint(stream, child.offset);
+            writeVarint(stream, child.count);
+            writeSigned(stream, child.tag);
+            writeVarint(stream, mapIndex);
+            writeBytes(stream, child.postfix);
+            auto marked = std::count_if(child.sids.begin(), child.sids.end(), [](auto& sid) {
+                return sid.isMarked();
+            });
+            writeVarint(stream, marked);
+            for (auto& sid : child.sids) {
+                if (sid.isMarked()) {
+                    writeVarint(stream, sid.value());
+                }
+            }
+        }
+
+        writeVarint(stream, indexedName.second.names.size());
+        for (auto& dequeueOfMappedNameRef : indexedName.second.names) {
+            for (auto ref = &dequeueOfMappedNameRef; ref; ref = ref->next.get()) {
+                if (!ref->name) {
+                    break;
+                }
+
+                ::App::StringID::IndexID prefixID {};
+                prefixID.id = 0;
+                IndexedName idx(ref->name.dataBytes());
+                bool printName = true;
+                if (idx) {
+                    auto key = QByteArray::fromRawData(idx.getType(),
+                                                       static_cast<int>(qstrlen(idx.getType())));
+                    auto it = postfixMap.find(key);
+                    if (it != postfixMap.end()) {
+                        writeVarint(stream, BinaryNameIndexed);
+                        writeVarint(stream, it->second);
+                        writeVarint(stream, idx.getIndex());
+                        printName = false;
+                    }
+                }
+                else {
+                    prefixID = ::App::StringID::fromString(ref->name.dataBytes());
+                    if (prefixID.id != 0) {
+                        for (auto& sid : ref->sids) {
+                            if (sid.isMarked() && sid.value() == prefixID.id) {
+                                writeVarint(stream, BinaryNamePrefixed);
+                                writeBytes(stream, ref->name.dataBytes());
+                                printName = false;
+                                break;
+                            }
+                        }
+                        if (printName) {
+                            prefixID.id = 0;
+                        }
+                    }
+                }
+                if (printName) {
+                    writeVarint(stream, BinaryNamePlain);
+                    writeBytes(stream, ref->name.dataBytes());
+                }
+
+                const QByteArray& postfix = ref->name.postfixBytes();
+                if (postfix.isEmpty()) {
+                    writeVarint(stream, 0);
+                }
+                else {
+                    auto it = postfixMap.find(postfix);
+                    assert(it != postfixMap.end());
+                    writeVarint(stream, it->second);
+                }
+                auto marked = std::count_if(ref->sids.begin(), ref->sids.end(), [&](auto& sid) {
+                    return sid.isMarked() && sid.value() != prefixID.id;
+                });
+                writeVarint(stream, marked);
+                for (auto& sid : ref->sids) {
+                    if (sid.isMarked() && sid.value() != prefixID.id) {
+                        writeVarint(stream, sid.value());
+                    }
+                }
+            }
+            writeVarint(stream, BinaryNameEnd);
+        }
+    }
+}
+
+void ElementMap::saveBinary(std::ostream& stream) const
+{
+    std::map<const ElementMap*, int> childMapSet;
+    std::vector<const ElementMap*> childMaps;
+    std::map<QByteArray, int> postfixMap;
+    std::vector<QByteArray> postfixes;
+
+    collectChildMaps(childMapSet, childMaps, postfixMap, postfixes);
+
+    writeVarint(stream, this->_id);
+    writeVarint(stream, postfixes.size());
+    for (auto& postfix : postfixes) {
+        writeBytes(stream, postfix);
+    }
+    int index = 0;
+    writeVarint(stream, childMaps.size());
+    for (auto& elementMap : childMaps) {
+        // Write the body aside first to be able to prefix it with its size
+        std::ostringstream body;
+        elementMap->saveBinary(body, childMapSet, postfixMap);
+        writeVarint(stream, ++index);
+        writeVarint(stream, elementMap->_id);
+        const std::string& bytes = body.str();
+        writeBytes(stream, bytes.c_str(), bytes.size());
+    }
+}
+
+ElementMapPtr ElementMap::restoreBinary(::App::StringHasherRef hasherRef, std::istream& stream)
+{
+    const char* msg = "Invalid element map";
+    constexpr int practicalMaximum {(1 << 30) / sizeof(ElementMapPtr)};
+
+    // The id of this map is repeated in front of its body below, where it
+    // is checked against the already restored maps
+    readVarint(stream);
+    int count = readCount(stream, practicalMaximum, msg);
+
+    std::vector<std::string> postfixes;
+    postfixes.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        postfixes.emplace_back(readBytes(stream).toStdString());
+    }
+
+    std::vector<ElementMapPtr> childMaps;
+    count = readCount(stream, practicalMaximum, msg);
+    if (count == 0) {
+        FC_THROWM(Base::RuntimeError, msg);  // NOLINT
+    }
+    childMaps.reserve(count - 1);
+    for (int i = 0; i < count; ++i) {
+        int index = readCount(stream, count, msg);
+        auto mapId = static_cast<unsigned>(readVarint(stream));
+        int size = readCount(stream, std::numeric_limits<int>::max(), msg);
+        ElementMapPtr map = mapId != 0 ? _idToElementMap[mapId] : ElementMapPtr();
+        if (map) {
+            stream.ignore(size);
+        }
+        else {
+            map = i + 1 < count ? std::make_shared<ElementMap>() : shared_from_this();
+            map = map->restoreBinary(hasherRef, stream, mapId, index, childMaps, postfixes);
+        }
+        if (i + 1 == count) {
+            return map;
+        }
+        childMaps.push_back(map);
+    }
+    return shared_from_this();
+}
+
+ElementMapPtr ElementMap::restoreBinary(::App::StringHasherRef hasherRef,
+                                        std::istream& stream,
+                                        unsigned id,
+                                        int index,
+                                        std::vector<ElementMapPtr>& childMaps,
+                                        const std::vector<std::string>& postfixes)
+{
+    const char* msg = "Invalid element map";
+    constexpr int maxTypeCount(1000);
+    constexpr int practicalMaximum {1 << 30};
+    int typeCount =
+        readCount(stream, maxTypeCount, "Bad type count in element map, ignoring map");
+
+    const char* hasherWarn = nullptr;
+    const char* hasherIDWarn = nullptr;
+    const char* postfixWarn = nullptr;
+    const char* childSIDWarn = nullptr;
+
+    for (int i = 0; i < typeCount; ++i) {
+        QByteArray type = readBytes(stream);
+        IndexedName idx(type.constData(), 1);
+
+        auto& indices = this->indexedNames[idx.getType()];
+        int outerCount = readCount(stream, practicalMaximum, "missing element child count");
+        for (int j = 0; j < outerCount; ++j) {
+            int cIndex = readCount(stream, practicalMaximum, "Invalid element child index");
+            int offset = readCount(stream, practicalMaximum, "Invalid element child offset");
+            int count = readCount(stream, practicalMaximum, "Invalid element child");
+            long tag = readSigned(stream);
+            int mapIndex = readCount(stream, practicalMaximum, msg);
+            if (mapIndex >= index || mapIndex > (int)childMaps.size()) {
+                FC_THROWM(Base::RuntimeError, "Invalid element child map index");  // NOLINT
+            }
+            auto& child = indices.children[cIndex + offset + count];
+            child.indexedName = IndexedName::fromConst(idx.getType(), cIndex);
+            child.offset = offset;
+            child.count = count;
+            child.tag = tag;
+            if (mapIndex > 0) {
+                child.elementMap = childMaps[mapIndex - 1];
+            }
+            else {
+                child.elementMap = nullptr;
+            }
+            child.postfix = readBytes(stream);
+            this->childElements[child.postfix].childMap = &child;
+            this->childElementSize += child.count;
+
+            int sidCount = readCount(stream, practicalMaximum, "Invalid element child string id");
+            child.sids.reserve(sidCount);
+            for (int k = 0; k < sidCount; ++k) {
+                auto childID = static_cast<long>(readVarint(stream));
+                auto sid = hasherRef ? hasherRef->getID(childID) : ::App::StringIDRef();
+                if (!sid) {
+                    childSIDWarn = "Missing element child string id";
+                }
+                else {
+                    child.sids.push_back(sid);
+                }
+            }
+        }
+
+        outerCount = readCount(stream, practicalMaximum, "missing element name outerCount");
+        indices.names.resize(outerCount);
+        for (int j = 0; j < outerCount; ++j) {
+            idx.setIndex(j);
+            auto* ref = &indices.names[j];
+            int innerCount = 0;
+            while (true) {
+                auto kind = readVarint(stream);
+                if (kind == BinaryNameEnd) {
+                    break;
+                }
+                if (innerCount++ != 0) {
+                    ref->next = std::make_unique<MappedNameRef>();
+                    ref = ref->next.get();
+                }
+
+                ::App::StringID::IndexID prefixID {};
+                prefixID.id = 0;
+
+                switch (kind) {
+                    case BinaryNameIndexed: {
+                        int elementNameIndex = readCount(stream, (int)postfixes.size(), msg);
+                        if (elementNameIndex == 0) {
+                            FC_THROWM(Base::RuntimeError, "Invalid element name index");  // NOLINT
+                        }
+                        int elementIndex = readCount(stream, practicalMaximum, msg);
+                        ref->name = MappedName(
+                            IndexedName::fromConst(postfixes[elementNameIndex - 1].c_str(),
+                                                   elementIndex));
+                        break;
+                    }
+                    case BinaryNamePrefixed: {
+                        QByteArray bytes = readBytes(stream);
+                        ref->name = MappedName(bytes.constData(), bytes.size());
+                        prefixID = ::App::StringID::fromString(ref->name.dataBytes());
+                        break;
+                    }
+                    case BinaryNamePlain: {
+                        QByteArray bytes = readBytes(stream);
+                        ref->name = MappedName(bytes.constData(), bytes.size());
+                        break;
+                    }
+                    default:
+                        FC_THROWM(Base::RuntimeError, "Invalid element name marker");  // NOLINT
+                }
+
+                auto postfixIndex = readVarint(stream);
+                if (postfixIndex != 0) {
+                    if (postfixIndex > postfixes.size()) {
+                        postfixWarn = "Invalid element postfix index";
+                    }
+                    else {
+                        ref->name += postfixes[postfixIndex - 1];
+                    }
+                }
+
+                this->mappedNames.emplace(ref->name, idx);
+
+                int sidCount = readCount(stream, practicalMaximum, "Invalid element string id");
+                if (!hasherRef) {
+                    if (sidCount != 0) {
+                        hasherWarn = "No hasherRef";
+                    }
+                    for (int l = 0; l < sidCount; ++l) {
+                        readVarint(stream);
+                    }
+                    continue;
+                }
+
+                ref->sids.reserve(sidCount + (prefixID.id != 0 ? 1 : 0));
+                if (prefixID.id != 0) {
+                    auto sid = hasherRef->getID(prefixID.id);
+                    if (!sid) {
+                        hasherIDWarn = "Missing element name prefix id";
+                    }
+                    else {
+                        ref->sids.push_back(sid);
+                    }
+                }
+                for (int l = 0; l < sidCount; ++l) {
+                    auto sid = hasherRef->getID(static_cast<long>(readVarint(stream)));
+                    if (!sid) {
+                        hasherIDWarn = "Invalid element name string id";
+                    }
+                    else {
+                        ref->sids.push_back(sid);
+                    }
+                }
+            }
+        }
+    }
+    if (hasherWarn) {
+        FC_WARN(hasherWarn);  // NOLINT
+    }
+    if (hasherIDWarn) {
+        FC_WARN(hasherIDWarn);  // NOLINT
+    }
+    if (postfixWarn) {
+        FC_WARN(postfixWarn);  // NOLINT
+    }
+    if (childSIDWarn) {
+        FC_WARN(childSIDWarn);  // NOLINT
+    }
+
+    if (id != 0) {
+        _idToElementMap[id] = shared_from_this();
+    }
+    return shared_from_this();
+}
+
 MappedName ElementMap::addName(MappedName& name,
                                const IndexedName& idx,
                                const ElementIDRefs& sids,
@@ -809,6 +1252,35 @@ void ElementMap::erase(const IndexedName& idx)
     ref.clear();
 }
 
+std::size_t ElementMap::MappedNameHash::operator()(const MappedName& name) const
+{
+    // FNV-1a over data and postfix as one byte sequence, because names with different split
+    // points may still compare equal
+    std::uint64_t hash = 14695981039346656037ULL;
+    auto combine = [&hash](const QByteArray& bytes) {
+        for (char byte : bytes) {
+            hash ^= static_cast<unsigned char>(byte);
+            hash *= 1099511628211ULL;
+        }
+    };
+    combine(name.dataBytes());
+    combine(name.postfixBytes());
+    return static_cast<std::size_t>(hash);
+}
+
+std::vector<const std::pair<const MappedName, IndexedName>*> ElementMap::sortedMappedNames() const
+{
+    std::vector<const std::pair<const MappedName, IndexedName>*> names;
+    names.reserve(mappedNames.size());
+    for (auto& mappedName : mappedNames) {
+        names.push_back(&mappedName);
+    }
+    std::sort(names.begin(), names.end(), [](auto* lhs, auto* rhs) {
+        return lhs->first < rhs->first;
+    });
+    return names;
+}
+
 unsigned long ElementMap::size() const
 {
     return mappedNames.size() + childElementSize;
@@ -1075,8 +1547,8 @@ void ElementMap::collectChildMaps(std::map<const ElementMap*, int>& childMapSet,
         }
     }
 
-    for (auto& mappedName : this->mappedNames) {
-        addPostfix(mappedName.first.constPostfix(), postfixMap, postfixes);
+    for (auto* mappedName : sortedMappedNames()) {
+        addPostfix(mappedName->first.constPostfix(), postfixMap, postfixes);
     }
 
     childMaps.push_back(this);
@@ -1302,8 +1774,8 @@ std::vector<MappedElement> ElementMap::getAll() const
 {
     std::vector<MappedElement> ret;
     ret.reserve(size());
-    for (auto& mappedName : this->mappedNames) {
-        ret.emplace_back(mappedName.first, mappedName.second);
+    for (auto* mappedName : sortedMappedNames()) {
+        ret.emplace_back(mappedName->first, mappedName->second);
     }
     for (auto& childElement : this->childElements) {
         auto& child = *childElement.childMap;
@@ -37,6 +37,7 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <unordered_map>
 
 
 namespace Data
@@ -101,6 +102,18 @@ public:
      */
     ElementMapPtr restore(::App::StringHasherRef hasherRef, std::istream& stream);
 
+    /** Serialize this map in the compact binary format. The layout follows \c save, but
+     * integers are written as variable length quantities and every child map body is
+     * prefixed with its size, so that an already restored map can be skipped in one go.
+     * @param stream: serialized stream
+     */
+    void saveBinary(std::ostream& stream) const;
+
+    /** Deserialize and restore this map from the binary format written by \c saveBinary.
+     * @param hasherRef: where all the StringIDs are stored
+     * @param stream: stream to deserialize
+     */
+    ElementMapPtr restoreBinary(::App::StringHasherRef hasherRef, std::istream& stream);
 
     /** Add a sub-element name mapping.
      *
@@ -233,6 +246,19 @@ private:
                           std::vector<ElementMapPtr>& childMaps,
                           const std::vector<std::string>& postfixes);
 
+    /// Binary counterpart of the private \c save
+    void saveBinary(std::ostream& stream,
+                    const std::map<const ElementMap*, int>& childMapSet,
+                    const std::map<QByteArray, int>& postfixMap) const;
+
+    /// Binary counterpart of the private \c restore
+    ElementMapPtr restoreBinary(::App::StringHasherRef hasherRef,
+                                std::istream& stream,
+                                unsigned id,
+                                int index,
+                                std::vector<ElementMapPtr>& childMaps,
+                                const std::vector<std::string>& postfixes);
+
     /** Associate the MappedName \c name with the IndexedName \c idx.
      * @param name: the name to add
      * @param idx: the indexed name that \c name will be bound to
@@ -303,7 +329,16 @@ private:
 
     std::map<const char*, IndexedElements, CStringComp> indexedNames;
 
-    std::map<MappedName, IndexedName, std::less<>> mappedNames;
+    /// Hashes the concatenation of data and postfix, consistent with MappedName::operator==()
+    struct MappedNameHash
+    {
+        std::size_t operator()(const MappedName& name) const;
+    };
+
+    /// Use sortedMappedNames() where the iteration order matters, e.g. for saving
+    std::unordered_map<MappedName, IndexedName, MappedNameHash> mappedNames;
+
+    std::vector<const std::pair<const MappedName, IndexedName>*> sortedMappedNames() const;
 
     struct ChildMapInfo
     {
@@ -97,6 +97,9 @@ ObjectIdentifier::ObjectIdentifier(const App::PropertyContainer* _owner,
     , documentObjectNameSet(false)
     , localProperty(false)
     , _hash(0)
+    , _propertyData(nullptr)
+    , _propertyName(nullptr)
+    , _propertyOffset(-1)
 {
     if (_owner) {
         const DocumentObject* docObj = freecad_cast<const DocumentObject*>(_owner);
@@ -123,6 +126,9 @@ ObjectIdentifier::ObjectIdentifier(const App::PropertyContainer* _owner, bool lo
     , documentObjectNameSet(false)
     , localProperty(localProperty)
     , _hash(0)
+    , _propertyData(nullptr)
+    , _propertyName(nullptr)
+    , _propertyOffset(-1)
 {
     if (_owner) {
         const DocumentObject* docObj = freecad_cast<const DocumentObject*>(_owner);
@@ -139,6 +145,9 @@ ObjectIdentifier::ObjectIdentifier(const Property& prop, int index)
     , documentObjectNameSet(false)
     , localProperty(false)
     , _hash(0)
+    , _propertyData(nullptr)
+    , _propertyName(nullptr)
+    , _propertyOffset(-1)
 {
     DocumentObject* docObj = freecad_cast<DocumentObject*>(prop.getContainer());
 
@@ -1227,6 +1236,16 @@ Property* ObjectIdentifier::resolveProperty(const App::DocumentObject* obj,
         return nullptr;
     }
 
+    // Fast path for repeated evaluation of the same static property. Its
+    // offset is fixed for all objects sharing the same property table.
+    const PropertyData& propData = obj->getPropertyData();
+    const PropertyContainer* container = obj;
+    if (_propertyData == &propData && std::strcmp(_propertyName, propertyName) == 0) {
+        ptype = PseudoNone;
+        return reinterpret_cast<Property*>(PropertyData::OffsetBase(container).getOffset()
+                                           + _propertyOffset);
+    }
+
     static std::unordered_map<const char*, int, CStringHasher, CStringHasher> _props = {
         {"_shape", PseudoShape},
         {"_pla", PseudoPlacement},
@@ -1256,7 +1275,17 @@ Property* ObjectIdentifier::resolveProperty(const App::DocumentObject* obj,
         return &const_cast<App::DocumentObject*>(obj)->Label;  // fake the property
     }
 
-    return obj->getPropertyByName(propertyName);
+    Property* prop = obj->getPropertyByName(propertyName);
+    if (prop) {
+        // Only cache if the object did not redirect the name elsewhere
+        const PropertyData::PropertySpec* spec = propData.findProperty(container, prop);
+        if (spec && std::strcmp(spec->Name, propertyName) == 0) {
+            _propertyData = &propData;
+            _propertyName = spec->Name;
+            _propertyOffset = spec->Offset;
+        }
+    }
+    return prop;
 }
 
 
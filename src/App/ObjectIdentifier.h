@@ -85,6 +85,7 @@ inline T& any_cast(boost::any& value)
 class Property;
 class Document;
 class PropertyContainer;
+struct PropertyData;
 class DocumentObject;
 class ExpressionVisitor;
 
@@ -806,6 +807,9 @@ public:
         localProperty = other.localProperty;
         _cache = std::move(other._cache);
         _hash = other._hash;
+        _propertyData = other._propertyData;
+        _propertyName = other._propertyName;
+        _propertyOffset = other._propertyOffset;
         return *this;
     }
 
@@ -1582,6 +1586,12 @@ private:
 private:
     std::string _cache;  // Cached string represstation of this identifier
     std::size_t _hash;   // Cached hash of this string
+
+    // Static property found by the last resolveProperty() call, reused for
+    // objects sharing the same property table
+    mutable const PropertyData* _propertyData;
+    mutable const char* _propertyName;
+    mutable short _propertyOffset;
 };
 
 /**
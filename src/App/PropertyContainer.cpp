@@ -69,11 +69,13 @@ App::Property* PropertyContainer::addDynamicProperty(
 
 Property *PropertyContainer::getPropertyByName(const char* name) const
 {
-    auto prop = dynamicProps.getDynamicPropertyByName(name);
+    // Both tables use the same hash function, so hash the name only once
+    HashedName key(name);
+    auto prop = dynamicProps.getDynamicPropertyByName(key);
     if (prop) {
         return prop;
     }
-    return getPropertyData().getPropertyByName(this,name);
+    return getPropertyData().getPropertyByName(this,key);
 }
 
 void PropertyContainer::getPropertyMap(std::map<std::string,Property*> &Map) const
@@ -474,6 +476,17 @@ const PropertyData::PropertySpec *PropertyData::findProperty(OffsetBase offsetBa
     return nullptr;
 }
 
+const PropertyData::PropertySpec *PropertyData::findProperty(OffsetBase offsetBase,const HashedName& PropName) const
+{
+    (void)offsetBase;
+    merge();
+    auto &index = propertyData.get<1>();
+    auto it = index.find(PropName, HashedNameHasher(), HashedNameHasher());
+    if(it != index.end())
+        return &(*it);
+    return nullptr;
+}
+
 const PropertyData::PropertySpec *PropertyData::findProperty(OffsetBase offsetBase,const Property* prop) const
 {
     merge();
@@ -569,6 +582,16 @@ Property *PropertyData::getPropertyByName(OffsetBase offsetBase,const char* name
     return nullptr;
 }
 
+Property *PropertyData::getPropertyByName(OffsetBase offsetBase,const HashedName& name) const
+{
+  const PropertyData::PropertySpec* Spec = findProperty(offsetBase,name);
+
+  if(Spec)
+    return reinterpret_cast<Property *>(Spec->Offset + offsetBase.getOffset());
+  else
+    return nullptr;
+}
+
 void PropertyData::getPropertyMap(OffsetBase offsetBase,std::map<std::string,Property*> &Map) const
 {
     merge();
@@ -208,6 +208,9 @@ struct AppExport PropertyData
    */
   const PropertySpec *findProperty(OffsetBase offsetBase,const char* PropName) const;
 
+  /// Same as above with a pre-hashed name
+  const PropertySpec *findProperty(OffsetBase offsetBase,const HashedName& PropName) const;
+
   /**
    * @brief Find a property by its pointer.
    *
@@ -245,6 +248,9 @@ struct AppExport PropertyData
    */
   Property *getPropertyByName(OffsetBase offsetBase,const char* name) const;
 
+  /// Same as above with a pre-hashed name
+  Property *getPropertyByName(OffsetBase offsetBase,const HashedName& name) const;
+
   /**
    * @brief Get a map of properties.
    *
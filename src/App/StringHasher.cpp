@@ -23,7 +23,10 @@
 
 #include <QCryptographicHash>
 #include <QHash>
+#include <array>
 #include <deque>
+#include <mutex>
+#include <unordered_set>
 
 #include <Base/Console.h>
 #include <Base/Reader.h>
@@ -32,9 +35,6 @@
 
 #include <boost/algorithm/string/classification.hpp>
 #include <boost/algorithm/string/split.hpp>
-#include <boost/bimap.hpp>
-#include <boost/bimap/set_of.hpp>
-#include <boost/bimap/unordered_set_of.hpp>
 #include <boost/io/ios_state.hpp>
 #include <boost/iostreams/stream.hpp>
 
@@ -51,37 +51,160 @@ using namespace App;
 
 ///////////////////////////////////////////////////////////
 
+/// Content of a StringID, used to look up the table without constructing a StringID
+struct StringIDKey
+{
+    const QByteArray& data;
+    const QByteArray& postfix;
+
+    explicit StringIDKey(const StringID& sid)
+        : data(sid.data())
+        , postfix(sid.postfix())
+    {}
+
+    StringIDKey(const QByteArray& data, const QByteArray& postfix)
+        : data(data)
+        , postfix(postfix)
+    {}
+};
+
 struct StringIDHasher
 {
+    using is_transparent = void;
+
+    std::size_t operator()(const StringIDKey& key) const
+    {
+        return qHash(key.data, qHash(key.postfix));
+    }
+
     std::size_t operator()(const StringID* sid) const
     {
-        if (!sid) {
-            return 0;
-        }
-        return qHash(sid->data(), qHash(sid->postfix()));
+        return operator()(StringIDKey(*sid));
+    }
+
+    bool operator()(const StringIDKey& keyA, const StringIDKey& keyB) const
+    {
+        return keyA.data == keyB.data && keyA.postfix == keyB.postfix;
     }
 
     bool operator()(const StringID* IDa, const StringID* IDb) const
     {
-        if (IDa == IDb) {
-            return true;
-        }
-        if (!IDa || !IDb) {
-            return false;
-        }
-        return IDa->data() == IDb->data() && IDa->postfix() == IDb->postfix();
+        return IDa == IDb || operator()(StringIDKey(*IDa), StringIDKey(*IDb));
     }
-};
 
-using HashMapBase =
-    boost::bimap<boost::bimaps::unordered_set_of<StringID*, StringIDHasher, StringIDHasher>,
-                 boost::bimaps::set_of<long>>;
+    bool operator()(const StringIDKey& keyA, const StringID* IDb) const
+    {
+        return operator()(keyA, StringIDKey(*IDb));
+    }
 
-class StringHasher::HashMap: public HashMapBase
+    bool operator()(const StringID* IDa, const StringIDKey& keyB) const
+    {
+        return operator()(StringIDKey(*IDa), keyB);
+    }
+};
+
+/** The tables of a StringHasher
+ *
+ * Lookup by content goes through a number of shards, each with its own lock, so that
+ * concurrent getID() calls rarely wait for each other. Lookup by id uses a dense vector
+ * indexed by id - 1. Lock order is shard first, then ids.
+ *
+ * Only getID() may be called concurrently. Operations working on the whole table (clear,
+ * compact, save and restore) must not run at the same time as any other operation.
+ */
+class StringHasher::HashMap
 {
 public:
     bool SaveAll = false;
     int Threshold = 0;
+
+    static constexpr std::size_t ShardCount = 32;
+
+    struct Shard
+    {
+        std::mutex mutex;
+        std::unordered_set<StringID*, StringIDHasher, StringIDHasher> sids;
+    };
+
+    std::array<Shard, ShardCount> shards;
+
+    /// StringIDs indexed by id - 1, or nullptr for unused ids. The last entry is never null.
+    std::vector<StringID*> ids;
+    std::size_t count = 0;
+    mutable std::mutex idMutex;
+
+    Shard& shard(const StringIDKey& key)
+    {
+        return shards[StringIDHasher()(key) % ShardCount];
+    }
+
+    StringID* find(const StringIDKey& key)
+    {
+        auto& entry = shard(key);
+        std::lock_guard<std::mutex> lock(entry.mutex);
+        auto it = entry.sids.find(key);
+        return it != entry.sids.end() ? *it : nullptr;
+    }
+
+    StringID* find(long id) const
+    {
+        std::lock_guard<std::mutex> lock(idMutex);
+        if (id <= 0 || id > static_cast<long>(ids.size())) {
+            return nullptr;
+        }
+        return ids[id - 1];
+    }
+
+    long lastID() const
+    {
+        std::lock_guard<std::mutex> lock(idMutex);
+        return static_cast<long>(ids.size());
+    }
+
+    std::size_t size() const
+    {
+        std::lock_guard<std::mutex> lock(idMutex);
+        return count;
+    }
+
+    bool erase(StringID* sid)
+    {
+        auto& entry = shard(StringIDKey(*sid));
+        std::lock_guard<std::mutex> lock(entry.mutex);
+        auto it = entry.sids.find(sid);
+        if (it == entry.sids.end() || *it != sid) {
+            return false;
+        }
+        entry.sids.erase(it);
+
+        std::lock_guard<std::mutex> idLock(idMutex);
+        ids[sid->value() - 1] = nullptr;
+        while (!ids.empty() && !ids.back()) {
+            ids.pop_back();
+        }
+        --count;
+        return true;
+    }
+
+    void clear()
+    {
+        for (auto& entry : shards) {
+            entry.sids.clear();
+        }
+        ids.clear();
+        count = 0;
+    }
+
+    /// Call \a func for each StringID in the order of their ids
+    template<typename Func>
+    void forEach(Func func) const
+    {
+        for (auto* sid : ids) {
+            if (sid) {
+                func(sid);
+            }
+        }
+    }
 };
 
 ///////////////////////////////////////////////////////////
@@ -91,7 +214,7 @@ TYPESYSTEM_SOURCE_ABSTRACT(App::StringID, Base::BaseClass)
 StringID::~StringID()
 {
     if (_hasher) {
-        _hasher->_hashes->right.erase(_id);
+        _hasher->_hashes->erase(this);
     }
 }
 
@@ -198,18 +321,18 @@ void StringHasher::compact()
     // Make a list of all the table entries that have only a single reference and are not marked
     // "persistent"
     std::deque<StringIDRef> pendings;
-    for (auto& hasher : _hashes->right) {
-        if (!hasher.second->isPersistent() && hasher.second->getRefCount() == 1) {
-            pendings.emplace_back(hasher.second);
+    _hashes->forEach([&pendings](StringID* sid) {
+        if (!sid->isPersistent() && sid->getRefCount() == 1) {
+            pendings.emplace_back(sid);
         }
-    }
+    });
 
     // Recursively remove the unused StringIDs
     while (!pendings.empty()) {
         StringIDRef sid = pendings.front();
         pendings.pop_front();
         // Try to erase the map entry for this StringID
-        if (_hashes->right.erase(sid.value()) == 0U) {
+        if (!_hashes->erase(sid._sid)) {
             continue;  // If nothing was erased, there's nothing more to do
         }
         sid._sid->_hasher = nullptr;
@@ -243,12 +366,7 @@ int StringHasher::getThreshold() const
 
 long StringHasher::lastID() const
 {
-    if (_hashes->right.empty()) {
-        return 0;
-    }
-    auto it = _hashes->right.end();
-    --it;
-    return it->first;
+    return _hashes->lastID();
 }
 
 StringIDRef StringHasher::getID(const char* text, int len, bool hashable)
@@ -267,24 +385,23 @@ StringIDRef StringHasher::getID(const QByteArray& data, Options options)
 
     bool hashed = hashable && _hashes->Threshold > 0 && (int)data.size() > _hashes->Threshold;
 
-    StringID dataID;
+    QByteArray bytes;
     if (hashed) {
         QCryptographicHash hasher(QCryptographicHash::Sha1);
         hasher.addData(data);
-        dataID._data = hasher.result();
+        bytes = hasher.result();
     }
     else {
-        dataID._data = data;
+        bytes = data;
     }
 
-    auto it = _hashes->left.find(&dataID);
-    if (it != _hashes->left.end()) {
-        return {it->first};
+    if (auto* existing = _hashes->find(StringIDKey(bytes, QByteArray()))) {
+        return {existing};
     }
 
     if (!hashed && !nocopy) {
         // if not hashed, make a deep copy of the data
-        dataID._data = QByteArray(data.constData(), data.size());
+        bytes = QByteArray(data.constData(), data.size());
     }
 
     StringID::Flags flags(StringID::Flag::None);
@@ -294,17 +411,17 @@ StringIDRef StringHasher::getID(const QByteArray& data, Options options)
     if (hashed) {
         flags.setFlag(StringID::Flag::Hashed);
     }
-    StringIDRef sid(new StringID(lastID() + 1, dataID._data, flags));
+    StringIDRef sid(new StringID(0, bytes, flags));
     return {insert(sid)};
 }
 
 StringIDRef StringHasher::getID(const Data::MappedName& name, const QVector<StringIDRef>& sids)
 {
-    StringID tempID;
-    tempID._postfix = name.postfixBytes();
+    QByteArray data;
+    QByteArray postfix = name.postfixBytes();
 
     Data::IndexedName indexed;
-    if (tempID._postfix.size() != 0) {
+    if (postfix.size() != 0) {
         // Only check for IndexedName if there is postfix, because of the way
         // we restore the StringID. See StringHasher::saveStream/restoreStreamNew()
         indexed = Data::IndexedName(name.dataBytes());
@@ -312,18 +429,17 @@ StringIDRef StringHasher::getID(const Data::MappedName& name, const QVector<Stri
     if (indexed) {
         // If this is an IndexedName, then _data only stores the base part of the name, without the
         // integer index
-        tempID._data =
+        data =
             QByteArray::fromRawData(indexed.getType(), static_cast<int>(strlen(indexed.getType())));
     }
     else {
         // Store the entire name in _data, but temporarily reuse the existing memory
-        tempID._data = name.dataBytes();
+        data = name.dataBytes();
     }
 
     // Check to see if there is already an entry in the hash table for this StringID
-    auto it = _hashes->left.find(&tempID);
-    if (it != _hashes->left.end()) {
-        auto res = StringIDRef(it->first);
+    if (auto* existing = _hashes->find(StringIDKey(data, postfix))) {
+        auto res = StringIDRef(existing);
         if (indexed) {
             res._index = indexed.getIndex();
         }
@@ -332,28 +448,28 @@ StringIDRef StringHasher::getID(const Data::MappedName& name, const QVector<Stri
 
     if (!indexed && name.isRaw()) {
         // Make a copy of the memory if we didn't do so earlier
-        tempID._data = QByteArray(name.dataBytes().constData(), name.dataBytes().size());
+        data = QByteArray(name.dataBytes().constData(), name.dataBytes().size());
     }
 
     // If the postfix is not already encoded, use getID to encode it:
     StringIDRef postfixRef;
-    if ((tempID._postfix.size() != 0) && tempID._postfix.indexOf("#") < 0) {
-        postfixRef = getID(tempID._postfix);
-        postfixRef.toBytes(tempID._postfix);
+    if ((postfix.size() != 0) && postfix.indexOf("#") < 0) {
+        postfixRef = getID(postfix);
+        postfixRef.toBytes(postfix);
     }
 
     // If _data is an IndexedName, use getID to encode it:
     StringIDRef indexRef;
     if (indexed) {
-        indexRef = getID(tempID._data);
+        indexRef = getID(data);
     }
 
     // The real StringID object that we are going to insert
-    StringIDRef newStringIDRef(new StringID(lastID() + 1, tempID._data));
+    StringIDRef newStringIDRef(new StringID(0, data));
     StringID& newStringID = *newStringIDRef._sid;
-    if (tempID._postfix.size() != 0) {
+    if (postfix.size() != 0) {
         newStringID._flags.setFlag(StringID::Flag::Postfixed);
-        newStringID._postfix = tempID._postfix;
+        newStringID._postfix = postfix;
     }
 
     // Count the related SIDs that use this hasher
@@ -437,11 +553,11 @@ StringIDRef StringHasher::getID(long id, int index) const
     if (id <= 0) {
         return {};
     }
-    auto it = _hashes->right.find(id);
-    if (it == _hashes->right.end()) {
+    auto* sid = _hashes->find(id);
+    if (!sid) {
         return {};
     }
-    StringIDRef res(it->second);
+    StringIDRef res(sid);
     res._index = index;
     return res;
 }
@@ -462,7 +578,7 @@ const std::string& StringHasher::getPersistenceFileName() const
 void StringHasher::Save(Base::Writer& writer) const
 {
 
-    std::size_t count = _hashes->SaveAll ? _hashes->size() : this->count();
+    std::size_t count = _hashes->SaveAll ? this->size() : this->count();
 
     writer.Stream() << writer.ind() << "<StringHasher saveall=\"" << _hashes->SaveAll
                     << "\" threshold=\"" << _hashes->Threshold << "\"";
@@ -505,8 +621,11 @@ void StringHasher::saveStream(std::ostream& stream) const
     long lastID = 0;
     bool relative = false;
 
-    for (auto& hasher : _hashes->right) {
-        auto& d = *hasher.second;
+    for (const auto* sid : _hashes->ids) {
+        if (!sid) {
+            continue;
+        }
+        auto& d = *sid;
         long id = d._id;
         if (!_hashes->SaveAll && !d.isMarked() && !d.isPersistent()) {
             continue;
@@ -730,15 +849,31 @@ StringID* StringHasher::insert(const StringIDRef& sid)
 {
     assert(sid && sid._sid->_hasher == nullptr);
     auto& hasher = *sid._sid;
+    auto& shard = _hashes->shard(StringIDKey(hasher));
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.sids.find(&hasher);
+    if (it != shard.sids.end()) {
+        return *it;
+    }
+
+    // A zero id means the next free one, other ids come from a restored table
+    std::lock_guard<std::mutex> idLock(_hashes->idMutex);
+    auto& ids = _hashes->ids;
+    if (hasher._id <= 0) {
+        hasher._id = static_cast<long>(ids.size()) + 1;
+    }
+    else if (hasher._id <= static_cast<long>(ids.size()) && ids[hasher._id - 1]) {
+        return ids[hasher._id - 1];
+    }
+    if (hasher._id > static_cast<long>(ids.size())) {
+        ids.resize(hasher._id, nullptr);
+    }
+    ids[hasher._id - 1] = &hasher;
+    ++_hashes->count;
+    shard.sids.insert(&hasher);
     hasher._hasher = this;
     hasher.ref();
-    auto res = _hashes->right.insert(_hashes->right.end(),
-                                     HashMap::right_map::value_type(sid.value(), &hasher));
-    if (res->second != &hasher) {
-        hasher._hasher = nullptr;
-        hasher.unref();
-    }
-    return res->second;
+    return &hasher;
 }
 
 void StringHasher::restoreStream(std::istream& stream, std::size_t count)
@@ -762,10 +897,10 @@ void StringHasher::restoreStream(std::istream& stream, std::size_t count)
 
 void StringHasher::clear()
 {
-    for (auto& hasher : _hashes->right) {
-        hasher.second->_hasher = nullptr;
-        hasher.second->unref();
-    }
+    _hashes->forEach([](StringID* sid) {
+        sid->_hasher = nullptr;
+        sid->unref();
+    });
     _hashes->clear();
 }
 
@@ -777,11 +912,11 @@ size_t StringHasher::size() const
 size_t StringHasher::count() const
 {
     size_t count = 0;
-    for (auto& hasher : _hashes->right) {
-        if (hasher.second->isMarked() || hasher.second->isPersistent()) {
+    _hashes->forEach([&count](const StringID* sid) {
+        if (sid->isMarked() || sid->isPersistent()) {
             ++count;
         }
-    }
+    });
     return count;
 }
 
@@ -854,15 +989,15 @@ PyObject* StringHasher::getPyObject()
 std::map<long, StringIDRef> StringHasher::getIDMap() const
 {
     std::map<long, StringIDRef> ret;
-    for (auto& hasher : _hashes->right) {
-        ret.emplace_hint(ret.end(), hasher.first, StringIDRef(hasher.second));
-    }
+    _hashes->forEach([&ret](StringID* sid) {
+        ret.emplace_hint(ret.end(), sid->value(), StringIDRef(sid));
+    });
     return ret;
 }
 
 void StringHasher::clearMarks() const
 {
-    for (auto& hasher : _hashes->right) {
-        hasher.second->_flags.setFlag(StringID::Flag::Marked, false);
-    }
+    _hashes->forEach([](const StringID* sid) {
+        sid->_flags.setFlag(StringID::Flag::Marked, false);
+    });
 }
@@ -181,7 +181,7 @@ public:
     }
 
     /// Returns the postfix
-    QByteArray postfix() const
+    const QByteArray& postfix() const
     {
         return _postfix;
     }
@@ -670,6 +670,9 @@ public:
      * instance.
      *
      * The purpose of this function is to provide a short form of a stable string identification.
+     *
+     * All getID() overloads may be called concurrently, e.g. from worker threads mapping element
+     * names. They must not overlap with clear(), compact(), saving or restoring.
      */
     StringIDRef getID(const char* text, int len = -1, bool hashable = false);
 
@@ -779,7 +782,7 @@ protected:
 
 private:
     std::unique_ptr<HashMap>
-        _hashes;  ///< Bidirectional map of StringID and its index (a long int).
+        _hashes;  ///< Sharded content lookup and id-indexed table of the StringIDs.
     mutable std::string _filename;
 };
 }  // namespace App
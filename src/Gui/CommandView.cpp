@@ -2925,6 +2925,9 @@ static void doSelect(void* ud, SoEventCallback * cb)
             Gui::Selection().clearSelection(doc->getName());
         }
 
+        // Collect everything first and add it in one go, so that the command
+        // states are updated only once
+        std::vector<App::SubObjectT> sels;
         const std::vector<App::DocumentObject*> objects = doc->getObjects();
         for(auto obj : objects) {
             if(App::GeoFeatureGroupExtension::getGroupOfObject(obj))
@@ -2936,8 +2939,9 @@ static void doSelect(void* ud, SoEventCallback * cb)
 
             Base::Matrix4D mat;
             for(auto &sub : getBoxSelection(vp,selectionMode,selectElement,proj,polygon,mat))
-                Gui::Selection().addSelection(doc->getName(), obj->getNameInDocument(), sub.c_str());
+                sels.emplace_back(obj, sub.c_str());
         }
+        Gui::Selection().addSelections(sels);
     }
 }
 
@@ -0,0 +1,222 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2025 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+#include <algorithm>
+#include <utility>
+
+#include <Inventor/SoFullPath.h>
+#include <Inventor/SoPickedPoint.h>
+#include <Inventor/actions/SoCallbackAction.h>
+#include <Inventor/actions/SoGetBoundingBoxAction.h>
+#include <Inventor/actions/SoGetPrimitiveCountAction.h>
+#include <Inventor/actions/SoGLRenderAction.h>
+#include <Inventor/actions/SoRayPickAction.h>
+#include <Inventor/elements/SoModelMatrixElement.h>
+#include <Inventor/elements/SoViewingMatrixElement.h>
+#include <Inventor/lists/SoPickedPointList.h>
+
+#include "SoFCInstanceGroup.h"
+
+
+using namespace Gui;
+
+SO_DETAIL_SOURCE(SoFCInstanceDetail)
+
+void SoFCInstanceDetail::initClass()
+{
+    SO_DETAIL_INIT_CLASS(SoFCInstanceDetail, SoDetail);
+}
+
+SoFCInstanceDetail::SoFCInstanceDetail(int index)
+    : index(index)
+{}
+
+SoDetail * SoFCInstanceDetail::copy() const
+{
+    return new SoFCInstanceDetail(index);
+}
+
+SO_NODE_SOURCE(SoFCInstanceGroup)
+
+void SoFCInstanceGroup::initClass()
+{
+    SO_NODE_INIT_CLASS(SoFCInstanceGroup, SoGroup, "Group");
+}
+
+SoFCInstanceGroup::SoFCInstanceGroup()
+{
+    SO_NODE_CONSTRUCTOR(SoFCInstanceGroup);
+    SO_NODE_ADD_FIELD(matrix, (SbMatrix::identity()));
+    SO_NODE_ADD_FIELD(hidden, (false));
+    matrix.setNum(0);
+    matrix.setDefault(true);
+    hidden.setNum(0);
+    hidden.setDefault(true);
+}
+
+SoFCInstanceGroup::~SoFCInstanceGroup() = default;
+
+bool SoFCInstanceGroup::isInstanceHidden(int index) const
+{
+    return index < hidden.getNum() && hidden[index];
+}
+
+template<class Func>
+void SoFCInstanceGroup::traverseInstances(SoAction * action, Func func)
+{
+    SoState * state = action->getState();
+    const SbMatrix * matrices = matrix.getValues(0);
+    for (int i = 0, count = matrix.getNum(); i < count; ++i) {
+        if (isInstanceHidden(i)) {
+            continue;
+        }
+        state->push();
+        SoModelMatrixElement::mult(state, this, matrices[i]);
+        func(i);
+        state->pop();
+        if (action->hasTerminated()) {
+            break;
+        }
+    }
+}
+
+void SoFCInstanceGroup::GLRender(SoGLRenderAction * action)
+{
+    int numIndices = 0;
+    const int * indices = nullptr;
+    switch (action->getPathCode(numIndices, indices)) {
+        case SoAction::OFF_PATH:
+            // the instances don't change the state of the following nodes
+            return;
+        case SoAction::IN_PATH:
+            // delayed or sorted transparent paths
+            renderDelayedPath(action);
+            return;
+        default:
+            // a new pass starts, the delayed paths of the last one are done
+            renderedPaths.clear();
+            break;
+    }
+
+    traverseInstances(action, [this, action](int) {
+        inherited::GLRender(action);
+    });
+}
+
+void SoFCInstanceGroup::renderDelayedPath(SoGLRenderAction * action)
+{
+    // All instances added the same path, so render them at its first occurrence
+    auto path = static_cast<const SoFullPath*>(action->getCurPath());
+    std::vector<SoNode*> nodes;
+    nodes.reserve(path->getLength());
+    for (int i = 0; i < path->getLength(); ++i) {
+        nodes.push_back(path->getNode(i));
+    }
+    if (std::find(renderedPaths.begin(), renderedPaths.end(), nodes) != renderedPaths.end()) {
+        return;
+    }
+    renderedPaths.push_back(std::move(nodes));
+
+    // Sort the instances back to front by the depth of their origin
+    SoState * state = action->getState();
+    SbMatrix toView = SoModelMatrixElement::get(state);
+    toView.multRight(SoViewingMatrixElement::get(state));
+    const SbMatrix * matrices = matrix.getValues(0);
+    std::vector<std::pair<float, int>> order;
+    order.reserve(matrix.getNum());
+    for (int i = 0, count = matrix.getNum(); i < count; ++i) {
+        if (isInstanceHidden(i)) {
+            continue;
+        }
+        SbVec3f origin(matrices[i][3][0], matrices[i][3][1], matrices[i][3][2]);
+        toView.multVecMatrix(origin, origin);
+        order.emplace_back(origin[2], i);
+    }
+    std::sort(order.begin(), order.end());
+
+    for (const auto & it : order) {
+        state->push();
+        SoModelMatrixElement::mult(state, this, matrices[it.second]);
+        inherited::GLRender(action);
+        state->pop();
+        if (action->hasTerminated()) {
+            break;
+        }
+    }
+}
+
+void SoFCInstanceGroup::callback(SoCallbackAction * action)
+{
+    traverseInstances(action, [this, action](int) {
+        inherited::callback(action);
+    });
+}
+
+void SoFCInstanceGroup::rayPick(SoRayPickAction * action)
+{
+    int count = action->getPickedPointList().getLength();
+    traverseInstances(action, [this, action, &count](int index) {
+        inherited::rayPick(action);
+
+        // Points picked under this instance are the only ones in the list
+        // going through this node that have no instance detail yet. Unless
+        // all points are picked, the list holds at most the closest point.
+        // Otherwise points are only added, usually at the end, so look for
+        // as many as were added, starting from the back.
+        const SoPickedPointList & points = action->getPickedPointList();
+        int added = action->isPickAll() ? points.getLength() - count : 1;
+        count = points.getLength();
+        for (int i = count - 1; i >= 0 && added > 0; --i) {
+            SoPickedPoint * pp = points[i];
+            if (!pp->getDetail(this) && pp->getPath()->containsNode(this)) {
+                pp->setDetail(new SoFCInstanceDetail(index), this);
+                --added;
+            }
+        }
+    });
+}
+
+void SoFCInstanceGroup::getBoundingBox(SoGetBoundingBoxAction * action)
+{
+    SbVec3f center(0.0F, 0.0F, 0.0F);
+    int numCenters = 0;
+    traverseInstances(action, [this, action, &center, &numCenters](int) {
+        inherited::getBoundingBox(action);
+        if (action->isCenterSet()) {
+            center += action->getCenter();
+            ++numCenters;
+            action->resetCenter();
+        }
+    });
+    if (numCenters) {
+        action->setCenter(center / static_cast<float>(numCenters), false);
+    }
+}
+
+void SoFCInstanceGroup::getPrimitiveCount(SoGetPrimitiveCountAction * action)
+{
+    traverseInstances(action, [this, action](int) {
+        inherited::getPrimitiveCount(action);
+    });
+}
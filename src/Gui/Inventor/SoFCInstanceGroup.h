@@ -0,0 +1,118 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2025 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+#ifndef GUI_INVENTOR_SOFCINSTANCEGROUP_H
+#define GUI_INVENTOR_SOFCINSTANCEGROUP_H
+
+#include <vector>
+
+#include <Inventor/details/SoSubDetail.h>
+#include <Inventor/fields/SoMFBool.h>
+#include <Inventor/fields/SoMFMatrix.h>
+#include <Inventor/nodes/SoSubNode.h>
+#include <Inventor/nodes/SoGroup.h>
+#include <FCGlobal.h>
+
+namespace Gui
+{
+
+/**
+ * @class SoFCInstanceDetail
+ * @brief Tells which copy of a SoFCInstanceGroup a picked point belongs to.
+ *
+ * The detail is attached to the SoFCInstanceGroup node of the picked path,
+ * use SoPickedPoint::getDetail(group) to obtain it.
+ */
+class GuiExport SoFCInstanceDetail : public SoDetail
+{
+    using inherited = SoDetail;
+
+    SO_DETAIL_HEADER(SoFCInstanceDetail);
+
+public:
+    static void initClass();
+    explicit SoFCInstanceDetail(int index = -1);
+
+    SoDetail * copy() const override;
+
+    int getIndex() const
+    {
+        return index;
+    }
+
+private:
+    int index;
+};
+
+/**
+ * @class SoFCInstanceGroup
+ * @brief Renders its children once for each matrix in \c matrix.
+ *
+ * Unlike SoMultipleCopy, instances can be skipped individually with
+ * \c hidden, and the instance hit by a ray pick is recorded as
+ * SoFCInstanceDetail. Actions other than rendering, picking, bounding box
+ * and primitive count traverse the children only once.
+ *
+ * Every instance of a transparent child adds the same path to the delayed or
+ * sorted transparent paths of SoGLRenderAction. When these are rendered, the
+ * instances are drawn back to front for the first of them and the others are
+ * skipped.
+ */
+class GuiExport SoFCInstanceGroup : public SoGroup
+{
+    using inherited = SoGroup;
+
+    SO_NODE_HEADER(SoFCInstanceGroup);
+
+public:
+    static void initClass();
+    SoFCInstanceGroup();
+
+    /// One model matrix per instance
+    SoMFMatrix matrix;
+    /// Instances not to be traversed, may hold fewer values than \c matrix
+    SoMFBool hidden;
+
+    bool isInstanceHidden(int index) const;
+
+protected:
+    ~SoFCInstanceGroup() override;
+
+    void GLRender(SoGLRenderAction * action) override;
+    void callback(SoCallbackAction * action) override;
+    void rayPick(SoRayPickAction * action) override;
+    void getBoundingBox(SoGetBoundingBoxAction * action) override;
+    void getPrimitiveCount(SoGetPrimitiveCountAction * action) override;
+
+private:
+    template<class Func>
+    void traverseInstances(SoAction * action, Func func);
+    void renderDelayedPath(SoGLRenderAction * action);
+
+    /// Paths to this node whose delayed rendering is done in the current pass
+    std::vector<std::vector<SoNode*>> renderedPaths;
+};
+
+} // namespace Gui
+
+#endif // GUI_INVENTOR_SOFCINSTANCEGROUP_H
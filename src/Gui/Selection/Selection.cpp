@@ -26,6 +26,7 @@
 
 # include <array>
 # include <set>
+# include <unordered_map>
 # include <boost/algorithm/string/predicate.hpp>
 # include <QApplication>
 
@@ -424,11 +425,13 @@ std::vector<SelectionObject> SelectionSingleton::getObjectList(const char* pDocN
     std::vector<SelectionObject> temp;
     if (single)
         temp.reserve(1);
-    std::map<App::DocumentObject*,size_t> SortMap;
+    std::unordered_map<App::DocumentObject*,size_t> SortMap;
 
     // check the type
     if (typeId.isBad())
         return temp;
+    if (!single)
+        SortMap.reserve(objList.size());
 
     App::Document *pcDoc = nullptr;
     if (!pDocName || strcmp(pDocName,"*") != 0) {
@@ -1041,31 +1044,13 @@ bool SelectionSingleton::addSelection(const char* pDocName, const char* pObjectN
     temp.z        = z;
 
     // check for a Selection Gate
-    if (ActiveGate) {
-        const char *subelement = nullptr;
-        auto pObject = getObjectOfType(temp,App::DocumentObject::getClassTypeId(),gateResolve,&subelement);
-        if (!ActiveGate->allow(pObject?pObject->getDocument():temp.pDoc,pObject,subelement)) {
-            if (getMainWindow()) {
-                QString msg;
-                if (ActiveGate->notAllowedReason.length() > 0) {
-                    msg = QObject::tr(ActiveGate->notAllowedReason.c_str());
-                } else {
-                    msg = QCoreApplication::translate("SelectionFilter","Selection not allowed by filter");
-                }
-                getMainWindow()->showMessage(msg);
-                Gui::MDIView* mdi = Gui::Application::Instance->activeDocument()->getActiveView();
-                mdi->setOverrideCursor(Qt::ForbiddenCursor);
-            }
-            ActiveGate->notAllowedReason.clear();
-            QApplication::beep();
-            return false;
-        }
-    }
+    if (!testSelectionGate(temp, true))
+        return false;
 
     if(!logDisabled)
         temp.log(false,clearPreselect);
 
-    _SelList.push_back(temp);
+    addSelObj(temp);
     _SelStackForward.clear();
 
     if(clearPreselect)
@@ -1229,7 +1214,7 @@ bool SelectionSingleton::addSelections(const char* pDocName, const char* pObject
         temp.y        = 0;
         temp.z        = 0;
 
-        _SelList.push_back(temp);
+        addSelObj(temp);
         _SelStackForward.clear();
 
         SelectionChanges Chng(SelectionChanges::AddSelection,
@@ -1246,6 +1231,56 @@ bool SelectionSingleton::addSelections(const char* pDocName, const char* pObject
     return true;
 }
 
+int SelectionSingleton::addSelections(const std::vector<App::SubObjectT>& objs, bool clearPreselect)
+{
+    if(!_PickedList.empty()) {
+        _PickedList.clear();
+        notify(SelectionChanges(SelectionChanges::PickedListChanged));
+    }
+
+    if(clearPreselect)
+        rmvPreselect();
+
+    bool reported = false;
+    int count = 0;
+    for(const auto &objT : objs) {
+        _SelObj temp;
+        int ret = checkSelection(objT.getDocumentName().c_str(), objT.getObjectName().c_str(),
+                objT.getSubName().c_str(), ResolveMode::NoResolve, temp);
+        if (ret!=0)
+            continue;
+
+        if (!testSelectionGate(temp, !reported)) {
+            reported = true;
+            continue;
+        }
+
+        if(!logDisabled)
+            temp.log(false,clearPreselect);
+
+        addSelObj(temp);
+        _SelStackForward.clear();
+        ++count;
+
+        SelectionChanges Chng(SelectionChanges::AddSelection,
+                temp.DocName,temp.FeatName,temp.SubName,temp.TypeName);
+
+        FC_LOG("Add Selection "<<Chng.pDocName<<'#'<<Chng.pObjectName<<'.'<<Chng.pSubName);
+
+        notify(std::move(Chng));
+    }
+
+    if(!count)
+        return 0;
+
+    // The views schedule their redraw themselves, so only the command update is
+    // left to be done once for the whole batch
+    getMainWindow()->updateActions();
+
+    rmvPreselect(true);
+    return count;
+}
+
 bool SelectionSingleton::updateSelection(bool show, const char* pDocName,
                             const char* pObjectName, const char* pSubName)
 {
@@ -1338,25 +1373,14 @@ void SelectionSingleton::rmvSelection(const char* pDocName, const char* pObjectN
         return;
 
     std::vector<SelectionChanges> changes;
-    for(auto It=_SelList.begin(),ItNext=It;It!=_SelList.end();It=ItNext) {
-        ++ItNext;
-        if(It->DocName!=temp.DocName || It->FeatName!=temp.FeatName)
-            continue;
-        // if no subname is specified, remove all subobjects of the matching object
-        if(!temp.SubName.empty()) {
-            // otherwise, match subojects with common prefix, separated by '.'
-            if(!boost::starts_with(It->SubName,temp.SubName) ||
-               (It->SubName.length()!=temp.SubName.length() && It->SubName[temp.SubName.length()-1]!='.'))
-                continue;
-        }
-
+    for(auto It : findSelObjs(temp)) {
         It->log(true);
 
         changes.emplace_back(SelectionChanges::RmvSelection,
                 It->DocName,It->FeatName,It->SubName,It->TypeName);
 
         // destroy the _SelObj item
-        _SelList.erase(It);
+        eraseSelObj(It);
     }
 
     // NOTE: It can happen that there are nested calls of rmvSelection()
@@ -1494,7 +1518,7 @@ void SelectionSingleton::setSelection(const char* pDocName, const std::vector<Ap
         if (ret!=0)
             continue;
         touched = true;
-        _SelList.push_back(temp);
+        addSelObj(temp);
     }
 
     if(touched) {
@@ -1530,7 +1554,7 @@ void SelectionSingleton::clearSelection(const char* pDocName, bool clearPreSelec
         for (auto it=_SelList.begin();it!=_SelList.end();) {
             if (it->DocName == docName) {
                 touched = true;
-                it = _SelList.erase(it);
+                it = eraseSelObj(it);
             }
             else {
                 ++it;
@@ -1589,6 +1613,8 @@ void SelectionSingleton::clearCompleteSelection(bool clearPreSelect)
     }
 
     _SelList.clear();
+    _SelIndex.clear();
+    _SelElementIndex.clear();
 
     SelectionChanges Chng(SelectionChanges::ClrSelection);
 
@@ -1614,6 +1640,100 @@ bool SelectionSingleton::isSelected(App::DocumentObject* pObject, const char* pS
             pObject->getNameInDocument(), pSubName, resolve, sel, &_SelList) > 0;
 }
 
+std::string SelectionSingleton::selKey(const std::string &docName, const std::string &objName,
+                                       const std::string &subName)
+{
+    // Neither document nor object names contain '#' or '.', so all selections
+    // of one object share the key prefix "Doc#Obj."
+    std::string key;
+    key.reserve(docName.size() + objName.size() + subName.size() + 2);
+    key += docName;
+    key += '#';
+    key += objName;
+    key += '.';
+    key += subName;
+    return key;
+}
+
+std::pair<const App::DocumentObject*, std::string> SelectionSingleton::selElementKey(const _SelObj &sel)
+{
+    // Mirrors the old style element matching in checkSelection()
+    if (!sel.elementName.newName.empty())
+        return std::make_pair(sel.pResolvedObject, "n" + sel.elementName.newName);
+    return std::make_pair(sel.pResolvedObject, "s" + sel.SubName);
+}
+
+void SelectionSingleton::addSelObj(const _SelObj &sel)
+{
+    auto it = _SelList.insert(_SelList.end(), sel);
+    _SelIndex.emplace(selKey(sel.DocName, sel.FeatName, sel.SubName), it);
+    _SelElementIndex.emplace(selElementKey(sel), it);
+}
+
+SelectionSingleton::SelIter SelectionSingleton::eraseSelObj(SelIter it)
+{
+    auto range = _SelIndex.equal_range(selKey(it->DocName, it->FeatName, it->SubName));
+    for (auto pos = range.first; pos != range.second; ++pos) {
+        if (pos->second == it) {
+            _SelIndex.erase(pos);
+            break;
+        }
+    }
+    auto elementRange = _SelElementIndex.equal_range(selElementKey(*it));
+    for (auto pos = elementRange.first; pos != elementRange.second; ++pos) {
+        if (pos->second == it) {
+            _SelElementIndex.erase(pos);
+            break;
+        }
+    }
+    return _SelList.erase(it);
+}
+
+std::vector<SelectionSingleton::SelIter> SelectionSingleton::findSelObjs(const _SelObj &sel)
+{
+    std::vector<SelIter> res;
+    // if no subname is specified, all subobjects of the matching object are found
+    auto key = selKey(sel.DocName, sel.FeatName, sel.SubName);
+    for (auto it = _SelIndex.lower_bound(key);
+            it != _SelIndex.end() && boost::starts_with(it->first, key); ++it) {
+        const auto &subName = it->second->SubName;
+        // otherwise, match subojects with common prefix, separated by '.'
+        if (!sel.SubName.empty() && subName.length() != sel.SubName.length()
+                && subName[sel.SubName.length()-1] != '.')
+            continue;
+        res.push_back(it->second);
+    }
+    return res;
+}
+
+bool SelectionSingleton::testSelectionGate(_SelObj &sel, bool report)
+{
+    if (!ActiveGate)
+        return true;
+
+    const char *subelement = nullptr;
+    auto pObject = getObjectOfType(sel,App::DocumentObject::getClassTypeId(),gateResolve,&subelement);
+    if (ActiveGate->allow(pObject?pObject->getDocument():sel.pDoc,pObject,subelement))
+        return true;
+
+    if (report) {
+        if (getMainWindow()) {
+            QString msg;
+            if (ActiveGate->notAllowedReason.length() > 0) {
+                msg = QObject::tr(ActiveGate->notAllowedReason.c_str());
+            } else {
+                msg = QCoreApplication::translate("SelectionFilter","Selection not allowed by filter");
+            }
+            getMainWindow()->showMessage(msg);
+            Gui::MDIView* mdi = Gui::Application::Instance->activeDocument()->getActiveView();
+            mdi->setOverrideCursor(Qt::ForbiddenCursor);
+        }
+        QApplication::beep();
+    }
+    ActiveGate->notAllowedReason.clear();
+    return false;
+}
+
 int SelectionSingleton::checkSelection(const char *pDocName, const char *pObjectName, const char *pSubName,
                                        ResolveMode resolve, _SelObj &sel, const std::list<_SelObj> *selList) const
 {
@@ -1665,12 +1785,33 @@ int SelectionSingleton::checkSelection(const char *pDocName, const char *pObject
             sel.SubName = subname;
         }
     }
-    if(!selList)
-        selList = &_SelList;
-
     if(!pSubName)
         pSubName = "";
 
+    if(!selList || selList == &_SelList) {
+        if (_SelIndex.count(selKey(sel.DocName, sel.FeatName, pSubName)))
+            return 1;
+        if (resolve > ResolveMode::OldStyleElement) {
+            auto key = selKey(sel.DocName, sel.FeatName, prefix);
+            auto it = _SelIndex.lower_bound(key);
+            if (it != _SelIndex.end() && boost::starts_with(it->first, key))
+                return 1;
+        }
+        if (resolve == ResolveMode::OldStyleElement) {
+            auto it = _SelElementIndex.lower_bound(std::make_pair(sel.pResolvedObject, std::string()));
+            if (it == _SelElementIndex.end() || it->first.first != sel.pResolvedObject)
+                return 0;
+            if (!pSubName[0])
+                return 1;
+            if (!sel.elementName.newName.empty()
+                    && _SelElementIndex.count(std::make_pair(sel.pResolvedObject, "n" + sel.elementName.newName)))
+                return 1;
+            if (_SelElementIndex.count(std::make_pair(sel.pResolvedObject, "s" + sel.elementName.oldName)))
+                return 1;
+        }
+        return 0;
+    }
+
     for (auto &s : *selList) {
         if (s.DocName==pDocName && s.FeatName==sel.FeatName) {
             if(s.SubName==pSubName)
@@ -1731,7 +1872,7 @@ void SelectionSingleton::slotDeletedObject(const App::DocumentObject& Obj)
         if(it->pResolvedObject == &Obj || it->pObject==&Obj) {
             changes.emplace_back(SelectionChanges::RmvSelection,
                     it->DocName,it->FeatName,it->SubName,it->TypeName);
-            _SelList.erase(it);
+            eraseSelObj(it);
         }
     }
     if(!changes.empty()) {
@@ -2086,12 +2227,13 @@ PyObject *SelectionSingleton::sAddSelection(PyObject * /*self*/, PyObject *args)
         try {
             if (PyTuple_Check(sequence) || PyList_Check(sequence)) {
                 Py::Sequence list(sequence);
+                std::vector<App::SubObjectT> objs;
+                objs.reserve(list.size());
                 for (Py::Sequence::iterator it = list.begin(); it != list.end(); ++it) {
                     std::string subname = static_cast<std::string>(Py::String(*it));
-                    Selection().addSelection(docObj->getDocument()->getName(),
-                                             docObj->getNameInDocument(),
-                                             subname.c_str(), 0, 0, 0, nullptr, Base::asBoolean(clearPreselect));
+                    objs.emplace_back(docObj, subname.c_str());
                 }
+                Selection().addSelections(objs, Base::asBoolean(clearPreselect));
                 Py_Return;
             }
         }
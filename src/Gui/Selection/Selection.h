@@ -27,6 +27,8 @@
 
 #include <deque>
 #include <list>
+#include <map>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -316,6 +318,17 @@ public:
     bool addSelection(const SelectionObject&, bool clearPreSelect=true);
     /// Add to selection with several sub-elements
     bool addSelections(const char* pDocName, const char* pObjectName, const std::vector<std::string>& pSubNames);
+    /** Add a batch of objects or sub-elements to the selection
+     *
+     * @param objs: the objects to add, already selected ones are skipped
+     * @param clearPreSelect: whether to remove the preselection
+     *
+     * @return Returns the number of added selections.
+     *
+     * Observers get an AddSelection message for each entry as with
+     * addSelection(), but the command states are only updated once.
+     */
+    int addSelections(const std::vector<App::SubObjectT>& objs, bool clearPreSelect=true);
     /// Update a selection
     bool updateSelection(bool show, const char* pDocName, const char* pObjectName=nullptr, const char* pSubName=nullptr);
     /// Remove from selection (for internal use)
@@ -681,6 +694,11 @@ protected:
         void log(bool remove=false, bool clearPreselect=true);
     };
     mutable std::list<_SelObj> _SelList;
+    using SelIter = std::list<_SelObj>::iterator;
+    /// Index of _SelList keyed on document, object and subname, see selKey()
+    std::multimap<std::string, SelIter> _SelIndex;
+    /// Index of _SelList keyed on the resolved object and element, see selElementKey()
+    std::multimap<std::pair<const App::DocumentObject*, std::string>, SelIter> _SelElementIndex;
 
     mutable std::list<_SelObj> _PickedList;
     bool _needPickedList{false};
@@ -689,6 +707,18 @@ protected:
     std::deque<SelStackItem> _SelStackBack;
     std::deque<SelStackItem> _SelStackForward;
 
+    static std::string selKey(const std::string &docName, const std::string &objName,
+            const std::string &subName);
+    static std::pair<const App::DocumentObject*, std::string> selElementKey(const _SelObj &sel);
+    /// Append to _SelList and update the indices
+    void addSelObj(const _SelObj &sel);
+    /// Remove from _SelList and update the indices
+    SelIter eraseSelObj(SelIter it);
+    /// Collect the selections matched by rmvSelection()
+    std::vector<SelIter> findSelObjs(const _SelObj &sel);
+    /// Check the active selection gate, optionally report a rejection to the user
+    bool testSelectionGate(_SelObj &sel, bool report);
+
     int checkSelection(const char *pDocName, const char *pObjectName,
             const char *pSubName, ResolveMode resolve, _SelObj &sel, const std::list<_SelObj> *selList=nullptr) const;
 
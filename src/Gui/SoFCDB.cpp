@@ -79,6 +79,7 @@
 #include "Inventor/SoDrawingGrid.h"
 #include "Inventor/SoFCBackgroundGradient.h"
 #include "Inventor/SoFCBoundingBox.h"
+#include "Inventor/SoFCInstanceGroup.h"
 #include "Inventor/SoMouseWheelEvent.h"
 #include "Inventor/SoFCTransform.h"
 #include "Inventor/SoToggleSwitch.h"
@@ -146,6 +147,8 @@ void Gui::SoFCDB::init()
     SoRegPoint                      ::initClass();
     SoDrawingGrid                   ::initClass();
     SoFCTransform                   ::initClass();
+    SoFCInstanceDetail              ::initClass();
+    SoFCInstanceGroup               ::initClass();
     SoAutoZoomTranslation           ::initClass();
     MarkerBitmaps                   ::initClass();
     SoTransformDragger              ::initClass();
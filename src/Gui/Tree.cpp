@@ -359,7 +359,12 @@ public:
     }
 
     void slotChangeIcon() {
-        testStatus(true);
+        // Rebuild the icon once the item gets painted
+        for (auto item : items) {
+            item->previousStatus = -1;
+            item->statusStamp = 0;
+        }
+        docItem->getTree()->viewport()->update();
     }
 
     void slotChangeToolTip(const QString& tip) {
@@ -727,10 +732,15 @@ TreeWidget::TreeWidget(const char* name, QWidget* parent)
     this->statusTimer = new QTimer(this);
     this->statusTimer->setSingleShot(false);
 
+    this->visibleStatusTimer = new QTimer(this);
+    this->visibleStatusTimer->setSingleShot(true);
+    this->visibleStatusTimer->setInterval(0);
+
     this->selectTimer = new QTimer(this);
     this->selectTimer->setSingleShot(true);
 
     connect(this->statusTimer, &QTimer::timeout, this, &TreeWidget::onUpdateStatus);
+    connect(this->visibleStatusTimer, &QTimer::timeout, this, &TreeWidget::updateVisibleStatus);
     connect(this, &QTreeWidget::itemEntered, this, &TreeWidget::onItemEntered);
     connect(this, &QTreeWidget::itemCollapsed, this, &TreeWidget::onItemCollapsed);
     connect(this, &QTreeWidget::itemExpanded, this, &TreeWidget::onItemExpanded);
@@ -2871,9 +2881,32 @@ void TreeWidget::sortDroppedObjects(TargetItemInfo& targetInfo, std::vector<App:
 
 void TreeWidget::drawRow(QPainter* painter, const QStyleOptionViewItem& options, const QModelIndex& index) const
 {
+    auto item = itemFromIndex(index);
+    if (item && item->type() == ObjectType
+        && static_cast<DocumentObjectItem*>(item)->statusStamp != statusStamp) {
+        visibleStatusTimer->start();
+    }
     QTreeWidget::drawRow(painter, options, index);
 }
 
+void TreeWidget::updateVisibleStatus()
+{
+    visibleStatusTimer->stop();
+
+    QRect rect = viewport()->rect();
+    for (auto item = itemAt(rect.topLeft()); item; item = itemBelow(item)) {
+        if (visualItemRect(item).top() > rect.bottom())
+            break;
+        if (item->type() != ObjectType)
+            continue;
+        auto objItem = static_cast<DocumentObjectItem*>(item);
+        if (objItem->statusStamp != statusStamp) {
+            objItem->statusStamp = statusStamp;
+            objItem->testStatus(false);
+        }
+    }
+}
+
 void TreeWidget::slotNewDocument(const Gui::Document& Doc, bool isMainDoc)
 {
     if (Doc.getDocument()->testStatus(App::Document::TempDoc))
@@ -3142,9 +3175,11 @@ void TreeWidget::onUpdateStatus()
 
     FC_LOG("update item status");
     TimingInit();
-    for (auto pos = DocumentMap.begin(); pos != DocumentMap.end(); ++pos) {
-        pos->second->testStatus();
-    }
+    // Only rows in view are tested here, the others are tested by
+    // updateVisibleStatus() once they get painted.
+    if (++statusStamp == 0)
+        statusStamp = 1;
+    updateVisibleStatus();
     TimingPrint();
 
     // Checking for just restored documents
@@ -4000,7 +4035,6 @@ bool DocumentItem::createNewItem(const Gui::ViewProviderDocumentObject& obj,
     item->setText(2, QString::fromUtf8(data->internalName.c_str()));
     if (!obj.showInTree() && !showHidden())
         item->setHidden(true);
-    item->testStatus(true);
 
     populateItem(item);
     return true;
@@ -5308,7 +5342,8 @@ static int countItems;
 
 DocumentObjectItem::DocumentObjectItem(DocumentItem* ownerDocItem, DocumentObjectDataPtr data)
     : QTreeWidgetItem(TreeWidget::ObjectType)
-    , myOwner(ownerDocItem), myData(data), previousStatus(-1), selected(0), populated(false)
+    , myOwner(ownerDocItem), myData(data), previousStatus(-1), statusStamp(0), selected(0)
+    , populated(false)
 {
     setFlags(flags() | Qt::ItemIsEditable | Qt::ItemIsUserCheckable);
     setCheckState(false);
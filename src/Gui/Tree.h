@@ -173,6 +173,7 @@ protected:
 
 private:
     void _updateStatus(bool delay=true);
+    void updateVisibleStatus();
 
 protected Q_SLOTS:
     void onCreateGroup();
@@ -254,6 +255,7 @@ private:
     DocumentItem *currentDocItem;
     QTreeWidgetItem* rootItem;
     QTimer* statusTimer;
+    QTimer* visibleStatusTimer;
     QTimer* selectTimer;
     QTimer* preselectTimer;
     QElapsedTimer preselectTime;
@@ -270,6 +272,10 @@ private:
 
     std::unordered_map<std::string,std::vector<long> > NewObjects;
 
+    // Bumped by each status update. Object items are only tested when they
+    // are painted, and remember the stamp of their last test.
+    std::size_t statusStamp = 1;
+
     static std::set<TreeWidget*> Instances;
 
     std::string myName; // for debugging purpose
@@ -483,11 +489,13 @@ private:
     std::vector<std::string> mySubs;
     using Connection = boost::signals2::connection;
     int previousStatus;
+    std::size_t statusStamp;
     int selected;
     bool populated;
 
     friend class TreeWidget;
     friend class DocumentItem;
+    friend class DocumentObjectData;
 };
 
 class TreePanel : public QWidget
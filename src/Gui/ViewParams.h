@@ -53,6 +53,7 @@ public:
     FC_VIEW_PARAM(AnnotationTextColor,unsigned long,Unsigned,4294967295UL) \
     FC_VIEW_PARAM(MarkerSize,int,Int,9) \
     FC_VIEW_PARAM(DefaultLinkColor,unsigned long,Unsigned,0x66FFFF00) \
+    FC_VIEW_PARAM(LinkArrayInstanceThreshold,int,Int,1000) \
     FC_VIEW_PARAM(DefaultShapeLineColor,unsigned long,Unsigned,421075455UL) \
     FC_VIEW_PARAM(DefaultShapeVertexColor,unsigned long,Unsigned,421075455UL) \
     FC_VIEW_PARAM(DefaultShapeColor,unsigned long,Unsigned,0xCCCCCC00) \
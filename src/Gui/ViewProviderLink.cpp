@@ -1023,11 +1023,19 @@ void LinkView::setMaterial(int index, const App::Material *material) {
     }else if(index >= (int)nodeArray.size())
         LINK_THROW(Base::ValueError,"LinkView: material index out of range");
     else {
-        auto &info = *nodeArray[index];
         if(!material) {
-            info.pcRoot->removeColorOverride();
+            if(nodeArray[index]) {
+                nodeArray[index]->pcRoot->removeColorOverride();
+                // Without the override the element can go back to pcInstances
+                if(pcInstances) {
+                    markTempElement(index);
+                    restoreArrayElements();
+                }
+            }
             return;
         }
+        auto &info = getArrayElement(index);
+        tempElements.erase(index);
         Base::Color c = material->diffuseColor;
         c.setTransparency(material->transparency);
         info.pcRoot->setColorOverride(c);
@@ -1065,23 +1073,44 @@ void LinkView::setLinkViewObject(ViewProviderDocumentObject *vpd,
     updateLink();
 }
 
-void LinkView::setTransform(SoTransform *pcTransform, const Base::Matrix4D &mat) {
+static SbMatrix toSbMatrix(const Base::Matrix4D &mat) {
     double dMtrx[16];
     mat.getGLMatrix(dMtrx);
-    pcTransform->setMatrix(SbMatrix(dMtrx[0], dMtrx[1], dMtrx[2],  dMtrx[3],
-                                    dMtrx[4], dMtrx[5], dMtrx[6],  dMtrx[7],
-                                    dMtrx[8], dMtrx[9], dMtrx[10], dMtrx[11],
-                                    dMtrx[12],dMtrx[13],dMtrx[14], dMtrx[15]));
+    return SbMatrix(dMtrx[0], dMtrx[1], dMtrx[2],  dMtrx[3],
+                    dMtrx[4], dMtrx[5], dMtrx[6],  dMtrx[7],
+                    dMtrx[8], dMtrx[9], dMtrx[10], dMtrx[11],
+                    dMtrx[12],dMtrx[13],dMtrx[14], dMtrx[15]);
+}
+
+static SbMatrix getTransformMatrix(const SoTransform *pcTransform) {
+    SbMatrix mat;
+    mat.setTransform(pcTransform->translation.getValue(),
+                     pcTransform->rotation.getValue(),
+                     pcTransform->scaleFactor.getValue(),
+                     pcTransform->scaleOrientation.getValue(),
+                     pcTransform->center.getValue());
+    return mat;
+}
+
+void LinkView::setTransform(SoTransform *pcTransform, const Base::Matrix4D &mat) {
+    pcTransform->setMatrix(toSbMatrix(mat));
 }
 
 void LinkView::setSize(int _size) {
     size_t size = _size<0?0:(size_t)_size;
-    if(childType<0 && size==nodeArray.size())
+    // Large arrays are drawn by a single SoFCInstanceGroup instead of one
+    // switch/root/transform subgraph per element
+    int threshold = ViewParams::instance()->getLinkArrayInstanceThreshold();
+    bool instanced = threshold>0 && size>=(size_t)threshold;
+    if(childType<0 && size==nodeArray.size() && instanced==(pcInstances.get()!=nullptr))
         return;
     resetRoot();
     if(!size || childType>=0) {
         nodeArray.clear();
         nodeMap.clear();
+        pcInstances.reset();
+        tempElements.clear();
+        connSelection.disconnect();
         if(!size && childType<0) {
             if(pcLinkedRoot)
                 pcLinkRoot->addChild(pcLinkedRoot);
@@ -1090,24 +1119,169 @@ void LinkView::setSize(int _size) {
         childType = SnapshotContainer;
     }
     if(size<nodeArray.size()) {
-        for(size_t i=size;i<nodeArray.size();++i)
-            nodeMap.erase(nodeArray[i]->pcSwitch);
+        for(size_t i=size;i<nodeArray.size();++i) {
+            if(nodeArray[i])
+                nodeMap.erase(nodeArray[i]->pcSwitch);
+        }
         nodeArray.resize(size);
     }
-    for(const auto &info : nodeArray)
-        pcLinkRoot->addChild(info->pcSwitch);
+    for(const auto &info : nodeArray) {
+        if(info)
+            pcLinkRoot->addChild(info->pcSwitch);
+    }
 
+    if(instanced) {
+        bool switched = !pcInstances;
+        if(switched) {
+            pcInstances = new SoFCInstanceGroup;
+            if(pcLinkedRoot)
+                pcInstances->addChild(pcLinkedRoot);
+        }
+        pcLinkRoot->addChild(pcInstances);
+
+        // Elements that already have their own nodes keep them for now, and
+        // their instances stay hidden.
+        int count = std::min(pcInstances->matrix.getNum(), (int)size);
+        pcInstances->matrix.setNum((int)size);
+        pcInstances->hidden.setNum((int)size);
+        SbMatrix *matrices = pcInstances->matrix.startEditing();
+        SbBool *hidden = pcInstances->hidden.startEditing();
+        for(size_t i=count;i<size;++i) {
+            bool hasNodes = i<nodeArray.size() && nodeArray[i];
+            matrices[i] = hasNodes?getTransformMatrix(nodeArray[i]->pcTransform):SbMatrix::identity();
+            hidden[i] = hasNodes;
+        }
+        pcInstances->hidden.finishEditing();
+        pcInstances->matrix.finishEditing();
+        nodeArray.resize(size);
+
+        // The array just grew over the threshold. Move the elements into
+        // pcInstances unless they have a material override or are
+        // preselected or selected.
+        if(switched) {
+            for(size_t i=0;i<nodeArray.size();++i) {
+                if(nodeArray[i] && !nodeArray[i]->pcRoot->hasColorOverride())
+                    markTempElement((int)i);
+            }
+            restoreArrayElements();
+        }
+        return;
+    }
+
+    if(pcInstances) {
+        for(size_t i=0;i<nodeArray.size();++i)
+            getArrayElement((int)i);
+        pcInstances.reset();
+        tempElements.clear();
+        connSelection.disconnect();
+    }
     while(nodeArray.size()<size) {
-        nodeArray.push_back(std::make_unique<Element>(*this));
-        auto &info = *nodeArray.back();
-        info.pcRoot->addChild(info.pcTransform);
-        if(pcLinkedRoot)
-            info.pcRoot->addChild(pcLinkedRoot);
-        pcLinkRoot->addChild(info.pcSwitch);
-        nodeMap.emplace(info.pcSwitch,(int)nodeArray.size()-1);
+        nodeArray.emplace_back();
+        createArrayElement((int)nodeArray.size()-1);
     }
 }
 
+LinkView::Element &LinkView::createArrayElement(int index) {
+    auto &info = nodeArray[index];
+    info = std::make_unique<Element>(*this);
+    info->pcRoot->addChild(info->pcTransform);
+    if(pcLinkedRoot)
+        info->pcRoot->addChild(pcLinkedRoot);
+    pcLinkRoot->addChild(info->pcSwitch);
+    nodeMap.emplace(info->pcSwitch,index);
+    return *info;
+}
+
+LinkView::Element &LinkView::getArrayElement(int index) {
+    if(nodeArray[index])
+        return *nodeArray[index];
+
+    // The element is drawn by pcInstances. Move it into its own subgraph,
+    // so that it can have its own material and selection context.
+    bool visible = !pcInstances->isInstanceHidden(index);
+    auto &info = createArrayElement(index);
+    info.pcTransform->setMatrix(pcInstances->matrix[index]);
+    info.pcSwitch->whichChild = visible?0:SO_SWITCH_NONE;
+    pcInstances->hidden.set1Value(index, true);
+    return info;
+}
+
+bool LinkView::isArrayElementInUse(int index) const {
+    auto owner = getOwner();
+    if(!owner || !owner->getObject())
+        return false;
+    auto ownerObj = owner->getObject();
+    auto check = [&](App::DocumentObject *obj, const char *subname) {
+        if(!obj || !subname || !subname[0])
+            return false;
+        std::vector<int> sizes;
+        auto objs = obj->getSubObjectList(subname,&sizes);
+        for(size_t i=0;i<objs.size();++i) {
+            if(objs[i] != ownerObj)
+                continue;
+            if(App::LinkBaseExtension::getArrayIndex(subname+sizes[i])==index)
+                return true;
+        }
+        return false;
+    };
+    for(const auto &sel : Selection().getSelection("*",ResolveMode::NoResolve)) {
+        if(check(sel.pObject,sel.SubName))
+            return true;
+    }
+    const auto &pre = Selection().getPreselection();
+    return pre.Type == SelectionChanges::SetPreselect
+        && check(pre.Object.getObject(),pre.pSubName);
+}
+
+void LinkView::restoreArrayElements() {
+    if(!pcInstances) {
+        tempElements.clear();
+        connSelection.disconnect();
+        return;
+    }
+    for(auto it=tempElements.begin();it!=tempElements.end();) {
+        int index = *it;
+        if(index>=(int)nodeArray.size() || !nodeArray[index]) {
+            it = tempElements.erase(it);
+            continue;
+        }
+        if(isArrayElementInUse(index)) {
+            ++it;
+            continue;
+        }
+        auto &info = *nodeArray[index];
+        pcInstances->matrix.set1Value(index,getTransformMatrix(info.pcTransform));
+        pcInstances->hidden.set1Value(index,info.pcSwitch->whichChild.getValue()<0);
+        int idx = pcLinkRoot->findChild(info.pcSwitch);
+        if(idx>=0)
+            pcLinkRoot->removeChild(idx);
+        nodeMap.erase(info.pcSwitch);
+        nodeArray[index].reset();
+        it = tempElements.erase(it);
+    }
+    if(tempElements.empty())
+        connSelection.disconnect();
+}
+
+void LinkView::markTempElement(int index) {
+    tempElements.insert(index);
+    if(connSelection.connected())
+        return;
+    connSelection = Selection().signalSelectionChanged.connect(
+        [this](const SelectionChanges &msg) {
+            switch(msg.Type) {
+            case SelectionChanges::RmvPreselect:
+            case SelectionChanges::RmvSelection:
+            case SelectionChanges::SetSelection:
+            case SelectionChanges::ClrSelection:
+                restoreArrayElements();
+                break;
+            default:
+                break;
+            }
+        });
+}
+
 void LinkView::resetRoot() {
     coinRemoveAllChildren(pcLinkRoot);
     if(pcTransform)
@@ -1125,6 +1299,9 @@ void LinkView::setChildren(const std::vector<App::DocumentObject*> &children,
         if(!nodeArray.empty()) {
             nodeArray.clear();
             nodeMap.clear();
+            pcInstances.reset();
+            tempElements.clear();
+            connSelection.disconnect();
             childType = SnapshotContainer;
             resetRoot();
             if(pcLinkedRoot)
@@ -1138,8 +1315,12 @@ void LinkView::setChildren(const std::vector<App::DocumentObject*> &children,
 
     resetRoot();
 
-    if(childType<0)
+    if(childType<0) {
         nodeArray.clear();
+        pcInstances.reset();
+        tempElements.clear();
+        connSelection.disconnect();
+    }
     childType = type;
 
     if(nodeArray.size() > children.size())
@@ -1185,7 +1366,7 @@ void LinkView::setChildren(const std::vector<App::DocumentObject*> &children,
 std::vector<ViewProviderDocumentObject*> LinkView::getChildren() const {
     std::vector<ViewProviderDocumentObject*> ret;
     for(const auto &info : nodeArray) {
-        if(info->isLinked())
+        if(info && info->isLinked())
             ret.push_back(info->linkInfo->pcLinked);
     }
     return ret;
@@ -1202,17 +1383,27 @@ void LinkView::setTransform(int index, const Base::Matrix4D &mat) {
     }
     if(index<0 || index>=(int)nodeArray.size())
         LINK_THROW(Base::ValueError,"LinkView: index out of range");
-    setTransform(nodeArray[index]->pcTransform,mat);
+    if(pcInstances)
+        pcInstances->matrix.set1Value(index, toSbMatrix(mat));
+    if(nodeArray[index])
+        setTransform(nodeArray[index]->pcTransform,mat);
 }
 
 void LinkView::setElementVisible(int idx, bool visible) {
-    if(idx>=0 && idx<(int)nodeArray.size())
+    if(idx<0 || idx>=(int)nodeArray.size())
+        return;
+    if(nodeArray[idx])
         nodeArray[idx]->pcSwitch->whichChild = visible?0:SO_SWITCH_NONE;
+    else if(pcInstances->isInstanceHidden(idx) == visible)
+        pcInstances->hidden.set1Value(idx, !visible);
 }
 
 bool LinkView::isElementVisible(int idx) const {
-    if(idx>=0 && idx<(int)nodeArray.size())
+    if(idx>=0 && idx<(int)nodeArray.size()) {
+        if(!nodeArray[idx])
+            return !pcInstances->isInstanceHidden(idx);
         return nodeArray[idx]->pcSwitch->whichChild.getValue()>=0;
+    }
     return false;
 }
 
@@ -1271,15 +1462,21 @@ void LinkView::replaceLinkedRoot(SoSeparator *root) {
         else
             resetRoot();
     }else if(childType<0) {
-        if(pcLinkedRoot && root) {
-            for(const auto &info : nodeArray)
-                info->pcRoot->replaceChild(pcLinkedRoot,root);
-        }else if(root) {
-            for(const auto &info : nodeArray)
-                info->pcRoot->addChild(root);
-        }else{
-            for(const auto &info : nodeArray)
-                info->pcRoot->removeChild(pcLinkedRoot);
+        std::vector<SoGroup*> roots;
+        roots.reserve(nodeArray.size()+1);
+        for(const auto &info : nodeArray) {
+            if(info)
+                roots.push_back(info->pcRoot);
+        }
+        if(pcInstances)
+            roots.push_back(pcInstances);
+        for(auto group : roots) {
+            if(pcLinkedRoot && root)
+                group->replaceChild(pcLinkedRoot,root);
+            else if(root)
+                group->addChild(root);
+            else
+                group->removeChild(pcLinkedRoot);
         }
     }
     pcLinkedRoot = root;
@@ -1378,7 +1575,13 @@ bool LinkView::linkGetElementPicked(const SoPickedPoint *pp, std::string &subnam
 {
     std::ostringstream ss;
     CoinPtr<SoPath> path = pp->getPath();
-    if(!nodeArray.empty()) {
+    int instance = getPickedInstance(pp);
+    if(instance >= 0) {
+        if(!isElementVisible(instance))
+            return false;
+        ss << instance << '.';
+    }
+    else if(!nodeArray.empty()) {
         auto idx = path->findNode(pcLinkRoot);
         if (idx < 0 || idx + 2 >= path->getLength()) {
             return false;
@@ -1470,6 +1673,19 @@ bool LinkView::linkGetElementPicked(const SoPickedPoint *pp, std::string &subnam
     return false;
 }
 
+int LinkView::getPickedInstance(const SoPickedPoint *pp) const {
+    if(!pcInstances)
+        return -1;
+    auto path = pp->getPath();
+    auto idx = path->findNode(pcLinkRoot);
+    if(idx < 0 || idx + 1 >= path->getLength() || path->getNode(idx+1) != pcInstances)
+        return -1;
+    auto det = pp->getDetail(pcInstances);
+    if(!det || !det->isOfType(SoFCInstanceDetail::getClassTypeId()))
+        return -1;
+    return static_cast<const SoFCInstanceDetail*>(det)->getIndex();
+}
+
 bool LinkView::getGroupHierarchy(int index, SoFullPath *path) const {
     if(index > (int)nodeArray.size())
         return false;
@@ -1481,7 +1697,7 @@ bool LinkView::getGroupHierarchy(int index, SoFullPath *path) const {
     return true;
 }
 
-bool LinkView::linkGetDetailPath(const char *subname, SoFullPath *path, SoDetail *&det) const
+bool LinkView::linkGetDetailPath(const char *subname, SoFullPath *path, SoDetail *&det)
 {
     if(!subname || *subname==0)
         return true;
@@ -1502,7 +1718,7 @@ bool LinkView::linkGetDetailPath(const char *subname, SoFullPath *path, SoDetail
                 if (subname[0] == '$') {
                     CharRange name(subname+1,dot);
                     for(const auto &info : nodeArray) {
-                        if(info->isLinked() && boost::equals(name,info->linkInfo->getLinkedLabel())) {
+                        if(info && info->isLinked() && boost::equals(name,info->linkInfo->getLinkedLabel())) {
                             idx = i;
                             break;
                         }
@@ -1511,7 +1727,7 @@ bool LinkView::linkGetDetailPath(const char *subname, SoFullPath *path, SoDetail
                 } else {
                     CharRange name(subname,dot);
                     for(const auto &info : nodeArray) {
-                        if(info->isLinked() && boost::equals(name,info->linkInfo->getLinkedName())) {
+                        if(info && info->isLinked() && boost::equals(name,info->linkInfo->getLinkedName())) {
                             idx = i;
                             break;
                         }
@@ -1531,7 +1747,15 @@ bool LinkView::linkGetDetailPath(const char *subname, SoFullPath *path, SoDetail
 
         if(idx<0 || idx>=(int)nodeArray.size())
             return false;
-        auto &info = *nodeArray[idx];
+        // Instances share the selection context, so give the element its own
+        // nodes before it gets highlighted or selected. The element goes back
+        // to pcInstances once it is no longer preselected or selected.
+        Element *pinfo = nodeArray[idx].get();
+        if(!pinfo) {
+            pinfo = &getArrayElement(idx);
+            markTempElement(idx);
+        }
+        auto &info = *pinfo;
         if(!appendPathSafe(path,pcLinkRoot))
             return false;
         if(info.groupIndex>=0 && !getGroupHierarchy(info.groupIndex,path))
@@ -1604,7 +1828,7 @@ void LinkView::unlink(LinkInfoPtr info) {
         else {
             for(const auto &info : nodeArray) {
                 int idx;
-                if(info->isLinked() &&
+                if(info && info->isLinked() &&
                    (idx=info->pcRoot->findChild(pcLinkedRoot))>=0)
                     info->pcRoot->removeChild(idx);
             }
@@ -26,10 +26,12 @@
 #include <App/Link.h>
 #include <unordered_map>
 #include <map>
+#include <set>
 #include <string>
 #include <vector>
 #include <memory>
 
+#include "Inventor/SoFCInstanceGroup.h"
 #include "Selection/SoFCUnifiedSelection.h"
 #include "ViewProviderDocumentObject.h"
 #include "ViewProviderExtension.h"
@@ -144,7 +146,7 @@ public:
     void setChildren(const std::vector<App::DocumentObject*> &children,
             const boost::dynamic_bitset<> &vis, SnapshotType type=SnapshotVisible);
 
-    bool linkGetDetailPath(const char *, SoFullPath *, SoDetail *&) const;
+    bool linkGetDetailPath(const char *, SoFullPath *, SoDetail *&);
     bool linkGetElementPicked(const SoPickedPoint *, std::string &) const;
 
     void setElementVisible(int index, bool visible);
@@ -166,6 +168,7 @@ protected:
     void replaceLinkedRoot(SoSeparator *);
     void resetRoot();
     bool getGroupHierarchy(int index, SoFullPath *path) const;
+    int getPickedInstance(const SoPickedPoint *pp) const;
 
 protected:
     LinkInfoPtr linkOwner;
@@ -184,8 +187,23 @@ protected:
     std::map<std::string, std::unique_ptr<SubInfo> > subInfo;
 
     class Element;
+    /** Array elements. If the array is drawn by \c pcInstances, an entry
+     * stays empty until the element needs its own nodes, e.g. for a material
+     * override or for highlighting.
+     */
     std::vector<std::unique_ptr<Element> > nodeArray;
     std::unordered_map<SoNode*,int> nodeMap;
+    CoinPtr<SoFCInstanceGroup> pcInstances;
+    /// Elements that only got their own nodes for highlighting or selection
+    std::set<int> tempElements;
+    boost::signals2::scoped_connection connSelection;
+
+    Element &createArrayElement(int index);
+    Element &getArrayElement(int index);
+    void restoreArrayElements();
+    /// Moves the element back to pcInstances once it is no longer in use
+    void markTempElement(int index);
+    bool isArrayElementInUse(int index) const;
 
     Py::Object PythonObject;
 };
@@ -122,7 +122,9 @@ PathSegmentWalker::PathSegmentWalker(const Toolpath& tp_)
 {}
 
 
-void PathSegmentWalker::walk(PathSegmentVisitor& cb, const Base::Vector3d& startPosition)
+void PathSegmentWalker::walk(PathSegmentVisitor& cb,
+                             const Base::Vector3d& startPosition,
+                             PathSegmentCache* cache)
 {
     if (tp.getSize() == 0) {
         return;
@@ -147,8 +149,12 @@ void PathSegmentWalker::walk(PathSegmentVisitor& cb, const Base::Vector3d& start
 
     cb.setup(last);
 
+    // only the arcs of this walk are kept in the cache
+    std::unordered_map<unsigned int, PathSegmentCache::Arc> arcs;
+
+    std::deque<Base::Vector3d> points;
     for (unsigned int i = 0; i < tp.getSize(); i++) {
-        std::deque<Base::Vector3d> points;
+        points.clear();
 
         const Path::Command& cmd = tp.getCommand(i);
         const std::string& name = cmd.Name;
@@ -262,34 +268,70 @@ void PathSegmentWalker::walk(PathSegmentVisitor& cb, const Base::Vector3d& start
                 angle = std::numbers::pi * 2;
             }
 
-            double amax = std::max(fmod(fabs(a - A), 360),
-                                   std::max(fmod(fabs(b - B), 360), fmod(fabs(c - C), 360)));
+            double plane = pz == &Base::Vector3d::z ? 0.0 : (pz == &Base::Vector3d::y ? 1.0 : 2.0);
+            PathSegmentCache::Key key {last.x,
+                                       last.y,
+                                       last.z,
+                                       next.x,
+                                       next.y,
+                                       next.z,
+                                       center.x,
+                                       center.y,
+                                       center.z,
+                                       a,
+                                       b,
+                                       c,
+                                       A,
+                                       B,
+                                       C,
+                                       rotCenter.x,
+                                       rotCenter.y,
+                                       rotCenter.z,
+                                       norm.*pz,
+                                       plane,
+                                       deviation};
+            PathSegmentCache::Arc* cached = nullptr;
+            if (cache) {
+                auto it = cache->arcs.find(i);
+                if (it != cache->arcs.end() && it->second.key == key) {
+                    cached = &it->second;
+                }
+            }
+            if (cached) {
+                points = std::move(cached->points);
+            }
+            else {
+                double amax = std::max(fmod(fabs(a - A), 360),
+                                       std::max(fmod(fabs(b - B), 360), fmod(fabs(c - C), 360)));
 
-            int segments = std::max(
-                ARC_MIN_SEGMENTS,
-                3.0
-                    / (deviation
-                       / std::max(angle, amax)));  // we use a rather simple rule here, provisorily
-            double dZ = (next.*pz - last.*pz) / segments;  // How far each segment will helix in Z
+                // we use a rather simple rule here, provisorily
+                int segments =
+                    std::max(ARC_MIN_SEGMENTS, 3.0 / (deviation / std::max(angle, amax)));
+                double dZ =
+                    (next.*pz - last.*pz) / segments;  // How far each segment will helix in Z
 
-            double dangle = angle / segments;
-            double da = (a - A) / segments;
-            double db = (b - B) / segments;
-            double dc = (c - C) / segments;
+                double dangle = angle / segments;
+                double da = (a - A) / segments;
+                double db = (b - B) / segments;
+                double dc = (c - C) / segments;
 
-            for (int j = 1; j < segments; j++) {
-                Base::Vector3d inter;
-                Base::Rotation rot(norm, dangle * j);
-                rot.multVec((last0 - center0), inter);
-                inter.*pz = last.*pz + dZ * j;  // Enable displaying helices
+                for (int j = 1; j < segments; j++) {
+                    Base::Vector3d inter;
+                    Base::Rotation rot(norm, dangle * j);
+                    rot.multVec((last0 - center0), inter);
+                    inter.*pz = last.*pz + dZ * j;  // Enable displaying helices
 
-                Base::Rotation arot = yawPitchRoll(A + da * j, B + db * j, C + dc * j);
-                Base::Vector3d rinter = compensateRotation(center0 + inter, arot, rotCenter);
+                    Base::Rotation arot = yawPitchRoll(A + da * j, B + db * j, C + dc * j);
+                    Base::Vector3d rinter = compensateRotation(center0 + inter, arot, rotCenter);
 
-                points.push_back(rinter);
+                    points.push_back(rinter);
+                }
             }
 
             cb.g23(i, last, rnext, points, center);
+            if (cache) {
+                arcs.emplace(i, PathSegmentCache::Arc {key, std::move(points)});
+            }
 
             last = next;
             A = a;
@@ -411,6 +453,10 @@ void PathSegmentWalker::walk(PathSegmentVisitor& cb, const Base::Vector3d& start
             retract_mode = 99;
         }
     }
+
+    if (cache) {
+        cache->arcs = std::move(arcs);
+    }
 }
 
 
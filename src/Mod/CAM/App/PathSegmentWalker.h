@@ -23,7 +23,10 @@
 #ifndef PATHSEGMENTWALKER_H
 #define PATHSEGMENTWALKER_H
 
+#include <array>
 #include <deque>
+#include <unordered_map>
+#include <vector>
 
 #include <Base/Vector3D.h>
 
@@ -66,6 +69,32 @@ public:
     virtual void g38(int id, const Base::Vector3d& last, const Base::Vector3d& next);
 };
 
+/**
+ * PathSegmentCache keeps the segmented points of the arcs of a path between walks. When the
+ * same path is walked again only the arcs whose command or start position has changed are
+ * segmented again.
+ */
+class PathExport PathSegmentCache
+{
+public:
+    void clear()
+    {
+        arcs.clear();
+    }
+
+private:
+    friend class PathSegmentWalker;
+
+    // everything the segmentation of an arc depends on
+    using Key = std::array<double, 21>;
+    struct Arc
+    {
+        Key key;
+        std::deque<Base::Vector3d> points;
+    };
+    std::unordered_map<unsigned int, Arc> arcs;  // by command index
+};
+
 /**
  * PathSegmentWalker processes a path and splits all movement commands into straight segments and
  * calls the appropriate member of the provided PathSegmentVisitor. All non-movement commands are
@@ -77,7 +106,10 @@ public:
     PathSegmentWalker(const Toolpath& tp_);
 
 
-    void walk(PathSegmentVisitor& cb, const Base::Vector3d& startPosition);
+    /// If \a cache is given the segmented arcs are taken from and stored in it
+    void walk(PathSegmentVisitor& cb,
+              const Base::Vector3d& startPosition,
+              PathSegmentCache* cache = nullptr);
 
 private:
     const Toolpath& tp;
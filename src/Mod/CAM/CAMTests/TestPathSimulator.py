@@ -0,0 +1,154 @@
+# SPDX-License-Identifier: LGPL-2.1-or-later
+
+# ***************************************************************************
+# *                                                                         *
+# *   This program is free software; you can redistribute it and/or modify  *
+# *   it under the terms of the GNU Lesser General Public License (LGPL)    *
+# *   as published by the Free Software Foundation; either version 2 of     *
+# *   the License, or (at your option) any later version.                   *
+# *   for detail see the LICENCE text file.                                 *
+# *                                                                         *
+# *   This program is distributed in the hope that it will be useful,       *
+# *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+# *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+# *   GNU Library General Public License for more details.                  *
+# *                                                                         *
+# *   You should have received a copy of the GNU Library General Public     *
+# *   License along with this program; if not, write to the Free Software   *
+# *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  *
+# *   USA                                                                   *
+# *                                                                         *
+# ***************************************************************************
+
+import FreeCAD
+import math
+import Part
+import Path
+import PathSimulator
+
+from CAMTests.PathTestUtils import PathTestBase
+
+Vector = FreeCAD.Vector
+
+Resolution = 0.1
+
+# a plunge to Z8 into a 20x20x10 stock, a line along X and a clockwise half circle
+# around (15, 10) back to the same side
+Commands = [
+    Path.Command("G0", {"X": 5, "Y": 5, "Z": 15}),
+    Path.Command("G1", {"Z": 8}),
+    Path.Command("G1", {"X": 15}),
+    Path.Command("G2", {"X": 15, "Y": 15, "I": 0, "J": 5}),
+    Path.Command("G0", {"Z": 15}),
+]
+
+
+def sweptVolume():
+    """The volume a 2mm end mill cuts out of the stock along Commands."""
+    h = 2
+    plunge = Part.makeCylinder(1, h, Vector(5, 5, 8))
+    line = Part.makeBox(10, 2, h, Vector(5, 4, 8))
+    lineEnd = Part.makeCylinder(1, h, Vector(15, 5, 8))
+    ring = Part.makeCylinder(6, h, Vector(15, 10, 8)).cut(
+        Part.makeCylinder(4, h, Vector(15, 10, 8))
+    )
+    arc = ring.common(Part.makeBox(6, 12, h, Vector(9, 4, 8)))
+    arcEnd = Part.makeCylinder(1, h, Vector(15, 15, 8))
+    return plunge.fuse([line, lineEnd, arc, arcEnd]).Volume
+
+
+class TestPathSimulator(PathTestBase):
+    def createSimulation(self):
+        sim = PathSimulator.PathSim()
+        sim.BeginSimulation(Part.makeBox(20, 20, 10), Resolution)
+        sim.SetToolShape(Part.makeCylinder(1, 10), Resolution)
+        return sim
+
+    def assertBoundBox(self, bb, xmin, ymin, zmin, xmax, ymax, zmax):
+        error = 2 * Resolution
+        self.assertRoughly(bb.XMin, xmin, error)
+        self.assertRoughly(bb.YMin, ymin, error)
+        self.assertRoughly(bb.ZMin, zmin, error)
+        self.assertRoughly(bb.XMax, xmax, error)
+        self.assertRoughly(bb.YMax, ymax, error)
+        self.assertRoughly(bb.ZMax, zmax, error)
+
+    def test00(self):
+        """Verify ApplyCommand and ApplyPath cut the same lines and arcs"""
+        start = FreeCAD.Placement(Vector(5, 5, 15), FreeCAD.Rotation())
+
+        simCmd = self.createSimulation()
+        pos = start
+        for cmd in Commands:
+            pos = simCmd.ApplyCommand(pos, cmd)
+        self.assertCoincide(pos.Base, Vector(15, 15, 15))
+
+        simPath = self.createSimulation()
+        pos, _, removed = simPath.ApplyPath(start, Path.Path(Commands))
+        self.assertCoincide(pos.Base, Vector(15, 15, 15))
+
+        expected = sweptVolume()
+        self.assertRoughly(removed, expected, 0.1 * expected)
+
+        # the stock is left untouched outside the cut, the inner mesh holds the
+        # walls and the floor of the pocket
+        for sim in (simCmd, simPath):
+            outer, inner = sim.GetResultMesh()
+            self.assertBoundBox(outer.BoundBox, 0, 0, 0, 20, 20, 10)
+            self.assertBoundBox(inner.BoundBox, 4, 4, 8, 16, 16, 10)
+
+        # the commands already removed everything the path cuts
+        _, _, removed = simCmd.ApplyPath(start, Path.Path(Commands))
+        self.assertRoughly(removed, 0, 0.01 * expected)
+
+    def test10(self):
+        """Verify reports gouges, rapid collisions and the cutting times"""
+        sim = self.createSimulation()
+        # the part is the left half of the stock, 4mm below its top
+        sim.SetModel(Part.makeBox(10, 20, 6))
+
+        path = Path.Path(
+            [
+                Path.Command("G0", {"X": 15, "Y": 10, "Z": 15}),
+                Path.Command("G1", {"Z": 8, "F": 100}),
+                Path.Command("G1", {"Y": 15}),
+                Path.Command("G0", {"Z": 15}),
+                Path.Command("G1", {"X": 5, "Y": 10}),
+                Path.Command("G1", {"Z": 4}),
+                Path.Command("G0", {"Z": 15}),
+                Path.Command("G0", {"X": 15, "Y": 5}),
+                Path.Command("G0", {"Z": 9}),
+            ]
+        )
+        start = FreeCAD.Placement(Vector(0, 0, 20), FreeCAD.Rotation())
+        result = sim.Verify(start, path)
+
+        self.assertCoincide(result["Placement"].Base, Vector(15, 5, 9))
+
+        # only the plunge to Z4 cuts into the part
+        self.assertEqual(len(result["Gouges"]), 1)
+        command, position, depth = result["Gouges"][0]
+        self.assertEqual(command, 5)
+        self.assertRoughly(depth, 2, Resolution)
+        self.assertRoughly(position.x, 5, 1 + Resolution)
+        self.assertRoughly(position.y, 10, 1 + Resolution)
+        self.assertRoughly(position.z, 4, Resolution)
+
+        # the last rapid plunges 1mm into the stock
+        self.assertEqual(len(result["RapidCollisions"]), 1)
+        command, volume = result["RapidCollisions"][0]
+        self.assertEqual(command, 8)
+        self.assertRoughly(volume, math.pi, 0.2 * math.pi)
+
+        # the feed moves 1, 2 and 5 cut, the move 4 above the stock only cuts air
+        self.assertRoughly(result["CuttingTime"], (7 + 5 + 11) / 100)
+        self.assertRoughly(result["AirCuttingTime"], math.sqrt(125) / 100)
+        self.assertGreater(result["RemovedVolume"], 0)
+
+    def test11(self):
+        """Verify needs a tool to cut the stock with"""
+        sim = PathSimulator.PathSim()
+        sim.BeginSimulation(Part.makeBox(20, 20, 10), Resolution)
+        start = FreeCAD.Placement(Vector(0, 0, 20), FreeCAD.Rotation())
+        with self.assertRaises(RuntimeError):
+            sim.Verify(start, Path.Path(Commands))
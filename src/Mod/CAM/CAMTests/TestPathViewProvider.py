@@ -0,0 +1,173 @@
+# SPDX-License-Identifier: LGPL-2.1-or-later
+
+# ***************************************************************************
+# *                                                                         *
+# *   This program is free software; you can redistribute it and/or modify  *
+# *   it under the terms of the GNU Lesser General Public License (LGPL)    *
+# *   as published by the Free Software Foundation; either version 2 of     *
+# *   the License, or (at your option) any later version.                   *
+# *   for detail see the LICENCE text file.                                 *
+# *                                                                         *
+# *   This program is distributed in the hope that it will be useful,       *
+# *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+# *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+# *   GNU Library General Public License for more details.                  *
+# *                                                                         *
+# *   You should have received a copy of the GNU Library General Public     *
+# *   License along with this program; if not, write to the Free Software   *
+# *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  *
+# *   USA                                                                   *
+# *                                                                         *
+# ***************************************************************************
+
+"""Tests the chunked display of toolpaths by the path view provider."""
+
+import os
+import time
+import unittest
+
+import FreeCAD
+import Path
+
+from pivy import coin
+
+# set to run the benchmarks, they are too slow for the regular test runs
+Benchmark = bool(os.environ.get("FREECAD_RUN_BENCHMARKS"))
+
+
+def createCommands(size, radius=1):
+    """A row of half circles along X with a plunge every 4th move."""
+    commands = []
+    for i in range(size):
+        x = 2 * radius * (i + 1)
+        if i % 4 == 3:
+            commands.append(Path.Command("G1", {"X": x, "Y": 0, "Z": -1}))
+        else:
+            commands.append(Path.Command("G2", {"X": x, "Y": 0, "I": radius, "J": 0}))
+    return commands
+
+
+def getChunks(vobj):
+    """Returns the (switch, coordinates, edge set) nodes of each chunk."""
+    sa = coin.SoSearchAction()
+    sa.setType(coin.SoIndexedLineSet.getClassTypeId())
+    sa.setInterest(coin.SoSearchAction.ALL)
+    sa.setSearchingAll(True)
+    sa.apply(vobj.RootNode)
+    paths = sa.getPaths()
+
+    chunks = []
+    for i in range(paths.getLength()):
+        path = paths.get(i)
+        n = path.getLength()
+        switch = path.getNode(n - 3)
+        if not switch.isOfType(coin.SoSwitch.getClassTypeId()):
+            continue
+        root = coin.cast(path.getNode(n - 2), "SoSeparator")
+        chunks.append(
+            (
+                coin.cast(switch, "SoSwitch"),
+                coin.cast(root.getChild(1), "SoCoordinate3"),
+                coin.cast(path.getTail(), "SoIndexedLineSet"),
+            )
+        )
+    return chunks
+
+
+def shownEdges(vobj):
+    """Returns the number of edges that are displayed."""
+    count = 0
+    for switch, _, lines in getChunks(vobj):
+        if switch.whichChild.getValue() == 0:
+            count += list(lines.coordIndex.getValues()).count(-1)
+    return count
+
+
+def chunkPoints(vobj):
+    """Returns the coordinates of all chunks."""
+    points = []
+    for _, coords, _ in getChunks(vobj):
+        points += [tuple(v.getValue()) for v in coords.point.getValues()]
+    return points
+
+
+class TestPathViewProvider(unittest.TestCase):
+    def setUp(self):
+        self.doc = FreeCAD.newDocument("TestPathViewProvider")
+
+    def tearDown(self):
+        FreeCAD.closeDocument(self.doc.Name)
+
+    def createPath(self, commands):
+        obj = self.doc.addObject("Path::Feature", "Path")
+        obj.Path = Path.Path(commands)
+        self.doc.recompute()
+        return obj
+
+    def test00(self):
+        """Verify the range of shown commands spans the chunks"""
+        size = 5000
+        obj = self.createPath(createCommands(size))
+        vobj = obj.ViewObject
+        self.assertGreater(len(getChunks(vobj)), 2)
+        self.assertEqual(shownEdges(vobj), size)
+
+        vobj.ShowCount = 100
+        self.assertEqual(shownEdges(vobj), 100)
+
+        # the range crosses the border of two chunks
+        vobj.StartIndex = 2000
+        self.assertEqual(shownEdges(vobj), 100)
+
+        vobj.StartIndex = size - 40
+        self.assertEqual(shownEdges(vobj), 40)
+
+        vobj.StartIndex = 0
+        vobj.ShowCount = 0
+        self.assertEqual(shownEdges(vobj), size)
+
+    def test01(self):
+        """Verify changed arcs are displayed like a new path"""
+        obj = self.createPath(createCommands(3000))
+
+        commands = obj.Path.Commands
+        commands[10] = Path.Command("G2", {"X": 24, "Y": 0, "I": 2, "J": 0})
+        commands.insert(2500, Path.Command("G1", {"Y": 5}))
+        obj.Path = Path.Path(commands)
+        self.doc.recompute()
+
+        fresh = self.createPath(commands)
+        self.assertEqual(shownEdges(obj.ViewObject), len(commands))
+        self.assertEqual(chunkPoints(obj.ViewObject), chunkPoints(fresh.ViewObject))
+
+    @unittest.skipUnless(Benchmark, "FREECAD_RUN_BENCHMARKS not set")
+    def test90(self):
+        """Benchmark building the chunks and changing the shown range"""
+        for size in (10000, 100000):
+            commands = createCommands(size)
+            obj = self.createPath([])
+            vobj = obj.ViewObject
+
+            begin = time.perf_counter()
+            obj.Path = Path.Path(commands)
+            build = time.perf_counter() - begin
+
+            # only the chunks at both ends of the range change
+            steps = 200
+            begin = time.perf_counter()
+            vobj.ShowCount = 1000
+            for i in range(steps):
+                vobj.StartIndex = i * (size - 1000) // steps
+            toggle = (time.perf_counter() - begin) / steps
+
+            # only the changed arc is segmented again
+            commands[size // 2] = Path.Command("G3", {"X": size + 2, "Y": 0, "I": 1, "J": 0})
+            begin = time.perf_counter()
+            obj.Path = Path.Path(commands)
+            rebuild = time.perf_counter() - begin
+
+            self.assertEqual(shownEdges(vobj), 1000)
+            print(
+                f"{size} commands: {build:.3f}s to build, {rebuild:.3f}s to rebuild "
+                f"after an arc changed, {1000 * toggle:.2f}ms per range change"
+            )
@@ -22,14 +22,17 @@
  *                                                                         *
  ***************************************************************************/
 
+#include <algorithm>
 #include <limits>
 #include <boost/algorithm/string/replace.hpp>
 
 #include <Inventor/SbVec3f.h>
+#include <Inventor/SoPickedPoint.h>
 #include <Inventor/details/SoLineDetail.h>
 #include <Inventor/nodes/SoBaseColor.h>
 #include <Inventor/nodes/SoCoordinate3.h>
 #include <Inventor/nodes/SoDrawStyle.h>
+#include <Inventor/nodes/SoGroup.h>
 #include <Inventor/nodes/SoMaterial.h>
 #include <Inventor/nodes/SoMaterialBinding.h>
 #include <Inventor/nodes/SoPointSet.h>
@@ -47,7 +50,6 @@
 #include <Gui/Inventor/SoFCBoundingBox.h>
 #include <Gui/Selection/SoFCUnifiedSelection.h>
 #include <Mod/CAM/App/FeaturePath.h>
-#include <Mod/CAM/App/PathSegmentWalker.h>
 
 #include "ViewProviderPath.h"
 
@@ -115,12 +117,14 @@ public:
             return;
         }
 
-        if (vp->pt0Index >= 0) {
+        if (vp->pt0Index >= 0 && vp->pickedChunk >= 0
+            && vp->pickedChunk < (int)vp->chunks.size()) {
             mat *= linkMat;
             mat.inverse();
             Base::Vector3d pt = mat * Base::Vector3d(msg.x, msg.y, msg.z);
-            if (vp->pcLineCoords->point.getNum() > 0) {
-                auto ptTo = vp->pcLineCoords->point.getValues(vp->pt0Index);
+            SoCoordinate3* coords = vp->chunks[vp->pickedChunk].pcCoords;
+            if (coords->point.getNum() > 0) {
+                auto ptTo = coords->point.getValues(vp->pt0Index);
                 SbVec3f ptFrom(pt.x, pt.y, pt.z);
                 if (ptTo && ptFrom != *ptTo) {
                     vp->pcArrowTransform->pointAt(ptFrom, *ptTo);
@@ -141,11 +145,12 @@ public:
 PROPERTY_SOURCE(PathGui::ViewProviderPath, Gui::ViewProviderGeometryObject)
 
 ViewProviderPath::ViewProviderPath()
-    : pt0Index(-1)
+    : pcPathRoot(nullptr)
+    , pcLineRoot(nullptr)
+    , pickedChunk(-1)
+    , pt0Index(-1)
     , blockPropertyChange(false)
     , edgeStart(-1)
-    , coordStart(-1)
-    , coordEnd(-1)
 {
     ParameterGrp::handle hGrp =
         App::GetApplication().GetParameterGroupByPath("User parameter:BaseApp/Preferences/Mod/CAM");
@@ -201,9 +206,6 @@ ViewProviderPath::ViewProviderPath()
                       App::Prop_None,
                       "Number of movement GCode to show, 0 means all");
 
-    pcLineCoords = new SoCoordinate3();
-    pcLineCoords->ref();
-
     pcMarkerSwitch = new SoSwitch();
     pcMarkerSwitch->ref();
     pcMarkerSwitch->whichChild = -1;
@@ -224,16 +226,12 @@ ViewProviderPath::ViewProviderPath()
     pcDrawStyle->style = SoDrawStyle::LINES;
     pcDrawStyle->lineWidth = LineWidth.getValue();
 
-    pcLines = new PartGui::SoBrepEdgeSet();
-    pcLines->ref();
-    pcLines->coordIndex.setNum(0);
-
-    pcLineColor = new SoMaterial;
-    pcLineColor->ref();
+    pcChunks = new SoGroup();
+    pcChunks->ref();
 
     pcMatBind = new SoMaterialBinding;
     pcMatBind->ref();
-    pcMatBind->value = SoMaterialBinding::OVERALL;
+    pcMatBind->value = SoMaterialBinding::PER_PART;
 
     pcMarkerColor = new SoBaseColor;
     pcMarkerColor->ref();
@@ -275,13 +273,11 @@ ViewProviderPath::ViewProviderPath()
 
 ViewProviderPath::~ViewProviderPath()
 {
-    pcLineCoords->unref();
     pcMarkerCoords->unref();
     pcMarkerSwitch->unref();
     pcDrawStyle->unref();
     pcMarkerStyle->unref();
-    pcLines->unref();
-    pcLineColor->unref();
+    pcChunks->unref();
     pcMatBind->unref();
     pcMarkerColor->unref();
     pcArrowSwitch->unref();
@@ -292,12 +288,10 @@ void ViewProviderPath::attach(App::DocumentObject* pcObj)
     inherited::attach(pcObj);
 
     // Draw trajectory lines
-    SoSeparator* linesep = new SoSeparator;
-    linesep->addChild(pcLineColor);
-    linesep->addChild(pcMatBind);
-    linesep->addChild(pcDrawStyle);
-    linesep->addChild(pcLineCoords);
-    linesep->addChild(pcLines);
+    pcLineRoot = new SoSeparator;
+    pcLineRoot->addChild(pcMatBind);
+    pcLineRoot->addChild(pcDrawStyle);
+    pcLineRoot->addChild(pcChunks);
 
     // Draw markers
     SoSeparator* markersep = new SoSeparator;
@@ -308,9 +302,9 @@ void ViewProviderPath::attach(App::DocumentObject* pcObj)
     markersep->addChild(marker);
     pcMarkerSwitch->addChild(markersep);
 
-    SoSeparator* pcPathRoot = new SoSeparator();
+    pcPathRoot = new SoSeparator();
     pcPathRoot->addChild(pcMarkerSwitch);
-    pcPathRoot->addChild(linesep);
+    pcPathRoot->addChild(pcLineRoot);
     pcPathRoot->addChild(pcArrowSwitch);
 
     addDisplayMaskMode(pcPathRoot, "Waypoints");
@@ -336,12 +330,28 @@ std::vector<std::string> ViewProviderPath::getDisplayModes() const
     return StrList;
 }
 
+bool ViewProviderPath::getElementPicked(const SoPickedPoint* pp, std::string& subname) const
+{
+    // the line detail refers to the edge set of a chunk, which is only known from the path
+    pickedChunk = -1;
+    if (pp) {
+        const SoPath* path = pp->getPath();
+        int idx = path->findNode(pcChunks);
+        if (idx >= 0 && idx + 1 < path->getLength()) {
+            pickedChunk = path->getIndex(idx + 1);
+        }
+    }
+    return inherited::getElementPicked(pp, subname);
+}
+
 std::string ViewProviderPath::getElement(const SoDetail* detail) const
 {
-    if (edgeStart >= 0 && detail && detail->getTypeId() == SoLineDetail::getClassTypeId()) {
+    if (pickedChunk >= 0 && pickedChunk < (int)chunks.size() && detail
+        && detail->getTypeId() == SoLineDetail::getClassTypeId()) {
+        const Chunk& chunk = chunks[pickedChunk];
         const SoLineDetail* line_detail = static_cast<const SoLineDetail*>(detail);
-        int index = line_detail->getLineIndex() + edgeStart;
-        if (index >= 0 && index < (int)edge2Command.size()) {
+        int index = line_detail->getLineIndex() + chunk.showStart;
+        if (index >= chunk.showStart && index < chunk.showEnd) {
             index = edge2Command[index];
             Path::Feature* pcPathObj = static_cast<Path::Feature*>(pcObject);
             const Toolpath& tp = pcPathObj->Path.getValue();
@@ -349,7 +359,7 @@ std::string ViewProviderPath::getElement(const SoDetail* detail) const
                 std::stringstream str;
                 str << index + 1 << " " << tp.getCommand(index).toGCode(6, false);
                 pt0Index = line_detail->getPoint0()->getCoordinateIndex();
-                if (pt0Index < 0 || pt0Index >= pcLineCoords->point.getNum()) {
+                if (pt0Index < 0 || pt0Index >= chunk.pcCoords->point.getNum()) {
                     pt0Index = -1;
                 }
                 return boost::replace_all_copy(str.str(), ".", ",");
@@ -367,14 +377,41 @@ SoDetail* ViewProviderPath::getDetail(const char* subelement) const
     SoDetail* detail = nullptr;
     if (index > 0 && index <= (int)command2Edge.size()) {
         index = command2Edge[index - 1];
-        if (index >= 0 && edgeStart >= 0 && edgeStart <= index) {
-            detail = new SoLineDetail();
-            static_cast<SoLineDetail*>(detail)->setLineIndex(index - edgeStart);
+        if (index >= 0) {
+            const Chunk& chunk = chunks[index / ChunkSize];
+            if (index >= chunk.showStart && index < chunk.showEnd) {
+                detail = new SoLineDetail();
+                static_cast<SoLineDetail*>(detail)->setLineIndex(index - chunk.showStart);
+            }
         }
     }
     return detail;
 }
 
+bool ViewProviderPath::getDetailPath(const char* subname,
+                                     SoFullPath* pPath,
+                                     bool append,
+                                     SoDetail*& det) const
+{
+    if (!inherited::getDetailPath(subname, pPath, append, det)) {
+        return false;
+    }
+
+    // the line detail is only valid for the edge set of its chunk
+    int index = subname ? std::atoi(subname) : 0;
+    if (append && det && index > 0 && index <= (int)command2Edge.size()
+        && command2Edge[index - 1] >= 0) {
+        const Chunk& chunk = chunks[command2Edge[index - 1] / ChunkSize];
+        pPath->append(pcPathRoot);
+        pPath->append(pcLineRoot);
+        pPath->append(pcChunks);
+        pPath->append(chunk.pcSwitch);
+        pPath->append(chunk.pcSwitch->getChild(0));
+        pPath->append(chunk.pcLines);
+    }
+    return true;
+}
+
 void ViewProviderPath::onChanged(const App::Property* prop)
 {
     if (blockPropertyChange) {
@@ -385,46 +422,28 @@ void ViewProviderPath::onChanged(const App::Property* prop)
         pcDrawStyle->lineWidth = LineWidth.getValue();
     }
     else if (prop == &NormalColor) {
-        if (!colorindex.empty() && coordStart >= 0 && coordStart < (int)colorindex.size()) {
-            const Base::Color& c = NormalColor.getValue();
-            ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath(
-                "User parameter:BaseApp/Preferences/Mod/CAM");
-            unsigned long rcol =
-                hGrp->GetUnsigned("DefaultRapidPathColor", 2852126975UL);  // dark red (170,0,0)
-            float rr, rg, rb;
-            rr = ((rcol >> 24) & 0xff) / 255.0;
-            rg = ((rcol >> 16) & 0xff) / 255.0;
-            rb = ((rcol >> 8) & 0xff) / 255.0;
-
-            unsigned long pcol =
-                hGrp->GetUnsigned("DefaultProbePathColor", 4293591295UL);  // yellow (255,255,5)
-            float pr, pg, pb;
-            pr = ((pcol >> 24) & 0xff) / 255.0;
-            pg = ((pcol >> 16) & 0xff) / 255.0;
-            pb = ((pcol >> 8) & 0xff) / 255.0;
-
-            pcMatBind->value = SoMaterialBinding::PER_PART;
-            // resizing and writing the color vector:
-
-            int count = coordEnd - coordStart;
-            if (count > (int)colorindex.size() - coordStart) {
-                count = colorindex.size() - coordStart;
-            }
-            pcLineColor->diffuseColor.setNum(count);
-            SbColor* colors = pcLineColor->diffuseColor.startEditing();
-            for (int i = 0; i < count; i++) {
-                switch (colorindex[i + coordStart]) {
-                    case 0:
-                        colors[i] = SbColor(rr, rg, rb);
-                        break;
-                    case 1:
-                        colors[i] = SbColor(c.r, c.g, c.b);
-                        break;
-                    default:
-                        colors[i] = SbColor(pr, pg, pb);
-                }
-            }
-            pcLineColor->diffuseColor.finishEditing();
+        const Base::Color& c = NormalColor.getValue();
+        ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath(
+            "User parameter:BaseApp/Preferences/Mod/CAM");
+        unsigned long rcol =
+            hGrp->GetUnsigned("DefaultRapidPathColor", 2852126975UL);  // dark red (170,0,0)
+        float rr, rg, rb;
+        rr = ((rcol >> 24) & 0xff) / 255.0;
+        rg = ((rcol >> 16) & 0xff) / 255.0;
+        rb = ((rcol >> 8) & 0xff) / 255.0;
+
+        unsigned long pcol =
+            hGrp->GetUnsigned("DefaultProbePathColor", 4293591295UL);  // yellow (255,255,5)
+        float pr, pg, pb;
+        pr = ((pcol >> 24) & 0xff) / 255.0;
+        pg = ((pcol >> 16) & 0xff) / 255.0;
+        pb = ((pcol >> 8) & 0xff) / 255.0;
+
+        lineColors[0] = SbColor(rr, rg, rb);
+        lineColors[1] = SbColor(c.r, c.g, c.b);
+        lineColors[2] = SbColor(pr, pg, pb);
+        for (auto& chunk : chunks) {
+            updateChunkColors(chunk);
         }
     }
     else if (prop == &MarkerColor) {
@@ -445,9 +464,9 @@ void ViewProviderPath::onChanged(const App::Property* prop)
         }
     }
     else if (prop == &StartPosition) {
-        if (pcLineCoords->point.getNum()) {
+        if (!chunks.empty()) {
             const Base::Vector3d& pt = StartPosition.getValue();
-            pcLineCoords->point.set1Value(0, pt.x, pt.y, pt.z);
+            chunks.front().pcCoords->point.set1Value(0, pt.x, pt.y, pt.z);
             pcMarkerCoords->point.set1Value(0, pt.x, pt.y, pt.z);
         }
     }
@@ -462,7 +481,7 @@ void ViewProviderPath::onChanged(const App::Property* prop)
 void ViewProviderPath::showBoundingBox(bool show)
 {
     if (show) {
-        if (!pcLineCoords->point.getNum()) {
+        if (chunks.empty()) {
             return;
         }
     }
@@ -518,11 +537,11 @@ void ViewProviderPath::hideSelection()
 {
     // Clear selection
     SoSelectionElementAction saction(Gui::SoSelectionElementAction::None);
-    saction.apply(pcLines);
+    saction.apply(pcChunks);
 
     // Clear highlighting
     SoHighlightElementAction haction;
-    haction.apply(pcLines);
+    haction.apply(pcChunks);
 
     // Hide arrow
     pcArrowSwitch->whichChild = -1;
@@ -532,16 +551,14 @@ class VisualPathSegmentVisitor: public PathSegmentVisitor
 {
 public:
     VisualPathSegmentVisitor(const Toolpath& tp,
-                             SoCoordinate3* pcLineCoords_,
                              SoCoordinate3* pcMarkerCoords_,
                              std::vector<int>& command2Edge_,
-                             std::deque<int>& edge2Command_,
-                             std::deque<int>& edgeIndices_,
+                             std::vector<int>& edge2Command_,
+                             std::vector<int>& edgeIndices_,
                              std::vector<int>& colorindex_,
-                             std::deque<Base::Vector3d>& points_,
-                             std::deque<Base::Vector3d>& markers_)
-        : pcLineCoords(pcLineCoords_)
-        , pcMarkerCoords(pcMarkerCoords_)
+                             std::vector<Base::Vector3d>& points_,
+                             std::vector<Base::Vector3d>& markers_)
+        : pcMarkerCoords(pcMarkerCoords_)
         , command2Edge(command2Edge_)
         , edge2Command(edge2Command_)
         , edgeIndices(edgeIndices_)
@@ -549,7 +566,6 @@ public:
         , points(points_)
         , markers(markers_)
     {
-        pcLineCoords->point.deleteValues(0);
         pcMarkerCoords->point.deleteValues(0);
 
         command2Edge.clear();
@@ -653,16 +669,15 @@ public:
     }
 
 private:
-    SoCoordinate3* pcLineCoords;
     SoCoordinate3* pcMarkerCoords;
 
     std::vector<int>& command2Edge;
-    std::deque<int>& edge2Command;
-    std::deque<int>& edgeIndices;
+    std::vector<int>& edge2Command;
+    std::vector<int>& edgeIndices;
 
     std::vector<int>& colorindex;
-    std::deque<Base::Vector3d>& points;
-    std::deque<Base::Vector3d>& markers;
+    std::vector<Base::Vector3d>& points;
+    std::vector<Base::Vector3d>& markers;
 
     virtual void
     gx(int id, const Base::Vector3d* next, const std::deque<Base::Vector3d>& pts, int color)
@@ -696,17 +711,14 @@ void ViewProviderPath::updateVisual(bool rebuild)
 
     updateShowConstraints();
 
-    pcLines->coordIndex.deleteValues(0);
-
     if (rebuild) {
         Path::Feature* pcPathObj = static_cast<Path::Feature*>(pcObject);
         const Toolpath& tp = pcPathObj->Path.getValue();
 
-        std::deque<Base::Vector3d> points;
-        std::deque<Base::Vector3d> markers;
+        std::vector<Base::Vector3d> points;
+        std::vector<Base::Vector3d> markers;
 
         VisualPathSegmentVisitor collect(tp,
-                                         pcLineCoords,
                                          pcMarkerCoords,
                                          command2Edge,
                                          edge2Command,
@@ -716,28 +728,22 @@ void ViewProviderPath::updateVisual(bool rebuild)
                                          markers);
 
         PathSegmentWalker segments(tp);
-        segments.walk(collect, StartPosition.getValue());
+        segments.walk(collect, StartPosition.getValue(), &segmentCache);
 
+        buildChunks(points);
 
         if (!edgeIndices.empty()) {
-            pcLineCoords->point.setNum(points.size());
-            SbVec3f* verts = pcLineCoords->point.startEditing();
-            int i = 0;
-            for (const auto& pt : points) {
-                verts[i++].setValue(pt.x, pt.y, pt.z);
-            }
-            pcLineCoords->point.finishEditing();
-
             pcMarkerCoords->point.setNum(markers.size());
-            for (unsigned int i = 0; i < markers.size(); i++) {
-                pcMarkerCoords->point.set1Value(i, markers[i].x, markers[i].y, markers[i].z);
+            SbVec3f* marks = pcMarkerCoords->point.startEditing();
+            for (std::size_t i = 0; i < markers.size(); i++) {
+                marks[i].setValue(markers[i].x, markers[i].y, markers[i].z);
             }
+            pcMarkerCoords->point.finishEditing();
 
             recomputeBoundingBox();
         }
     }
 
-    // count = index + separators
     edgeStart = -1;
     int i;
     for (i = StartIndex.getValue(); i < (int)command2Edge.size(); ++i) {
@@ -746,85 +752,157 @@ void ViewProviderPath::updateVisual(bool rebuild)
         }
     }
 
-    if (edgeStart < 0) {
-        return;
+    int edgeEnd = edgeStart;
+    if (edgeStart >= 0) {
+        if (i != StartIndex.getValue() && StartIndex.getValue() != 0) {
+            blockPropertyChange = true;
+            StartIndex.setValue(i);
+            blockPropertyChange = false;
+            StartIndex.purgeTouched();
+        }
+
+        edgeEnd = edgeStart + ShowCount.getValue();
+        if (edgeEnd == edgeStart || edgeEnd > (int)edgeIndices.size()) {
+            edgeEnd = edgeIndices.size();
+        }
     }
 
-    if (i != StartIndex.getValue() && StartIndex.getValue() != 0) {
-        blockPropertyChange = true;
-        StartIndex.setValue(i);
-        blockPropertyChange = false;
-        StartIndex.purgeTouched();
+    // only the chunks at both ends of the range have to be trimmed
+    for (int c = 0; c < (int)chunks.size(); c++) {
+        int start = std::clamp(edgeStart, chunkEdgeStart(c), chunkEdgeEnd(c));
+        int end = std::clamp(edgeEnd, start, chunkEdgeEnd(c));
+        showChunk(chunks[c], start, end);
+    }
+}
+
+int ViewProviderPath::chunkEdgeStart(int chunk) const
+{
+    return chunk * ChunkSize;
+}
+
+int ViewProviderPath::chunkEdgeEnd(int chunk) const
+{
+    return std::min((chunk + 1) * ChunkSize, (int)edgeIndices.size());
+}
+
+int ViewProviderPath::edgeCoordStart(int edge) const
+{
+    return edge == 0 ? 0 : edgeIndices[edge - 1] - 1;
+}
+
+void ViewProviderPath::buildChunks(const std::vector<Base::Vector3d>& points)
+{
+    pcChunks->removeAllChildren();
+    chunks.clear();
+
+    int numChunks = ((int)edgeIndices.size() + ChunkSize - 1) / ChunkSize;
+    chunks.resize(numChunks);
+    for (int c = 0; c < numChunks; c++) {
+        Chunk& chunk = chunks[c];
+        chunk.coordStart = edgeCoordStart(chunkEdgeStart(c));
+        chunk.showStart = 0;
+        chunk.showEnd = 0;
+
+        int coordEnd = edgeIndices[chunkEdgeEnd(c) - 1];
+        chunk.pcCoords = new SoCoordinate3();
+        chunk.pcCoords->point.setNum(coordEnd - chunk.coordStart);
+        SbVec3f* verts = chunk.pcCoords->point.startEditing();
+        for (int i = chunk.coordStart; i < coordEnd; i++) {
+            const Base::Vector3d& pt = points[i];
+            verts[i - chunk.coordStart].setValue(pt.x, pt.y, pt.z);
+            // the start position doesn't count for the bounding box
+            if (i > 0) {
+                chunk.bbox.Add(pt);
+            }
+        }
+        chunk.pcCoords->point.finishEditing();
+
+        chunk.pcColor = new SoMaterial();
+        chunk.pcLines = new PartGui::SoBrepEdgeSet();
+        chunk.pcLines->coordIndex.setNum(0);
+
+        // chunks outside of the view are skipped by their bounding box
+        auto root = new SoSeparator();
+        root->renderCulling = SoSeparator::ON;
+        root->addChild(chunk.pcColor);
+        root->addChild(chunk.pcCoords);
+        root->addChild(chunk.pcLines);
+
+        chunk.pcSwitch = new SoSwitch();
+        chunk.pcSwitch->whichChild = -1;
+        chunk.pcSwitch->addChild(root);
+        pcChunks->addChild(chunk.pcSwitch);
     }
+}
 
-    int edgeEnd = edgeStart + ShowCount.getValue();
-    if (edgeEnd == edgeStart || edgeEnd > (int)edgeIndices.size()) {
-        edgeEnd = edgeIndices.size();
+void ViewProviderPath::showChunk(Chunk& chunk, int start, int end)
+{
+    if (start == chunk.showStart && end == chunk.showEnd) {
+        return;
     }
 
-    // coord index start
-    coordStart = edgeStart == 0 ? 0 : (edgeIndices[edgeStart - 1] - 1);
-    coordEnd = edgeIndices[edgeEnd - 1];
+    chunk.showStart = start;
+    chunk.showEnd = end;
+    if (start == end) {
+        chunk.pcSwitch->whichChild = -1;
+        return;
+    }
 
     // count = coord indices + index separators
-    int count = coordEnd - coordStart + 2 * (edgeEnd - edgeStart - 1) + 1;
-
-    pcLines->coordIndex.setNum(count);
-    int32_t* idx = pcLines->coordIndex.startEditing();
-    i = 0;
-    int start = coordStart;
-    for (int e = edgeStart; e != edgeEnd; ++e) {
-        for (int end = edgeIndices[e]; start < end; ++start) {
-            idx[i++] = start;
+    int coordStart = edgeCoordStart(start);
+    int coordEnd = edgeIndices[end - 1];
+    int count = coordEnd - coordStart + 2 * (end - start - 1) + 1;
+
+    chunk.pcLines->coordIndex.setNum(count);
+    int32_t* idx = chunk.pcLines->coordIndex.startEditing();
+    int i = 0;
+    int pos = coordStart - chunk.coordStart;
+    for (int e = start; e != end; ++e) {
+        for (int last = edgeIndices[e] - chunk.coordStart; pos < last; ++pos) {
+            idx[i++] = pos;
         }
         idx[i++] = -1;
-        --start;
+        --pos;
     }
-    pcLines->coordIndex.finishEditing();
+    chunk.pcLines->coordIndex.finishEditing();
     assert(i == count);
 
-    NormalColor.touch();
+    updateChunkColors(chunk);
+    chunk.pcSwitch->whichChild = 0;
+}
+
+void ViewProviderPath::updateChunkColors(Chunk& chunk)
+{
+    if (chunk.showStart == chunk.showEnd) {
+        return;
+    }
+
+    int coordStart = edgeCoordStart(chunk.showStart);
+    int coordEnd = std::min(edgeIndices[chunk.showEnd - 1], (int)colorindex.size());
+    int count = std::max(0, coordEnd - coordStart);
+    chunk.pcColor->diffuseColor.setNum(count);
+    SbColor* colors = chunk.pcColor->diffuseColor.startEditing();
+    for (int i = 0; i < count; i++) {
+        colors[i] = lineColors[std::clamp(colorindex[i + coordStart], 0, 2)];
+    }
+    chunk.pcColor->diffuseColor.finishEditing();
 }
 
 void ViewProviderPath::recomputeBoundingBox()
 {
-    // update the boundbox
-    double MinX, MinY, MinZ, MaxX, MaxY, MaxZ;
-    MinX = 999999999.0;
-    MinY = 999999999.0;
-    MinZ = 999999999.0;
-    MaxX = -999999999.0;
-    MaxY = -999999999.0;
-    MaxZ = -999999999.0;
-    Path::Feature* pcPathObj = static_cast<Path::Feature*>(pcObject);
-    Base::Placement pl = *(&pcPathObj->Placement.getValue());
-    Base::Vector3d pt;
-    for (int i = 1; i < pcLineCoords->point.getNum(); i++) {
-        pt.x = pcLineCoords->point[i].getValue()[0];
-        pt.y = pcLineCoords->point[i].getValue()[1];
-        pt.z = pcLineCoords->point[i].getValue()[2];
-        pl.multVec(pt, pt);
-        if (pt.x < MinX) {
-            MinX = pt.x;
-        }
-        if (pt.y < MinY) {
-            MinY = pt.y;
-        }
-        if (pt.z < MinZ) {
-            MinZ = pt.z;
-        }
-        if (pt.x > MaxX) {
-            MaxX = pt.x;
-        }
-        if (pt.y > MaxY) {
-            MaxY = pt.y;
-        }
-        if (pt.z > MaxZ) {
-            MaxZ = pt.z;
-        }
+    // update the boundbox from the boxes of the chunks
+    Base::BoundBox3d bbox;
+    for (const auto& chunk : chunks) {
+        bbox.Add(chunk.bbox);
     }
-    pcBoundingBox->minBounds.setValue(MinX, MinY, MinZ);
-    pcBoundingBox->maxBounds.setValue(MaxX, MaxY, MaxZ);
+    if (!bbox.IsValid()) {
+        return;
+    }
+
+    Path::Feature* pcPathObj = static_cast<Path::Feature*>(pcObject);
+    bbox = bbox.Transformed(pcPathObj->Placement.getValue().toMatrix());
+    pcBoundingBox->minBounds.setValue(bbox.MinX, bbox.MinY, bbox.MinZ);
+    pcBoundingBox->maxBounds.setValue(bbox.MaxX, bbox.MaxY, bbox.MaxZ);
 }
 
 QIcon ViewProviderPath::getIcon() const
@@ -25,11 +25,15 @@
 #ifndef PATH_ViewProviderPath_H
 #define PATH_ViewProviderPath_H
 
+#include <Inventor/SbColor.h>
+
 #include <App/PropertyGeo.h>
+#include <Base/BoundBox.h>
 #include <Gui/Selection/Selection.h>
 #include <Gui/ViewProviderGeometryObject.h>
 #include <Gui/ViewProviderFeaturePython.h>
 #include <Mod/Part/Gui/SoBrepEdgeSet.h>
+#include <Mod/CAM/App/PathSegmentWalker.h>
 #include <Mod/CAM/PathGlobal.h>
 
 
@@ -40,6 +44,8 @@ class SoBaseColor;
 class SoMaterialBinding;
 class SoTransform;
 class SoSwitch;
+class SoGroup;
+class SoSeparator;
 
 namespace PathGui
 {
@@ -78,8 +84,13 @@ public:
     QIcon getIcon() const override;
 
     bool useNewSelectionModel() const override;
+    bool getElementPicked(const SoPickedPoint* pp, std::string& subname) const override;
     std::string getElement(const SoDetail*) const override;
     SoDetail* getDetail(const char* subelement) const override;
+    bool getDetailPath(const char* subname,
+                       SoFullPath* pPath,
+                       bool append,
+                       SoDetail*& det) const override;
 
     void updateShowConstraints();
     void updateVisual(bool rebuild = false);
@@ -93,28 +104,56 @@ protected:
     void onChanged(const App::Property* prop) override;
     unsigned long getBoundColor() const override;
 
-    SoCoordinate3* pcLineCoords;
+    /* The edges of the path are split into chunks of ChunkSize edges, each with its
+       own coordinates, colors and edge set. Changing the displayed range of commands
+       only switches chunks on or off and trims the chunks at both ends of the range,
+       and Coin only has to update the caches of these chunks. */
+    struct Chunk
+    {
+        SoSwitch* pcSwitch;
+        SoCoordinate3* pcCoords;
+        SoMaterial* pcColor;
+        PartGui::SoBrepEdgeSet* pcLines;
+        int coordStart;  // index of the first coordinate in the whole path
+        int showStart;   // range of displayed edges, empty if the chunk is hidden
+        int showEnd;
+        Base::BoundBox3d bbox;
+    };
+    static const int ChunkSize = 2048;
+
+    void buildChunks(const std::vector<Base::Vector3d>& points);
+    void showChunk(Chunk& chunk, int start, int end);
+    void updateChunkColors(Chunk& chunk);
+    // edge range of the chunk with the given index
+    int chunkEdgeStart(int chunk) const;
+    int chunkEdgeEnd(int chunk) const;
+    // the first coordinate of an edge, which is the last one of the previous edge
+    int edgeCoordStart(int edge) const;
+
     SoCoordinate3* pcMarkerCoords;
     SoDrawStyle* pcDrawStyle;
     SoDrawStyle* pcMarkerStyle;
-    PartGui::SoBrepEdgeSet* pcLines;
-    SoMaterial* pcLineColor;
+    SoGroup* pcChunks;
+    SoSeparator* pcPathRoot;
+    SoSeparator* pcLineRoot;
     SoBaseColor* pcMarkerColor;
     SoMaterialBinding* pcMatBind;
     std::vector<int> colorindex;
     SoSwitch* pcMarkerSwitch;
     SoSwitch* pcArrowSwitch;
     SoTransform* pcArrowTransform;
+    SbColor lineColors[3];  // rapid, feed and probe moves
 
+    std::vector<Chunk> chunks;
     std::vector<int> command2Edge;
-    std::deque<int> edge2Command;
-    std::deque<int> edgeIndices;
+    std::vector<int> edge2Command;
+    std::vector<int> edgeIndices;
+    Path::PathSegmentCache segmentCache;
 
+    mutable int pickedChunk;
     mutable int pt0Index;
     bool blockPropertyChange;
     int edgeStart;
-    int coordStart;
-    int coordEnd;
 };
 
 using ViewProviderPathPython = Gui::ViewProviderFeaturePythonT<ViewProviderPath>;
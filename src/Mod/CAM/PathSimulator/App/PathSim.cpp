@@ -22,6 +22,11 @@
  *                                                                         *
  ***************************************************************************/
 
+#include <chrono>
+#include <cmath>
+#include <numbers>
+
+#include <Base/Exception.h>
 
 #include "PathSim.h"
 
@@ -80,3 +85,150 @@ Base::Placement* PathSim::ApplyCommand(Base::Placement* pos, Command* cmd)
     plc->setPosition(vec);
     return plc;
 }
+
+Point3D PathSim::CollectMoves(const Base::Placement& pos,
+                              const Toolpath& path,
+                              std::vector<cSweep>& sweeps,
+                              std::vector<Move>& moves)
+{
+    Base::Placement plc(pos);
+    Point3D curPos(plc);
+    double feed = 0;
+    const std::vector<Command*>& cmds = path.getCommands();
+    sweeps.reserve(cmds.size());
+    moves.reserve(cmds.size());
+    for (size_t i = 0; i < cmds.size(); i++) {
+        Command* cmd = cmds[i];
+        Point3D toPos(curPos);
+        toPos.UpdateCmd(*cmd);
+        feed = cmd->getParam("F", feed);
+
+        Move move {static_cast<int>(i), false, 0, feed};
+        const std::string& name = cmd->Name;
+        if (name == "G0" || name == "G00" || name == "G1" || name == "G01") {
+            sweeps.push_back(m_stock->LinearSweep(curPos, toPos, *m_tool));
+            move.rapid = name == "G0" || name == "G00";
+            move.length = length(toPos - curPos);
+            moves.push_back(move);
+        }
+        else if (name == "G2" || name == "G02" || name == "G3" || name == "G03") {
+            Vector3d vcent = cmd->getCenter();
+            Point3D cent(vcent);
+            bool isCCW = name == "G3" || name == "G03";
+            sweeps.push_back(m_stock->CircularSweep(curPos, toPos, cent, *m_tool, isCCW));
+
+            // the length of the helix, the center is relative to the start point
+            double sang = atan2(-cent.y, -cent.x);
+            double eang = atan2(toPos.y - curPos.y - cent.y, toPos.x - curPos.x - cent.x);
+            double ang = eang - sang;
+            if (!isCCW && ang > 0) {
+                ang -= 2 * std::numbers::pi;
+            }
+            if (isCCW && ang < 0) {
+                ang += 2 * std::numbers::pi;
+            }
+            double arc = fabs(ang) * sqrt(cent.x * cent.x + cent.y * cent.y);
+            double dz = toPos.z - curPos.z;
+            move.length = sqrt(arc * arc + dz * dz);
+            moves.push_back(move);
+        }
+        curPos = toPos;
+    }
+    return curPos;
+}
+
+Base::Placement PathSim::ApplyPath(const Base::Placement& pos, const Toolpath& path)
+{
+    auto start = std::chrono::steady_clock::now();
+    Point3D curPos;
+    if (m_stock && m_tool) {
+        double volume = m_stock->GetVolume();
+        std::vector<cSweep> sweeps;
+        std::vector<Move> moves;
+        curPos = CollectMoves(pos, path, sweeps, moves);
+        m_stock->ApplySweeps(sweeps);
+        m_removedVolume = volume - m_stock->GetVolume();
+    }
+    else {
+        Base::Placement plc(pos);
+        curPos = Point3D(plc);
+        for (Command* cmd : path.getCommands()) {
+            curPos.UpdateCmd(*cmd);
+        }
+        m_removedVolume = 0;
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    m_simTime = elapsed.count();
+
+    Base::Placement result;
+    result.setPosition(Vector3d(curPos.x, curPos.y, curPos.z));
+    return result;
+}
+
+void PathSim::SetModel(const Part::TopoShape& model, float tolerance)
+{
+    if (!m_stock) {
+        throw Base::RuntimeError("Path Simulation: No stock to set the model on");
+    }
+    // the triangulation only has to be as fine as the stock
+    std::vector<Base::Vector3d> points;
+    std::vector<Data::ComplexGeoData::Facet> facets;
+    model.getFaces(points, facets, m_stock->GetResolution() / 2);
+
+    std::vector<Triangle3D> triangles;
+    triangles.reserve(facets.size());
+    for (const auto& it : facets) {
+        Point3D p1(points[it.I1]);
+        Point3D p2(points[it.I2]);
+        Point3D p3(points[it.I3]);
+        triangles.emplace_back(p1, p2, p3);
+    }
+    m_stock->SetModel(triangles);
+    m_tolerance = tolerance;
+}
+
+PathVerification PathSim::Verify(const Base::Placement& pos, const Toolpath& path)
+{
+    if (!m_stock || !m_tool) {
+        throw Base::RuntimeError("Path Simulation: No stock or tool to verify the path with");
+    }
+    auto start = std::chrono::steady_clock::now();
+    PathVerification result;
+    std::vector<cSweep> sweeps;
+    std::vector<Move> moves;
+    Point3D endPos = CollectMoves(pos, path, sweeps, moves);
+    result.endPos.setPosition(Vector3d(endPos.x, endPos.y, endPos.z));
+
+    std::vector<cSweepReport> reports = m_stock->VerifySweeps(sweeps);
+    for (size_t i = 0; i < moves.size(); i++) {
+        const Move& move = moves[i];
+        const cSweepReport& report = reports[i];
+        result.removedVolume += report.removed;
+        if (report.gouge > m_tolerance) {
+            const Point3D& gp = report.gougePos;
+            result.gouges.push_back({move.command, Vector3d(gp.x, gp.y, gp.z), report.gouge});
+        }
+
+        bool cuts = report.maxCut > m_tolerance;
+        if (move.rapid) {
+            if (cuts) {
+                result.rapidCollisions.push_back({move.command, report.removed});
+            }
+        }
+        else if (move.feed > 0) {
+            double time = move.length / move.feed;
+            if (cuts) {
+                result.cuttingTime += time;
+            }
+            else {
+                result.airCuttingTime += time;
+            }
+        }
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    result.simTime = elapsed.count();
+    m_simTime = result.simTime;
+    m_removedVolume = result.removedVolume;
+    return result;
+}
@@ -29,6 +29,7 @@
 #include <TopoDS_Shape.hxx>
 
 #include <Mod/CAM/App/Command.h>
+#include <Mod/CAM/App/Path.h>
 #include <Mod/Part/App/TopoShape.h>
 #include <Mod/CAM/PathGlobal.h>
 
@@ -40,6 +41,30 @@ using namespace Path;
 namespace PathSimulator
 {
 
+/** The findings of PathSim::Verify() */
+struct PathVerification
+{
+    struct Gouge
+    {
+        int command;              // index of the command in the toolpath
+        Base::Vector3d position;  // tool tip position of the deepest cut
+        double depth;             // depth of the cut below the model surface
+    };
+    struct Collision
+    {
+        int command;
+        double volume;  // stock volume the rapid move runs through
+    };
+
+    Base::Placement endPos;
+    std::vector<Gouge> gouges;
+    std::vector<Collision> rapidCollisions;
+    double cuttingTime {0};     // time of the feed moves that remove material in seconds
+    double airCuttingTime {0};  // time of the feed moves that remove nothing in seconds
+    double removedVolume {0};
+    double simTime {0};  // duration of the verification in seconds
+};
+
 /** The representation of a CNC Toolpath Simulator */
 
 class PathSimulatorExport PathSim: public Base::BaseClass
@@ -53,10 +78,37 @@ public:
     void BeginSimulation(Part::TopoShape* stock, float resolution);
     void SetToolShape(const TopoDS_Shape& toolShape, float resolution);
     Base::Placement* ApplyCommand(Base::Placement* pos, Command* cmd);
+    /* Applies all commands of a toolpath starting from pos and returns the end
+       position. The moves are collected first and removed from the stock at once. */
+    Base::Placement ApplyPath(const Base::Placement& pos, const Toolpath& path);
+    /* Sets the part the stock is machined into. Cuts deeper than tolerance into its
+       upper surface are reported as gouges by Verify(). */
+    void SetModel(const Part::TopoShape& model, float tolerance);
+    /* Applies all commands of a toolpath like ApplyPath() and checks every move for
+       gouges into the model, rapid moves through the stock and feed moves that don't
+       remove any material. No display is needed for it. */
+    PathVerification Verify(const Base::Placement& pos, const Toolpath& path);
+
+private:
+    struct Move
+    {
+        int command;
+        bool rapid;
+        double length;
+        double feed;  // feed rate in mm/s, 0 if unknown
+    };
+    // Converts the commands to sweeps, returns the end position
+    Point3D CollectMoves(const Base::Placement& pos,
+                         const Toolpath& path,
+                         std::vector<cSweep>& sweeps,
+                         std::vector<Move>& moves);
 
 public:
     std::unique_ptr<cStock> m_stock;
     std::unique_ptr<cSimTool> m_tool;
+    double m_simTime {0};        // duration of the last ApplyPath() in seconds
+    double m_removedVolume {0};  // volume removed by the last ApplyPath()
+    float m_tolerance {0.01f};   // smallest cut depth that is reported by Verify()
 };
 
 }  // namespace PathSimulator
@@ -47,5 +47,34 @@ class PathSim(BaseClass):
 
                   Apply a single path command on the stock starting from placement."""
         ...
+
+    def ApplyPath(self, **kwargs) -> Any:
+        """
+        ApplyPath(position, path):
+
+                  Apply all commands of a path on the stock starting from placement.
+                  Return a tuple of the end placement, the simulation time in seconds
+                  and the removed volume."""
+        ...
+
+    def SetModel(self, **kwargs) -> Any:
+        """
+        SetModel(shape, tolerance=0.01):
+
+                  Set the part that is machined out of the stock. Cuts deeper than
+                  tolerance into its upper surface are reported as gouges by Verify."""
+        ...
+
+    def Verify(self, **kwargs) -> Any:
+        """
+        Verify(position, path):
+
+                  Apply all commands of a path on the stock starting from placement and
+                  check them without a display. Return a dict with the end Placement,
+                  the Gouges into the model as (command index, position, depth), the
+                  RapidCollisions with the stock as (command index, volume), the
+                  CuttingTime and AirCuttingTime in seconds, the RemovedVolume, the
+                  SimulationTime in seconds and the LinesPerSecond throughput."""
+        ...
     Tool: Final[Any]
     """Return current simulation tool."""
@@ -24,10 +24,12 @@
 
 
 #include <Base/PlacementPy.h>
+#include <Base/VectorPy.h>
 #include <Base/PyWrapParseTupleAndKeywords.h>
 
 #include <Mod/Mesh/App/MeshPy.h>
 #include <Mod/CAM/App/CommandPy.h>
+#include <Mod/CAM/App/PathPy.h>
 #include <Mod/Part/App/TopoShapePy.h>
 
 #include "PathSim.h"
@@ -141,6 +143,114 @@ PyObject* PathSimPy::ApplyCommand(PyObject* args, PyObject* kwds)
     return newposPy;
 }
 
+PyObject* PathSimPy::ApplyPath(PyObject* args, PyObject* kwds)
+{
+    static const std::array<const char*, 3> kwlist {"position", "path", nullptr};
+    PyObject* pObjPlace;
+    PyObject* pObjPath;
+    if (!Base::Wrapped_ParseTupleAndKeywords(args,
+                                             kwds,
+                                             "O!O!",
+                                             kwlist,
+                                             &(Base::PlacementPy::Type),
+                                             &pObjPlace,
+                                             &(Path::PathPy::Type),
+                                             &pObjPath)) {
+        return nullptr;
+    }
+    PathSim* sim = getPathSimPtr();
+    if (!sim->m_stock) {
+        PyErr_SetString(PyExc_RuntimeError, "Simulation has no stock object");
+        return nullptr;
+    }
+    Base::Placement* pos = static_cast<Base::PlacementPy*>(pObjPlace)->getPlacementPtr();
+    Path::Toolpath* path = static_cast<Path::PathPy*>(pObjPath)->getToolpathPtr();
+    Base::Placement newpos = sim->ApplyPath(*pos, *path);
+    Py::Tuple tuple(3);
+    tuple.setItem(0, Py::asObject(new Base::PlacementPy(new Base::Placement(newpos))));
+    tuple.setItem(1, Py::Float(sim->m_simTime));
+    tuple.setItem(2, Py::Float(sim->m_removedVolume));
+    return Py::new_reference_to(tuple);
+}
+
+PyObject* PathSimPy::SetModel(PyObject* args, PyObject* kwds)
+{
+    static const std::array<const char*, 3> kwlist {"shape", "tolerance", nullptr};
+    PyObject* pObjModel;
+    float tolerance = 0.01f;
+    if (!Base::Wrapped_ParseTupleAndKeywords(args,
+                                             kwds,
+                                             "O!|f",
+                                             kwlist,
+                                             &(Part::TopoShapePy::Type),
+                                             &pObjModel,
+                                             &tolerance)) {
+        return nullptr;
+    }
+    PathSim* sim = getPathSimPtr();
+    if (!sim->m_stock) {
+        PyErr_SetString(PyExc_RuntimeError, "Simulation has no stock object");
+        return nullptr;
+    }
+    const Part::TopoShape* model = static_cast<Part::TopoShapePy*>(pObjModel)->getTopoShapePtr();
+    sim->SetModel(*model, tolerance);
+    Py_Return;
+}
+
+PyObject* PathSimPy::Verify(PyObject* args, PyObject* kwds)
+{
+    static const std::array<const char*, 3> kwlist {"position", "path", nullptr};
+    PyObject* pObjPlace;
+    PyObject* pObjPath;
+    if (!Base::Wrapped_ParseTupleAndKeywords(args,
+                                             kwds,
+                                             "O!O!",
+                                             kwlist,
+                                             &(Base::PlacementPy::Type),
+                                             &pObjPlace,
+                                             &(Path::PathPy::Type),
+                                             &pObjPath)) {
+        return nullptr;
+    }
+    PathSim* sim = getPathSimPtr();
+    if (!sim->m_stock || !sim->m_tool) {
+        PyErr_SetString(PyExc_RuntimeError, "Simulation has no stock or tool object");
+        return nullptr;
+    }
+    Base::Placement* pos = static_cast<Base::PlacementPy*>(pObjPlace)->getPlacementPtr();
+    Path::Toolpath* path = static_cast<Path::PathPy*>(pObjPath)->getToolpathPtr();
+    PathVerification result = sim->Verify(*pos, *path);
+
+    Py::List gouges;
+    for (const auto& it : result.gouges) {
+        Py::Tuple gouge(3);
+        gouge.setItem(0, Py::Long(it.command));
+        gouge.setItem(1, Py::asObject(new Base::VectorPy(new Base::Vector3d(it.position))));
+        gouge.setItem(2, Py::Float(it.depth));
+        gouges.append(gouge);
+    }
+    Py::List collisions;
+    for (const auto& it : result.rapidCollisions) {
+        Py::Tuple collision(2);
+        collision.setItem(0, Py::Long(it.command));
+        collision.setItem(1, Py::Float(it.volume));
+        collisions.append(collision);
+    }
+
+    double lines = result.simTime > 0 ? path->getSize() / result.simTime : 0.0;
+    Py::Dict dict;
+    dict.setItem("Placement",
+                 Py::asObject(new Base::PlacementPy(new Base::Placement(result.endPos))));
+    dict.setItem("Gouges", gouges);
+    dict.setItem("RapidCollisions", collisions);
+    dict.setItem("CuttingTime", Py::Float(result.cuttingTime));
+    dict.setItem("AirCuttingTime", Py::Float(result.airCuttingTime));
+    dict.setItem("RemovedVolume", Py::Float(result.removedVolume));
+    dict.setItem("SimulationTime", Py::Float(result.simTime));
+    dict.setItem("LinesPerSecond", Py::Float(lines));
+    return Py::new_reference_to(dict);
+}
+
 Py::Object PathSimPy::getTool() const
 {
     // return Py::Object();
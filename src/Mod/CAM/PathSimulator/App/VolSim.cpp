@@ -23,7 +23,9 @@
  ***************************************************************************/
 
 #include <algorithm>
-
+#include <cmath>
+#include <limits>
+#include <QtConcurrentMap>
 
 #include <BRepBndLib.hxx>
 #include <BRepCheck_Analyzer.hxx>
@@ -48,13 +50,18 @@ cStock::cStock(float px, float py, float pz, float lx, float ly, float lz, float
 {
     m_x = (int)(m_lx / res) + 1;
     m_y = (int)(m_ly / res) + 1;
-    m_stock.Init(m_x, m_y);
-    m_attr.Init(m_x, m_y);
     m_plane = pz + lz;
-    for (int y = 0; y < m_y; y++) {
-        for (int x = 0; x < m_x; x++) {
-            m_stock[x][y] = m_plane;
-            m_attr[x][y] = 0;
+    m_stock.Init(m_x, m_y, m_plane);
+    m_attr.Init(m_x, m_y, 0);
+    for (int ty = 0; ty < m_stock.TilesY(); ty++) {
+        for (int tx = 0; tx < m_stock.TilesX(); tx++) {
+            cTile tile;
+            tile.x0 = tx * SIM_TILE_SIZE;
+            tile.y0 = ty * SIM_TILE_SIZE;
+            tile.x1 = std::min(m_x, tile.x0 + SIM_TILE_SIZE);
+            tile.y1 = std::min(m_y, tile.y0 + SIM_TILE_SIZE);
+            tile.dirty = true;
+            m_tiles.push_back(tile);
         }
     }
 }
@@ -63,9 +70,14 @@ cStock::~cStock()
 {}
 
 
-float cStock::FindRectTop(int& xp, int& yp, int& x_size, int& y_size, bool scanHoriz)
+float cStock::FindRectTop(const cTile& tile,
+                         int& xp,
+                         int& yp,
+                         int& x_size,
+                         int& y_size,
+                         bool scanHoriz)
 {
-    float z = m_stock[xp][yp];
+    float z = m_stock(xp, yp);
     bool xr_ok = true;
     bool xl_ok = scanHoriz;
     bool yu_ok = true;
@@ -76,12 +88,12 @@ float cStock::FindRectTop(int& xp, int& yp, int& x_size, int& y_size, bool scanH
         // sweep right x direction
         if (xr_ok) {
             int tx = xp + x_size;
-            if (tx >= m_x) {
+            if (tx >= tile.x1) {
                 xr_ok = false;
             }
             else {
                 for (int y = yp; y < yp + y_size; y++) {
-                    if ((m_attr[tx][y] & SIM_TESSEL_TOP) != 0 || fabs(z - m_stock[tx][y]) > m_res) {
+                    if ((m_attr(tx, y) & SIM_TESSEL_TOP) != 0 || fabs(z - m_stock(tx, y)) > m_res) {
                         xr_ok = false;
                         break;
                     }
@@ -95,12 +107,12 @@ float cStock::FindRectTop(int& xp, int& yp, int& x_size, int& y_size, bool scanH
         // sweep left x direction
         if (xl_ok) {
             int tx = xp - 1;
-            if (tx < 0) {
+            if (tx < tile.x0) {
                 xl_ok = false;
             }
             else {
                 for (int y = yp; y < yp + y_size; y++) {
-                    if ((m_attr[tx][y] & SIM_TESSEL_TOP) != 0 || fabs(z - m_stock[tx][y]) > m_res) {
+                    if ((m_attr(tx, y) & SIM_TESSEL_TOP) != 0 || fabs(z - m_stock(tx, y)) > m_res) {
                         xl_ok = false;
                         break;
                     }
@@ -115,12 +127,12 @@ float cStock::FindRectTop(int& xp, int& yp, int& x_size, int& y_size, bool scanH
         // sweep up y direction
         if (yu_ok) {
             int ty = yp + y_size;
-            if (ty >= m_y) {
+            if (ty >= tile.y1) {
                 yu_ok = false;
             }
             else {
                 for (int x = xp; x < xp + x_size; x++) {
-                    if ((m_attr[x][ty] & SIM_TESSEL_TOP) != 0 || fabs(z - m_stock[x][ty]) > m_res) {
+                    if ((m_attr(x, ty) & SIM_TESSEL_TOP) != 0 || fabs(z - m_stock(x, ty)) > m_res) {
                         yu_ok = false;
                         break;
                     }
@@ -134,12 +146,12 @@ float cStock::FindRectTop(int& xp, int& yp, int& x_size, int& y_size, bool scanH
         // sweep down y direction
         if (yd_ok) {
             int ty = yp - 1;
-            if (ty < 0) {
+            if (ty < tile.y0) {
                 yd_ok = false;
             }
             else {
                 for (int x = xp; x < xp + x_size; x++) {
-                    if ((m_attr[x][ty] & SIM_TESSEL_TOP) != 0 || fabs(z - m_stock[x][ty]) > m_res) {
+                    if ((m_attr(x, ty) & SIM_TESSEL_TOP) != 0 || fabs(z - m_stock(x, ty)) > m_res) {
                         yd_ok = false;
                         break;
                     }
@@ -154,27 +166,27 @@ float cStock::FindRectTop(int& xp, int& yp, int& x_size, int& y_size, bool scanH
     return z;
 }
 
-int cStock::TesselTop(int xp, int yp)
+int cStock::TesselTop(cTile& tile, int xp, int yp)
 {
     int x_size, y_size;
-    float z = FindRectTop(xp, yp, x_size, y_size, true);
+    float z = FindRectTop(tile, xp, yp, x_size, y_size, true);
     bool farRect = false;
     while (y_size / x_size > 5) {
         farRect = true;
         yp += x_size * 5;
-        z = FindRectTop(xp, yp, x_size, y_size, true);
+        z = FindRectTop(tile, xp, yp, x_size, y_size, true);
     }
 
     while (x_size / y_size > 5) {
         farRect = true;
         xp += y_size * 5;
-        z = FindRectTop(xp, yp, x_size, y_size, false);
+        z = FindRectTop(tile, xp, yp, x_size, y_size, false);
     }
 
     // mark all points inside
     for (int y = yp; y < yp + y_size; y++) {
         for (int x = xp; x < xp + x_size; x++) {
-            m_attr[x][y] |= SIM_TESSEL_TOP;
+            m_attr(x, y) |= SIM_TESSEL_TOP;
         }
     }
 
@@ -185,10 +197,10 @@ int cStock::TesselTop(int xp, int yp)
         Point3D ptl(xp, yp + y_size, z);
         Point3D ptr(xp + x_size, yp + y_size, z);
         if (fabs(m_pz + m_lz - z) < SIM_EPSILON) {
-            AddQuad(pbl, pbr, ptr, ptl, facetsOuter);
+            AddQuad(pbl, pbr, ptr, ptl, tile.facetsOuter);
         }
         else {
-            AddQuad(pbl, pbr, ptr, ptl, facetsInner);
+            AddQuad(pbl, pbr, ptr, ptl, tile.facetsInner);
         }
     }
 
@@ -200,7 +212,12 @@ int cStock::TesselTop(int xp, int yp)
 }
 
 
-void cStock::FindRectBot(int& xp, int& yp, int& x_size, int& y_size, bool scanHoriz)
+void cStock::FindRectBot(const cTile& tile,
+                         int& xp,
+                         int& yp,
+                         int& x_size,
+                         int& y_size,
+                         bool scanHoriz)
 {
     bool xr_ok = true;
     bool xl_ok = scanHoriz;
@@ -212,12 +229,12 @@ void cStock::FindRectBot(int& xp, int& yp, int& x_size, int& y_size, bool scanHo
         // sweep right x direction
         if (xr_ok) {
             int tx = xp + x_size;
-            if (tx >= m_x) {
+            if (tx >= tile.x1) {
                 xr_ok = false;
             }
             else {
                 for (int y = yp; y < yp + y_size; y++) {
-                    if ((m_attr[tx][y] & SIM_TESSEL_BOT) != 0 || (m_stock[tx][y] - m_pz) < m_res) {
+                    if ((m_attr(tx, y) & SIM_TESSEL_BOT) != 0 || (m_stock(tx, y) - m_pz) < m_res) {
                         xr_ok = false;
                         break;
                     }
@@ -231,12 +248,12 @@ void cStock::FindRectBot(int& xp, int& yp, int& x_size, int& y_size, bool scanHo
         // sweep left x direction
         if (xl_ok) {
             int tx = xp - 1;
-            if (tx < 0) {
+            if (tx < tile.x0) {
                 xl_ok = false;
             }
             else {
                 for (int y = yp; y < yp + y_size; y++) {
-                    if ((m_attr[tx][y] & SIM_TESSEL_BOT) != 0 || (m_stock[tx][y] - m_pz) < m_res) {
+                    if ((m_attr(tx, y) & SIM_TESSEL_BOT) != 0 || (m_stock(tx, y) - m_pz) < m_res) {
                         xl_ok = false;
                         break;
                     }
@@ -251,12 +268,12 @@ void cStock::FindRectBot(int& xp, int& yp, int& x_size, int& y_size, bool scanHo
         // sweep up y direction
         if (yu_ok) {
             int ty = yp + y_size;
-            if (ty >= m_y) {
+            if (ty >= tile.y1) {
                 yu_ok = false;
             }
             else {
                 for (int x = xp; x < xp + x_size; x++) {
-                    if ((m_attr[x][ty] & SIM_TESSEL_BOT) != 0 || (m_stock[x][ty] - m_pz) < m_res) {
+                    if ((m_attr(x, ty) & SIM_TESSEL_BOT) != 0 || (m_stock(x, ty) - m_pz) < m_res) {
                         yu_ok = false;
                         break;
                     }
@@ -270,12 +287,12 @@ void cStock::FindRectBot(int& xp, int& yp, int& x_size, int& y_size, bool scanHo
         // sweep down y direction
         if (yd_ok) {
             int ty = yp - 1;
-            if (ty < 0) {
+            if (ty < tile.y0) {
                 yd_ok = false;
             }
             else {
                 for (int x = xp; x < xp + x_size; x++) {
-                    if ((m_attr[x][ty] & SIM_TESSEL_BOT) != 0 || (m_stock[x][ty] - m_pz) < m_res) {
+                    if ((m_attr(x, ty) & SIM_TESSEL_BOT) != 0 || (m_stock(x, ty) - m_pz) < m_res) {
                         yd_ok = false;
                         break;
                     }
@@ -290,27 +307,27 @@ void cStock::FindRectBot(int& xp, int& yp, int& x_size, int& y_size, bool scanHo
 }
 
 
-int cStock::TesselBot(int xp, int yp)
+int cStock::TesselBot(cTile& tile, int xp, int yp)
 {
     int x_size, y_size;
-    FindRectBot(xp, yp, x_size, y_size, true);
+    FindRectBot(tile, xp, yp, x_size, y_size, true);
     bool farRect = false;
     while (y_size / x_size > 5) {
         farRect = true;
         yp += x_size * 5;
-        FindRectTop(xp, yp, x_size, y_size, true);
+        FindRectTop(tile, xp, yp, x_size, y_size, true);
     }
 
     while (x_size / y_size > 5) {
         farRect = true;
         xp += y_size * 5;
-        FindRectTop(xp, yp, x_size, y_size, false);
+        FindRectTop(tile, xp, yp, x_size, y_size, false);
     }
 
     // mark all points inside
     for (int y = yp; y < yp + y_size; y++) {
         for (int x = xp; x < xp + x_size; x++) {
-            m_attr[x][y] |= SIM_TESSEL_BOT;
+            m_attr(x, y) |= SIM_TESSEL_BOT;
         }
     }
 
@@ -319,7 +336,7 @@ int cStock::TesselBot(int xp, int yp)
     Point3D pbr(xp + x_size, yp, m_pz);
     Point3D ptl(xp, yp + y_size, m_pz);
     Point3D ptr(xp + x_size, yp + y_size, m_pz);
-    AddQuad(pbl, ptl, ptr, pbr, facetsOuter);
+    AddQuad(pbl, ptl, ptr, pbr, tile.facetsOuter);
 
     if (farRect) {
         return -1;
@@ -329,36 +346,37 @@ int cStock::TesselBot(int xp, int yp)
 }
 
 
-int cStock::TesselSidesX(int yp)
+int cStock::TesselSidesX(cTile& tile, int yp)
 {
     float lastz1 = m_pz;
     if (yp < m_y) {
-        lastz1 = std::max(m_stock[0][yp], m_pz);
+        lastz1 = std::max(m_stock(tile.x0, yp), m_pz);
     }
     float lastz2 = m_pz;
     if (yp > 0) {
-        lastz2 = std::max(m_stock[0][yp - 1], m_pz);
+        lastz2 = std::max(m_stock(tile.x0, yp - 1), m_pz);
     }
 
-    std::vector<MeshCore::MeshGeomFacet>* facets = &facetsInner;
+    std::vector<MeshCore::MeshGeomFacet>* facets = &tile.facetsInner;
     if (yp == 0 || yp == m_y) {
-        facets = &facetsOuter;
+        facets = &tile.facetsOuter;
     }
 
     // bool lastzclip = (lastz - m_pz) < m_res;
-    int lastpoint = 0;
-    for (int x = 1; x <= m_x; x++) {
+    int lastpoint = tile.x0;
+    for (int x = tile.x0 + 1; x <= tile.x1; x++) {
         float newz1 = m_pz;
         if (yp < m_y && x < m_x) {
-            newz1 = std::max(m_stock[x][yp], m_pz);
+            newz1 = std::max(m_stock(x, yp), m_pz);
         }
         float newz2 = m_pz;
         if (yp > 0 && x < m_x) {
-            newz2 = std::max(m_stock[x][yp - 1], m_pz);
+            newz2 = std::max(m_stock(x, yp - 1), m_pz);
         }
 
         if (fabs(lastz1 - lastz2) > m_res) {
-            if (fabs(newz1 - lastz1) < m_res && fabs(newz2 - lastz2) < m_res) {
+            // a side never extends into the next tile
+            if (x < tile.x1 && fabs(newz1 - lastz1) < m_res && fabs(newz2 - lastz2) < m_res) {
                 continue;
             }
             Point3D pbl(lastpoint, yp, lastz1);
@@ -374,36 +392,37 @@ int cStock::TesselSidesX(int yp)
     return 0;
 }
 
-int cStock::TesselSidesY(int xp)
+int cStock::TesselSidesY(cTile& tile, int xp)
 {
     float lastz1 = m_pz;
     if (xp < m_x) {
-        lastz1 = std::max(m_stock[xp][0], m_pz);
+        lastz1 = std::max(m_stock(xp, tile.y0), m_pz);
     }
     float lastz2 = m_pz;
     if (xp > 0) {
-        lastz2 = std::max(m_stock[xp - 1][0], m_pz);
+        lastz2 = std::max(m_stock(xp - 1, tile.y0), m_pz);
     }
 
-    std::vector<MeshCore::MeshGeomFacet>* facets = &facetsInner;
+    std::vector<MeshCore::MeshGeomFacet>* facets = &tile.facetsInner;
     if (xp == 0 || xp == m_x) {
-        facets = &facetsOuter;
+        facets = &tile.facetsOuter;
     }
 
     // bool lastzclip = (lastz - m_pz) < m_res;
-    int lastpoint = 0;
-    for (int y = 1; y <= m_y; y++) {
+    int lastpoint = tile.y0;
+    for (int y = tile.y0 + 1; y <= tile.y1; y++) {
         float newz1 = m_pz;
         if (xp < m_x && y < m_y) {
-            newz1 = std::max(m_stock[xp][y], m_pz);
+            newz1 = std::max(m_stock(xp, y), m_pz);
         }
         float newz2 = m_pz;
         if (xp > 0 && y < m_y) {
-            newz2 = std::max(m_stock[xp - 1][y], m_pz);
+            newz2 = std::max(m_stock(xp - 1, y), m_pz);
         }
 
         if (fabs(lastz1 - lastz2) > m_res) {
-            if (fabs(newz1 - lastz1) < m_res && fabs(newz2 - lastz2) < m_res) {
+            // a side never extends into the next tile
+            if (y < tile.y1 && fabs(newz1 - lastz1) < m_res && fabs(newz2 - lastz2) < m_res) {
                 continue;
             }
             Point3D pbr(xp, lastpoint, lastz1);
@@ -446,46 +465,93 @@ void cStock::AddQuad(Point3D& p1,
     facets.push_back(facet);
 }
 
-void cStock::Tessellate(Mesh::MeshObject& meshOuter, Mesh::MeshObject& meshInner)
+void cStock::TessellateTile(cTile& tile)
 {
     // reset attribs
-    for (int y = 0; y < m_y; y++) {
-        for (int x = 0; x < m_x; x++) {
-            m_attr[x][y] = 0;
+    for (int y = tile.y0; y < tile.y1; y++) {
+        for (int x = tile.x0; x < tile.x1; x++) {
+            m_attr(x, y) = 0;
         }
     }
 
-    facetsOuter.clear();
-    facetsInner.clear();
+    tile.facetsOuter.clear();
+    tile.facetsInner.clear();
 
-    for (int y = 0; y < m_y; y++) {
-        for (int x = 0; x < m_x; x++) {
-            int attr = m_attr[x][y];
+    for (int y = tile.y0; y < tile.y1; y++) {
+        for (int x = tile.x0; x < tile.x1; x++) {
+            int attr = m_attr(x, y);
             if ((attr & SIM_TESSEL_TOP) == 0) {
-                x += TesselTop(x, y);
+                x += TesselTop(tile, x, y);
             }
         }
     }
-    for (int y = 0; y < m_y; y++) {
-        for (int x = 0; x < m_x; x++) {
-            if ((m_stock[x][y] - m_pz) < m_res) {
-                m_attr[x][y] |= SIM_TESSEL_BOT;
+    for (int y = tile.y0; y < tile.y1; y++) {
+        for (int x = tile.x0; x < tile.x1; x++) {
+            if ((m_stock(x, y) - m_pz) < m_res) {
+                m_attr(x, y) |= SIM_TESSEL_BOT;
             }
-            if ((m_attr[x][y] & SIM_TESSEL_BOT) == 0) {
-                x += TesselBot(x, y);
+            if ((m_attr(x, y) & SIM_TESSEL_BOT) == 0) {
+                x += TesselBot(tile, x, y);
             }
         }
     }
-    for (int y = 0; y <= m_y; y++) {
-        TesselSidesX(y);
+
+    // a tile owns the sides at its lower borders, the last tiles also the stock borders
+    int ye = tile.y1 == m_y ? m_y : tile.y1 - 1;
+    for (int y = tile.y0; y <= ye; y++) {
+        TesselSidesX(tile, y);
     }
-    for (int x = 0; x <= m_x; x++) {
-        TesselSidesY(x);
+    int xe = tile.x1 == m_x ? m_x : tile.x1 - 1;
+    for (int x = tile.x0; x <= xe; x++) {
+        TesselSidesY(tile, x);
+    }
+    tile.dirty = false;
+}
+
+void cStock::Tessellate(Mesh::MeshObject& meshOuter, Mesh::MeshObject& meshInner)
+{
+    // only the tiles modified since the last call are tessellated again
+    std::vector<cTile*> dirtyTiles;
+    for (auto& tile : m_tiles) {
+        if (tile.dirty) {
+            dirtyTiles.push_back(&tile);
+        }
+    }
+    QtConcurrent::blockingMap(dirtyTiles, [this](cTile* tile) {
+        TessellateTile(*tile);
+    });
+
+    size_t numOuter = 0;
+    size_t numInner = 0;
+    for (const auto& tile : m_tiles) {
+        numOuter += tile.facetsOuter.size();
+        numInner += tile.facetsInner.size();
+    }
+
+    std::vector<MeshCore::MeshGeomFacet> facetsOuter;
+    std::vector<MeshCore::MeshGeomFacet> facetsInner;
+    facetsOuter.reserve(numOuter);
+    facetsInner.reserve(numInner);
+    for (const auto& tile : m_tiles) {
+        facetsOuter.insert(facetsOuter.end(), tile.facetsOuter.begin(), tile.facetsOuter.end());
+        facetsInner.insert(facetsInner.end(), tile.facetsInner.begin(), tile.facetsInner.end());
     }
     meshOuter.addFacets(facetsOuter);
     meshInner.addFacets(facetsInner);
-    facetsOuter.clear();
-    facetsInner.clear();
+}
+
+void cStock::SetDirty(int xs, int ys, int xe, int ye)
+{
+    // The sides at the upper borders of the pixels belong to the next tiles
+    int txs = std::max(0, xs / SIM_TILE_SIZE);
+    int tys = std::max(0, ys / SIM_TILE_SIZE);
+    int txe = std::min(m_stock.TilesX() - 1, xe / SIM_TILE_SIZE);
+    int tye = std::min(m_stock.TilesY() - 1, ye / SIM_TILE_SIZE);
+    for (int ty = tys; ty <= tye; ty++) {
+        for (int tx = txs; tx <= txe; tx++) {
+            m_tiles[ty * m_stock.TilesX() + tx].dirty = true;
+        }
+    }
 }
 
 
@@ -496,167 +562,467 @@ void cStock::CreatePocket(float cxf, float cyf, float radf, float height)
     int rad = (int)(radf / m_res);
     int drad = rad * rad;
     int ys = std::max(0, cy - rad);
-    int ye = std::min(m_x, cy + rad);
+    int ye = std::min(m_y, cy + rad);
     int xs = std::max(0, cx - rad);
     int xe = std::min(m_x, cx + rad);
     for (int y = ys; y < ye; y++) {
         for (int x = xs; x < xe; x++) {
             if (((x - cx) * (x - cx) + (y - cy) * (y - cy)) < drad) {
-                if (m_stock[x][y] > height) {
-                    m_stock[x][y] = height;
+                if (m_stock(x, y) > height) {
+                    m_stock(x, y) = height;
                 }
             }
         }
     }
+    SetDirty(xs, ys, xe, ye);
 }
 
 void cStock::ApplyLinearTool(Point3D& p1, Point3D& p2, cSimTool& tool)
+{
+    ApplySweeps(std::vector<cSweep> {LinearSweep(p1, p2, tool)});
+}
+
+void cStock::ApplyCircularTool(Point3D& p1, Point3D& p2, Point3D& cent, cSimTool& tool, bool isCCW)
+{
+    ApplySweeps(std::vector<cSweep> {CircularSweep(p1, p2, cent, tool, isCCW)});
+}
+
+cSweep cStock::LinearSweep(Point3D& p1, Point3D& p2, cSimTool& tool)
 {
     // translate coordinates
-    Point3D pi1 = ToInner(p1);
-    Point3D pi2 = ToInner(p2);
-    float rad = tool.radius;
-    rad /= m_res;
-    float cupAngle = 180;
-
-    // strait motion
-    float perpDirX = 1;
-    float perpDirY = 0;
-    cLineSegment path(pi1, pi2);
-    if (path.lenXY > SIM_EPSILON)  // only if moving along xy
-    {
-        perpDirX = -path.pDirXY.y;
-        perpDirY = path.pDirXY.x;
-        Point3D start(perpDirX * rad + pi1.x, perpDirY * rad + pi1.y, pi1.z);
-        Point3D mainWay = path.pDir * SIM_WALK_RES;
-        Point3D sideWay(-perpDirX * SIM_WALK_RES, -perpDirY * SIM_WALK_RES, 0);
-        int lenSteps = (int)(path.len / SIM_WALK_RES) + 1;
-        int radSteps = (int)(rad * 2 / SIM_WALK_RES) + 1;
-        float zstep = (pi2.z - pi1.z) / radSteps;
-        float tstep = 2.0 / radSteps;
-        float t = -1;
-        for (int j = 0; j < radSteps; j++) {
-            float z = pi1.z + tool.GetToolProfileAt(t);
-            Point3D p = start;
-            for (int i = 0; i < lenSteps; i++) {
-                int x = (int)p.x;
-                int y = (int)p.y;
-                if (x >= 0 && y >= 0 && x < m_x && y < m_y) {
-                    if (m_stock[x][y] > z) {
-                        m_stock[x][y] = z;
-                    }
-                }
-                p.Add(mainWay);
-                z += zstep;
+    cSweep sweep;
+    sweep.p1 = ToInner(p1);
+    sweep.p2 = ToInner(p2);
+    sweep.rad = tool.radius / m_res;
+    sweep.profile = tool.GetProfileTable(m_res).data();
+
+    float xmin = std::min(sweep.p1.x, sweep.p2.x) - sweep.rad;
+    float ymin = std::min(sweep.p1.y, sweep.p2.y) - sweep.rad;
+    float xmax = std::max(sweep.p1.x, sweep.p2.x) + sweep.rad;
+    float ymax = std::max(sweep.p1.y, sweep.p2.y) + sweep.rad;
+    sweep.xmin = std::max(0, (int)std::floor(xmin));
+    sweep.ymin = std::max(0, (int)std::floor(ymin));
+    sweep.xmax = std::min(m_x, (int)std::floor(xmax) + 1);
+    sweep.ymax = std::min(m_y, (int)std::floor(ymax) + 1);
+    return sweep;
+}
+
+cSweep cStock::CircularSweep(Point3D& p1, Point3D& p2, Point3D& cent, cSimTool& tool, bool isCCW)
+{
+    // translate coordinates, the center is relative to the start point
+    cSweep sweep;
+    sweep.isArc = true;
+    sweep.isCCW = isCCW;
+    sweep.p1 = ToInner(p1);
+    sweep.p2 = ToInner(p2);
+    sweep.cent = Point3D(sweep.p1.x + cent.x / m_res, sweep.p1.y + cent.y / m_res, cent.z);
+    sweep.rad = tool.radius / m_res;
+    sweep.profile = tool.GetProfileTable(m_res).data();
+
+    float cpx = sweep.p1.x - sweep.cent.x;
+    float cpy = sweep.p1.y - sweep.cent.y;
+    sweep.arcRad = sqrt(cpx * cpx + cpy * cpy);
+    sweep.startAng = atan2(cpy, cpx);
+    double eang = atan2(sweep.p2.y - sweep.cent.y, sweep.p2.x - sweep.cent.x);  // end angle
+
+    double ang = eang - sweep.startAng;
+    if (!isCCW && ang > 0) {
+        ang -= 2 * pi;
+    }
+    if (isCCW && ang < 0) {
+        ang += 2 * pi;
+    }
+    sweep.sweepAng = fabs(ang);
+    float fromAng = isCCW ? sweep.startAng : (float)eang;
+    sweep.fromX = cos(fromAng);
+    sweep.fromY = sin(fromAng);
+    sweep.toX = cos(fromAng + sweep.sweepAng);
+    sweep.toY = sin(fromAng + sweep.sweepAng);
+
+    // the end points and the extreme points of the circle that lie on the arc
+    float xmin = std::min(sweep.p1.x, sweep.p2.x);
+    float ymin = std::min(sweep.p1.y, sweep.p2.y);
+    float xmax = std::max(sweep.p1.x, sweep.p2.x);
+    float ymax = std::max(sweep.p1.y, sweep.p2.y);
+    for (int i = 0; i < 4; i++) {
+        double a = i * pi / 2 - sweep.startAng;
+        if (!isCCW) {
+            a = -a;
+        }
+        a = fmod(a + 4 * pi, 2 * pi);
+        if (a <= sweep.sweepAng) {
+            float x = sweep.cent.x + sweep.arcRad * (float)cos(i * pi / 2);
+            float y = sweep.cent.y + sweep.arcRad * (float)sin(i * pi / 2);
+            xmin = std::min(xmin, x);
+            ymin = std::min(ymin, y);
+            xmax = std::max(xmax, x);
+            ymax = std::max(ymax, y);
+        }
+    }
+    sweep.xmin = std::max(0, (int)std::floor(xmin - sweep.rad));
+    sweep.ymin = std::max(0, (int)std::floor(ymin - sweep.rad));
+    sweep.xmax = std::min(m_x, (int)std::floor(xmax + sweep.rad) + 1);
+    sweep.ymax = std::min(m_y, (int)std::floor(ymax + sweep.rad) + 1);
+    return sweep;
+}
+
+std::vector<std::vector<int>> cStock::SortToTiles(const std::vector<cSweep>& sweeps)
+{
+    int tilesX = m_stock.TilesX();
+    std::vector<std::vector<int>> tileSweeps(m_tiles.size());
+    for (size_t i = 0; i < sweeps.size(); i++) {
+        const cSweep& sweep = sweeps[i];
+        if (sweep.IsEmpty()) {
+            continue;
+        }
+        int txe = (sweep.xmax - 1) / SIM_TILE_SIZE;
+        int tye = (sweep.ymax - 1) / SIM_TILE_SIZE;
+        for (int ty = sweep.ymin / SIM_TILE_SIZE; ty <= tye; ty++) {
+            for (int tx = sweep.xmin / SIM_TILE_SIZE; tx <= txe; tx++) {
+                tileSweeps[ty * tilesX + tx].push_back((int)i);
             }
-            t += tstep;
-            start.Add(sideWay);
         }
+        SetDirty(sweep.xmin, sweep.ymin, sweep.xmax, sweep.ymax);
     }
-    else {
-        cupAngle = 360;
+    return tileSweeps;
+}
+
+void cStock::ApplySweeps(const std::vector<cSweep>& sweeps)
+{
+    int tilesX = m_stock.TilesX();
+    std::vector<std::vector<int>> tileSweeps = SortToTiles(sweeps);
+    std::vector<int> tiles;
+    for (size_t i = 0; i < tileSweeps.size(); i++) {
+        if (!tileSweeps[i].empty()) {
+            tiles.push_back((int)i);
+        }
     }
+    QtConcurrent::blockingMap(tiles, [&](int tile) {
+        for (int sweep : tileSweeps[tile]) {
+            StampTile(tile % tilesX, tile / tilesX, sweeps[sweep]);
+        }
+    });
+}
+
+std::vector<cSweepReport> cStock::VerifySweeps(const std::vector<cSweep>& sweeps)
+{
+    // every tile collects the reports of its moves, these are summed up afterwards
+    int tilesX = m_stock.TilesX();
+    std::vector<std::vector<int>> tileSweeps = SortToTiles(sweeps);
+    std::vector<std::vector<cSweepReport>> tileReports(tileSweeps.size());
+    std::vector<int> tiles;
+    for (size_t i = 0; i < tileSweeps.size(); i++) {
+        if (!tileSweeps[i].empty()) {
+            tiles.push_back((int)i);
+            tileReports[i].resize(tileSweeps[i].size());
+        }
+    }
+    QtConcurrent::blockingMap(tiles, [&](int tile) {
+        for (size_t i = 0; i < tileSweeps[tile].size(); i++) {
+            const cSweep& sweep = sweeps[tileSweeps[tile][i]];
+            VerifyTile(tile % tilesX, tile / tilesX, sweep, tileReports[tile][i]);
+        }
+    });
+
+    std::vector<cSweepReport> reports(sweeps.size());
+    for (int tile : tiles) {
+        for (size_t i = 0; i < tileSweeps[tile].size(); i++) {
+            const cSweepReport& part = tileReports[tile][i];
+            cSweepReport& report = reports[tileSweeps[tile][i]];
+            report.removed += part.removed * m_res * m_res;
+            report.maxCut = std::max(report.maxCut, part.maxCut);
+            if (part.gouge > report.gouge) {
+                report.gouge = part.gouge;
+                report.gougePos = Point3D(m_px + (part.gougePos.x + 0.5f) * m_res,
+                                          m_py + (part.gougePos.y + 0.5f) * m_res,
+                                          part.gougePos.z);
+            }
+        }
+    }
+    return reports;
+}
+
+void cStock::StampTile(int tx, int ty, const cSweep& sweep)
+{
+    int xs = std::max(sweep.xmin, tx * SIM_TILE_SIZE);
+    int xe = std::min(sweep.xmax, (tx + 1) * SIM_TILE_SIZE);
+    int ys = std::max(sweep.ymin, ty * SIM_TILE_SIZE);
+    int ye = std::min(sweep.ymax, (ty + 1) * SIM_TILE_SIZE);
+
+    // The heights are computed into a buffer first so that taking the minimum
+    // with the contiguous tile row can be vectorized
+    float heights[SIM_TILE_SIZE];
+    for (int y = ys; y < ye; y++) {
+        sweep.GetHeights(y, xs, xe, heights);
+        float* row = m_stock.TileRow(tx, ty, y) + (xs - tx * SIM_TILE_SIZE);
+        for (int i = 0; i < xe - xs; i++) {
+            row[i] = std::min(row[i], heights[i]);
+        }
+    }
+}
+
+void cStock::VerifyTile(int tx, int ty, const cSweep& sweep, cSweepReport& report)
+{
+    int xs = std::max(sweep.xmin, tx * SIM_TILE_SIZE);
+    int xe = std::min(sweep.xmax, (tx + 1) * SIM_TILE_SIZE);
+    int ys = std::max(sweep.ymin, ty * SIM_TILE_SIZE);
+    int ye = std::min(sweep.ymax, (ty + 1) * SIM_TILE_SIZE);
+    bool hasModel = m_model.TilesX() > 0;
 
-    // end cup
-    for (float r = 0.5f; r <= rad; r += (float)SIM_WALK_RES) {
-        Point3D cupCirc(perpDirX * r, perpDirY * r, pi2.z);
-        float rotang = 180 * SIM_WALK_RES / (pi * r);
-        cupCirc.SetRotationAngle(-rotang);
-        float z = pi2.z + tool.GetToolProfileAt(r / rad);
-        for (float a = 0; a < cupAngle; a += rotang) {
-            int x = (int)(pi2.x + cupCirc.x);
-            int y = (int)(pi2.y + cupCirc.y);
-            if (x >= 0 && y >= 0 && x < m_x && y < m_y) {
-                if (m_stock[x][y] > z) {
-                    m_stock[x][y] = z;
+    float heights[SIM_TILE_SIZE];
+    for (int y = ys; y < ye; y++) {
+        sweep.GetHeights(y, xs, xe, heights);
+        float* row = m_stock.TileRow(tx, ty, y) + (xs - tx * SIM_TILE_SIZE);
+        for (int i = 0; i < xe - xs; i++) {
+            // the material below the stock bottom doesn't count
+            float cut = row[i] - std::max(heights[i], m_pz);
+            if (cut > 0) {
+                report.removed += cut;
+                report.maxCut = std::max(report.maxCut, cut);
+            }
+            row[i] = std::min(row[i], heights[i]);
+        }
+
+        if (hasModel) {
+            const float* model = m_model.TileRow(tx, ty, y) + (xs - tx * SIM_TILE_SIZE);
+            for (int i = 0; i < xe - xs; i++) {
+                float gouge = model[i] - heights[i];
+                if (gouge > report.gouge) {
+                    report.gouge = gouge;
+                    report.gougePos = Point3D(xs + i, y, heights[i]);
                 }
             }
-            cupCirc.Rotate();
         }
     }
 }
 
-void cStock::ApplyCircularTool(Point3D& p1, Point3D& p2, Point3D& cent, cSimTool& tool, bool isCCW)
+void cStock::SetModel(const std::vector<Triangle3D>& triangles)
 {
-    // translate coordinates
-    Point3D pi1 = ToInner(p1);
-    Point3D pi2 = ToInner(p2);
-    Point3D centi(cent.x / m_res, cent.y / m_res, cent.z);
-    float rad = tool.radius;
-    rad /= m_res;
-    float cpx = centi.x;
-    float cpy = centi.y;
-
-    Point3D xynorm = unit(Point3D(-cpx, -cpy, 0));
-    float crad = sqrt(cpx * cpx + cpy * cpy);
-    float crad1 = std::max((float)0.5, crad - rad);
-    float crad2 = crad + rad;
-
-    float sang = atan2(-cpy, -cpx);  // start angle
-
-    cpx += pi1.x;
-    cpy += pi1.y;
-    double eang = atan2(pi2.y - cpy, pi2.x - cpx);  // end angle
-
-    double ang = eang - sang;
-    if (!isCCW && ang > 0) {
-        ang -= 2 * pi;
+    m_model.Init(m_x, m_y, std::numeric_limits<float>::lowest());
+
+    // the triangles in stock pixel coordinates sorted to the tiles they overlap
+    int tilesX = m_model.TilesX();
+    std::vector<Triangle3D> inner(triangles.size());
+    std::vector<std::vector<int>> tileTris(m_tiles.size());
+    for (size_t i = 0; i < triangles.size(); i++) {
+        Triangle3D& tri = inner[i];
+        float xmin = std::numeric_limits<float>::max();
+        float ymin = xmin;
+        float xmax = std::numeric_limits<float>::lowest();
+        float ymax = xmax;
+        for (int j = 0; j < 3; j++) {
+            Point3D pnt = triangles[i].points[j];
+            tri.points[j] = ToInner(pnt);
+            xmin = std::min(xmin, tri.points[j].x);
+            ymin = std::min(ymin, tri.points[j].y);
+            xmax = std::max(xmax, tri.points[j].x);
+            ymax = std::max(ymax, tri.points[j].y);
+        }
+        int txs = std::max(0, (int)std::floor(xmin) / SIM_TILE_SIZE);
+        int tys = std::max(0, (int)std::floor(ymin) / SIM_TILE_SIZE);
+        int txe = std::min(m_model.TilesX() - 1, (int)std::floor(xmax) / SIM_TILE_SIZE);
+        int tye = std::min(m_model.TilesY() - 1, (int)std::floor(ymax) / SIM_TILE_SIZE);
+        for (int ty = tys; ty <= tye; ty++) {
+            for (int tx = txs; tx <= txe; tx++) {
+                tileTris[ty * tilesX + tx].push_back((int)i);
+            }
+        }
     }
-    if (isCCW && ang < 0) {
-        ang += 2 * pi;
+
+    std::vector<int> tiles;
+    for (size_t i = 0; i < tileTris.size(); i++) {
+        if (!tileTris[i].empty()) {
+            tiles.push_back((int)i);
+        }
     }
-    ang = fabs(ang);
-
-    // apply path
-    Point3D cupCirc;
-    float tstep = (float)SIM_WALK_RES / rad;
-    float t = -1;
-    for (float r = crad1; r <= crad2; r += (float)SIM_WALK_RES) {
-        cupCirc.x = xynorm.x * r;
-        cupCirc.y = xynorm.y * r;
-        float rotang = (float)SIM_WALK_RES / r;
-        int ndivs = (int)(ang / rotang) + 1;
-        if (!isCCW) {
-            rotang = -rotang;
-        }
-        cupCirc.SetRotationAngleRad(rotang);
-        float z = pi1.z + tool.GetToolProfileAt(t);
-        float zstep = (pi2.z - pi1.z) / ndivs;
-        for (int i = 0; i < ndivs; i++) {
-            int x = (int)(cpx + cupCirc.x);
-            int y = (int)(cpy + cupCirc.y);
-            if (x >= 0 && y >= 0 && x < m_x && y < m_y) {
-                if (m_stock[x][y] > z) {
-                    m_stock[x][y] = z;
-                }
+    QtConcurrent::blockingMap(tiles, [&](int tile) {
+        for (int tri : tileTris[tile]) {
+            RasterizeTile(tile % tilesX, tile / tilesX, inner[tri]);
+        }
+    });
+}
+
+void cStock::RasterizeTile(int tx, int ty, const Triangle3D& tri)
+{
+    // the highest point of the triangle above each pixel center
+    const Point3D& a = tri.points[0];
+    const Point3D& b = tri.points[1];
+    const Point3D& c = tri.points[2];
+    float area = (b.x - a.x) * (c.y - a.y) - (c.x - a.x) * (b.y - a.y);
+    if (fabs(area) < SIM_EPSILON) {
+        return;  // vertical triangles are covered by their neighbours
+    }
+
+    float xmin = std::min({a.x, b.x, c.x});
+    float ymin = std::min({a.y, b.y, c.y});
+    float xmax = std::max({a.x, b.x, c.x});
+    float ymax = std::max({a.y, b.y, c.y});
+    int xs = std::max({0, tx * SIM_TILE_SIZE, (int)std::floor(xmin - 0.5f)});
+    int ys = std::max({0, ty * SIM_TILE_SIZE, (int)std::floor(ymin - 0.5f)});
+    int xe = std::min({m_x, (tx + 1) * SIM_TILE_SIZE, (int)std::floor(xmax) + 1});
+    int ye = std::min({m_y, (ty + 1) * SIM_TILE_SIZE, (int)std::floor(ymax) + 1});
+    for (int y = ys; y < ye; y++) {
+        float* row = m_model.TileRow(tx, ty, y) - tx * SIM_TILE_SIZE;
+        float py = y + 0.5f;
+        for (int x = xs; x < xe; x++) {
+            float px = x + 0.5f;
+            float wa = ((b.x - px) * (c.y - py) - (c.x - px) * (b.y - py)) / area;
+            float wb = ((c.x - px) * (a.y - py) - (a.x - px) * (c.y - py)) / area;
+            float wc = 1.0f - wa - wb;
+            if (wa < -SIM_EPSILON || wb < -SIM_EPSILON || wc < -SIM_EPSILON) {
+                continue;
             }
-            z += zstep;
-            cupCirc.Rotate();
+            row[x] = std::max(row[x], wa * a.z + wb * b.z + wc * c.z);
         }
-        t += tstep;
     }
+}
 
-    // apply end cup
-    xynorm.SetRotationAngleRad(ang);
-    xynorm.Rotate();
-    for (float r = 0.5f; r <= rad; r += (float)SIM_WALK_RES) {
-        Point3D cupCirc(xynorm.x * r, xynorm.y * r, 0);
-        float rotang = (float)SIM_WALK_RES / r;
-        int ndivs = (int)(pi / rotang) + 1;
-        if (!isCCW) {
-            rotang = -rotang;
-        }
-        cupCirc.SetRotationAngleRad(rotang);
-        float z = pi2.z + tool.GetToolProfileAt(r / rad);
-        for (int i = 0; i < ndivs; i++) {
-            int x = (int)(pi2.x + cupCirc.x);
-            int y = (int)(pi2.y + cupCirc.y);
-            if (x >= 0 && y >= 0 && x < m_x && y < m_y) {
-                if (m_stock[x][y] > z) {
-                    m_stock[x][y] = z;
+double cStock::GetVolume()
+{
+    // the volume above the bottom of the stock, summed up per tile
+    std::vector<double> volumes(m_tiles.size(), 0.0);
+    const double* first = volumes.data();
+    QtConcurrent::blockingMap(volumes, [this, first](double& volume) {
+        const cTile& tile = m_tiles[&volume - first];
+        for (int y = tile.y0; y < tile.y1; y++) {
+            for (int x = tile.x0; x < tile.x1; x++) {
+                volume += std::max(0.0f, m_stock(x, y) - m_pz);
+            }
+        }
+    });
+
+    double volume = 0.0;
+    for (double it : volumes) {
+        volume += it;
+    }
+    return volume * m_res * m_res;
+}
+
+
+//************************************************************************************************************
+// Swept area
+//************************************************************************************************************
+
+void cSweep::GetHeights(int y, int xs, int xe, float* out) const
+{
+    const float noCut = std::numeric_limits<float>::max();
+    float radSq = rad * rad;
+    float cy = y + 0.5f;
+
+    // the tool height at a distance from the tool axis
+    auto toolHeight = [this](float distSq) {
+        return profile[(int)(distSq * SIM_PROFILE_STEPS)];
+    };
+
+    if (!isArc) {
+        float dx = p2.x - p1.x;
+        float dy = p2.y - p1.y;
+        float dz = p2.z - p1.z;
+        float lenSq = dx * dx + dy * dy;
+
+        // only the part of the move within the tool radius of the row can reach it
+        float ta = 0.0f;
+        float tb = 1.0f;
+        if (fabs(dy) > SIM_EPSILON) {
+            ta = std::clamp((cy - rad - p1.y) / dy, 0.0f, 1.0f);
+            tb = std::clamp((cy + rad - p1.y) / dy, 0.0f, 1.0f);
+        }
+        float xlo = p1.x + std::min(ta, tb) * dx;
+        float xhi = p1.x + std::max(ta, tb) * dx;
+        if (xlo > xhi) {
+            std::swap(xlo, xhi);
+        }
+        int xa = std::clamp((int)std::floor(xlo - rad), xs, xe);
+        int xb = std::clamp((int)std::floor(xhi + rad) + 1, xa, xe);
+        std::fill(out, out + (xa - xs), noCut);
+        std::fill(out + (xb - xs), out + (xe - xs), noCut);
+
+        // first the nearest tool position along the move for all pixels, a plunge
+        // only cuts at its end
+        float invLenSq = lenSq > SIM_EPSILON ? 1.0f / lenSq : 0.0f;
+        float tStart = lenSq > SIM_EPSILON ? 0.0f : 1.0f;
+        float distSq[SIM_TILE_SIZE];
+        float* tipZ = out + (xa - xs);
+        for (int i = 0; i < xb - xa; i++) {
+            float vx = xa + i + 0.5f - p1.x;
+            float vy = cy - p1.y;
+            float t = std::clamp((vx * dx + vy * dy) * invLenSq, tStart, 1.0f);
+            float ex = vx - t * dx;
+            float ey = vy - t * dy;
+            distSq[i] = ex * ex + ey * ey;
+            tipZ[i] = p1.z + t * dz;
+        }
+        // then the tool profile at these distances
+        for (int i = 0; i < xb - xa; i++) {
+            tipZ[i] = distSq[i] <= radSq ? tipZ[i] + toolHeight(distSq[i]) : noCut;
+        }
+        return;
+    }
+
+    std::fill(out, out + (xe - xs), noCut);
+
+    // the end points
+    for (const Point3D* p : {&p1, &p2}) {
+        float vy = cy - p->y;
+        if (fabs(vy) > rad) {
+            continue;
+        }
+        int xa = std::clamp((int)std::floor(p->x - rad), xs, xe);
+        int xb = std::clamp((int)std::floor(p->x + rad) + 1, xa, xe);
+        for (int x = xa; x < xb; x++) {
+            float vx = x + 0.5f - p->x;
+            float distSq = vx * vx + vy * vy;
+            if (distSq <= radSq) {
+                out[x - xs] = std::min(out[x - xs], p->z + toolHeight(distSq));
+            }
+        }
+    }
+
+    // the nearest tool position on the arc, only the pixels of the row that are
+    // within the tool radius of the circle are checked
+    float vy = cy - cent.y;
+    float outerSq = (arcRad + rad) * (arcRad + rad) - vy * vy;
+    if (outerSq < 0 || sweepAng <= 0) {
+        return;
+    }
+    float innerRad = std::max(0.0f, arcRad - rad);
+    float innerSq = innerRad * innerRad - vy * vy;
+    float wo = sqrtf(outerSq);
+    float wi = innerSq > 0 ? sqrtf(innerSq) : 0.0f;
+    const float ranges[2][2] = {{cent.x - wo, cent.x - wi}, {cent.x + wi, cent.x + wo}};
+    for (const auto& range : ranges) {
+        int xa = std::clamp((int)std::floor(range[0]), xs, xe);
+        int xb = std::clamp((int)std::floor(range[1]) + 1, xa, xe);
+        for (int x = xa; x < xb; x++) {
+            float vx = x + 0.5f - cent.x;
+            float dist = fabs(sqrtf(vx * vx + vy * vy) - arcRad);
+            if (dist > rad) {
+                continue;
+            }
+
+            // whether the pixel lies in the sector of the arc
+            bool afterFrom = fromX * vy - fromY * vx >= 0;
+            bool beforeTo = vx * toY - vy * toX >= 0;
+            if (sweepAng <= pi ? !(afterFrom && beforeTo) : !(afterFrom || beforeTo)) {
+                continue;
+            }
+
+            // the angle is only needed for helical moves
+            float z = p1.z;
+            if (p1.z != p2.z) {
+                float a = atan2f(vy, vx) - startAng;
+                if (!isCCW) {
+                    a = -a;
+                }
+                while (a < 0) {
+                    a += 2 * pi;
                 }
+                while (a >= 2 * pi) {
+                    a -= 2 * pi;
+                }
+                z += std::min(1.0f, a / sweepAng) * (p2.z - p1.z);
             }
-            cupCirc.Rotate();
+            out[x - xs] = std::min(out[x - xs], z + toolHeight(dist * dist));
         }
     }
 }
@@ -790,6 +1156,21 @@ float cSimTool::GetToolProfileAt(
     return it != m_toolShape.end() ? it->heightPos : 0.0f;
 }
 
+const std::vector<float>& cSimTool::GetProfileTable(float res)
+{
+    if (m_profileTable.empty() || m_profileRes != res) {
+        float rad = radius / res;
+        int size = (int)(rad * rad * SIM_PROFILE_STEPS) + 2;
+        m_profileTable.resize(size);
+        for (int i = 0; i < size; i++) {
+            float dist = sqrtf((float)i / SIM_PROFILE_STEPS);
+            m_profileTable[i] = GetToolProfileAt(rad > 0 ? std::min(1.0f, dist / rad) : 0.0f);
+        }
+        m_profileRes = res;
+    }
+    return m_profileTable;
+}
+
 bool cSimTool::isInside(const TopoDS_Shape& toolShape, Base::Vector3d pnt, float res)
 {
     bool checkFace = true;
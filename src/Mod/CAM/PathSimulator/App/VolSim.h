@@ -38,6 +38,8 @@
 #define SIM_TESSEL_BOT 2
 #define SIM_WALK_RES                                                                               \
     0.6  // step size in pixel units (to make sure all pixels in the path are visited)
+#define SIM_TILE_SIZE 64     // edge length of a stock tile in pixels
+#define SIM_PROFILE_STEPS 4  // samples of the tool profile per squared pixel
 
 struct toolShapePoint
 {
@@ -180,44 +182,113 @@ public:
 
     float GetToolProfileAt(float pos);
     bool isInside(const TopoDS_Shape& toolShape, Base::Vector3d pnt, float res);
+    /* Returns the tool profile over the squared distance from the tool axis, sampled
+       SIM_PROFILE_STEPS times per squared pixel of a stock with resolution res */
+    const std::vector<float>& GetProfileTable(float res);
 
     /* m_toolShape has to be populated with linearly increased
        radiusPos to get the tool profile at given position */
     std::vector<toolShapePoint> m_toolShape;
     float radius;
     float length;
+
+private:
+    std::vector<float> m_profileTable;
+    float m_profileRes {0};
 };
 
+/* A 2D array that is split into square tiles of SIM_TILE_SIZE x SIM_TILE_SIZE
+   elements. The tiles are stored one after another and the elements of a tile
+   row by row, so that every tile can be processed on its own and a row of a
+   tile is contiguous in memory. */
 template<class T>
-class Array2D
+class TiledArray2D
 {
 public:
-    Array2D()
-        : data(nullptr)
-        , height(0)
-    {}
+    void Init(int x, int y, T value)
+    {
+        tilesX = (x + SIM_TILE_SIZE - 1) / SIM_TILE_SIZE;
+        tilesY = (y + SIM_TILE_SIZE - 1) / SIM_TILE_SIZE;
+        data.assign(static_cast<size_t>(tilesX) * tilesY * SIM_TILE_SIZE * SIM_TILE_SIZE, value);
+    }
 
-    ~Array2D()
+    T& operator()(int x, int y)
     {
-        if (data) {
-            delete[] data;
-        }
+        return TileRow(x / SIM_TILE_SIZE, y / SIM_TILE_SIZE, y)[x % SIM_TILE_SIZE];
     }
 
-    void Init(int x, int y)
+    // Returns the first element of row y in the tile tx, ty
+    T* TileRow(int tx, int ty, int y)
     {
-        data = new T[x * y];
-        height = y;
+        size_t tile = static_cast<size_t>(ty) * tilesX + tx;
+        return &data[(tile * SIM_TILE_SIZE + y % SIM_TILE_SIZE) * SIM_TILE_SIZE];
     }
 
-    T* operator[](int i)
+    int TilesX() const
     {
-        return data + i * height;
+        return tilesX;
+    }
+
+    int TilesY() const
+    {
+        return tilesY;
     }
 
 private:
-    T* data;
-    int height;
+    std::vector<T> data;
+    int tilesX {0};
+    int tilesY {0};
+};
+
+/* The area swept by the tool along a single linear or circular move in stock
+   pixel coordinates. For every pixel it yields the lowest height of the tool
+   over that pixel. */
+struct cSweep
+{
+    cSweep()
+        : isArc(false)
+        , isCCW(false)
+        , arcRad(0)
+        , startAng(0)
+        , sweepAng(0)
+        , fromX(0)
+        , fromY(0)
+        , toX(0)
+        , toY(0)
+        , rad(0)
+        , profile(nullptr)
+        , xmin(0)
+        , ymin(0)
+        , xmax(0)
+        , ymax(0)
+    {}
+    // Writes the tool heights of the pixels xs..xe-1 of row y to out
+    void GetHeights(int y, int xs, int xe, float* out) const;
+    bool IsEmpty() const
+    {
+        return xmin >= xmax || ymin >= ymax;
+    }
+
+    bool isArc;
+    bool isCCW;
+    Point3D p1, p2;  // start and end of the tool tip
+    Point3D cent;    // center of the arc
+    float arcRad;    // radius of the arc
+    float startAng;  // angle of p1 around the center
+    float sweepAng;  // absolute angle of the arc
+    float fromX, fromY, toX, toY;  // directions that enclose the arc counter-clockwise
+    float rad;       // tool radius
+    const float* profile;
+    int xmin, ymin, xmax, ymax;  // bounding rectangle of the swept pixels
+};
+
+/* What a single move did to the stock, see cStock::VerifySweeps() */
+struct cSweepReport
+{
+    double removed {0};  // removed volume
+    float maxCut {0};    // deepest cut into the stock
+    float gouge {0};     // deepest cut into the model
+    Point3D gougePos;    // tool tip position of the deepest cut into the model
 };
 
 class cStock
@@ -229,33 +300,69 @@ public:
     void CreatePocket(float x, float y, float rad, float height);
     void ApplyLinearTool(Point3D& p1, Point3D& p2, cSimTool& tool);
     void ApplyCircularTool(Point3D& p1, Point3D& p2, Point3D& cent, cSimTool& tool, bool isCCW);
+    cSweep LinearSweep(Point3D& p1, Point3D& p2, cSimTool& tool);
+    cSweep CircularSweep(Point3D& p1, Point3D& p2, Point3D& cent, cSimTool& tool, bool isCCW);
+    /* Removes the material of all moves at once. Since the result doesn't depend on
+       the order of the moves the tiles are processed concurrently, each one with
+       all the moves that overlap it. */
+    void ApplySweeps(const std::vector<cSweep>& sweeps);
+    /* Sets the part that is machined out of the stock by its triangulation. The moves
+       passed to VerifySweeps() are checked against the upper surface of the part. */
+    void SetModel(const std::vector<Triangle3D>& triangles);
+    /* Removes the material like ApplySweeps() and reports for every move how much
+       material it removed and how deep it cut into the model. Every tile sees its
+       moves in the order of the program, so the tiles still run concurrently. */
+    std::vector<cSweepReport> VerifySweeps(const std::vector<cSweep>& sweeps);
+    double GetVolume();
+    float GetResolution() const
+    {
+        return m_res;
+    }
     inline Point3D ToInner(Point3D& p)
     {
         return Point3D((p.x - m_px) / m_res, (p.y - m_py) / m_res, p.z);
     }
 
 private:
-    float FindRectTop(int& xp, int& yp, int& x_size, int& y_size, bool scanHoriz);
-    void FindRectBot(int& xp, int& yp, int& x_size, int& y_size, bool scanHoriz);
+    /* The facets of a tile are kept until the tile is modified, so that only the
+       modified tiles have to be tessellated again */
+    struct cTile
+    {
+        int x0, y0, x1, y1;  // pixel range of the tile
+        bool dirty;
+        std::vector<MeshCore::MeshGeomFacet> facetsOuter;
+        std::vector<MeshCore::MeshGeomFacet> facetsInner;
+    };
+
+    float
+    FindRectTop(const cTile& tile, int& xp, int& yp, int& x_size, int& y_size, bool scanHoriz);
+    void FindRectBot(const cTile& tile, int& xp, int& yp, int& x_size, int& y_size, bool scanHoriz);
     void SetFacetPoints(MeshCore::MeshGeomFacet& facet, Point3D& p1, Point3D& p2, Point3D& p3);
     void AddQuad(Point3D& p1,
                  Point3D& p2,
                  Point3D& p3,
                  Point3D& p4,
                  std::vector<MeshCore::MeshGeomFacet>& facets);
-    int TesselTop(int x, int y);
-    int TesselBot(int x, int y);
-    int TesselSidesX(int yp);
-    int TesselSidesY(int xp);
-    Array2D<float> m_stock;
-    Array2D<char> m_attr;
+    int TesselTop(cTile& tile, int x, int y);
+    int TesselBot(cTile& tile, int x, int y);
+    int TesselSidesX(cTile& tile, int yp);
+    int TesselSidesY(cTile& tile, int xp);
+    void TessellateTile(cTile& tile);
+    void StampTile(int tx, int ty, const cSweep& sweep);
+    void VerifyTile(int tx, int ty, const cSweep& sweep, cSweepReport& report);
+    void RasterizeTile(int tx, int ty, const Triangle3D& tri);
+    void SetDirty(int xs, int ys, int xe, int ye);
+    // Returns the indices of the moves that overlap each tile in their original order
+    std::vector<std::vector<int>> SortToTiles(const std::vector<cSweep>& sweeps);
+    TiledArray2D<float> m_stock;
+    TiledArray2D<char> m_attr;
+    TiledArray2D<float> m_model;  // upper surface of the model, empty without a model
+    std::vector<cTile> m_tiles;
     float m_px, m_py, m_pz;  // stock zero position
     float m_lx, m_ly, m_lz;  // stock dimensions
     float m_res;             // resoulution
     float m_plane;           // stock plane height
     int m_x, m_y;            // stock array size
-    std::vector<MeshCore::MeshGeomFacet> facetsOuter;
-    std::vector<MeshCore::MeshGeomFacet> facetsInner;
 };
 
 class cVolSim
@@ -33,3 +33,4 @@ from CAMTests.TestPathToolDocumentObjectEditorWidget import TestDocumentObjectEd
 from CAMTests.TestPathToolBitBrowserWidget import TestToolBitBrowserWidget
 from CAMTests.TestPathToolBitEditorWidget import TestToolBitPropertiesWidget
 from CAMTests.TestPathToolBitListWidget import TestToolBitListWidget
+from CAMTests.TestPathViewProvider import TestPathViewProvider
@@ -210,6 +210,7 @@ private:
 
         int exportAmfCompressed(hGrp->GetBool("ExportAmfCompressed", true));
         bool export3mfModel(hGrp->GetBool("Export3mfModel", true));
+        bool exportParallel(hGrp->GetBool("ExportInParallel", true));
 
         static const std::array<const char*, 5> kwList {"objectList",
                                                         "filename",
@@ -271,6 +272,9 @@ private:
                                                      Extension3MFFactory::createExtensions());
             dynamic_cast<Exporter3MF*>(exporter.get())->setForceModel(export3mfModel);
         }
+        else if (exportFormat == MeshIO::BSTL || exportFormat == MeshIO::ASTL) {
+            exporter = std::make_unique<ExporterSTL>(outputFileName, exportFormat);
+        }
         else if (exportFormat != MeshIO::Undefined) {
             exporter = std::make_unique<MergeExporter>(outputFileName, exportFormat);
         }
@@ -281,9 +285,8 @@ private:
             throw Py::ValueError(exStr.c_str());
         }
 
-        for (auto it : objectList) {
-            exporter->addObject(it, fTolerance);
-        }
+        exporter->setParallel(exportParallel);
+        exporter->addObjects(objectList, fTolerance);
 
         exporter.reset();  // deletes Exporter, mesh file is written by destructor
 
@@ -25,6 +25,7 @@
 
 #include <algorithm>
 #include <limits>
+#include <numeric>
 
 #include <Base/Console.h>
 #include <Base/Sequencer.h>
@@ -32,6 +33,7 @@
 #include "Algorithm.h"
 #include "Approximation.h"
 #include "Elements.h"
+#include "Functional.h"
 #include "Grid.h"
 #include "Iterator.h"
 #include "Triangulation.h"
@@ -669,6 +671,22 @@ bool MeshAlgorithm::FillupHole(const std::vector<PointIndex>& boundary,
                                MeshPointArray& rPoints,
                                int level,
                                const MeshRefPointToFacets* pP2FStructure) const
+{
+    if (!pP2FStructure) {
+        const MeshCompactPointToFacets* compact = nullptr;
+        return FillupHole(boundary, cTria, rFaces, rPoints, level, compact);
+    }
+
+    MeshCompactPointToFacets compact(_rclMesh);
+    return FillupHole(boundary, cTria, rFaces, rPoints, level, &compact);
+}
+
+bool MeshAlgorithm::FillupHole(const std::vector<PointIndex>& boundary,
+                               AbstractPolygonTriangulator& cTria,
+                               MeshFacetArray& rFaces,
+                               MeshPointArray& rPoints,
+                               int level,
+                               const MeshCompactPointToFacets* pP2FStructure) const
 {
     if (boundary.front() == boundary.back()) {
         // first and last vertex are identical
@@ -686,8 +704,8 @@ bool MeshAlgorithm::FillupHole(const std::vector<PointIndex>& boundary,
     PointIndex refPoint0 = *(boundary.begin());
     PointIndex refPoint1 = *(boundary.begin() + 1);
     if (pP2FStructure) {
-        const std::set<FacetIndex>& ring1 = (*pP2FStructure)[refPoint0];
-        const std::set<FacetIndex>& ring2 = (*pP2FStructure)[refPoint1];
+        auto ring1 = (*pP2FStructure)[refPoint0];
+        auto ring2 = (*pP2FStructure)[refPoint1];
         std::vector<FacetIndex> f_int;
         std::set_intersection(ring1.begin(),
                               ring1.end(),
@@ -1830,29 +1848,18 @@ float MeshAlgorithm::CalculateMinimumGridLength(float fLength,
 
 // ----------------------------------------------------
 
-void MeshRefPointToFacets::Rebuild()
+namespace
 {
-    _map.clear();
+// The helpers below implement the queries shared by the set-based and the compact adjacency
+// structures. Both return the sorted neighbour indices of an element with operator[].
 
-    const MeshPointArray& rPoints = _rclMesh.GetPoints();
-    const MeshFacetArray& rFacets = _rclMesh.GetFacets();
-    _map.resize(rPoints.size());
-
-    auto pFBegin = rFacets.begin();
-    for (auto pFIter = rFacets.begin(); pFIter != rFacets.end(); ++pFIter) {
-        _map[pFIter->_aulPoints[0]].insert(pFIter - pFBegin);
-        _map[pFIter->_aulPoints[1]].insert(pFIter - pFBegin);
-        _map[pFIter->_aulPoints[2]].insert(pFIter - pFBegin);
-    }
-}
-
-Base::Vector3f MeshRefPointToFacets::GetNormal(PointIndex pos) const
+template<class PointToFacets>
+Base::Vector3f pointNormal(const MeshKernel& mesh, const PointToFacets& map, PointIndex pos)
 {
-    const std::set<FacetIndex>& n = _map[pos];
     Base::Vector3f normal;
     MeshGeomFacet f;
-    for (FacetIndex it : n) {
-        f = _rclMesh.GetFacet(it);
+    for (FacetIndex it : map[pos]) {
+        f = mesh.GetFacet(it);
         normal += f.Area() * f.GetNormal();
     }
 
@@ -1860,18 +1867,20 @@ Base::Vector3f MeshRefPointToFacets::GetNormal(PointIndex pos) const
     return normal;
 }
 
-std::set<PointIndex> MeshRefPointToFacets::NeighbourPoints(const std::vector<PointIndex>& pt,
-                                                           int level) const
+template<class PointToFacets>
+std::set<PointIndex> neighbourPoints(const MeshKernel& mesh,
+                                     const PointToFacets& map,
+                                     const std::vector<PointIndex>& pt,
+                                     int level)
 {
     std::set<PointIndex> cp, nb, lp;
     cp.insert(pt.begin(), pt.end());
     lp.insert(pt.begin(), pt.end());
-    auto f_it = _rclMesh.GetFacets().begin();
+    auto f_it = mesh.GetFacets().begin();
     for (int i = 0; i < level; i++) {
         std::set<PointIndex> cur;
         for (PointIndex it : lp) {
-            const std::set<FacetIndex>& ft = (*this)[it];
-            for (FacetIndex jt : ft) {
+            for (FacetIndex jt : map[it]) {
                 for (PointIndex index : f_it[jt]._aulPoints) {
                     if (cp.find(index) == cp.end() && nb.find(index) == nb.end()) {
                         nb.insert(index);
@@ -1889,13 +1898,14 @@ std::set<PointIndex> MeshRefPointToFacets::NeighbourPoints(const std::vector<Poi
     return nb;
 }
 
-std::set<PointIndex> MeshRefPointToFacets::NeighbourPoints(PointIndex pos) const
+template<class PointToFacets>
+std::set<PointIndex>
+neighbourPoints(const MeshKernel& mesh, const PointToFacets& map, PointIndex pos)
 {
     std::set<PointIndex> p;
-    const std::set<FacetIndex>& vf = _map[pos];
-    for (FacetIndex it : vf) {
+    for (FacetIndex it : map[pos]) {
         PointIndex p1 {}, p2 {}, p3 {};
-        _rclMesh.GetFacetPoints(it, p1, p2, p3);
+        mesh.GetFacetPoints(it, p1, p2, p3);
         if (p1 != pos) {
             p.insert(p1);
         }
@@ -1910,44 +1920,140 @@ std::set<PointIndex> MeshRefPointToFacets::NeighbourPoints(PointIndex pos) const
     return p;
 }
 
-void MeshRefPointToFacets::Neighbours(FacetIndex ulFacetInd,
-                                      float fMaxDist,
-                                      MeshCollector& collect) const
-{
-    std::set<FacetIndex> visited;
-    Base::Vector3f clCenter = _rclMesh.GetFacet(ulFacetInd).GetGravityPoint();
-
-    const MeshFacetArray& rFacets = _rclMesh.GetFacets();
-    SearchNeighbours(rFacets, ulFacetInd, clCenter, fMaxDist * fMaxDist, visited, collect);
-}
-
-void MeshRefPointToFacets::SearchNeighbours(const MeshFacetArray& rFacets,
-                                            FacetIndex index,
-                                            const Base::Vector3f& rclCenter,
-                                            float fMaxDist2,
-                                            std::set<FacetIndex>& visited,
-                                            MeshCollector& collect) const
+template<class PointToFacets>
+void searchNeighbours(const MeshKernel& mesh,
+                      const PointToFacets& map,
+                      FacetIndex index,
+                      const Base::Vector3f& rclCenter,
+                      float fMaxDist2,
+                      std::set<FacetIndex>& visited,
+                      MeshCollector& collect)
 {
     if (visited.find(index) != visited.end()) {
         return;
     }
 
-    const MeshFacet& face = rFacets[index];
-    if (Base::DistanceP2(rclCenter, _rclMesh.GetFacet(face).GetGravityPoint()) > fMaxDist2) {
+    const MeshFacet& face = mesh.GetFacets()[index];
+    if (Base::DistanceP2(rclCenter, mesh.GetFacet(face).GetGravityPoint()) > fMaxDist2) {
         return;
     }
 
     visited.insert(index);
-    collect.Append(_rclMesh, index);
+    collect.Append(mesh, index);
     for (PointIndex ptIndex : face._aulPoints) {
-        const std::set<FacetIndex>& f = (*this)[ptIndex];
-
-        for (FacetIndex j : f) {
-            SearchNeighbours(rFacets, j, rclCenter, fMaxDist2, visited, collect);
+        for (FacetIndex j : map[ptIndex]) {
+            searchNeighbours(mesh, map, j, rclCenter, fMaxDist2, visited, collect);
         }
     }
 }
 
+template<class PointToFacets>
+void neighbours(const MeshKernel& mesh,
+                const PointToFacets& map,
+                FacetIndex ulFacetInd,
+                float fMaxDist,
+                MeshCollector& collect)
+{
+    std::set<FacetIndex> visited;
+    Base::Vector3f clCenter = mesh.GetFacet(ulFacetInd).GetGravityPoint();
+    searchNeighbours(mesh, map, ulFacetInd, clCenter, fMaxDist * fMaxDist, visited, collect);
+}
+
+template<class Map>
+std::vector<FacetIndex> commonIndices(const Map& map, ElementIndex pos1, ElementIndex pos2)
+{
+    std::vector<FacetIndex> intersection;
+    std::back_insert_iterator<std::vector<FacetIndex>> result(intersection);
+    const auto& set1 = map[pos1];
+    const auto& set2 = map[pos2];
+    std::set_intersection(set1.begin(), set1.end(), set2.begin(), set2.end(), result);
+    return intersection;
+}
+
+template<class Map>
+std::vector<FacetIndex>
+commonIndices(const Map& map, ElementIndex pos1, ElementIndex pos2, ElementIndex pos3)
+{
+    std::vector<FacetIndex> intersection;
+    std::back_insert_iterator<std::vector<FacetIndex>> result(intersection);
+    std::vector<FacetIndex> set1 = commonIndices(map, pos1, pos2);
+    const auto& set2 = map[pos3];
+    std::set_intersection(set1.begin(), set1.end(), set2.begin(), set2.end(), result);
+    return intersection;
+}
+
+template<class PointToPoints>
+Base::Vector3f planeNormal(const MeshKernel& mesh, const PointToPoints& map, PointIndex pos)
+{
+    const MeshPointArray& rPoints = mesh.GetPoints();
+    MeshCore::PlaneFit pf;
+    pf.AddPoint(rPoints[pos]);
+    MeshCore::MeshPoint center = rPoints[pos];
+    for (PointIndex cv_it : map[pos]) {
+        pf.AddPoint(rPoints[cv_it]);
+        center += rPoints[cv_it];
+    }
+
+    pf.Fit();
+
+    Base::Vector3f normal = pf.GetNormal();
+    normal.Normalize();
+    return normal;
+}
+
+template<class PointToPoints>
+float averageEdgeLength(const MeshKernel& mesh, const PointToPoints& map, PointIndex index)
+{
+    const MeshPointArray& rPoints = mesh.GetPoints();
+    float len = 0.0F;
+    const auto& n = map[index];
+    const Base::Vector3f& p = rPoints[index];
+    for (PointIndex it : n) {
+        len += Base::Distance(p, rPoints[it]);
+    }
+    return (len / n.size());
+}
+}  // namespace
+
+void MeshRefPointToFacets::Rebuild()
+{
+    _map.clear();
+
+    const MeshPointArray& rPoints = _rclMesh.GetPoints();
+    const MeshFacetArray& rFacets = _rclMesh.GetFacets();
+    _map.resize(rPoints.size());
+
+    auto pFBegin = rFacets.begin();
+    for (auto pFIter = rFacets.begin(); pFIter != rFacets.end(); ++pFIter) {
+        _map[pFIter->_aulPoints[0]].insert(pFIter - pFBegin);
+        _map[pFIter->_aulPoints[1]].insert(pFIter - pFBegin);
+        _map[pFIter->_aulPoints[2]].insert(pFIter - pFBegin);
+    }
+}
+
+Base::Vector3f MeshRefPointToFacets::GetNormal(PointIndex pos) const
+{
+    return pointNormal(_rclMesh, *this, pos);
+}
+
+std::set<PointIndex> MeshRefPointToFacets::NeighbourPoints(const std::vector<PointIndex>& pt,
+                                                           int level) const
+{
+    return neighbourPoints(_rclMesh, *this, pt, level);
+}
+
+std::set<PointIndex> MeshRefPointToFacets::NeighbourPoints(PointIndex pos) const
+{
+    return neighbourPoints(_rclMesh, *this, pos);
+}
+
+void MeshRefPointToFacets::Neighbours(FacetIndex ulFacetInd,
+                                      float fMaxDist,
+                                      MeshCollector& collect) const
+{
+    neighbours(_rclMesh, *this, ulFacetInd, fMaxDist, collect);
+}
+
 MeshFacetArray::_TConstIterator MeshRefPointToFacets::GetFacet(FacetIndex index) const
 {
     return _rclMesh.GetFacets().begin() + index;
@@ -1960,23 +2066,13 @@ const std::set<FacetIndex>& MeshRefPointToFacets::operator[](PointIndex pos) con
 
 std::vector<FacetIndex> MeshRefPointToFacets::GetIndices(PointIndex pos1, PointIndex pos2) const
 {
-    std::vector<FacetIndex> intersection;
-    std::back_insert_iterator<std::vector<FacetIndex>> result(intersection);
-    const std::set<FacetIndex>& set1 = _map[pos1];
-    const std::set<FacetIndex>& set2 = _map[pos2];
-    std::set_intersection(set1.begin(), set1.end(), set2.begin(), set2.end(), result);
-    return intersection;
+    return commonIndices(*this, pos1, pos2);
 }
 
 std::vector<FacetIndex>
 MeshRefPointToFacets::GetIndices(PointIndex pos1, PointIndex pos2, PointIndex pos3) const
 {
-    std::vector<FacetIndex> intersection;
-    std::back_insert_iterator<std::vector<FacetIndex>> result(intersection);
-    std::vector<FacetIndex> set1 = GetIndices(pos1, pos2);
-    const std::set<FacetIndex>& set2 = _map[pos3];
-    std::set_intersection(set1.begin(), set1.end(), set2.begin(), set2.end(), result);
-    return intersection;
+    return commonIndices(*this, pos1, pos2, pos3);
 }
 
 void MeshRefPointToFacets::AddNeighbour(PointIndex pos, FacetIndex facet)
@@ -2027,12 +2123,7 @@ const std::set<FacetIndex>& MeshRefFacetToFacets::operator[](FacetIndex pos) con
 
 std::vector<FacetIndex> MeshRefFacetToFacets::GetIndices(FacetIndex pos1, FacetIndex pos2) const
 {
-    std::vector<FacetIndex> intersection;
-    std::back_insert_iterator<std::vector<FacetIndex>> result(intersection);
-    const std::set<FacetIndex>& set1 = _map[pos1];
-    const std::set<FacetIndex>& set2 = _map[pos2];
-    std::set_intersection(set1.begin(), set1.end(), set2.begin(), set2.end(), result);
-    return intersection;
+    return commonIndices(*this, pos1, pos2);
 }
 
 //----------------------------------------------------------------------------
@@ -2061,33 +2152,12 @@ void MeshRefPointToPoints::Rebuild()
 
 Base::Vector3f MeshRefPointToPoints::GetNormal(PointIndex pos) const
 {
-    const MeshPointArray& rPoints = _rclMesh.GetPoints();
-    MeshCore::PlaneFit pf;
-    pf.AddPoint(rPoints[pos]);
-    MeshCore::MeshPoint center = rPoints[pos];
-    const std::set<PointIndex>& cv = _map[pos];
-    for (PointIndex cv_it : cv) {
-        pf.AddPoint(rPoints[cv_it]);
-        center += rPoints[cv_it];
-    }
-
-    pf.Fit();
-
-    Base::Vector3f normal = pf.GetNormal();
-    normal.Normalize();
-    return normal;
+    return planeNormal(_rclMesh, *this, pos);
 }
 
 float MeshRefPointToPoints::GetAverageEdgeLength(PointIndex index) const
 {
-    const MeshPointArray& rPoints = _rclMesh.GetPoints();
-    float len = 0.0F;
-    const std::set<PointIndex>& n = (*this)[index];
-    const Base::Vector3f& p = rPoints[index];
-    for (PointIndex it : n) {
-        len += Base::Distance(p, rPoints[it]);
-    }
-    return (len / n.size());
+    return averageEdgeLength(_rclMesh, *this, index);
 }
 
 const std::set<PointIndex>& MeshRefPointToPoints::operator[](PointIndex pos) const
@@ -2107,6 +2177,207 @@ void MeshRefPointToPoints::RemoveNeighbour(PointIndex pos, PointIndex facet)
 
 //----------------------------------------------------------------------------
 
+void MeshCompactPointToFacets::Rebuild()
+{
+    const MeshPointArray& rPoints = _rclMesh.GetPoints();
+    const MeshFacetArray& rFacets = _rclMesh.GetFacets();
+
+    // a degenerated facet may reference a point more than once but is listed only once
+    auto isRepeated = [](const MeshFacet& rFacet, int i) {
+        const auto& pnts = rFacet._aulPoints;
+        return (i > 0 && pnts[i] == pnts[0]) || (i > 1 && pnts[i] == pnts[1]);
+    };
+
+    _offsets.assign(rPoints.size() + 1, 0);
+    for (const auto& rFacet : rFacets) {
+        for (int i = 0; i < 3; i++) {
+            if (!isRepeated(rFacet, i)) {
+                _offsets[rFacet._aulPoints[i] + 1]++;
+            }
+        }
+    }
+    std::partial_sum(_offsets.begin(), _offsets.end(), _offsets.begin());
+
+    // the facets are visited in ascending order so that each row is sorted
+    _indices.resize(_offsets.back());
+    std::vector<std::size_t> fill(_offsets.begin(), _offsets.end() - 1);
+    FacetIndex index = 0;
+    for (auto it = rFacets.begin(); it != rFacets.end(); ++it, ++index) {
+        for (int i = 0; i < 3; i++) {
+            if (!isRepeated(*it, i)) {
+                _indices[fill[it->_aulPoints[i]]++] = index;
+            }
+        }
+    }
+}
+
+Base::Vector3f MeshCompactPointToFacets::GetNormal(PointIndex pos) const
+{
+    return pointNormal(_rclMesh, *this, pos);
+}
+
+std::set<PointIndex> MeshCompactPointToFacets::NeighbourPoints(const std::vector<PointIndex>& pt,
+                                                               int level) const
+{
+    return neighbourPoints(_rclMesh, *this, pt, level);
+}
+
+std::set<PointIndex> MeshCompactPointToFacets::NeighbourPoints(PointIndex pos) const
+{
+    return neighbourPoints(_rclMesh, *this, pos);
+}
+
+void MeshCompactPointToFacets::Neighbours(FacetIndex ulFacetInd,
+                                          float fMaxDist,
+                                          MeshCollector& collect) const
+{
+    neighbours(_rclMesh, *this, ulFacetInd, fMaxDist, collect);
+}
+
+MeshFacetArray::_TConstIterator MeshCompactPointToFacets::GetFacet(FacetIndex index) const
+{
+    return _rclMesh.GetFacets().begin() + index;
+}
+
+std::vector<FacetIndex> MeshCompactPointToFacets::GetIndices(PointIndex pos1,
+                                                             PointIndex pos2) const
+{
+    return commonIndices(*this, pos1, pos2);
+}
+
+std::vector<FacetIndex>
+MeshCompactPointToFacets::GetIndices(PointIndex pos1, PointIndex pos2, PointIndex pos3) const
+{
+    return commonIndices(*this, pos1, pos2, pos3);
+}
+
+//----------------------------------------------------------------------------
+
+void MeshCompactFacetToFacets::Rebuild()
+{
+    const MeshFacetArray& rFacets = _rclMesh.GetFacets();
+    std::size_t countFacets = rFacets.size();
+    int threads = thread_count(_threads);
+
+    MeshCompactPointToFacets vertexFace(_rclMesh);
+    auto collectFacets = [&](std::size_t index, std::vector<FacetIndex>& faces) {
+        faces.clear();
+        for (PointIndex ptIndex : rFacets[index]._aulPoints) {
+            auto row = vertexFace[ptIndex];
+            faces.insert(faces.end(), row.begin(), row.end());
+        }
+        std::sort(faces.begin(), faces.end());
+        faces.erase(std::unique(faces.begin(), faces.end()), faces.end());
+    };
+
+    // the first pass counts the facets of each row, the second pass fills the rows
+    _offsets.assign(countFacets + 1, 0);
+    parallel_for(
+        countFacets,
+        [&](std::size_t begin, std::size_t end) {
+            std::vector<FacetIndex> faces;
+            for (std::size_t index = begin; index < end; index++) {
+                collectFacets(index, faces);
+                _offsets[index + 1] = faces.size();
+            }
+        },
+        threads);
+    std::partial_sum(_offsets.begin(), _offsets.end(), _offsets.begin());
+
+    _indices.resize(_offsets.back());
+    parallel_for(
+        countFacets,
+        [&](std::size_t begin, std::size_t end) {
+            std::vector<FacetIndex> faces;
+            for (std::size_t index = begin; index < end; index++) {
+                collectFacets(index, faces);
+                std::copy(faces.begin(),
+                          faces.end(),
+                          _indices.begin() + static_cast<std::ptrdiff_t>(_offsets[index]));
+            }
+        },
+        threads);
+}
+
+std::vector<FacetIndex> MeshCompactFacetToFacets::GetIndices(FacetIndex pos1,
+                                                             FacetIndex pos2) const
+{
+    return commonIndices(*this, pos1, pos2);
+}
+
+//----------------------------------------------------------------------------
+
+void MeshCompactPointToPoints::Rebuild()
+{
+    const MeshPointArray& rPoints = _rclMesh.GetPoints();
+    const MeshFacetArray& rFacets = _rclMesh.GetFacets();
+    std::size_t countPoints = rPoints.size();
+
+    // each corner of a facet adds its two other points to the neighbours of the corner point
+    _offsets.assign(countPoints + 1, 0);
+    for (const auto& rFacet : rFacets) {
+        for (PointIndex ulP : rFacet._aulPoints) {
+            _offsets[ulP + 1] += 2;
+        }
+    }
+    std::partial_sum(_offsets.begin(), _offsets.end(), _offsets.begin());
+
+    _indices.resize(_offsets.back());
+    std::vector<std::size_t> fill(_offsets.begin(), _offsets.end() - 1);
+    for (const auto& rFacet : rFacets) {
+        PointIndex ulP0 = rFacet._aulPoints[0];
+        PointIndex ulP1 = rFacet._aulPoints[1];
+        PointIndex ulP2 = rFacet._aulPoints[2];
+
+        _indices[fill[ulP0]++] = ulP1;
+        _indices[fill[ulP0]++] = ulP2;
+        _indices[fill[ulP1]++] = ulP0;
+        _indices[fill[ulP1]++] = ulP2;
+        _indices[fill[ulP2]++] = ulP0;
+        _indices[fill[ulP2]++] = ulP1;
+    }
+
+    // sort the neighbours of each point and remove the duplicates of the shared edges
+    std::vector<std::size_t>& counts = fill;
+    parallel_for(
+        countPoints,
+        [&](std::size_t begin, std::size_t end) {
+            for (std::size_t pos = begin; pos < end; pos++) {
+                auto first = _indices.begin() + static_cast<std::ptrdiff_t>(_offsets[pos]);
+                auto last = _indices.begin() + static_cast<std::ptrdiff_t>(_offsets[pos + 1]);
+                std::sort(first, last);
+                counts[pos] = static_cast<std::size_t>(std::unique(first, last) - first);
+            }
+        },
+        thread_count(_threads));
+
+    // close the gaps left by the duplicates
+    std::size_t size = 0;
+    for (std::size_t pos = 0; pos < countPoints; pos++) {
+        std::size_t start = _offsets[pos];
+        _offsets[pos] = size;
+        std::copy_n(_indices.begin() + static_cast<std::ptrdiff_t>(start),
+                    counts[pos],
+                    _indices.begin() + static_cast<std::ptrdiff_t>(size));
+        size += counts[pos];
+    }
+    _offsets[countPoints] = size;
+    _indices.resize(size);
+    _indices.shrink_to_fit();
+}
+
+Base::Vector3f MeshCompactPointToPoints::GetNormal(PointIndex pos) const
+{
+    return planeNormal(_rclMesh, *this, pos);
+}
+
+float MeshCompactPointToPoints::GetAverageEdgeLength(PointIndex index) const
+{
+    return averageEdgeLength(_rclMesh, *this, index);
+}
+
+//----------------------------------------------------------------------------
+
 void MeshRefEdgeToFacets::Rebuild()
 {
     _map.clear();
@@ -27,6 +27,7 @@
 
 #include <map>
 #include <set>
+#include <span>
 #include <vector>
 
 #include "Elements.h"
@@ -49,6 +50,7 @@ class MeshGeomEdge;
 class MeshKernel;
 class MeshFacetGrid;
 class MeshFacetArray;
+class MeshCompactPointToFacets;
 class MeshRefPointToFacets;
 class AbstractPolygonTriangulator;
 
@@ -219,7 +221,16 @@ public:
                     MeshFacetArray& rFaces,
                     MeshPointArray& rPoints,
                     int level,
-                    const MeshRefPointToFacets* pP2FStructure = nullptr) const;
+                    const MeshCompactPointToFacets* pP2FStructure = nullptr) const;
+    /** This is an overloaded method kept for compatibility. A compact point-to-facets
+     * structure is built from the mesh if \a pP2FStructure is not null.
+     */
+    bool FillupHole(const std::vector<PointIndex>& boundary,
+                    AbstractPolygonTriangulator& cTria,
+                    MeshFacetArray& rFaces,
+                    MeshPointArray& rPoints,
+                    int level,
+                    const MeshRefPointToFacets* pP2FStructure) const;
     /** Sets to all facets in \a raulInds the properties in raulProps.
      * \note Both arrays must have the same size.
      */
@@ -497,14 +508,6 @@ public:
     void RemoveNeighbour(PointIndex, FacetIndex);
     void RemoveFacet(FacetIndex);
 
-protected:
-    void SearchNeighbours(const MeshFacetArray& rFacets,
-                          FacetIndex index,
-                          const Base::Vector3f& rclCenter,
-                          float fMaxDist,
-                          std::set<FacetIndex>& visit,
-                          MeshCollector& collect) const;
-
 private:
     const MeshKernel& _rclMesh; /**< The mesh kernel. */
     std::vector<std::set<FacetIndex>> _map;
@@ -568,6 +571,133 @@ private:
     std::vector<std::set<PointIndex>> _map;
 };
 
+/**
+ * The MeshCompactPointToFacets is an immutable variant of MeshRefPointToFacets with the same
+ * query interface. The facets of all points are stored in one contiguous array (compressed sparse
+ * rows) which needs a fraction of the memory and is much faster to build and traverse. The facets
+ * of a point are sorted.
+ * \note If the underlying mesh kernel gets changed this structure becomes invalid and must
+ * be rebuilt.
+ */
+class MeshExport MeshCompactPointToFacets
+{
+public:
+    /// Construction
+    explicit MeshCompactPointToFacets(const MeshKernel& rclM)
+        : _rclMesh(rclM)
+    {
+        Rebuild();
+    }
+
+    /// Rebuilds up data structure
+    void Rebuild();
+    std::span<const FacetIndex> operator[](PointIndex pos) const
+    {
+        return {_indices.data() + _offsets[pos], _indices.data() + _offsets[pos + 1]};
+    }
+    std::vector<FacetIndex> GetIndices(PointIndex, PointIndex) const;
+    std::vector<FacetIndex> GetIndices(PointIndex, PointIndex, PointIndex) const;
+    MeshFacetArray::_TConstIterator GetFacet(FacetIndex) const;
+    std::set<PointIndex> NeighbourPoints(const std::vector<PointIndex>&, int level) const;
+    std::set<PointIndex> NeighbourPoints(PointIndex) const;
+    void Neighbours(FacetIndex ulFacetInd, float fMaxDist, MeshCollector& collect) const;
+    Base::Vector3f GetNormal(PointIndex) const;
+    /// Returns the number of points.
+    std::size_t size() const
+    {
+        return _offsets.size() - 1;
+    }
+
+private:
+    const MeshKernel& _rclMesh; /**< The mesh kernel. */
+    std::vector<std::size_t> _offsets;
+    std::vector<FacetIndex> _indices;
+};
+
+/**
+ * The MeshCompactFacetToFacets is an immutable variant of MeshRefFacetToFacets with the same
+ * query interface. It is built in parallel and stores the facets sharing a point with a facet
+ * in one contiguous array. The facets of a facet are sorted and include the facet itself.
+ * \note If the underlying mesh kernel gets changed this structure becomes invalid and must
+ * be rebuilt.
+ */
+class MeshExport MeshCompactFacetToFacets
+{
+public:
+    /// Construction
+    explicit MeshCompactFacetToFacets(const MeshKernel& rclM, int threads = 0)
+        : _rclMesh(rclM)
+        , _threads(threads)
+    {
+        Rebuild();
+    }
+
+    /// Rebuilds up data structure
+    void Rebuild();
+    /// Returns the facets sharing one or more points with the facet with index \a pos.
+    std::span<const FacetIndex> operator[](FacetIndex pos) const
+    {
+        return {_indices.data() + _offsets[pos], _indices.data() + _offsets[pos + 1]};
+    }
+    /// Returns an array of common facets of the passed facet indexes.
+    std::vector<FacetIndex> GetIndices(FacetIndex, FacetIndex) const;
+    /// Returns the number of facets.
+    std::size_t size() const
+    {
+        return _offsets.size() - 1;
+    }
+
+private:
+    const MeshKernel& _rclMesh; /**< The mesh kernel. */
+    int _threads;
+    std::vector<std::size_t> _offsets;
+    std::vector<FacetIndex> _indices;
+};
+
+/**
+ * The MeshCompactPointToPoints is an immutable variant of MeshRefPointToPoints. The neighbour
+ * points of all points are stored in one contiguous array (compressed sparse rows) which needs
+ * a fraction of the memory and is much faster to traverse. The neighbours of a point are sorted.
+ * \note If the underlying mesh kernel gets changed this structure becomes invalid and must
+ * be rebuilt.
+ */
+class MeshExport MeshCompactPointToPoints
+{
+public:
+    /// Construction
+    explicit MeshCompactPointToPoints(const MeshKernel& rclM, int threads = 0)
+        : _rclMesh(rclM)
+        , _threads(threads)
+    {
+        Rebuild();
+    }
+
+    /// Rebuilds up data structure
+    void Rebuild();
+    std::span<const PointIndex> operator[](PointIndex pos) const
+    {
+        return {_indices.data() + _offsets[pos], _indices.data() + _offsets[pos + 1]};
+    }
+    /// Returns the number of neighbours of the point with index \a pos.
+    std::size_t CountNeighbours(PointIndex pos) const
+    {
+        return _offsets[pos + 1] - _offsets[pos];
+    }
+    Base::Vector3f GetNormal(PointIndex) const;
+    float GetAverageEdgeLength(PointIndex) const;
+    /// Returns the number of points.
+    std::size_t size() const
+    {
+        return _offsets.size() - 1;
+    }
+
+private:
+    const MeshKernel& _rclMesh; /**< The mesh kernel. */
+    int _threads;
+    std::vector<std::size_t> _offsets;
+    std::vector<PointIndex> _indices;
+};
+
 /**
  * The MeshRefEdgeToFacets builds up a structure to have access to all facets
  * of an edge. On a manifold mesh an edge has one or two facets associated.
@@ -0,0 +1,479 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026 The FreeCAD Project Association AISBL               *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <future>
+#include <thread>
+
+#include <Base/Sequencer.h>
+
+#include "Analysis.h"
+#include "BVH.h"
+#include "Evaluation.h"
+#include "Functional.h"
+#include "MeshKernel.h"
+
+
+using namespace MeshCore;
+
+namespace
+{
+
+// Removes duplicates from the index list and brings it into ascending order
+template<class T>
+void makeUnique(std::vector<T>& items)
+{
+    std::sort(items.begin(), items.end());
+    items.erase(std::unique(items.begin(), items.end()), items.end());
+}
+
+// Collects the per-chunk results of a parallel loop in chunk order so that the
+// output does not depend on the number of threads
+template<class T, class Func>
+std::vector<T> collectParallel(std::size_t count, int threads, Func func)
+{
+    std::size_t numChunks = count < 1024 ? 1 : static_cast<std::size_t>(std::max(threads, 1));
+    std::vector<std::vector<T>> chunks(numChunks);
+    std::size_t chunkSize = (count + chunks.size() - 1) / chunks.size();
+    parallel_for(
+        chunks.size(),
+        [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++) {
+                std::size_t first = i * chunkSize;
+                std::size_t last = std::min(first + chunkSize, count);
+                for (std::size_t j = first; j < last; j++) {
+                    func(j, chunks[i]);
+                }
+            }
+        },
+        threads,
+        1);
+
+    std::vector<T> result;
+    for (const auto& it : chunks) {
+        result.insert(result.end(), it.begin(), it.end());
+    }
+    return result;
+}
+
+struct EdgeItem
+{
+    PointIndex p0;
+    PointIndex p1;
+
+    bool operator<(const EdgeItem& other) const
+    {
+        return (p0 != other.p0) ? p0 < other.p0 : p1 < other.p1;
+    }
+    bool operator!=(const EdgeItem& other) const
+    {
+        return p0 != other.p0 || p1 != other.p1;
+    }
+};
+
+}  // namespace
+
+// ----------------------------------------------------------------------------
+
+bool MeshDefectSummary::IsValid() const
+{
+    return CountDefects() == 0;
+}
+
+std::size_t MeshDefectSummary::CountDefects() const
+{
+    return invalidFacets.size() + nanPoints.size() + duplicatedPoints.size()
+        + duplicatedFacets.size() + degeneratedFacets.size() + nonManifoldEdges.size()
+        + nonManifoldPoints.size() + wrongOrientedFacets.size() + foldsOnSurface.size()
+        + selfIntersections.size();
+}
+
+// ----------------------------------------------------------------------------
+
+MeshAnalysis::MeshAnalysis(const MeshKernel& rclM)
+    : _rclMesh(rclM)
+    , epsilon(MeshDefinitions::_fMinPointDistanceD1)
+{}
+
+MeshAnalysis::~MeshAnalysis() = default;
+
+int MeshAnalysis::GetThreads() const
+{
+    if (threads > 0) {
+        return threads;
+    }
+    return std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+}
+
+MeshDefectSummary MeshAnalysis::Evaluate(MeshDefects which)
+{
+    MeshDefectSummary summary;
+    Base::SequencerLauncher seq("Analysing mesh...", 4);
+
+    // The index check must succeed first because all further checks rely on valid indices
+    if (which.testFlag(MeshDefect::InvalidIndices)) {
+        summary.invalidFacets = CheckInvalidIndices();
+        if (!summary.invalidFacets.empty()) {
+            return summary;
+        }
+    }
+    seq.next();
+
+    BuildFacetCache();
+    seq.next();
+
+    // Checks that only need the mesh arrays run concurrently to the per-facet checks
+    auto launch = [which](MeshDefect flag, auto func) {
+        using Result = decltype(func());
+        if (!which.testFlag(flag)) {
+            return std::future<Result>();
+        }
+        return std::async(std::launch::async, func);
+    };
+
+    auto duplicatedPoints = launch(MeshDefect::DuplicatedPoints, [this]() {
+        return CheckDuplicatedPoints();
+    });
+    auto duplicatedFacets = launch(MeshDefect::DuplicatedFacets, [this]() {
+        return CheckDuplicatedFacets();
+    });
+    auto nonManifoldEdges = launch(MeshDefect::NonManifoldEdges, [this]() {
+        return CheckNonManifoldEdges();
+    });
+    auto nonManifoldPoints = launch(MeshDefect::NonManifoldPoints, [this]() {
+        return CheckNonManifoldPoints();
+    });
+    auto selfIntersections = launch(MeshDefect::SelfIntersections, [this]() {
+        return CheckSelfIntersections();
+    });
+
+    if (which.testFlag(MeshDefect::NaNPoints)) {
+        summary.nanPoints = CheckNaNPoints();
+    }
+    if (which.testFlag(MeshDefect::DegeneratedFacets)) {
+        summary.degeneratedFacets = CheckDegeneratedFacets();
+    }
+    if (which.testFlag(MeshDefect::FoldsOnSurface)) {
+        summary.foldsOnSurface = CheckFoldsOnSurface();
+    }
+    // uses the facet flags and thus is the only check that modifies the mesh
+    if (which.testFlag(MeshDefect::Orientation)) {
+        summary.wrongOrientedFacets = CheckOrientation();
+    }
+    seq.next();
+
+    if (duplicatedPoints.valid()) {
+        summary.duplicatedPoints = duplicatedPoints.get();
+    }
+    if (duplicatedFacets.valid()) {
+        summary.duplicatedFacets = duplicatedFacets.get();
+    }
+    if (nonManifoldEdges.valid()) {
+        summary.nonManifoldEdges = nonManifoldEdges.get();
+    }
+    if (nonManifoldPoints.valid()) {
+        summary.nonManifoldPoints = nonManifoldPoints.get();
+    }
+    if (selfIntersections.valid()) {
+        summary.selfIntersections = selfIntersections.get();
+    }
+    seq.next();
+
+    return summary;
+}
+
+void MeshAnalysis::BuildFacetCache()
+{
+    std::size_t count = _rclMesh.CountFacets();
+    facets.resize(count);
+    normals.resize(count);
+    const MeshFacetArray& rFacets = _rclMesh.GetFacets();
+    parallel_for(
+        count,
+        [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++) {
+                facets[i] = _rclMesh.GetFacet(rFacets[i]);
+                normals[i] = facets[i].GetNormal();
+            }
+        },
+        GetThreads());
+}
+
+std::vector<FacetIndex> MeshAnalysis::CheckInvalidIndices() const
+{
+    const MeshFacetArray& rFacets = _rclMesh.GetFacets();
+    const MeshPointArray& rPoints = _rclMesh.GetPoints();
+    std::size_t countPoints = rPoints.size();
+    std::size_t countFacets = rFacets.size();
+
+    return collectParallel<FacetIndex>(
+        countFacets,
+        GetThreads(),
+        [&](std::size_t index, std::vector<FacetIndex>& result) {
+            const MeshFacet& face = rFacets[index];
+            bool invalid = !face.IsValid();
+            for (int i = 0; i < 3 && !invalid; i++) {
+                PointIndex pnt = face._aulPoints[i];
+                FacetIndex nb = face._aulNeighbours[i];
+                invalid = pnt >= countPoints || !rPoints[pnt].IsValid()
+                    || (nb != FACET_INDEX_MAX && nb >= countFacets);
+            }
+            if (invalid) {
+                result.push_back(static_cast<FacetIndex>(index));
+            }
+        });
+}
+
+std::vector<PointIndex> MeshAnalysis::CheckNaNPoints() const
+{
+    const MeshPointArray& rPoints = _rclMesh.GetPoints();
+    return collectParallel<PointIndex>(
+        rPoints.size(),
+        GetThreads(),
+        [&](std::size_t index, std::vector<PointIndex>& result) {
+            const MeshPoint& pnt = rPoints[index];
+            if (std::isnan(pnt.x) || std::isnan(pnt.y) || std::isnan(pnt.z)) {
+                result.push_back(static_cast<PointIndex>(index));
+            }
+        });
+}
+
+std::vector<PointIndex> MeshAnalysis::CheckDuplicatedPoints() const
+{
+    // Use the same ordering as MeshEvalDuplicatePoints and MeshBuilder
+    const MeshPointArray& rPoints = _rclMesh.GetPoints();
+    std::vector<PointIndex> order(rPoints.size());
+    for (std::size_t i = 0; i < order.size(); i++) {
+        order[i] = static_cast<PointIndex>(i);
+    }
+
+    auto less = [&rPoints](PointIndex x, PointIndex y) {
+        return rPoints[x] < rPoints[y];
+    };
+    parallel_sort(order.begin(), order.end(), less, GetThreads());
+
+    // Of each group of equal points all but the one with the lowest index are reported
+    std::vector<PointIndex> result;
+    auto first = order.begin();
+    while (first != order.end()) {
+        auto last = first + 1;
+        while (last != order.end() && !less(*first, *last) && !less(*last, *first)) {
+            ++last;
+        }
+        if (last - first > 1) {
+            PointIndex keep = *std::min_element(first, last);
+            std::copy_if(first, last, std::back_inserter(result), [keep](PointIndex index) {
+                return index != keep;
+            });
+        }
+        first = last;
+    }
+
+    makeUnique(result);
+    return result;
+}
+
+std::vector<FacetIndex> MeshAnalysis::CheckDuplicatedFacets() const
+{
+    const MeshFacetArray& rFacets = _rclMesh.GetFacets();
+    std::vector<std::array<PointIndex, 3>> keys(rFacets.size());
+    parallel_for(
+        keys.size(),
+        [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++) {
+                const MeshFacet& face = rFacets[i];
+                keys[i] = {face._aulPoints[0], face._aulPoints[1], face._aulPoints[2]};
+                std::sort(keys[i].begin(), keys[i].end());
+            }
+        },
+        GetThreads());
+
+    std::vector<FacetIndex> order(keys.size());
+    for (std::size_t i = 0; i < order.size(); i++) {
+        order[i] = static_cast<FacetIndex>(i);
+    }
+    parallel_sort(
+        order.begin(),
+        order.end(),
+        [&keys](FacetIndex x, FacetIndex y) {
+            return keys[x] < keys[y] || (keys[x] == keys[y] && x < y);
+        },
+        GetThreads());
+
+    std::vector<FacetIndex> result;
+    for (std::size_t i = 1; i < order.size(); i++) {
+        if (keys[order[i]] == keys[order[i - 1]]) {
+            result.push_back(order[i]);
+        }
+    }
+
+    makeUnique(result);
+    return result;
+}
+
+std::vector<FacetIndex> MeshAnalysis::CheckDegeneratedFacets() const
+{
+    return collectParallel<FacetIndex>(
+        facets.size(),
+        GetThreads(),
+        [this](std::size_t index, std::vector<FacetIndex>& result) {
+            if (facets[index].IsDegenerated(epsilon)) {
+                result.push_back(static_cast<FacetIndex>(index));
+            }
+        });
+}
+
+std::vector<std::pair<PointIndex, PointIndex>> MeshAnalysis::CheckNonManifoldEdges() const
+{
+    const MeshFacetArray& rFacets = _rclMesh.GetFacets();
+    std::vector<EdgeItem> edges(3 * rFacets.size());
+    parallel_for(
+        rFacets.size(),
+        [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++) {
+                const MeshFacet& face = rFacets[i];
+                for (int j = 0; j < 3; j++) {
+                    PointIndex p0 = face._aulPoints[j];
+                    PointIndex p1 = face._aulPoints[(j + 1) % 3];
+                    edges[3 * i + j] = {std::min(p0, p1), std::max(p0, p1)};
+                }
+            }
+        },
+        GetThreads());
+
+    parallel_sort(edges.begin(), edges.end(), std::less<>(), GetThreads());
+
+    // an edge that is shared by more than two facets is non-manifold
+    std::vector<std::pair<PointIndex, PointIndex>> result;
+    std::size_t first = 0;
+    while (first < edges.size()) {
+        std::size_t last = first + 1;
+        while (last < edges.size() && !(edges[first] != edges[last])) {
+            ++last;
+        }
+        if (last - first > 2) {
+            result.emplace_back(edges[first].p0, edges[first].p1);
+        }
+        first = last;
+    }
+
+    return result;
+}
+
+std::vector<PointIndex> MeshAnalysis::CheckNonManifoldPoints() const
+{
+    // Compact point to facet references
+    const MeshFacetArray& rFacets = _rclMesh.GetFacets();
+    std::size_t countPoints = _rclMesh.CountPoints();
+    std::vector<std::size_t> offsets(countPoints + 1, 0);
+    for (const auto& face : rFacets) {
+        for (PointIndex pnt : face._aulPoints) {
+            offsets[pnt + 1]++;
+        }
+    }
+    for (std::size_t i = 0; i < countPoints; i++) {
+        offsets[i + 1] += offsets[i];
+    }
+    std::vector<FacetIndex> pointFacets(offsets.back());
+    std::vector<std::size_t> fill(offsets.begin(), offsets.end() - 1);
+    for (std::size_t i = 0; i < rFacets.size(); i++) {
+        for (PointIndex pnt : rFacets[i]._aulPoints) {
+            pointFacets[fill[pnt]++] = static_cast<FacetIndex>(i);
+        }
+    }
+
+    // For an inner point the number of adjacent points is equal to the number of shared
+    // facets, for a boundary point it's higher by one and for a non-manifold point it's
+    // higher by more than one. This is the same criterion as used in MeshEvalPointManifolds.
+    return collectParallel<PointIndex>(
+        countPoints,
+        GetThreads(),
+        [&](std::size_t index, std::vector<PointIndex>& result) {
+            std::size_t numFacets = offsets[index + 1] - offsets[index];
+            std::vector<PointIndex> points;
+            points.reserve(2 * numFacets);
+            for (std::size_t i = offsets[index]; i < offsets[index + 1]; i++) {
+                for (PointIndex pnt : rFacets[pointFacets[i]]._aulPoints) {
+                    if (pnt != index) {
+                        points.push_back(pnt);
+                    }
+                }
+            }
+            makeUnique(points);
+            if (points.size() > numFacets + 1) {
+                result.push_back(static_cast<PointIndex>(index));
+            }
+        });
+}
+
+std::vector<FacetIndex> MeshAnalysis::CheckOrientation() const
+{
+    MeshEvalOrientation eval(_rclMesh);
+    if (eval.Evaluate()) {
+        return {};
+    }
+
+    std::vector<FacetIndex> result = eval.GetIndices();
+    makeUnique(result);
+    return result;
+}
+
+std::vector<FacetIndex> MeshAnalysis::CheckFoldsOnSurface() const
+{
+    // same criterion as MeshEvalFoldsOnSurface but using the cached normals
+    const MeshFacetArray& rFacets = _rclMesh.GetFacets();
+    std::vector<FacetIndex> result = collectParallel<FacetIndex>(
+        rFacets.size(),
+        GetThreads(),
+        [&](std::size_t index, std::vector<FacetIndex>& indices) {
+            const MeshFacet& face = rFacets[index];
+            const Base::Vector3f& v1 = normals[index];
+            for (int i = 0; i < 3; i++) {
+                FacetIndex n1 = face._aulNeighbours[i];
+                FacetIndex n2 = face._aulNeighbours[(i + 1) % 3];
+                if (n1 != FACET_INDEX_MAX && n2 != FACET_INDEX_MAX) {
+                    const Base::Vector3f& v2 = normals[n1];
+                    const Base::Vector3f& v3 = normals[n2];
+                    if (v2 * v3 > 0.0F && v1 * v2 < -0.1F && v1 * v3 < -0.1F) {
+                        indices.push_back(n1);
+                        indices.push_back(n2);
+                        indices.push_back(static_cast<FacetIndex>(index));
+                    }
+                }
+            }
+        });
+
+    makeUnique(result);
+    return result;
+}
+
+std::vector<std::pair<FacetIndex, FacetIndex>> MeshAnalysis::CheckSelfIntersections() const
+{
+    std::vector<MeshFacetBVH::FacetPair> result;
+    MeshFacetBVH bvh(_rclMesh, GetThreads());
+    bvh.GetSelfIntersections(result);
+    return result;
+}
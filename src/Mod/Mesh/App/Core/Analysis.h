@@ -0,0 +1,147 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026 The FreeCAD Project Association AISBL               *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+#ifndef MESH_ANALYSIS_H
+#define MESH_ANALYSIS_H
+
+#include <utility>
+#include <vector>
+
+#include <Base/Bitmask.h>
+
+#include "Elements.h"
+
+
+namespace MeshCore
+{
+
+class MeshKernel;
+
+/** The checks that can be run by MeshAnalysis. */
+enum class MeshDefect
+{
+    None = 0,
+    InvalidIndices = 1 << 0,
+    NaNPoints = 1 << 1,
+    DuplicatedPoints = 1 << 2,
+    DuplicatedFacets = 1 << 3,
+    DegeneratedFacets = 1 << 4,
+    NonManifoldEdges = 1 << 5,
+    NonManifoldPoints = 1 << 6,
+    Orientation = 1 << 7,
+    FoldsOnSurface = 1 << 8,
+    SelfIntersections = 1 << 9,
+    All = (1 << 10) - 1
+};
+
+using MeshDefects = Base::Flags<MeshDefect>;
+
+/**
+ * The MeshDefectSummary collects the results of all checks run by MeshAnalysis.
+ * The index lists are sorted and free of duplicates.
+ */
+struct MeshExport MeshDefectSummary
+{
+    /** Facets that reference points or neighbours out of range. If this list is not empty all
+     * other geometric checks are skipped because they would access invalid memory. */
+    std::vector<FacetIndex> invalidFacets;
+    std::vector<PointIndex> nanPoints;
+    std::vector<PointIndex> duplicatedPoints;
+    std::vector<FacetIndex> duplicatedFacets;
+    std::vector<FacetIndex> degeneratedFacets;
+    std::vector<std::pair<PointIndex, PointIndex>> nonManifoldEdges;
+    std::vector<PointIndex> nonManifoldPoints;
+    std::vector<FacetIndex> wrongOrientedFacets;
+    std::vector<FacetIndex> foldsOnSurface;
+    std::vector<std::pair<FacetIndex, FacetIndex>> selfIntersections;
+
+    /// Returns true if no defect of any kind was found.
+    bool IsValid() const;
+    /// Returns the number of reported elements of all checks.
+    std::size_t CountDefects() const;
+};
+
+/**
+ * The MeshAnalysis class runs a set of independent mesh checks in one pass.
+ * In contrast to running MeshEvalDuplicatePoints, MeshEvalTopology, MeshEvalSelfIntersection,
+ * etc. one after another the checks that don't depend on each other run concurrently and the
+ * per-facet checks are split into chunks that are processed in parallel.
+ * Only the facet geometry and normals are computed once and shared by the degeneration and
+ * fold checks. The other checks still build their own data, e.g. the manifold checks sort
+ * their own edge list and the self-intersection check builds its own BVH.
+ * @note The passed mesh kernel is not modified apart from the temporary flags that are used by
+ * the orientation check.
+ */
+class MeshExport MeshAnalysis
+{
+public:
+    explicit MeshAnalysis(const MeshKernel& rclM);
+    ~MeshAnalysis();
+
+    MeshAnalysis(const MeshAnalysis&) = delete;
+    MeshAnalysis(MeshAnalysis&&) = delete;
+    MeshAnalysis& operator=(const MeshAnalysis&) = delete;
+    MeshAnalysis& operator=(MeshAnalysis&&) = delete;
+
+    /** Sets the number of threads. A value < 1 uses the number of available cores. */
+    void SetThreads(int num)
+    {
+        threads = num;
+    }
+    int GetThreads() const;
+    /** Sets the tolerance used to detect degenerated facets. */
+    void SetDegenerationEpsilon(float eps)
+    {
+        epsilon = eps;
+    }
+
+    /** Runs the requested checks and returns the collected defects. */
+    MeshDefectSummary Evaluate(MeshDefects which = MeshDefect::All);
+
+private:
+    void BuildFacetCache();
+    std::vector<FacetIndex> CheckInvalidIndices() const;
+    std::vector<PointIndex> CheckNaNPoints() const;
+    std::vector<PointIndex> CheckDuplicatedPoints() const;
+    std::vector<FacetIndex> CheckDuplicatedFacets() const;
+    std::vector<FacetIndex> CheckDegeneratedFacets() const;
+    std::vector<std::pair<PointIndex, PointIndex>> CheckNonManifoldEdges() const;
+    std::vector<PointIndex> CheckNonManifoldPoints() const;
+    std::vector<FacetIndex> CheckOrientation() const;
+    std::vector<FacetIndex> CheckFoldsOnSurface() const;
+    std::vector<std::pair<FacetIndex, FacetIndex>> CheckSelfIntersections() const;
+
+private:
+    const MeshKernel& _rclMesh;
+    int threads {0};
+    float epsilon;
+    std::vector<MeshGeomFacet> facets;
+    std::vector<Base::Vector3f> normals;
+};
+
+}  // namespace MeshCore
+
+ENABLE_BITMASK_OPERATORS(MeshCore::MeshDefect)
+
+#endif  // MESH_ANALYSIS_H
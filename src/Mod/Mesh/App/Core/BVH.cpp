@@ -0,0 +1,533 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026 The FreeCAD Project Association AISBL               *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <limits>
+#include <numeric>
+#include <thread>
+
+#include <Base/Sequencer.h>
+
+#include "BVH.h"
+#include "Elements.h"
+#include "Functional.h"
+#include "MeshKernel.h"
+
+
+using namespace MeshCore;
+
+namespace
+{
+
+constexpr std::uint32_t MaxLeafSize = 4;
+constexpr std::uint32_t MaxSAHLeafSize = 16;
+constexpr int NumBins = 16;
+
+// Returns true if all three vertices are strictly on the same side of the plane
+bool onSameSide(const std::array<float, 4>& plane, const std::array<float, 9>& v)
+{
+    std::array<float, 3> dist {};
+    for (int i = 0; i < 3; i++) {
+        dist[i] = plane[0] * v[3 * i] + plane[1] * v[3 * i + 1] + plane[2] * v[3 * i + 2]
+            + plane[3];
+    }
+    return (dist[0] > 0.0F && dist[1] > 0.0F && dist[2] > 0.0F)
+        || (dist[0] < 0.0F && dist[1] < 0.0F && dist[2] < 0.0F);
+}
+
+bool boxesOverlap(const std::array<float, 9>& a, const std::array<float, 9>& b)
+{
+    for (int k = 0; k < 3; k++) {
+        float minA = std::min({a[k], a[k + 3], a[k + 6]});
+        float maxA = std::max({a[k], a[k + 3], a[k + 6]});
+        float minB = std::min({b[k], b[k + 3], b[k + 6]});
+        float maxB = std::max({b[k], b[k + 3], b[k + 6]});
+        if (maxA < minB || maxB < minA) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+// ----------------------------------------------------------------------------
+
+void MeshFacetBVH::Box::Reset()
+{
+    min.fill(std::numeric_limits<float>::max());
+    max.fill(-std::numeric_limits<float>::max());
+}
+
+void MeshFacetBVH::Box::Add(const Box& box)
+{
+    for (int k = 0; k < 3; k++) {
+        min[k] = std::min(min[k], box.min[k]);
+        max[k] = std::max(max[k], box.max[k]);
+    }
+}
+
+void MeshFacetBVH::Box::Add(const std::array<float, 3>& pnt)
+{
+    for (int k = 0; k < 3; k++) {
+        min[k] = std::min(min[k], pnt[k]);
+        max[k] = std::max(max[k], pnt[k]);
+    }
+}
+
+float MeshFacetBVH::Box::Area() const
+{
+    float dx = std::max(max[0] - min[0], 0.0F);
+    float dy = std::max(max[1] - min[1], 0.0F);
+    float dz = std::max(max[2] - min[2], 0.0F);
+    return 2.0F * (dx * dy + dy * dz + dz * dx);
+}
+
+// ----------------------------------------------------------------------------
+
+MeshFacetBVH::MeshFacetBVH(const MeshKernel& rclM, int threads)
+    : _rclMesh(rclM)
+    , _threads(threads)
+{
+    Rebuild();
+}
+
+int MeshFacetBVH::GetThreads() const
+{
+    if (_threads > 0) {
+        return _threads;
+    }
+    return std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+}
+
+void MeshFacetBVH::Rebuild()
+{
+    _nodes.clear();
+    _triangles.clear();
+
+    const MeshFacetArray& rFacets = _rclMesh.GetFacets();
+    const MeshPointArray& rPoints = _rclMesh.GetPoints();
+    std::size_t count = rFacets.size();
+    if (count == 0) {
+        return;
+    }
+
+    std::vector<Triangle> triangles(count);
+    std::vector<Box> boxes(count);
+    std::vector<std::array<float, 3>> centers(count);
+    parallel_for(
+        count,
+        [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++) {
+                const MeshFacet& face = rFacets[i];
+                Triangle& tria = triangles[i];
+                Box& box = boxes[i];
+                box.Reset();
+                for (int j = 0; j < 3; j++) {
+                    const MeshPoint& pnt = rPoints[face._aulPoints[j]];
+                    tria.v[3 * j] = pnt.x;
+                    tria.v[3 * j + 1] = pnt.y;
+                    tria.v[3 * j + 2] = pnt.z;
+                    tria.points[j] = face._aulPoints[j];
+                    box.Add(std::array<float, 3> {pnt.x, pnt.y, pnt.z});
+                }
+
+                Base::Vector3f p0(tria.v[0], tria.v[1], tria.v[2]);
+                Base::Vector3f p1(tria.v[3], tria.v[4], tria.v[5]);
+                Base::Vector3f p2(tria.v[6], tria.v[7], tria.v[8]);
+                Base::Vector3f normal = (p1 - p0) % (p2 - p0);
+                tria.plane = {normal.x, normal.y, normal.z, -(normal * p0)};
+                tria.facet = static_cast<FacetIndex>(i);
+
+                for (int k = 0; k < 3; k++) {
+                    centers[i][k] = 0.5F * (box.min[k] + box.max[k]);
+                }
+            }
+        },
+        GetThreads());
+
+    std::vector<std::uint32_t> order(count);
+    std::iota(order.begin(), order.end(), 0);
+    _nodes.reserve(2 * count / MaxLeafSize + 1);
+    BuildRecursive(order, 0, static_cast<std::uint32_t>(count), boxes, centers);
+
+    _triangles.reserve(count);
+    for (std::uint32_t index : order) {
+        _triangles.push_back(triangles[index]);
+    }
+}
+
+std::uint32_t MeshFacetBVH::BuildRecursive(std::vector<std::uint32_t>& order,
+                                           std::uint32_t first,
+                                           std::uint32_t last,
+                                           const std::vector<Box>& boxes,
+                                           const std::vector<std::array<float, 3>>& centers)
+{
+    auto index = static_cast<std::uint32_t>(_nodes.size());
+    _nodes.emplace_back();
+
+    Box box;
+    Box centerBox;
+    box.Reset();
+    centerBox.Reset();
+    for (std::uint32_t i = first; i < last; i++) {
+        box.Add(boxes[order[i]]);
+        centerBox.Add(centers[order[i]]);
+    }
+
+    std::uint32_t count = last - first;
+    auto makeLeaf = [&]() {
+        _nodes[index].box = box;
+        _nodes[index].offset = first;
+        _nodes[index].count = count;
+        return index;
+    };
+
+    if (count <= MaxLeafSize) {
+        return makeLeaf();
+    }
+
+    int axis = 0;
+    for (int k = 1; k < 3; k++) {
+        if (centerBox.max[k] - centerBox.min[k] > centerBox.max[axis] - centerBox.min[axis]) {
+            axis = k;
+        }
+    }
+
+    std::uint32_t mid = first;
+    float extent = centerBox.max[axis] - centerBox.min[axis];
+    if (extent > 0.0F) {
+        // binned surface area heuristic
+        std::array<Box, NumBins> binBoxes {};
+        std::array<std::uint32_t, NumBins> binCounts {};
+        for (auto& it : binBoxes) {
+            it.Reset();
+        }
+        float scale = static_cast<float>(NumBins) / extent;
+        auto binOf = [&](std::uint32_t facet) {
+            auto bin = static_cast<int>((centers[facet][axis] - centerBox.min[axis]) * scale);
+            return std::clamp(bin, 0, NumBins - 1);
+        };
+        for (std::uint32_t i = first; i < last; i++) {
+            int bin = binOf(order[i]);
+            binCounts[bin]++;
+            binBoxes[bin].Add(boxes[order[i]]);
+        }
+
+        // sweep from the right to get the costs of the right sides
+        std::array<float, NumBins> rightCost {};
+        Box acc;
+        acc.Reset();
+        std::uint32_t accCount = 0;
+        for (int i = NumBins - 1; i > 0; i--) {
+            acc.Add(binBoxes[i]);
+            accCount += binCounts[i];
+            rightCost[i] = accCount > 0 ? acc.Area() * static_cast<float>(accCount) : 0.0F;
+        }
+
+        acc.Reset();
+        accCount = 0;
+        int bestSplit = -1;
+        float bestCost = std::numeric_limits<float>::max();
+        for (int i = 0; i < NumBins - 1; i++) {
+            acc.Add(binBoxes[i]);
+            accCount += binCounts[i];
+            if (accCount == 0 || accCount == count) {
+                continue;
+            }
+            float cost = acc.Area() * static_cast<float>(accCount) + rightCost[i + 1];
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestSplit = i;
+            }
+        }
+
+        float area = box.Area();
+        float leafCost = static_cast<float>(count);
+        float splitCost = area > 0.0F ? 1.0F + bestCost / area : leafCost;
+        if (bestSplit >= 0 && count <= MaxSAHLeafSize && splitCost >= leafCost) {
+            return makeLeaf();
+        }
+
+        if (bestSplit >= 0) {
+            auto it = std::partition(order.begin() + first,
+                                     order.begin() + last,
+                                     [&](std::uint32_t facet) {
+                                         return binOf(facet) <= bestSplit;
+                                     });
+            mid = static_cast<std::uint32_t>(it - order.begin());
+        }
+    }
+
+    // fall back to a median split if the heuristic cannot separate the facets
+    if (mid == first || mid == last) {
+        mid = first + count / 2;
+        std::nth_element(order.begin() + first,
+                         order.begin() + mid,
+                         order.begin() + last,
+                         [&](std::uint32_t a, std::uint32_t b) {
+                             return centers[a][axis] < centers[b][axis];
+                         });
+    }
+
+    BuildRecursive(order, first, mid, boxes, centers);
+    std::uint32_t right = BuildRecursive(order, mid, last, boxes, centers);
+    _nodes[index].box = box;
+    _nodes[index].offset = right;
+    _nodes[index].count = 0;
+    return index;
+}
+
+int MeshFacetBVH::GetDepth() const
+{
+    if (_nodes.empty()) {
+        return 0;
+    }
+
+    int depth = 0;
+    std::vector<std::pair<std::uint32_t, int>> stack {{0, 1}};
+    while (!stack.empty()) {
+        auto [index, level] = stack.back();
+        stack.pop_back();
+        depth = std::max(depth, level);
+        const Node& node = _nodes[index];
+        if (!node.IsLeaf()) {
+            stack.emplace_back(index + 1, level + 1);
+            stack.emplace_back(node.offset, level + 1);
+        }
+    }
+    return depth;
+}
+
+bool MeshFacetBVH::TestPair(const MeshFacetBVH& other, std::uint32_t tri1, std::uint32_t tri2) const
+{
+    const Triangle& t1 = _triangles[tri1];
+    const Triangle& t2 = other._triangles[tri2];
+    if (!boxesOverlap(t1.v, t2.v)) {
+        return false;
+    }
+    if (onSameSide(t1.plane, t2.v) || onSameSide(t2.plane, t1.v)) {
+        return false;
+    }
+
+    MeshGeomFacet facet1(Base::Vector3f(t1.v[0], t1.v[1], t1.v[2]),
+                         Base::Vector3f(t1.v[3], t1.v[4], t1.v[5]),
+                         Base::Vector3f(t1.v[6], t1.v[7], t1.v[8]));
+    MeshGeomFacet facet2(Base::Vector3f(t2.v[0], t2.v[1], t2.v[2]),
+                         Base::Vector3f(t2.v[3], t2.v[4], t2.v[5]),
+                         Base::Vector3f(t2.v[6], t2.v[7], t2.v[8]));
+    Base::Vector3f pt1, pt2;
+    return facet1.IntersectWithFacet(facet2, pt1, pt2) == 2;
+}
+
+void MeshFacetBVH::CollectPairs(const MeshFacetBVH& other,
+                                bool self,
+                                bool firstOnly,
+                                std::vector<FacetPair>& pairs) const
+{
+    pairs.clear();
+    if (_nodes.empty() || other._nodes.empty()) {
+        return;
+    }
+
+    std::atomic<bool> stop {false};
+    auto testLeaves = [&](const Node& a, const Node& b, bool same, std::vector<FacetPair>& out) {
+        for (std::uint32_t i = a.offset; i < a.offset + a.count; i++) {
+            std::uint32_t start = same ? i + 1 : b.offset;
+            for (std::uint32_t j = start; j < b.offset + b.count; j++) {
+                const Triangle& t1 = _triangles[i];
+                const Triangle& t2 = other._triangles[j];
+                if (self) {
+                    // facets sharing a common point are ignored to avoid false-positives
+                    bool common = std::any_of(t1.points.begin(),
+                                              t1.points.end(),
+                                              [&t2](PointIndex pnt) {
+                                                  return pnt == t2.points[0]
+                                                      || pnt == t2.points[1]
+                                                      || pnt == t2.points[2];
+                                              });
+                    if (common) {
+                        continue;
+                    }
+                }
+                if (TestPair(other, i, j)) {
+                    if (self) {
+                        out.emplace_back(std::min(t1.facet, t2.facet),
+                                         std::max(t1.facet, t2.facet));
+                    }
+                    else {
+                        out.emplace_back(t1.facet, t2.facet);
+                    }
+                    if (firstOnly) {
+                        stop = true;
+                        return;
+                    }
+                }
+            }
+        }
+    };
+
+    // Processes a pair of nodes: leaves are tested, inner nodes are split into child pairs
+    auto expand = [&](const NodePair& np,
+                      std::vector<NodePair>& stack,
+                      std::vector<FacetPair>& out) {
+        const Node& a = _nodes[np.first];
+        const Node& b = other._nodes[np.second];
+        bool same = self && np.first == np.second;
+        if (!same && !a.box.Intersects(b.box)) {
+            return;
+        }
+        if (a.IsLeaf() && b.IsLeaf()) {
+            testLeaves(a, b, same, out);
+        }
+        else if (same) {
+            std::uint32_t left = np.first + 1;
+            std::uint32_t right = a.offset;
+            stack.emplace_back(left, left);
+            stack.emplace_back(right, right);
+            stack.emplace_back(left, right);
+        }
+        else if (b.IsLeaf() || (!a.IsLeaf() && a.box.Area() >= b.box.Area())) {
+            stack.emplace_back(np.first + 1, np.second);
+            stack.emplace_back(a.offset, np.second);
+        }
+        else {
+            stack.emplace_back(np.first, np.second + 1);
+            stack.emplace_back(np.first, b.offset);
+        }
+    };
+
+    // Expand the upper levels of both trees to get enough independent tasks
+    int threads = GetThreads();
+    std::vector<NodePair> tasks {{0, 0}};
+    std::vector<FacetPair> found;
+    std::size_t numTasks = threads > 1 ? 16 * static_cast<std::size_t>(threads) : 1;
+    if (!_progressText.empty()) {
+        // finer tasks give a smoother progress
+        numTasks = std::max<std::size_t>(numTasks, 256);
+    }
+    while (tasks.size() < numTasks && !stop) {
+        std::vector<NodePair> next;
+        bool expanded = false;
+        for (const auto& it : tasks) {
+            if (_nodes[it.first].IsLeaf() && other._nodes[it.second].IsLeaf()) {
+                next.push_back(it);
+            }
+            else {
+                expand(it, next, found);
+                expanded = true;
+            }
+        }
+        tasks.swap(next);
+        if (!expanded) {
+            break;
+        }
+    }
+
+    std::vector<std::vector<FacetPair>> results(tasks.size());
+    std::atomic<std::size_t> done {0};
+    auto traverse = [&]() {
+        parallel_for(
+            tasks.size(),
+            [&](std::size_t begin, std::size_t end) {
+                std::vector<NodePair> stack;
+                for (std::size_t i = begin; i < end && !stop; i++) {
+                    stack.push_back(tasks[i]);
+                    while (!stack.empty() && !stop) {
+                        NodePair np = stack.back();
+                        stack.pop_back();
+                        expand(np, stack, results[i]);
+                    }
+                    stack.clear();
+                    ++done;
+                }
+            },
+            threads,
+            1);
+    };
+
+    if (_progressText.empty()) {
+        traverse();
+    }
+    else {
+        // The sequencer must only be used from this thread. Thus, the traversal runs
+        // asynchronously and its progress is polled here.
+        Base::SequencerLauncher seq(_progressText.c_str(), tasks.size());
+        std::future<void> future = std::async(std::launch::async, traverse);
+        try {
+            std::size_t reported = 0;
+            for (;;) {
+                bool ready = future.wait_for(std::chrono::milliseconds(100))
+                    == std::future_status::ready;
+                for (std::size_t num = done; reported < num; reported++) {
+                    seq.next(_canAbort);
+                }
+                if (ready) {
+                    break;
+                }
+            }
+        }
+        catch (...) {
+            // e.g. aborted by the user
+            stop = true;
+            future.wait();
+            throw;
+        }
+        future.get();
+    }
+
+    pairs.swap(found);
+    for (const auto& it : results) {
+        pairs.insert(pairs.end(), it.begin(), it.end());
+    }
+    std::sort(pairs.begin(), pairs.end());
+    pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+}
+
+bool MeshFacetBVH::HasSelfIntersections() const
+{
+    std::vector<FacetPair> pairs;
+    CollectPairs(*this, true, true, pairs);
+    return !pairs.empty();
+}
+
+void MeshFacetBVH::GetSelfIntersections(std::vector<FacetPair>& pairs) const
+{
+    CollectPairs(*this, true, false, pairs);
+}
+
+bool MeshFacetBVH::HasIntersections(const MeshFacetBVH& other) const
+{
+    std::vector<FacetPair> pairs;
+    CollectPairs(other, false, true, pairs);
+    return !pairs.empty();
+}
+
+void MeshFacetBVH::GetIntersections(const MeshFacetBVH& other, std::vector<FacetPair>& pairs) const
+{
+    CollectPairs(other, false, false, pairs);
+}
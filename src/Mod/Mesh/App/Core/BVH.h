@@ -0,0 +1,160 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026 The FreeCAD Project Association AISBL               *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+#ifndef MESH_BVH_H
+#define MESH_BVH_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Definitions.h"
+
+
+namespace MeshCore
+{
+
+class MeshKernel;
+
+/**
+ * The MeshFacetBVH class is a bounding volume hierarchy over the facets of a mesh kernel.
+ * The tree is built with the surface area heuristic (SAH) and thus adapts to meshes with
+ * very uneven triangle sizes where a uniform MeshFacetGrid degenerates.
+ *
+ * Self-intersection and mesh-mesh intersection tests traverse two trees simultaneously.
+ * The traversal is split into independent sub-tasks that are processed in parallel, and each
+ * candidate facet pair passes a cheap plane-separation test before the exact triangle-triangle
+ * test of MeshGeomFacet::IntersectWithFacet() is done.
+ * \note If the underlying mesh kernel gets changed this structure becomes invalid and must
+ * be rebuilt.
+ */
+class MeshExport MeshFacetBVH
+{
+public:
+    using FacetPair = std::pair<FacetIndex, FacetIndex>;
+
+    /// Construction
+    explicit MeshFacetBVH(const MeshKernel& rclM, int threads = 0);
+
+    /// Rebuilds up data structure
+    void Rebuild();
+    /** Sets the number of threads used for the queries. A value < 1 uses the number of
+     * available cores. */
+    void SetThreads(int num)
+    {
+        _threads = num;
+    }
+    /** Shows a progress indicator with \a text while the intersection queries run and, if
+     * \a canAbort is true, allows the user to cancel them. The progress is reported from the
+     * calling thread, so only enable it when the queries run in the main thread. */
+    void SetProgress(const char* text, bool canAbort)
+    {
+        _progressText = text;
+        _canAbort = canAbort;
+    }
+    /// Returns the number of nodes of the tree
+    std::size_t CountNodes() const
+    {
+        return _nodes.size();
+    }
+    /// Returns the depth of the tree
+    int GetDepth() const;
+
+    /** Returns true if two facets of the mesh intersect each other. Facets sharing a common
+     * point are ignored. */
+    bool HasSelfIntersections() const;
+    /** Collects all pairs of intersecting facets. Facets sharing a common point are ignored.
+     * Each pair is reported only once with the lower index first and the list is sorted. */
+    void GetSelfIntersections(std::vector<FacetPair>& pairs) const;
+    /** Returns true if a facet of this mesh intersects a facet of \a other. */
+    bool HasIntersections(const MeshFacetBVH& other) const;
+    /** Collects all pairs of intersecting facets of this mesh (first) and \a other (second).
+     * The list is sorted. */
+    void GetIntersections(const MeshFacetBVH& other, std::vector<FacetPair>& pairs) const;
+
+private:
+    struct Box
+    {
+        std::array<float, 3> min;
+        std::array<float, 3> max;
+
+        void Reset();
+        void Add(const Box& box);
+        void Add(const std::array<float, 3>& pnt);
+        float Area() const;
+        bool Intersects(const Box& box) const
+        {
+            return min[0] <= box.max[0] && box.min[0] <= max[0] && min[1] <= box.max[1]
+                && box.min[1] <= max[1] && min[2] <= box.max[2] && box.min[2] <= max[2];
+        }
+    };
+    struct Node
+    {
+        Box box;
+        /// first triangle of a leaf or the index of the right child of an inner node
+        std::uint32_t offset;
+        /// number of triangles of a leaf or 0 for an inner node
+        std::uint32_t count;
+
+        bool IsLeaf() const
+        {
+            return count > 0;
+        }
+    };
+    /// triangle data in tree order: three vertices and the plane equation
+    struct Triangle
+    {
+        std::array<float, 9> v;
+        std::array<float, 4> plane;
+        std::array<PointIndex, 3> points;
+        FacetIndex facet;
+    };
+    using NodePair = std::pair<std::uint32_t, std::uint32_t>;
+
+    std::uint32_t BuildRecursive(std::vector<std::uint32_t>& order,
+                                 std::uint32_t first,
+                                 std::uint32_t last,
+                                 const std::vector<Box>& boxes,
+                                 const std::vector<std::array<float, 3>>& centers);
+    int GetThreads() const;
+    void CollectPairs(const MeshFacetBVH& other,
+                      bool self,
+                      bool firstOnly,
+                      std::vector<FacetPair>& pairs) const;
+    bool TestPair(const MeshFacetBVH& other, std::uint32_t tri1, std::uint32_t tri2) const;
+
+private:
+    const MeshKernel& _rclMesh; /**< The mesh kernel. */
+    int _threads;
+    std::string _progressText;
+    bool _canAbort {false};
+    std::vector<Node> _nodes;
+    std::vector<Triangle> _triangles;
+};
+
+}  // namespace MeshCore
+
+#endif  // MESH_BVH_H
@@ -31,26 +31,26 @@
 
 using namespace MeshCore;
 
-MeshSimplify::MeshSimplify(MeshKernel& mesh)
-    : myKernel(mesh)
-{}
-
-void MeshSimplify::simplify(float tolerance, float reduction)
+namespace
 {
-    Simplify alg;
-
-    const MeshPointArray& points = myKernel.GetPoints();
-    for (std::size_t i = 0; i < points.size(); i++) {
+// Moves the kernel data into the simplification structures. The kernel is
+// cleared to keep the peak memory low.
+void fillSimplify(MeshKernel& kernel, Simplify& alg)
+{
+    const MeshPointArray& points = kernel.GetPoints();
+    alg.vertices.reserve(points.size());
+    for (const auto& point : points) {
         Simplify::Vertex v;
         v.tstart = 0;
         v.tcount = 0;
         v.border = 0;
-        v.p = points[i];
+        v.p = point;
         alg.vertices.push_back(v);
     }
 
-    const MeshFacetArray& facets = myKernel.GetFacets();
-    for (std::size_t i = 0; i < facets.size(); i++) {
+    const MeshFacetArray& facets = kernel.GetFacets();
+    alg.triangles.reserve(facets.size());
+    for (const auto& facet : facets) {
         Simplify::Triangle t;
         t.deleted = 0;
         t.dirty = 0;
@@ -58,22 +58,24 @@ void MeshSimplify::simplify(float tolerance, float reduction)
             j = 0.0;
         }
         for (int j = 0; j < 3; j++) {
-            t.v[j] = facets[i]._aulPoints[j];
+            t.v[j] = static_cast<int>(facet._aulPoints[j]);
         }
         alg.triangles.push_back(t);
     }
 
-    int target_count = static_cast<int>(static_cast<float>(facets.size()) * (1.0F - reduction));
-
-    // Simplification starts
-    alg.simplify_mesh(target_count, tolerance);
+    kernel.Clear();
+}
 
-    // Simplification done
+// Moves the simplified mesh back into the kernel
+void adoptSimplify(MeshKernel& kernel, Simplify& alg)
+{
     MeshPointArray new_points;
     new_points.reserve(alg.vertices.size());
     for (const auto& vertex : alg.vertices) {
         new_points.push_back(vertex.p);
     }
+    std::vector<Simplify::Vertex>().swap(alg.vertices);
+    std::vector<Simplify::Ref>().swap(alg.refs);
 
     std::size_t numFacets = 0;
     for (const auto& triangle : alg.triangles) {
@@ -92,65 +94,39 @@ void MeshSimplify::simplify(float tolerance, float reduction)
             new_facets.push_back(face);
         }
     }
+    std::vector<Simplify::Triangle>().swap(alg.triangles);
 
-    myKernel.Adopt(new_points, new_facets, true);
+    kernel.Adopt(new_points, new_facets, true);
 }
+}  // namespace
 
-void MeshSimplify::simplify(int targetSize)
+MeshSimplify::MeshSimplify(MeshKernel& mesh)
+    : myKernel(mesh)
+{}
+
+void MeshSimplify::simplify(float tolerance, float reduction)
 {
     Simplify alg;
+    std::size_t numFacets = myKernel.CountFacets();
+    fillSimplify(myKernel, alg);
 
-    const MeshPointArray& points = myKernel.GetPoints();
-    for (std::size_t i = 0; i < points.size(); i++) {
-        Simplify::Vertex v;
-        v.tstart = 0;
-        v.tcount = 0;
-        v.border = 0;
-        v.p = points[i];
-        alg.vertices.push_back(v);
-    }
-
-    const MeshFacetArray& facets = myKernel.GetFacets();
-    for (std::size_t i = 0; i < facets.size(); i++) {
-        Simplify::Triangle t;
-        t.deleted = 0;
-        t.dirty = 0;
-        for (double& j : t.err) {
-            j = 0.0;
-        }
-        for (int j = 0; j < 3; j++) {
-            t.v[j] = facets[i]._aulPoints[j];
-        }
-        alg.triangles.push_back(t);
-    }
+    int target_count = static_cast<int>(static_cast<float>(numFacets) * (1.0F - reduction));
 
     // Simplification starts
-    alg.simplify_mesh(targetSize, std::numeric_limits<float>::max());
+    alg.simplify_mesh(target_count, tolerance);
 
     // Simplification done
-    MeshPointArray new_points;
-    new_points.reserve(alg.vertices.size());
-    for (const auto& vertex : alg.vertices) {
-        new_points.push_back(vertex.p);
-    }
+    adoptSimplify(myKernel, alg);
+}
 
-    std::size_t numFacets = 0;
-    for (const auto& triangle : alg.triangles) {
-        if (!triangle.deleted) {
-            numFacets++;
-        }
-    }
-    MeshFacetArray new_facets;
-    new_facets.reserve(numFacets);
-    for (const auto& triangle : alg.triangles) {
-        if (!triangle.deleted) {
-            MeshFacet face;
-            face._aulPoints[0] = triangle.v[0];
-            face._aulPoints[1] = triangle.v[1];
-            face._aulPoints[2] = triangle.v[2];
-            new_facets.push_back(face);
-        }
-    }
+void MeshSimplify::simplify(int targetSize)
+{
+    Simplify alg;
+    fillSimplify(myKernel, alg);
 
-    myKernel.Adopt(new_points, new_facets, true);
+    // Simplification starts
+    alg.simplify_mesh(targetSize, std::numeric_limits<float>::max());
+
+    // Simplification done
+    adoptSimplify(myKernel, alg);
 }
@@ -26,7 +26,10 @@
 #define MESH_FUNCTIONAL_H
 
 #include <algorithm>
+#include <cstddef>
 #include <future>
+#include <thread>
+#include <vector>
 
 
 namespace MeshCore
@@ -64,6 +67,49 @@ static void parallel_sort(Iter begin, Iter end, Pred comp, int threads)
     }
 }
 
+/**
+ * Returns \a threads if it is positive and the number of hardware threads otherwise.
+ */
+inline int thread_count(int threads)
+{
+    if (threads > 0) {
+        return threads;
+    }
+    return std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+}
+
+/**
+ * Splits the index range [0, \a count) into \a threads contiguous chunks and calls
+ * \a func(begin, end) for each of them concurrently. Small ranges or \a threads < 2
+ * are processed on the calling thread.
+ */
+template<class Func>
+static void parallel_for(std::size_t count, Func func, int threads, std::size_t minChunk = 1024)
+{
+    std::size_t numChunks = threads > 1 ? static_cast<std::size_t>(threads) : 1;
+    minChunk = std::max<std::size_t>(minChunk, 1);
+    numChunks = std::min(numChunks, std::max<std::size_t>(count / minChunk, 1));
+    if (numChunks < 2) {
+        if (count > 0) {
+            func(std::size_t(0), count);
+        }
+        return;
+    }
+
+    std::size_t chunk = (count + numChunks - 1) / numChunks;
+    std::vector<std::future<void>> futures;
+    futures.reserve(numChunks - 1);
+    for (std::size_t begin = chunk; begin < count; begin += chunk) {
+        std::size_t end = std::min(begin + chunk, count);
+        futures.push_back(std::async(std::launch::async, func, begin, end));
+    }
+
+    func(std::size_t(0), std::min(chunk, count));
+    for (auto& it : futures) {
+        it.get();
+    }
+}
+
 }  // namespace MeshCore
 
 
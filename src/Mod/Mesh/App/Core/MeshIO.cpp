@@ -1578,18 +1578,10 @@ bool MeshOutput::SaveFormat(std::ostream& str, MeshIO::Format fmt) const
 /** Saves the mesh object into an ASCII file. */
 bool MeshOutput::SaveAsciiSTL(std::ostream& output) const
 {
-    MeshFacetIterator clIter(_rclMesh), clEnd(_rclMesh);
-    clIter.Transform(this->_transform);
-    const MeshGeomFacet* pclFacet {};
-
     if (!output || output.bad() || _rclMesh.CountFacets() == 0) {
         return false;
     }
 
-    output.precision(6);
-    output.setf(std::ios::fixed | std::ios::showpoint);
-    Base::SequencerLauncher seq("saving...", _rclMesh.CountFacets() + 1);
-
     if (this->objectName.empty()) {
         output << "solid Mesh\n";
     }
@@ -1597,6 +1589,27 @@ bool MeshOutput::SaveAsciiSTL(std::ostream& output) const
         output << "solid " << this->objectName << '\n';
     }
 
+    SaveAsciiSTLFacets(output);
+
+    output << "endsolid Mesh\n";
+
+    return true;
+}
+
+bool MeshOutput::SaveAsciiSTLFacets(std::ostream& output) const
+{
+    MeshFacetIterator clIter(_rclMesh), clEnd(_rclMesh);
+    clIter.Transform(this->_transform);
+    const MeshGeomFacet* pclFacet {};
+
+    if (!output || output.bad()) {
+        return false;
+    }
+
+    output.precision(6);
+    output.setf(std::ios::fixed | std::ios::showpoint);
+    Base::SequencerLauncher seq("saving...", _rclMesh.CountFacets() + 1);
+
     clIter.Begin();
     clEnd.End();
     while (clIter < clEnd) {
@@ -1619,26 +1632,18 @@ bool MeshOutput::SaveAsciiSTL(std::ostream& output) const
         seq.next(true);  // allow to cancel
     }
 
-    output << "endsolid Mesh\n";
-
     return true;
 }
 
 /** Saves the mesh object into a binary file. */
 bool MeshOutput::SaveBinarySTL(std::ostream& output) const
 {
-    MeshFacetIterator clIter(_rclMesh), clEnd(_rclMesh);
-    clIter.Transform(this->_transform);
-    const MeshGeomFacet* pclFacet {};
-    uint16_t usAtt {};
     char szInfo[81];
 
     if (!output || output.bad() /*|| _rclMesh.CountFacets() == 0*/) {
         return false;
     }
 
-    Base::SequencerLauncher seq("saving...", _rclMesh.CountFacets() + 1);
-
     // stl_header has a length of 80
     strcpy(szInfo, stl_header.c_str());
     output.write(szInfo, std::strlen(szInfo));
@@ -1646,6 +1651,22 @@ bool MeshOutput::SaveBinarySTL(std::ostream& output) const
     uint32_t uCtFts = (uint32_t)_rclMesh.CountFacets();
     output.write((const char*)&uCtFts, sizeof(uCtFts));
 
+    return SaveBinarySTLFacets(output);
+}
+
+bool MeshOutput::SaveBinarySTLFacets(std::ostream& output) const
+{
+    MeshFacetIterator clIter(_rclMesh), clEnd(_rclMesh);
+    clIter.Transform(this->_transform);
+    const MeshGeomFacet* pclFacet {};
+    uint16_t usAtt {};
+
+    if (!output || output.bad()) {
+        return false;
+    }
+
+    Base::SequencerLauncher seq("saving...", _rclMesh.CountFacets() + 1);
+
     usAtt = 0;
     clIter.Begin();
     clEnd.End();
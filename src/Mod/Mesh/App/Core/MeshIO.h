@@ -213,6 +213,14 @@ public:
     bool SaveAsciiSTL(std::ostream& output) const;
     /** Saves the mesh object into a binary STL file. */
     bool SaveBinarySTL(std::ostream& output) const;
+    /** Writes the facets of the mesh object in ASCII STL format, without
+     * the enclosing solid and endsolid lines.
+     */
+    bool SaveAsciiSTLFacets(std::ostream& output) const;
+    /** Writes the facets of the mesh object in binary STL format, without
+     * the header and the number of facets.
+     */
+    bool SaveBinarySTLFacets(std::ostream& output) const;
     /** Saves the mesh object into an OBJ file. */
     bool SaveOBJ(std::ostream& output) const;
     /** Saves the mesh object into an OBJ file. */
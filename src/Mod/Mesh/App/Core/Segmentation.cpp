@@ -28,6 +28,7 @@
 
 #include "Algorithm.h"
 #include "Approximation.h"
+#include "Functional.h"
 #include "Segmentation.h"
 
 using namespace MeshCore;
@@ -538,9 +539,64 @@ bool MeshSurfaceVisitor::AllowVisit(const MeshFacet& face,
                                     unsigned long,
                                     unsigned short)
 {
+    // a visited facet is rejected anyway, so skip the (possibly expensive) test
+    if (face.IsFlag(MeshFacet::VISIT)) {
+        return false;
+    }
     return segm.TestFacet(face);
 }
 
+// --------------------------------------------------------
+
+namespace
+{
+// Like MeshSurfaceVisitor but it takes the results of the facet test from a pre-computed array
+class MeshTestedSurfaceVisitor: public MeshFacetVisitor
+{
+public:
+    MeshTestedSurfaceVisitor(MeshSurfaceSegment& segm,
+                             const std::vector<char>& accepted,
+                             std::vector<FacetIndex>& indices)
+        : indices(indices)
+        , accepted(accepted)
+        , segm(segm)
+    {}
+    bool AllowVisit(const MeshFacet&,
+                    const MeshFacet&,
+                    FacetIndex ulFInd,
+                    unsigned long,
+                    unsigned short) override
+    {
+        return accepted[ulFInd] != 0;
+    }
+    bool Visit(const MeshFacet& face, const MeshFacet&, FacetIndex ulFInd, unsigned long) override
+    {
+        indices.push_back(ulFInd);
+        segm.AddFacet(face);
+        return true;
+    }
+
+private:
+    std::vector<FacetIndex>& indices;
+    const std::vector<char>& accepted;
+    MeshSurfaceSegment& segm;
+};
+
+std::vector<char> testFacets(const MeshSurfaceSegment& segm, const MeshFacetArray& rFAry)
+{
+    std::vector<char> result(rFAry.size());
+    parallel_for(
+        rFAry.size(),
+        [&](std::size_t begin, std::size_t end) {
+            for (std::size_t index = begin; index < end; index++) {
+                result[index] = segm.TestFacet(rFAry[index]) ? 1 : 0;
+            }
+        },
+        thread_count(0));
+    return result;
+}
+}  // namespace
+
 bool MeshSurfaceVisitor::Visit(const MeshFacet& face,
                                const MeshFacet&,
                                FacetIndex ulFInd,
@@ -553,7 +609,7 @@ bool MeshSurfaceVisitor::Visit(const MeshFacet& face,
 
 // --------------------------------------------------------
 
-void MeshSegmentAlgorithm::FindSegments(std::vector<MeshSurfaceSegmentPtr>& segm)
+void MeshSegmentAlgorithm::FindSegments(std::vector<MeshSurfaceSegmentPtr>& segm, bool parallel)
 {
     // reset VISIT flags
     FacetIndex startFacet {};
@@ -573,6 +629,12 @@ void MeshSegmentAlgorithm::FindSegments(std::vector<MeshSurfaceSegmentPtr>& segm
         cAlgo.ResetFacetsFlag(resetVisited, MeshCore::MeshFacet::VISIT);
         resetVisited.clear();
 
+        std::vector<char> accepted;
+        bool tested = parallel && it->IsFacetTestLocal();
+        if (tested) {
+            accepted = testFacets(*it, rFAry);
+        }
+
         MeshCore::MeshIsNotFlag<MeshCore::MeshFacet> flag;
         iCur = std::find_if(iBeg, iEnd, [flag](const MeshFacet& f) {
             return flag(f, MeshFacet::VISIT);
@@ -590,8 +652,14 @@ void MeshSegmentAlgorithm::FindSegments(std::vector<MeshSurfaceSegmentPtr>& segm
             if (it->TestInitialFacet(startFacet)) {
                 indices.push_back(startFacet);
             }
-            MeshSurfaceVisitor pv(*it, indices);
-            myKernel.VisitNeighbourFacets(pv, startFacet);
+            if (tested) {
+                MeshTestedSurfaceVisitor pv(*it, accepted, indices);
+                myKernel.VisitNeighbourFacets(pv, startFacet);
+            }
+            else {
+                MeshSurfaceVisitor pv(*it, indices);
+                myKernel.VisitNeighbourFacets(pv, startFacet);
+            }
 
             // add or discard the segment
             if (indices.size() <= 1) {
@@ -56,6 +56,12 @@ public:
     MeshSurfaceSegment& operator=(MeshSurfaceSegment&&) = delete;
 
     virtual bool TestFacet(const MeshFacet& rclFacet) const = 0;
+    /** Returns true if the result of TestFacet() only depends on the tested facet and not on the
+     * facets added to the segment so far. Such segments can test all facets in parallel. */
+    virtual bool IsFacetTestLocal() const
+    {
+        return false;
+    }
     virtual const char* GetType() const = 0;
     virtual void Initialize(FacetIndex);
     virtual bool TestInitialFacet(FacetIndex) const;
@@ -135,6 +141,12 @@ public:
     virtual float Fit() = 0;
     virtual float GetDistanceToSurface(const Base::Vector3f&) const = 0;
     virtual std::vector<float> Parameters() const = 0;
+    /** Returns true if the surface is given by fixed parameters and thus not fitted to the
+     * added triangles. */
+    virtual bool IsFixed() const
+    {
+        return false;
+    }
 };
 
 class MeshExport PlaneSurfaceFit: public AbstractSurfaceFit
@@ -160,6 +172,10 @@ public:
     float Fit() override;
     float GetDistanceToSurface(const Base::Vector3f&) const override;
     std::vector<float> Parameters() const override;
+    bool IsFixed() const override
+    {
+        return fitter == nullptr;
+    }
 
 private:
     Base::Vector3f basepoint;
@@ -190,6 +206,10 @@ public:
     float Fit() override;
     float GetDistanceToSurface(const Base::Vector3f&) const override;
     std::vector<float> Parameters() const override;
+    bool IsFixed() const override
+    {
+        return fitter == nullptr;
+    }
 
 private:
     Base::Vector3f basepoint;
@@ -221,6 +241,10 @@ public:
     float Fit() override;
     float GetDistanceToSurface(const Base::Vector3f&) const override;
     std::vector<float> Parameters() const override;
+    bool IsFixed() const override
+    {
+        return fitter == nullptr;
+    }
 
 private:
     Base::Vector3f center;
@@ -245,6 +269,10 @@ public:
     operator=(MeshDistanceGenericSurfaceFitSegment&&) = delete;
 
     bool TestFacet(const MeshFacet& face) const override;
+    bool IsFacetTestLocal() const override
+    {
+        return fitter->IsFixed();
+    }
     const char* GetType() const override
     {
         return fitter->GetType();
@@ -272,6 +300,10 @@ public:
     {
         return info.at(pos);
     }
+    bool IsFacetTestLocal() const override
+    {
+        return true;
+    }
 
 private:
     const std::vector<CurvatureInfo>& info;
@@ -392,7 +424,10 @@ public:
     explicit MeshSegmentAlgorithm(const MeshKernel& kernel)
         : myKernel(kernel)
     {}
-    void FindSegments(std::vector<MeshSurfaceSegmentPtr>&);
+    /** Grows the segments of each surface type in \a segm one after another. With \a parallel
+     * the facets of segments with a local facet test are tested concurrently before the regions
+     * are grown. The result is the same as of the serial run. */
+    void FindSegments(std::vector<MeshSurfaceSegmentPtr>&, bool parallel = false);
 
 private:
     const MeshKernel& myKernel;
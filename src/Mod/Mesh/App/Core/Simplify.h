@@ -12,9 +12,12 @@
 // * Comment out printf statements
 // * Fix compiler warnings
 // * Remove macros loop,i,j,k
+// * Compute normals, quadrics, edge errors and borders in parallel
 
 #include <vector>
 
+#include "Functional.h"
+
 using vec3f = Base::Vector3f;
 
 class SymmetricMatrix {
@@ -93,8 +96,8 @@ public:
 private:
     // Helper functions
 
-    double vertex_error(const SymmetricMatrix& q, double x, double y, double z);
-    double calculate_error(int id_v1, int id_v2, vec3f &p_result);
+    double vertex_error(const SymmetricMatrix& q, double x, double y, double z) const;
+    double calculate_error(int id_v1, int id_v2, vec3f &p_result) const;
     bool flipped(vec3f p,int i0,int i1,Vertex &v0,Vertex &v1,std::vector<int> &deleted);
     void update_triangles(int i0,Vertex &v,std::vector<int> &deleted,int &deleted_triangles);
     void update_mesh(int iteration);
@@ -341,31 +344,21 @@ void Simplify::update_mesh(int iteration)
     // recomputing during the simplification is not required,
     // but mostly improves the result for closed meshes
     //
+    const int threads = MeshCore::thread_count(0);
     if (iteration == 0)
     {
-        for (std::size_t i=0;i<vertices.size();++i)
-            vertices[i].q=SymmetricMatrix(0.0);
-
-        for (std::size_t i=0;i<triangles.size();++i)
-        {
-            Triangle &t=triangles[i];
-            vec3f n,p[3];
-            for (std::size_t j=0;j<3;++j)
-                p[j]=vertices[t.v[j]].p;
-            n = (p[1]-p[0]).Cross(p[2]-p[0]);
-            n.Normalize();
-            t.n=n;
-            for (std::size_t j=0;j<3;++j)
-                vertices[t.v[j]].q = vertices[t.v[j]].q+SymmetricMatrix(n.x,n.y,n.z,-n.Dot(p[0]));
-        }
-        for (std::size_t i=0;i<triangles.size();++i)
-        {
-            // Calc Edge Error
-            Triangle &t=triangles[i];vec3f p;
-            for (std::size_t j=0;j<3;++j)
-                t.err[j] = calculate_error(t.v[j],t.v[(j+1)%3],p);
-            t.err[3]=std::min(t.err[0],std::min(t.err[1],t.err[2]));
-        }
+        MeshCore::parallel_for(triangles.size(), [this](std::size_t begin, std::size_t end) {
+            for (std::size_t i=begin;i<end;++i)
+            {
+                Triangle &t=triangles[i];
+                vec3f n,p[3];
+                for (std::size_t j=0;j<3;++j)
+                    p[j]=vertices[t.v[j]].p;
+                n = (p[1]-p[0]).Cross(p[2]-p[0]);
+                n.Normalize();
+                t.n=n;
+            }
+        }, threads);
     }
 
     // Init Reference ID list
@@ -403,48 +396,78 @@ void Simplify::update_mesh(int iteration)
         }
     }
 
-    // Identify boundary : vertices[].border=0,1
     if (iteration == 0)
     {
-        std::vector<int> vcount,vids;
-
-        for (std::size_t i=0;i<vertices.size();++i)
-            vertices[i].border=0;
+        // Gather the plane quadrics of the adjacent triangles of each vertex.
+        // The references are sorted by triangle, so the sums don't depend on
+        // the number of threads.
+        MeshCore::parallel_for(vertices.size(), [this](std::size_t begin, std::size_t end) {
+            for (std::size_t i=begin;i<end;++i)
+            {
+                Vertex &v=vertices[i];
+                v.q=SymmetricMatrix(0.0);
+                for (int k=0;k<v.tcount;++k)
+                {
+                    const Triangle &t=triangles[refs[v.tstart+k].tid];
+                    const vec3f &n=t.n;
+                    v.q += SymmetricMatrix(n.x,n.y,n.z,-n.Dot(vertices[t.v[0]].p));
+                }
+            }
+        }, threads);
 
-        for (std::size_t i=0;i<vertices.size();++i)
-        {
-            Vertex &v=vertices[i];
-            vcount.clear();
-            vids.clear();
-            for (int j=0; j<v.tcount; ++j)
+        // Calc Edge Error, before the borders are known
+        MeshCore::parallel_for(triangles.size(), [this](std::size_t begin, std::size_t end) {
+            vec3f p;
+            for (std::size_t i=begin;i<end;++i)
+            {
+                Triangle &t=triangles[i];
+                for (std::size_t j=0;j<3;++j)
+                    t.err[j] = calculate_error(t.v[j],t.v[(j+1)%3],p);
+                t.err[3]=std::min(t.err[0],std::min(t.err[1],t.err[2]));
+            }
+        }, threads);
+
+        // Identify boundary : vertices[].border=0,1
+        // A vertex is at the boundary if one of its neighbours shares only a
+        // single triangle with it. Each vertex only sets its own flag.
+        MeshCore::parallel_for(vertices.size(), [this](std::size_t begin, std::size_t end) {
+            std::vector<int> vcount,vids;
+            for (std::size_t i=begin;i<end;++i)
             {
-                int k=refs[v.tstart+j].tid;
-                Triangle &t=triangles[k];
-                for (int k=0;k<3;++k)
+                Vertex &v=vertices[i];
+                vcount.clear();
+                vids.clear();
+                for (int j=0; j<v.tcount; ++j)
                 {
-                    std::size_t ofs=0; int id=t.v[k];
-                    while(ofs<vcount.size())
+                    int k=refs[v.tstart+j].tid;
+                    Triangle &t=triangles[k];
+                    for (int k=0;k<3;++k)
                     {
-                        if (vids[ofs]==id)
-                            break;
-                        ofs++;
-                    }
-                    if(ofs==vcount.size())
-                    {
-                        vcount.push_back(1);
-                        vids.push_back(id);
-                    }
-                    else
-                    {
-                        vcount[ofs]++;
+                        std::size_t ofs=0; int id=t.v[k];
+                        while(ofs<vcount.size())
+                        {
+                            if (vids[ofs]==id)
+                                break;
+                            ofs++;
+                        }
+                        if(ofs==vcount.size())
+                        {
+                            vcount.push_back(1);
+                            vids.push_back(id);
+                        }
+                        else
+                        {
+                            vcount[ofs]++;
+                        }
                     }
                 }
+                v.border=0;
+                for (std::size_t j=0;j<vcount.size();++j) {
+                    if (vcount[j]==1)
+                        v.border=1;
+                }
             }
-            for (std::size_t j=0;j<vcount.size();++j) {
-                if (vcount[j]==1)
-                    vertices[vids[j]].border=1;
-            }
-        }
+        }, threads);
     }
 }
 
@@ -490,7 +513,7 @@ void Simplify::compact_mesh()
 
 // Error between vertex and Quadric
 
-double Simplify::vertex_error(const SymmetricMatrix& q, double x, double y, double z)
+double Simplify::vertex_error(const SymmetricMatrix& q, double x, double y, double z) const
 {
     return   q[0]*x*x + 2*q[1]*x*y + 2*q[2]*x*z + 2*q[3]*x + q[4]*y*y
          + 2*q[5]*y*z + 2*q[6]*y + q[7]*z*z + 2*q[8]*z + q[9];
@@ -498,7 +521,7 @@ double Simplify::vertex_error(const SymmetricMatrix& q, double x, double y, doub
 
 // Error for one edge
 
-double Simplify::calculate_error(int id_v1, int id_v2, vec3f &p_result)
+double Simplify::calculate_error(int id_v1, int id_v2, vec3f &p_result) const
 {
     // compute interpolated vertex
 
@@ -34,9 +34,9 @@
 namespace MeshCore
 {
 class MeshKernel;
-class MeshRefPointToPoints;
-class MeshRefPointToFacets;
-class MeshRefFacetToFacets;
+class MeshCompactPointToPoints;
+class MeshCompactPointToFacets;
+class MeshCompactFacetToFacets;
 
 /** Base class for smoothing algorithms. */
 class MeshExport AbstractSmoothing
@@ -109,11 +109,13 @@ public:
     }
 
 protected:
-    void Umbrella(const MeshRefPointToPoints&, const MeshRefPointToFacets&, double);
-    void Umbrella(const MeshRefPointToPoints&,
-                  const MeshRefPointToFacets&,
-                  double,
-                  const std::vector<PointIndex>&);
+    /** Returns the points of \a point_indices the umbrella operator can move. Border points and
+     * points with less than three neighbours are kept fixed. */
+    std::vector<PointIndex> InnerPoints(const MeshCompactPointToPoints&,
+                                        const std::vector<PointIndex>&) const;
+    /** Moves the points \a point_indices by one umbrella step. All new positions are computed
+     * from the old ones before any of them is assigned. */
+    void Umbrella(const MeshCompactPointToPoints&, const std::vector<PointIndex>&, double);
 
 private:
     double lambda {0.6307};
@@ -151,8 +153,8 @@ public:
     void SmoothPoints(unsigned int, const std::vector<PointIndex>&) override;
 
 private:
-    void UpdatePoints(const MeshRefFacetToFacets&,
-                      const MeshRefPointToFacets&,
+    void UpdatePoints(const MeshCompactFacetToFacets&,
+                      const MeshCompactPointToFacets&,
                       const std::vector<PointIndex>&);
 
 private:
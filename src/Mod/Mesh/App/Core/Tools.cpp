@@ -85,7 +85,7 @@ MeshSearchNeighbours::NeighboursFromFacet(FacetIndex ulFacetIdx,
         std::set<PointIndex> aclTmp;
         aclTmp.swap(_aclOuter);
         for (PointIndex pI : aclTmp) {
-            const std::set<FacetIndex>& rclISet = _clPt2Fa[pI];
+            auto rclISet = _clPt2Fa[pI];
             // search all facets hanging on this point
             for (FacetIndex pJ : rclISet) {
                 const MeshFacet& rclF = f_beg[pJ];
@@ -185,7 +185,7 @@ MeshSearchNeighbours::NeighboursFromSampledFacets(FacetIndex ulFacetIdx,
         std::set<PointIndex> aclTmp;
         aclTmp.swap(_aclOuter);
         for (PointIndex pI : aclTmp) {
-            const std::set<FacetIndex>& rclISet = _clPt2Fa[pI];
+            auto rclISet = _clPt2Fa[pI];
             // search all facets hanging on this point
             for (FacetIndex pJ : rclISet) {
                 const MeshFacet& rclF = f_beg[pJ];
@@ -307,7 +307,7 @@ MeshSearchNeighbours::NeighboursFacetFromFacet(FacetIndex ulFacetIdx,
         std::set<PointIndex> aclTmp;
         aclTmp.swap(_aclOuter);
         for (PointIndex pI : aclTmp) {
-            const std::set<FacetIndex>& rclISet = _clPt2Fa[pI];
+            auto rclISet = _clPt2Fa[pI];
             // search all facets hanging on this point
             for (FacetIndex pJ : rclISet) {
                 const MeshFacet& rclF = f_beg[pJ];
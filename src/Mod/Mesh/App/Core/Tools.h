@@ -96,7 +96,7 @@ private:
     const MeshKernel& _rclMesh;
     const MeshFacetArray& _rclFAry;
     const MeshPointArray& _rclPAry;
-    MeshRefPointToFacets _clPt2Fa;
+    MeshCompactPointToFacets _clPt2Fa;
     float _fMaxDistanceP2 {0};                                   // square distance
     Base::Vector3f _clCenter;                                    // center points of start facet
     std::set<PointIndex> _aclResult;                             // result container (point indices)
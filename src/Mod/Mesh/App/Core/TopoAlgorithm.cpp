@@ -1670,7 +1670,7 @@ void MeshTopoAlgorithm::FillupHoles(int level,
                                     std::list<std::vector<PointIndex>>& aFailed)
 {
     // get the facets to a point
-    MeshRefPointToFacets cPt2Fac(_rclMesh);
+    MeshCompactPointToFacets cPt2Fac(_rclMesh);
     MeshAlgorithm cAlgo(_rclMesh);
 
     MeshFacetArray newFacets;
@@ -99,7 +99,7 @@ unsigned long MeshKernel::VisitNeighbourFacetsOverCorners(MeshFacetVisitor& rclF
                                                           FacetIndex ulStartFacet) const
 {
     unsigned long ulVisited = 0, ulLevel = 0;
-    MeshRefPointToFacets clRPF(*this);
+    MeshCompactPointToFacets clRPF(*this);
     const MeshFacetArray& raclFAry = _aclFacetArray;
     MeshFacetArray::_TConstIterator pFBegin = raclFAry.begin();
     std::vector<FacetIndex> aclCurrentLevel, aclNextLevel;
@@ -117,8 +117,7 @@ unsigned long MeshKernel::VisitNeighbourFacetsOverCorners(MeshFacetVisitor& rclF
              ++pCurrFacet) {
             for (int i = 0; i < 3; i++) {
                 const MeshFacet& rclFacet = raclFAry[*pCurrFacet];
-                const std::set<FacetIndex>& raclNB = clRPF[rclFacet._aulPoints[i]];
-                for (FacetIndex pINb : raclNB) {
+                for (FacetIndex pINb : clRPF[rclFacet._aulPoints[i]]) {
                     if (!pFBegin[pINb].IsFlag(MeshFacet::VISIT)) {
                         // only visit if VISIT Flag not set
                         ulVisited++;
@@ -150,7 +149,7 @@ unsigned long MeshKernel::VisitNeighbourPoints(MeshPointVisitor& rclPVisitor,
     std::vector<PointIndex> aclCurrentLevel, aclNextLevel;
     std::vector<PointIndex>::iterator clCurrIter;
     MeshPointArray::_TConstIterator pPBegin = _aclPointArray.begin();
-    MeshRefPointToPoints clNPs(*this);
+    MeshCompactPointToPoints clNPs(*this);
 
     aclCurrentLevel.push_back(ulStartPoint);
     (pPBegin + ulStartPoint)->SetFlag(MeshPoint::VISIT);
@@ -159,8 +158,7 @@ unsigned long MeshKernel::VisitNeighbourPoints(MeshPointVisitor& rclPVisitor,
         // visit all neighbours of the current level
         for (clCurrIter = aclCurrentLevel.begin(); clCurrIter < aclCurrentLevel.end();
              ++clCurrIter) {
-            const std::set<PointIndex>& raclNB = clNPs[*clCurrIter];
-            for (PointIndex pINb : raclNB) {
+            for (PointIndex pINb : clNPs[*clCurrIter]) {
                 if (!pPBegin[pINb].IsFlag(MeshPoint::VISIT)) {
                     // only visit if VISIT Flag not set
                     ulVisited++;
@@ -23,9 +23,12 @@
  ***************************************************************************/
 
 #include <algorithm>
+#include <exception>
+#include <set>
 #include <boost/algorithm/string/replace.hpp>
 #include <boost/core/ignore_unused.hpp>
 #include <vector>
+#include <QtConcurrentMap>
 
 
 #include <App/Application.h>
@@ -103,47 +106,129 @@ std::string Exporter::xmlEscape(const std::string& input)
 
 int Exporter::addObject(App::DocumentObject* obj, float tol)
 {
-    int count = 0;
-    for (std::string& sub : expandSubObjectNames(obj, subObjectNameCache, 0)) {
-        Base::Matrix4D matrix;
-        auto sobj = obj->getSubObject(sub.c_str(), nullptr, &matrix);
-        auto linked = sobj->getLinkedObject(true, &matrix, false);
-        auto it = meshCache.find(linked);
-        if (it == meshCache.end()) {
+    return addObjects({obj}, tol);
+}
+
+namespace
+{
+// A sub-object to pass to addMesh()
+struct ExportEntry
+{
+    App::DocumentObject* sobj;
+    const App::DocumentObject* linked;
+    Base::Matrix4D matrix;
+};
+
+// A shape that is not in the mesh cache yet
+struct TessellateTask
+{
+    const App::DocumentObject* linked;
+    PyObject* pyobj;
+    const Data::ComplexGeoData* geoData;
+    std::vector<Base::Vector3d> points;
+    std::vector<Data::ComplexGeoData::Facet> facets;
+    MeshObject mesh;
+    std::exception_ptr error;
+};
+}  // namespace
+
+int Exporter::addObjects(const std::vector<App::DocumentObject*>& objs, float tol)
+{
+    // Collect the sub-objects and their shapes first, which requires the GIL
+    std::vector<ExportEntry> entries;
+    std::vector<TessellateTask> tasks;
+    std::set<const App::DocumentObject*> pending;
+    for (auto obj : objs) {
+        for (std::string& sub : expandSubObjectNames(obj, subObjectNameCache, 0)) {
+            Base::Matrix4D matrix;
+            auto sobj = obj->getSubObject(sub.c_str(), nullptr, &matrix);
+            if (!sobj) {
+                continue;
+            }
+            auto linked = sobj->getLinkedObject(true, &matrix, false);
+            entries.push_back({sobj, linked, matrix});
+            if (meshCache.find(linked) != meshCache.end() || !pending.insert(linked).second) {
+                continue;
+            }
+
             if (linked->isDerivedFrom<Mesh::Feature>()) {
-                it = meshCache.emplace(linked, static_cast<Mesh::Feature*>(linked)->Mesh.getValue())
-                         .first;
-                it->second.setTransform(matrix);
+                meshCache.emplace(linked, static_cast<Mesh::Feature*>(linked)->Mesh.getValue());
+                continue;
+            }
+
+            Base::PyGILStateLocker lock;
+            PyObject* pyobj = nullptr;
+            linked->getSubObject("", &pyobj, nullptr, false);
+            if (!pyobj) {
+                continue;
+            }
+            if (PyObject_TypeCheck(pyobj, &Data::ComplexGeoDataPy::Type)) {
+                auto geoData = static_cast<Data::ComplexGeoDataPy*>(pyobj)->getComplexGeoDataPtr();
+                tasks.push_back({linked, pyobj, geoData, {}, {}, MeshObject(), nullptr});
             }
             else {
-                Base::PyGILStateLocker lock;
-                PyObject* pyobj = nullptr;
-                linked->getSubObject("", &pyobj, nullptr, false);
-                if (!pyobj) {
-                    continue;
-                }
-                if (PyObject_TypeCheck(pyobj, &Data::ComplexGeoDataPy::Type)) {
-                    std::vector<Base::Vector3d> aPoints;
-                    std::vector<Data::ComplexGeoData::Facet> aTopo;
-                    auto geoData =
-                        static_cast<Data::ComplexGeoDataPy*>(pyobj)->getComplexGeoDataPtr();
-                    geoData->getFaces(aPoints, aTopo, tol);
-                    it = meshCache.emplace(linked, MeshObject()).first;
-                    it->second.setFacets(aTopo, aPoints);
-                    it->second.setTransform(matrix);
-                }
                 Py_DECREF(pyobj);
             }
         }
-        else if (it->second.getTransform() != matrix) {
-            it->second.setTransform(matrix);
+    }
+
+    // Different shapes may share sub-shapes, and meshing stores the
+    // triangulation in them, so the shapes are tessellated one after another.
+    // Only building the mesh structures runs concurrently. The Python objects
+    // keep the shapes alive.
+    for (auto& task : tasks) {
+        try {
+            task.geoData->getFaces(task.points, task.facets, tol);
+        }
+        catch (...) {
+            task.error = std::current_exception();
+        }
+    }
+    auto buildMesh = [](TessellateTask& task) {
+        if (task.error) {
+            return;
         }
+        try {
+            task.mesh.setFacets(task.facets, task.points);
+        }
+        catch (...) {
+            task.error = std::current_exception();
+        }
+        task.points.clear();
+        task.facets.clear();
+    };
+    if (parallel && tasks.size() > 1) {
+        QtConcurrent::blockingMap(tasks, buildMesh);
+    }
+    else {
+        std::for_each(tasks.begin(), tasks.end(), buildMesh);
+    }
 
-        // Add a new mesh
-        if (it != meshCache.end()) {
-            if (addMesh(sobj->Label.getValue(), it->second)) {
-                ++count;
-            }
+    {
+        Base::PyGILStateLocker lock;
+        for (auto& task : tasks) {
+            Py_DECREF(task.pyobj);
+        }
+    }
+    for (auto& task : tasks) {
+        if (task.error) {
+            std::rethrow_exception(task.error);
+        }
+        meshCache.emplace(task.linked, std::move(task.mesh));
+    }
+
+    // Add the meshes in a deterministic order
+    int count = 0;
+    for (const auto& entry : entries) {
+        auto it = meshCache.find(entry.linked);
+        if (it == meshCache.end()) {
+            continue;
+        }
+        if (it->second.getTransform() != entry.matrix) {
+            it->second.setTransform(entry.matrix);
+        }
+        if (addMesh(entry.sobj->Label.getValue(), it->second)) {
+            ++count;
         }
     }
     return count;
@@ -237,6 +322,74 @@ bool MergeExporter::addMesh(const char* name, const MeshObject& mesh)
 
 // ----------------------------------------------------------------------------
 
+ExporterSTL::ExporterSTL(std::string fileName, MeshIO::Format fmt)
+    : binary(fmt != MeshIO::ASTL)
+{
+    throwIfNoPermission(fileName);
+
+    Base::FileInfo fi(fileName);
+    outputStream = std::make_unique<Base::ofstream>(fi, std::ios::out | std::ios::binary);
+    if (binary) {
+        // Write the header with a facet count of zero that is fixed in write()
+        MeshKernel empty;
+        MeshOutput(empty).SaveBinarySTL(*outputStream);
+        countPos = outputStream->tellp() - std::streamoff(sizeof(numFacets));
+    }
+}
+
+ExporterSTL::~ExporterSTL()
+{
+    write();
+}
+
+void ExporterSTL::write()
+{
+    if (binary) {
+        if (countPos >= 0) {
+            outputStream->seekp(countPos);
+            outputStream->write(reinterpret_cast<const char*>(&numFacets), sizeof(numFacets));
+        }
+    }
+    else {
+        if (solidName.empty()) {
+            solidName = "Mesh";
+            *outputStream << "solid " << solidName << '\n';
+        }
+        *outputStream << "endsolid " << solidName << '\n';
+    }
+}
+
+bool ExporterSTL::addMesh(const char* name, const MeshObject& mesh)
+{
+    const MeshKernel& kernel = mesh.getKernel();
+    if (outputStream->bad() || kernel.CountFacets() == 0) {
+        return false;
+    }
+
+    MeshOutput aWriter(kernel);
+    aWriter.Transform(mesh.getTransform());
+    if (binary) {
+        if (!aWriter.SaveBinarySTLFacets(*outputStream)) {
+            return false;
+        }
+    }
+    else {
+        // The file holds a single solid named after the first object
+        if (solidName.empty()) {
+            solidName = name && name[0] ? name : "Mesh";
+            *outputStream << "solid " << solidName << '\n';
+        }
+        if (!aWriter.SaveAsciiSTLFacets(*outputStream)) {
+            return false;
+        }
+    }
+
+    numFacets += static_cast<uint32_t>(kernel.CountFacets());
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+
 AbstractFormatExtensionPtr GuiExtension3MFProducer::create() const
 {
     return nullptr;
@@ -61,6 +61,22 @@ public:
      */
     int addObject(App::DocumentObject* obj, float tol);
 
+    /// Add several objects, see addObject()
+    /*!
+     * Shapes that are not cached yet are tessellated one after another, as
+     * they may share sub-shapes, and their meshes are then built concurrently,
+     * unless disabled with setParallel(). The meshes are passed to addMesh() in the
+     * order of \a objs and their sub-objects, regardless of the order in
+     * which the tessellation finishes.
+     */
+    int addObjects(const std::vector<App::DocumentObject*>& objs, float tol);
+
+    /// Enables or disables building the meshes concurrently in addObjects()
+    void setParallel(bool on)
+    {
+        parallel = on;
+    }
+
     virtual bool addMesh(const char* name, const MeshObject& mesh) = 0;
 
     Exporter(const Exporter&) = delete;
@@ -75,6 +91,9 @@ protected:
 
     std::map<const App::DocumentObject*, std::vector<std::string>> subObjectNameCache;
     std::map<const App::DocumentObject*, MeshObject> meshCache;
+
+private:
+    bool parallel {true};
 };
 
 /// Creates a single mesh, in a file, from one or more objects
@@ -102,6 +121,37 @@ protected:
     // NOLINTEND
 };
 
+/// Writes the meshes of one or more objects to an ASCII or binary STL file
+/*!
+ * Unlike MergeExporter the facets are written out as soon as a mesh is added,
+ * so the meshes are never merged into a single kernel in memory.
+ */
+class MeshExport ExporterSTL: public Exporter
+{
+public:
+    ExporterSTL(std::string fileName, MeshCore::MeshIO::Format fmt);
+    /// Writes the number of facets of a binary STL
+    ~ExporterSTL() override;
+
+    ExporterSTL(const ExporterSTL&) = delete;
+    ExporterSTL(ExporterSTL&&) = delete;
+    ExporterSTL& operator=(const ExporterSTL&) = delete;
+    ExporterSTL& operator=(ExporterSTL&&) = delete;
+
+    bool addMesh(const char* name, const MeshObject& mesh) override;
+
+private:
+    /// Write the end of the output file
+    void write();
+
+private:
+    std::unique_ptr<std::ostream> outputStream;
+    std::string solidName;
+    std::streamoff countPos {-1};
+    uint32_t numFacets {0};
+    bool binary;
+};
+
 // ------------------------------------------------------------------------------------------------
 
 /*!
@@ -2227,7 +2227,7 @@ PyObject* MeshPy::getSegmentsByCurvature(PyObject* args) const
                                                                      c2));
     }
 
-    finder.FindSegments(segm);
+    finder.FindSegments(segm, true);
 
     Py::List list;
     for (const auto& segmIt : segm) {
@@ -114,7 +114,7 @@ void Segmentation::accept()
                                                                    ui->numPln->value(),
                                                                    ui->tolPln->value()));
     }
-    finder.FindSegments(segm);
+    finder.FindSegments(segm, true);
 
     App::Document* document = App::GetApplication().getActiveDocument();
     document->openTransaction("Segmentation");
@@ -498,7 +498,7 @@ void SegmentationBestFit::accept()
                                                                              ui->numPln->value(),
                                                                              ui->tolPln->value()));
     }
-    finder.FindSegments(segm);
+    finder.FindSegments(segm, true);
 
     App::Document* document = App::GetApplication().getActiveDocument();
     document->openTransaction("Segmentation");
@@ -1920,7 +1920,7 @@ void ViewProviderMesh::fillHole(Mesh::FacetIndex uFacet)
     // get the boundary to the picked facet
     std::list<Mesh::PointIndex> aBorder;
     const MeshCore::MeshKernel& rKernel = getMeshObject().getKernel();
-    MeshCore::MeshRefPointToFacets cPt2Fac(rKernel);
+    MeshCore::MeshCompactPointToFacets cPt2Fac(rKernel);
     MeshCore::MeshAlgorithm meshAlg(rKernel);
     meshAlg.GetFacetBorder(uFacet, aBorder);
     std::vector<Mesh::PointIndex> boundary(aBorder.begin(), aBorder.end());
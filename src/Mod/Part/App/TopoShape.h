@@ -2721,6 +2721,8 @@ private:
                                    bool forward,
                                    bool& warned);
     void mapCompoundSubElements(const std::vector<TopoShape>& shapes, const char* op);
+    /// Fill the vertex, edge and face maps of this shape and the mappable \a shapes concurrently
+    void initAncestry(const std::vector<TopoShape>& shapes) const;
 
     /** Given a set of edges, return a sorted list of connected edges
      *
@@ -1040,6 +1040,32 @@ void TopoShape::mapCompoundSubElements(const std::vector<TopoShape>& shapes, con
     setMappedChildElements(children);
 }
 
+void TopoShape::initAncestry(const std::vector<TopoShape>& shapes) const
+{
+    // Element mapping looks up every sub-shape through these maps, and building them is the
+    // expensive part for large shapes. Each map belongs to one cache and one shape type, so they
+    // are built in parallel up front while the mapping itself, which writes to the element map
+    // and the string hasher, stays serial.
+    static const std::array<TopAbs_ShapeEnum, 3> types = {TopAbs_VERTEX, TopAbs_EDGE, TopAbs_FACE};
+    std::vector<TopoShapeCache*> caches;
+    for (auto& shape : shapes) {
+        if (canMapElement(shape)) {
+            caches.push_back(shape._cache.get());
+        }
+    }
+    if (caches.empty()) {
+        return;
+    }
+    caches.push_back(_cache.get());
+    std::sort(caches.begin(), caches.end());
+    caches.erase(std::unique(caches.begin(), caches.end()), caches.end());
+
+    int count = static_cast<int>(caches.size() * types.size());
+    OSD_Parallel::For(0, count, [&caches](int index) {
+        caches[index / types.size()]->getAncestry(types[index % types.size()]);
+    });
+}
+
 void TopoShape::mapSubElement(const std::vector<TopoShape>& shapes, const char* op)
 {
     if (shapes.empty()) {
@@ -1090,6 +1116,9 @@ void TopoShape::mapSubElement(const std::vector<TopoShape>& shapes, const char*
         }
     }
 
+    if (shapes.size() > 1) {
+        initAncestry(shapes);
+    }
     for (auto& shape : shapes) {
         mapSubElement(shape, op);
     }
@@ -1420,7 +1449,7 @@ TopoShape& TopoShape::makeShapeWithElementMap(const TopoDS_Shape& shape,
     std::string _op = op;
     _op += '_';
 
-    initCache();
+    initAncestry(shapes);
     ShapeInfo vertexInfo(_Shape, TopAbs_VERTEX, _cache->getAncestry(TopAbs_VERTEX));
     ShapeInfo edgeInfo(_Shape, TopAbs_EDGE, _cache->getAncestry(TopAbs_EDGE));
     ShapeInfo faceInfo(_Shape, TopAbs_FACE, _cache->getAncestry(TopAbs_FACE));
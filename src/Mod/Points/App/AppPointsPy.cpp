@@ -22,6 +22,7 @@
  *                                                                         *
  ***************************************************************************/
 
+#include <limits>
 #include <memory>
 
 
@@ -34,6 +35,7 @@
 #include <Base/FileInfo.h>
 #include <Base/Interpreter.h>
 
+#include "ChunkedPoints.h"
 #include "Points.h"
 #include "PointsAlgos.h"
 #include "PointsPy.h"
@@ -60,7 +62,7 @@ public:
     }
 
 private:
-    std::tuple<bool, bool, double> readE57Settings() const
+    std::tuple<bool, bool, double, double> readE57Settings() const
     {
         Base::Reference<ParameterGrp> hGrp = App::GetApplication()
                                                  .GetUserParameter()
@@ -70,8 +72,52 @@ private:
         bool useColor = hGrp->GetBool("UseColor", true);
         bool checkState = hGrp->GetBool("CheckInvalidState", true);
         double minDistance = hGrp->GetFloat("MinDistance", -1.);
+        double voxelSize = hGrp->GetFloat("VoxelSize", -1.);
 
-        return std::make_tuple(useColor, checkState, minDistance);
+        return std::make_tuple(useColor, checkState, minDistance, voxelSize);
+    }
+    /** If a point limit is set, E57 and PLY files are read into a ChunkedPointStore
+     * and only its level of detail with at most this number of points is passed to
+     * \a lod. Returns true in this case, otherwise the points are kept by \a reader.
+     */
+    bool readPoints(Reader& reader,
+                    const Base::FileInfo& file,
+                    const std::string& filename,
+                    PointKernel& lod) const
+    {
+        Base::Reference<ParameterGrp> hGrp = App::GetApplication()
+                                                 .GetUserParameter()
+                                                 .GetGroup("BaseApp")
+                                                 ->GetGroup("Preferences")
+                                                 ->GetGroup("Mod/Points");
+        std::size_t maxPoints = hGrp->GetUnsigned("OutOfCoreLimit", 0);
+        if (maxPoints == 0 || !(file.hasExtension("e57") || file.hasExtension("ply"))) {
+            reader.read(filename);
+            return false;
+        }
+
+        ChunkedPointStore store;
+        reader.setPointStore(&store);
+        reader.read(filename);
+        reader.setPointStore(nullptr);
+        lod = store.getPoints(maxPoints);
+        if (lod.size() < store.size()) {
+            Base::Console().warning("%s: %zu of %zu points are loaded\n",
+                                    file.fileName().c_str(),
+                                    lod.size(),
+                                    store.size());
+        }
+        return true;
+    }
+    /** The width of a structured cloud. Throws if it doesn't fit into the
+     * long of PropertyInteger, which has only 32 bits on Windows.
+     */
+    static long getWidth(const Reader& reader)
+    {
+        if (reader.getWidth() > std::numeric_limits<long>::max()) {
+            throw Base::ValueError("Structured point cloud is too wide");
+        }
+        return static_cast<long>(reader.getWidth());
     }
     Py::Object open(const Py::Tuple& args)
     {
@@ -97,9 +143,11 @@ private:
             }
             else if (file.hasExtension("e57")) {
                 auto setting = readE57Settings();
-                reader = std::make_unique<E57Reader>(std::get<0>(setting),
-                                                     std::get<1>(setting),
-                                                     std::get<2>(setting));
+                auto e57 = std::make_unique<E57Reader>(std::get<0>(setting),
+                                                       std::get<1>(setting),
+                                                       std::get<2>(setting));
+                e57->setVoxelSize(std::get<3>(setting));
+                reader = std::move(e57);
             }
             else if (file.hasExtension("ply")) {
                 reader = std::make_unique<PlyReader>();
@@ -111,7 +159,10 @@ private:
                 throw Py::RuntimeError("Unsupported file extension");
             }
 
-            reader->read(EncodedName);
+            PointKernel lod;
+            bool outOfCore = readPoints(*reader, file, EncodedName, lod);
+            const PointKernel& points = outOfCore ? lod : reader->getPoints();
+            long columns = reader->isStructured() ? getWidth(*reader) : 0;
 
             App::Document* pcDoc = App::GetApplication().newDocument();
 
@@ -124,7 +175,7 @@ private:
                     App::PropertyInteger* width =
                         static_cast<App::PropertyInteger*>(pcFeature->getPropertyByName("Width"));
                     if (width) {
-                        width->setValue(reader->getWidth());
+                        width->setValue(columns);
                     }
                     App::PropertyInteger* height =
                         static_cast<App::PropertyInteger*>(pcFeature->getPropertyByName("Height"));
@@ -136,7 +187,7 @@ private:
                     pcFeature = new Points::FeatureCustom();
                 }
 
-                pcFeature->Points.setValue(reader->getPoints());
+                pcFeature->Points.setValue(points);
                 // add gray values
                 if (reader->hasIntensities()) {
                     Points::PropertyGreyValueList* prop =
@@ -172,7 +223,7 @@ private:
             else {
                 if (reader->isStructured()) {
                     Structured* structured = new Points::Structured();
-                    structured->Width.setValue(reader->getWidth());
+                    structured->Width.setValue(columns);
                     structured->Height.setValue(reader->getHeight());
                     pcFeature = structured;
                 }
@@ -181,7 +232,7 @@ private:
                 }
 
                 // delayed adding of the points feature
-                pcFeature->Points.setValue(reader->getPoints());
+                pcFeature->Points.setValue(points);
                 pcDoc->addObject(pcFeature, file.fileNamePure().c_str());
                 pcDoc->recomputeFeature(pcFeature);
                 pcFeature->purgeTouched();
@@ -219,9 +270,11 @@ private:
             }
             else if (file.hasExtension("e57")) {
                 auto setting = readE57Settings();
-                reader = std::make_unique<E57Reader>(std::get<0>(setting),
-                                                     std::get<1>(setting),
-                                                     std::get<2>(setting));
+                auto e57 = std::make_unique<E57Reader>(std::get<0>(setting),
+                                                       std::get<1>(setting),
+                                                       std::get<2>(setting));
+                e57->setVoxelSize(std::get<3>(setting));
+                reader = std::move(e57);
             }
             else if (file.hasExtension("ply")) {
                 reader = std::make_unique<PlyReader>();
@@ -233,7 +286,10 @@ private:
                 throw Py::RuntimeError("Unsupported file extension");
             }
 
-            reader->read(EncodedName);
+            PointKernel lod;
+            bool outOfCore = readPoints(*reader, file, EncodedName, lod);
+            const PointKernel& points = outOfCore ? lod : reader->getPoints();
+            long columns = reader->isStructured() ? getWidth(*reader) : 0;
 
             App::Document* pcDoc = App::GetApplication().getDocument(DocName);
             if (!pcDoc) {
@@ -249,7 +305,7 @@ private:
                     App::PropertyInteger* width =
                         static_cast<App::PropertyInteger*>(pcFeature->getPropertyByName("Width"));
                     if (width) {
-                        width->setValue(reader->getWidth());
+                        width->setValue(columns);
                     }
                     App::PropertyInteger* height =
                         static_cast<App::PropertyInteger*>(pcFeature->getPropertyByName("Height"));
@@ -261,7 +317,7 @@ private:
                     pcFeature = new Points::FeatureCustom();
                 }
 
-                pcFeature->Points.setValue(reader->getPoints());
+                pcFeature->Points.setValue(points);
                 // add gray values
                 if (reader->hasIntensities()) {
                     Points::PropertyGreyValueList* prop =
@@ -296,7 +352,7 @@ private:
             }
             else {
                 auto* pcFeature = pcDoc->addObject<Points::Feature>(file.fileNamePure().c_str());
-                pcFeature->Points.setValue(reader->getPoints());
+                pcFeature->Points.setValue(points);
                 pcDoc->recomputeFeature(pcFeature);
                 pcFeature->purgeTouched();
             }
@@ -0,0 +1,576 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2025 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+#include <algorithm>
+#include <limits>
+
+#include <Base/Exception.h>
+#include <Base/Stream.h>
+
+#include "ChunkedPoints.h"
+
+
+using namespace Points;
+
+namespace
+{
+constexpr std::size_t NoNode = std::numeric_limits<std::size_t>::max();
+
+// Cells aren't split any further below this level so that a pile of equal
+// points cannot cause an endless subdivision
+constexpr int MinLevel = -24;
+
+std::streamsize getByteSize(std::size_t count)
+{
+    return static_cast<std::streamsize>(count * sizeof(ChunkedPointStore::value_type));
+}
+
+int getOctant(const Base::BoundBox3f& cell, const Base::Vector3f& pnt)
+{
+    Base::Vector3f center = cell.GetCenter();
+    int octant = 0;
+    if (pnt.x >= center.x) {
+        octant |= 1;
+    }
+    if (pnt.y >= center.y) {
+        octant |= 2;
+    }
+    if (pnt.z >= center.z) {
+        octant |= 4;
+    }
+    return octant;
+}
+
+Base::BoundBox3f getOctantBox(const Base::BoundBox3f& cell, int octant)
+{
+    Base::Vector3f center = cell.GetCenter();
+    Base::BoundBox3f box = cell;
+    if (octant & 1) {
+        box.MinX = center.x;
+    }
+    else {
+        box.MaxX = center.x;
+    }
+    if (octant & 2) {
+        box.MinY = center.y;
+    }
+    else {
+        box.MaxY = center.y;
+    }
+    if (octant & 4) {
+        box.MinZ = center.z;
+    }
+    else {
+        box.MaxZ = center.z;
+    }
+    return box;
+}
+}  // namespace
+
+bool ChunkedPointStore::Node::isLeaf() const
+{
+    return children[0] == NoNode;
+}
+
+ChunkedPointStore::ChunkedPointStore(std::size_t chunkSize,
+                                     std::size_t sampleSize,
+                                     std::size_t memoryLimit)
+    : chunkSize {std::max<std::size_t>(chunkSize, 1)}
+    , sampleSize {sampleSize}
+    , memoryLimit {memoryLimit}
+{}
+
+ChunkedPointStore::~ChunkedPointStore()
+{
+    clear();
+}
+
+void ChunkedPointStore::clear()
+{
+    nodes.clear();
+    leaves.clear();
+    leavesValid = false;
+    root = 0;
+    numPoints = 0;
+    inMemory = 0;
+    boundBox = Base::BoundBox3f();
+
+    swapReader.reset();
+    if (swapWriter) {
+        swapWriter.reset();
+        swapFile.deleteFile();
+    }
+    swapSize = 0;
+    freeSegments.clear();
+}
+
+std::size_t ChunkedPointStore::addNode(const Base::BoundBox3f& cell, int level)
+{
+    Node node;
+    node.cell = cell;
+    node.level = level;
+    node.children.fill(NoNode);
+    nodes.push_back(std::move(node));
+    return nodes.size() - 1;
+}
+
+void ChunkedPointStore::add(const std::vector<value_type>& pnts)
+{
+    for (const auto& it : pnts) {
+        add(it);
+    }
+}
+
+void ChunkedPointStore::add(const value_type& pnt)
+{
+    if (nodes.empty()) {
+        root = addNode(Base::BoundBox3f(pnt, 0.5F), 0);
+    }
+
+    while (!nodes[root].cell.IsInBox(pnt)) {
+        growRoot(pnt);
+    }
+
+    boundBox.Add(pnt);
+    numPoints++;
+    leavesValid = false;
+    insert(root, pnt);
+
+    if (inMemory > memoryLimit) {
+        swapOut();
+    }
+}
+
+void ChunkedPointStore::growRoot(const value_type& pnt)
+{
+    // The new root has twice the edge length and the old root as one of its
+    // octants, extended towards the point
+    Base::BoundBox3f cell = nodes[root].cell;
+    float length = cell.LengthX();
+    int octant = 0;
+    if (pnt.x < cell.MinX) {
+        cell.MinX -= length;
+        octant |= 1;
+    }
+    else {
+        cell.MaxX += length;
+    }
+    if (pnt.y < cell.MinY) {
+        cell.MinY -= length;
+        octant |= 2;
+    }
+    else {
+        cell.MaxY += length;
+    }
+    if (pnt.z < cell.MinZ) {
+        cell.MinZ -= length;
+        octant |= 4;
+    }
+    else {
+        cell.MaxZ += length;
+    }
+
+    int level = nodes[root].level;
+    std::size_t index = addNode(cell, level + 1);
+    for (int i = 0; i < 8; i++) {
+        std::size_t child = (i == octant) ? root : addNode(getOctantBox(cell, i), level);
+        nodes[index].children[i] = child;
+    }
+
+    // all points so far are below the old root, so its sample is valid for the new one
+    nodes[index].count = nodes[root].count;
+    nodes[index].sample = nodes[root].sample;
+    root = index;
+}
+
+void ChunkedPointStore::addSample(Node& node, const value_type& pnt)
+{
+    // reservoir sampling keeps a uniform subsample of all points seen so far
+    node.count++;
+    if (node.sample.size() < sampleSize) {
+        node.sample.push_back(pnt);
+    }
+    else if (sampleSize > 0) {
+        std::uniform_int_distribution<std::size_t> dist(0, node.count - 1);
+        std::size_t pos = dist(random);
+        if (pos < sampleSize) {
+            node.sample[pos] = pnt;
+        }
+    }
+}
+
+void ChunkedPointStore::insert(std::size_t index, const value_type& pnt)
+{
+    for (;;) {
+        Node& node = nodes[index];
+        addSample(node, pnt);
+        if (!node.isLeaf()) {
+            index = node.children[getOctant(node.cell, pnt)];
+            continue;
+        }
+
+        node.points.push_back(pnt);
+        inMemory++;
+        if (node.count > chunkSize && node.level > MinLevel) {
+            split(index);
+        }
+        break;
+    }
+}
+
+void ChunkedPointStore::split(std::size_t index)
+{
+    std::vector<value_type> pnts = readLeaf(index);
+    releaseSegments(nodes[index].segments);
+    inMemory -= nodes[index].points.size();
+    std::vector<value_type>().swap(nodes[index].points);
+    std::vector<Segment>().swap(nodes[index].segments);
+
+    Base::BoundBox3f cell = nodes[index].cell;
+    int level = nodes[index].level;
+    for (int i = 0; i < 8; i++) {
+        std::size_t child = addNode(getOctantBox(cell, i), level - 1);
+        nodes[index].children[i] = child;
+    }
+
+    for (const auto& it : pnts) {
+        insert(nodes[index].children[getOctant(cell, it)], it);
+    }
+}
+
+void ChunkedPointStore::swapOut()
+{
+    if (!swapWriter) {
+        swapFile.setFile(Base::FileInfo::getTempFileName());
+        swapWriter = std::make_unique<Base::ofstream>(swapFile,
+                                                      std::ios::out | std::ios::binary
+                                                          | std::ios::trunc);
+    }
+
+    std::vector<std::size_t> buffered;
+    for (std::size_t i = 0; i < nodes.size(); i++) {
+        if (nodes[i].isLeaf() && !nodes[i].points.empty()) {
+            buffered.push_back(i);
+        }
+    }
+
+    // write the largest buffers until half of the limit is reached so that
+    // the store doesn't have to swap on every further point
+    std::sort(buffered.begin(), buffered.end(), [this](std::size_t lhs, std::size_t rhs) {
+        return nodes[lhs].points.size() > nodes[rhs].points.size();
+    });
+
+    for (std::size_t index : buffered) {
+        if (inMemory <= memoryLimit / 2) {
+            break;
+        }
+
+        // fill the ranges of split chunks first and append the rest
+        Node& node = nodes[index];
+        const value_type* pnts = node.points.data();
+        std::size_t remaining = node.points.size();
+        while (remaining > 0 && !freeSegments.empty()) {
+            auto it = freeSegments.begin();
+            auto [offset, size] = *it;
+            freeSegments.erase(it);
+            std::size_t count = std::min(remaining, size);
+            writeSegment(node, offset, pnts, count);
+            if (count < size) {
+                freeSegments.emplace(offset + getByteSize(count), size - count);
+            }
+            pnts += count;
+            remaining -= count;
+        }
+        if (remaining > 0) {
+            writeSegment(node, swapSize, pnts, remaining);
+            swapSize += getByteSize(remaining);
+        }
+
+        inMemory -= node.points.size();
+        std::vector<value_type>().swap(node.points);
+    }
+
+    swapWriter->flush();
+}
+
+void ChunkedPointStore::writeSegment(Node& node,
+                                     std::streamoff offset,
+                                     const value_type* pnts,
+                                     std::size_t count)
+{
+    swapWriter->seekp(offset);
+    swapWriter->write(reinterpret_cast<const char*>(pnts), getByteSize(count));
+    if (!*swapWriter) {
+        throw Base::FileException("Failed to write points to swap file", swapFile);
+    }
+
+    node.segments.push_back({offset, count});
+}
+
+void ChunkedPointStore::releaseSegments(const std::vector<Segment>& segments)
+{
+    // merge adjacent ranges so that whole chunks fit into them again
+    for (const auto& it : segments) {
+        auto pos = freeSegments.emplace(it.offset, it.count).first;
+        if (pos != freeSegments.begin()) {
+            auto prev = std::prev(pos);
+            if (prev->first + getByteSize(prev->second) == pos->first) {
+                prev->second += pos->second;
+                freeSegments.erase(pos);
+                pos = prev;
+            }
+        }
+        auto next = std::next(pos);
+        if (next != freeSegments.end() && pos->first + getByteSize(pos->second) == next->first) {
+            pos->second += next->second;
+            freeSegments.erase(next);
+        }
+    }
+
+    // a range at the end of the file is used for appending again
+    if (!freeSegments.empty()) {
+        auto last = std::prev(freeSegments.end());
+        if (last->first + getByteSize(last->second) == swapSize) {
+            swapSize = last->first;
+            freeSegments.erase(last);
+        }
+    }
+}
+
+std::vector<ChunkedPointStore::value_type> ChunkedPointStore::readLeaf(std::size_t index) const
+{
+    const Node& node = nodes[index];
+    std::vector<value_type> pnts;
+    pnts.reserve(node.count);
+
+    if (!node.segments.empty()) {
+        if (!swapReader) {
+            swapReader = std::make_unique<Base::ifstream>(swapFile,
+                                                          std::ios::in | std::ios::binary);
+        }
+
+        for (const auto& it : node.segments) {
+            std::size_t pos = pnts.size();
+            pnts.resize(pos + it.count);
+            swapReader->clear();
+            swapReader->seekg(it.offset);
+            swapReader->read(reinterpret_cast<char*>(pnts.data() + pos),
+                             static_cast<std::streamsize>(it.count * sizeof(value_type)));
+            if (!*swapReader) {
+                throw Base::FileException("Failed to read points from swap file", swapFile);
+            }
+        }
+    }
+
+    pnts.insert(pnts.end(), node.points.begin(), node.points.end());
+    return pnts;
+}
+
+const std::vector<std::size_t>& ChunkedPointStore::getLeaves() const
+{
+    if (!leavesValid) {
+        // depth-first order keeps neighbouring chunks close to each other
+        leaves.clear();
+        std::vector<std::size_t> stack;
+        if (!nodes.empty()) {
+            stack.push_back(root);
+        }
+        while (!stack.empty()) {
+            std::size_t index = stack.back();
+            stack.pop_back();
+            const Node& node = nodes[index];
+            if (node.isLeaf()) {
+                if (node.count > 0) {
+                    leaves.push_back(index);
+                }
+            }
+            else {
+                stack.insert(stack.end(), node.children.rbegin(), node.children.rend());
+            }
+        }
+        leavesValid = true;
+    }
+
+    return leaves;
+}
+
+unsigned int ChunkedPointStore::getDepth() const
+{
+    unsigned int depth = 0;
+    std::vector<std::pair<std::size_t, unsigned int>> stack;
+    if (!nodes.empty()) {
+        stack.emplace_back(root, 0);
+    }
+    while (!stack.empty()) {
+        auto [index, level] = stack.back();
+        stack.pop_back();
+        depth = std::max(depth, level);
+        const Node& node = nodes[index];
+        if (!node.isLeaf()) {
+            for (std::size_t child : node.children) {
+                stack.emplace_back(child, level + 1);
+            }
+        }
+    }
+
+    return depth;
+}
+
+std::vector<ChunkedPointStore::value_type>
+ChunkedPointStore::getLevelOfDetail(unsigned int depth, const Base::BoundBox3f& box) const
+{
+    std::vector<value_type> pnts;
+    std::vector<std::pair<std::size_t, unsigned int>> stack;
+    if (!nodes.empty()) {
+        stack.emplace_back(root, 0);
+    }
+    while (!stack.empty()) {
+        auto [index, level] = stack.back();
+        stack.pop_back();
+        const Node& node = nodes[index];
+        if (node.count == 0 || (box.IsValid() && !node.cell.Intersect(box))) {
+            continue;
+        }
+
+        if (level == depth || node.isLeaf()) {
+            pnts.insert(pnts.end(), node.sample.begin(), node.sample.end());
+        }
+        else {
+            for (std::size_t child : node.children) {
+                stack.emplace_back(child, level + 1);
+            }
+        }
+    }
+
+    return pnts;
+}
+
+PointKernel ChunkedPointStore::getPoints(std::size_t maxPoints) const
+{
+    std::vector<value_type> pnts;
+    if (numPoints <= maxPoints) {
+        pnts.reserve(numPoints);
+        for (std::size_t index : getLeaves()) {
+            std::vector<value_type> chunk = readLeaf(index);
+            pnts.insert(pnts.end(), chunk.begin(), chunk.end());
+        }
+    }
+    else {
+        unsigned int depth = getDepth();
+        for (unsigned int level = 0; level <= depth; level++) {
+            std::vector<value_type> lod = getLevelOfDetail(level);
+            if (lod.size() > maxPoints) {
+                // the samples are random, so a part of them is still uniform
+                if (level == 0) {
+                    lod.resize(maxPoints);
+                    pnts.swap(lod);
+                }
+                break;
+            }
+            pnts.swap(lod);
+        }
+    }
+
+    PointKernel kernel;
+    kernel.swap(pnts);
+    return kernel;
+}
+
+std::size_t ChunkedPointStore::countChunks() const
+{
+    return getLeaves().size();
+}
+
+std::size_t ChunkedPointStore::getChunkSize(std::size_t index) const
+{
+    return nodes[getLeaves().at(index)].count;
+}
+
+Base::BoundBox3f ChunkedPointStore::getChunkBoundBox(std::size_t index) const
+{
+    return nodes[getLeaves().at(index)].cell;
+}
+
+bool ChunkedPointStore::isChunkInMemory(std::size_t index) const
+{
+    return nodes[getLeaves().at(index)].segments.empty();
+}
+
+PointKernel ChunkedPointStore::getChunk(std::size_t index) const
+{
+    std::vector<value_type> pnts = readLeaf(getLeaves().at(index));
+    PointKernel kernel;
+    kernel.swap(pnts);
+    return kernel;
+}
+
+ChunkedPointStore::const_chunk_iterator ChunkedPointStore::begin() const
+{
+    return {this, 0};
+}
+
+ChunkedPointStore::const_chunk_iterator ChunkedPointStore::end() const
+{
+    return {this, countChunks()};
+}
+
+// ----------------------------------------------------------------------------
+
+ChunkedPointStore::const_chunk_iterator::const_chunk_iterator(const ChunkedPointStore* owner,
+                                                              std::size_t pos)
+    : store(owner)
+    , index(pos)
+{}
+
+const PointKernel& ChunkedPointStore::const_chunk_iterator::operator*()
+{
+    if (!loaded) {
+        chunk = store->getChunk(index);
+        loaded = true;
+    }
+    return chunk;
+}
+
+const PointKernel* ChunkedPointStore::const_chunk_iterator::operator->()
+{
+    return &(operator*());
+}
+
+bool ChunkedPointStore::const_chunk_iterator::operator==(const const_chunk_iterator& it) const
+{
+    return (this->store == it.store) && (this->index == it.index);
+}
+
+bool ChunkedPointStore::const_chunk_iterator::operator!=(const const_chunk_iterator& it) const
+{
+    return !operator==(it);
+}
+
+ChunkedPointStore::const_chunk_iterator& ChunkedPointStore::const_chunk_iterator::operator++()
+{
+    ++index;
+    chunk.clear();
+    loaded = false;
+    return *this;
+}
@@ -0,0 +1,219 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2025 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+#ifndef POINTS_CHUNKEDPOINTS_H
+#define POINTS_CHUNKEDPOINTS_H
+
+#include <array>
+#include <iosfwd>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <Base/BoundBox.h>
+#include <Base/FileInfo.h>
+
+#include "Points.h"
+
+
+namespace Base
+{
+class ifstream;
+class ofstream;
+}  // namespace Base
+
+namespace Points
+{
+
+/**
+ * The ChunkedPointStore holds a point cloud that can be much larger than the
+ * available memory. The points are sorted into the cells of an octree whose
+ * leaves, the chunks, are split once they get more than a given number of
+ * points. When the points kept in memory exceed a limit the largest chunks are
+ * moved into a temporary file and only read back when they are requested.
+ *
+ * The octree grows with the data, so the points can be added in one pass
+ * without knowing their bounding box in advance. Each node keeps a random
+ * subsample of all the points below it which gives a coarse representation of
+ * the cloud, or a part of it, without accessing the disk.
+ */
+class PointsExport ChunkedPointStore
+{
+public:
+    using value_type = PointKernel::value_type;
+
+    /** \a chunkSize is the number of points a chunk holds before it gets split,
+     * \a sampleSize the number of points each node keeps for the level of detail
+     * and \a memoryLimit the number of chunk points that are kept in memory.
+     */
+    explicit ChunkedPointStore(std::size_t chunkSize = 1U << 18U,
+                               std::size_t sampleSize = 1U << 10U,
+                               std::size_t memoryLimit = 1U << 24U);
+    ~ChunkedPointStore();
+
+    ChunkedPointStore(const ChunkedPointStore&) = delete;
+    ChunkedPointStore(ChunkedPointStore&&) = delete;
+    ChunkedPointStore& operator=(const ChunkedPointStore&) = delete;
+    ChunkedPointStore& operator=(ChunkedPointStore&&) = delete;
+
+    /** @name Modification */
+    //@{
+    void add(const value_type& pnt);
+    void add(const std::vector<value_type>& pnts);
+    /// Removes all points and the temporary file
+    void clear();
+    //@}
+
+    /** @name Inquiry */
+    //@{
+    /// Number of points stored
+    std::size_t size() const
+    {
+        return numPoints;
+    }
+    /// Bounding box of all points
+    const Base::BoundBox3f& getBoundBox() const
+    {
+        return boundBox;
+    }
+    /// Number of bytes of the temporary file that are in use or can be reused
+    std::size_t getSwapSize() const
+    {
+        return static_cast<std::size_t>(swapSize);
+    }
+    /// Depth of the octree
+    unsigned int getDepth() const;
+    /** Returns the samples of the nodes at level \a depth, or of the leaves above
+     * it, that intersect with \a box. An invalid box selects all nodes.
+     */
+    std::vector<value_type> getLevelOfDetail(unsigned int depth,
+                                             const Base::BoundBox3f& box = Base::BoundBox3f()) const;
+    /** Returns all points if there are not more than \a maxPoints, otherwise
+     * the finest level of detail that doesn't exceed \a maxPoints.
+     */
+    PointKernel getPoints(std::size_t maxPoints) const;
+    //@}
+
+    /** @name Chunks */
+    //@{
+    /// Number of non-empty chunks
+    std::size_t countChunks() const;
+    /// Number of points of the chunk
+    std::size_t getChunkSize(std::size_t index) const;
+    /// Octree cell of the chunk
+    Base::BoundBox3f getChunkBoundBox(std::size_t index) const;
+    /// Checks whether no points of the chunk were moved to disk
+    bool isChunkInMemory(std::size_t index) const;
+    /// Returns the points of the chunk and reads them from disk if needed
+    PointKernel getChunk(std::size_t index) const;
+    //@}
+
+    /** Iterates over the chunks of the store where only the chunk the iterator
+     * points to is held as PointKernel. This way algorithms written for a
+     * PointKernel can process the whole cloud piece by piece.
+     */
+    class PointsExport const_chunk_iterator
+    {
+    public:
+        using value_type = PointKernel;
+        using difference_type = std::ptrdiff_t;
+        using iterator_category = std::input_iterator_tag;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+
+        const_chunk_iterator(const ChunkedPointStore* owner, std::size_t pos);
+
+        const value_type& operator*();
+        const value_type* operator->();
+        bool operator==(const const_chunk_iterator& it) const;
+        bool operator!=(const const_chunk_iterator& it) const;
+        const_chunk_iterator& operator++();
+
+    private:
+        const ChunkedPointStore* store;
+        std::size_t index;
+        PointKernel chunk;
+        bool loaded {false};
+    };
+
+    const_chunk_iterator begin() const;
+    const_chunk_iterator end() const;
+
+private:
+    struct Segment
+    {
+        std::streamoff offset;
+        std::size_t count;
+    };
+
+    struct Node
+    {
+        Base::BoundBox3f cell;
+        std::array<std::size_t, 8> children;
+        int level {0};
+        std::size_t count {0};
+        std::vector<value_type> sample;
+        std::vector<value_type> points;
+        std::vector<Segment> segments;
+
+        bool isLeaf() const;
+    };
+
+    std::size_t addNode(const Base::BoundBox3f& cell, int level);
+    void growRoot(const value_type& pnt);
+    void insert(std::size_t index, const value_type& pnt);
+    void addSample(Node& node, const value_type& pnt);
+    void split(std::size_t index);
+    void swapOut();
+    void writeSegment(Node& node, std::streamoff offset, const value_type* pnts, std::size_t count);
+    void releaseSegments(const std::vector<Segment>& segments);
+    std::vector<value_type> readLeaf(std::size_t index) const;
+    const std::vector<std::size_t>& getLeaves() const;
+
+private:
+    std::size_t chunkSize;
+    std::size_t sampleSize;
+    std::size_t memoryLimit;
+    std::size_t numPoints {0};
+    std::size_t inMemory {0};
+    std::size_t root {0};
+    std::vector<Node> nodes;
+    Base::BoundBox3f boundBox;
+    std::minstd_rand random;
+
+    Base::FileInfo swapFile;
+    std::streamoff swapSize {0};
+    /// Ranges of the temporary file left behind by split chunks, offset and number of points
+    std::map<std::streamoff, std::size_t> freeSegments;
+    std::unique_ptr<Base::ofstream> swapWriter;
+    mutable std::unique_ptr<Base::ifstream> swapReader;
+    mutable std::vector<std::size_t> leaves;
+    mutable bool leavesValid {false};
+};
+
+}  // namespace Points
+
+
+#endif  // POINTS_CHUNKEDPOINTS_H
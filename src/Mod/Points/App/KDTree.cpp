@@ -0,0 +1,282 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2025 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+#include <algorithm>
+#include <deque>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <thread>
+#include <QtConcurrentMap>
+
+#include "KDTree.h"
+
+
+using namespace Points;
+
+namespace
+{
+// Ranges of at most this many points are not split any further
+constexpr std::size_t LeafSize = 8;
+
+// Keeps the k closest points found so far in a max-heap
+class NearestVisitor
+{
+public:
+    explicit NearestVisitor(std::size_t num)
+        : k(num)
+    {}
+
+    void visit(std::size_t index, float sqrDist)
+    {
+        if (heap.size() < k) {
+            heap.emplace(sqrDist, index);
+        }
+        else if (sqrDist < heap.top().first) {
+            heap.pop();
+            heap.emplace(sqrDist, index);
+        }
+    }
+
+    float sqrRadius() const
+    {
+        return heap.size() < k ? std::numeric_limits<float>::max() : heap.top().first;
+    }
+
+    std::vector<std::size_t> result()
+    {
+        std::vector<std::size_t> indices(heap.size());
+        for (auto it = indices.rbegin(); it != indices.rend(); ++it) {
+            *it = heap.top().second;
+            heap.pop();
+        }
+        return indices;
+    }
+
+private:
+    std::size_t k;
+    std::priority_queue<std::pair<float, std::size_t>> heap;
+};
+
+// Collects all points within a fixed distance
+class RadiusVisitor
+{
+public:
+    explicit RadiusVisitor(float radius)
+        : sqrDistance(radius * radius)
+    {}
+
+    void visit(std::size_t index, float sqrDist)
+    {
+        if (sqrDist <= sqrDistance) {
+            indices.push_back(index);
+        }
+    }
+
+    float sqrRadius() const
+    {
+        return sqrDistance;
+    }
+
+    std::vector<std::size_t> result()
+    {
+        return std::move(indices);
+    }
+
+private:
+    float sqrDistance;
+    std::vector<std::size_t> indices;
+};
+
+template<typename T, typename Func>
+void fillConcurrent(std::vector<T>& values, std::size_t count, Func func)
+{
+    values.resize(count);
+    const T* first = values.data();
+    QtConcurrent::blockingMap(values, [first, &func](T& value) {
+        value = func(static_cast<std::size_t>(&value - first));
+    });
+}
+}  // namespace
+
+KDTree::KDTree(const std::vector<Base::Vector3f>& pnts)
+    : points(pnts)
+{
+    build();
+}
+
+KDTree::KDTree(const PointKernel& kernel)
+    : points(kernel.getBasicPoints())
+{
+    build();
+}
+
+void KDTree::build()
+{
+    indices.resize(points.size());
+    std::iota(indices.begin(), indices.end(), 0);
+    axes.resize(points.size());
+
+    // split the top levels one after another until there are enough
+    // independent ranges to keep all threads busy
+    std::size_t numRanges = 4 * std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    std::vector<Range> ranges;
+    std::deque<Range> pending;
+    pending.push_back({0, indices.size()});
+    while (!pending.empty()) {
+        Range range = pending.front();
+        pending.pop_front();
+        if (range.last - range.first <= LeafSize
+            || ranges.size() + pending.size() >= numRanges) {
+            ranges.push_back(range);
+            continue;
+        }
+
+        index_type mid = splitRange(range.first, range.last);
+        pending.push_back({range.first, mid});
+        pending.push_back({mid + 1, range.last});
+    }
+
+    QtConcurrent::blockingMap(ranges, [this](const Range& range) {
+        buildRange(range.first, range.last);
+    });
+}
+
+void KDTree::buildRange(index_type first, index_type last)
+{
+    while (last - first > LeafSize) {
+        index_type mid = splitRange(first, last);
+        buildRange(first, mid);
+        first = mid + 1;
+    }
+}
+
+KDTree::index_type KDTree::splitRange(index_type first, index_type last)
+{
+    Base::Vector3f minPt = points[indices[first]];
+    Base::Vector3f maxPt = minPt;
+    for (index_type i = first + 1; i < last; i++) {
+        const Base::Vector3f& pnt = points[indices[i]];
+        minPt.x = std::min(minPt.x, pnt.x);
+        minPt.y = std::min(minPt.y, pnt.y);
+        minPt.z = std::min(minPt.z, pnt.z);
+        maxPt.x = std::max(maxPt.x, pnt.x);
+        maxPt.y = std::max(maxPt.y, pnt.y);
+        maxPt.z = std::max(maxPt.z, pnt.z);
+    }
+
+    Base::Vector3f len = maxPt - minPt;
+    unsigned short axis = 0;
+    if (len.y > len.x && len.y >= len.z) {
+        axis = 1;
+    }
+    else if (len.z > len.x && len.z > len.y) {
+        axis = 2;
+    }
+
+    index_type mid = first + (last - first) / 2;
+    auto begin = indices.begin();
+    using diff_t = std::vector<index_type>::difference_type;
+    std::nth_element(begin + static_cast<diff_t>(first),
+                     begin + static_cast<diff_t>(mid),
+                     begin + static_cast<diff_t>(last),
+                     [this, axis](index_type lhs, index_type rhs) {
+                         return points[lhs][axis] < points[rhs][axis];
+                     });
+    axes[mid] = static_cast<std::uint8_t>(axis);
+    return mid;
+}
+
+template<typename Visitor>
+void KDTree::search(index_type first,
+                    index_type last,
+                    const Base::Vector3f& pnt,
+                    Visitor& visitor) const
+{
+    if (last - first <= LeafSize) {
+        for (index_type i = first; i < last; i++) {
+            visitor.visit(indices[i], Base::DistanceP2(pnt, points[indices[i]]));
+        }
+        return;
+    }
+
+    index_type mid = first + (last - first) / 2;
+    unsigned short axis = axes[mid];
+    const Base::Vector3f& split = points[indices[mid]];
+    visitor.visit(indices[mid], Base::DistanceP2(pnt, split));
+
+    // descend into the half of the query point first, the other half can only
+    // contain closer points if the split plane is within the search radius
+    float diff = pnt[axis] - split[axis];
+    if (diff < 0.0F) {
+        search(first, mid, pnt, visitor);
+        if (diff * diff <= visitor.sqrRadius()) {
+            search(mid + 1, last, pnt, visitor);
+        }
+    }
+    else {
+        search(mid + 1, last, pnt, visitor);
+        if (diff * diff <= visitor.sqrRadius()) {
+            search(first, mid, pnt, visitor);
+        }
+    }
+}
+
+std::vector<KDTree::index_type> KDTree::findNearest(const Base::Vector3f& pnt, std::size_t k) const
+{
+    NearestVisitor visitor(k);
+    if (k > 0 && !indices.empty()) {
+        search(0, indices.size(), pnt, visitor);
+    }
+    return visitor.result();
+}
+
+std::vector<KDTree::index_type> KDTree::findInRadius(const Base::Vector3f& pnt, float radius) const
+{
+    RadiusVisitor visitor(radius);
+    if (!indices.empty()) {
+        search(0, indices.size(), pnt, visitor);
+    }
+    return visitor.result();
+}
+
+std::vector<std::vector<KDTree::index_type>>
+KDTree::findNearest(const std::vector<Base::Vector3f>& pnts, std::size_t k) const
+{
+    std::vector<std::vector<index_type>> result;
+    fillConcurrent(result, pnts.size(), [&](std::size_t i) {
+        return findNearest(pnts[i], k);
+    });
+    return result;
+}
+
+std::vector<std::vector<KDTree::index_type>>
+KDTree::findInRadius(const std::vector<Base::Vector3f>& pnts, float radius) const
+{
+    std::vector<std::vector<index_type>> result;
+    fillConcurrent(result, pnts.size(), [&](std::size_t i) {
+        return findInRadius(pnts[i], radius);
+    });
+    return result;
+}
@@ -0,0 +1,102 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2025 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+#ifndef POINTS_KDTREE_H
+#define POINTS_KDTREE_H
+
+#include <cstdint>
+#include <vector>
+
+#include <Base/Vector3D.h>
+
+#include "Points.h"
+
+
+namespace Points
+{
+
+/**
+ * A static kd-tree to find the nearest neighbours of a point cloud.
+ *
+ * The tree only consists of a permutation of the point indices: each range of
+ * the permutation is split at its median along the longest side of its
+ * bounding box with std::nth_element, and the split axis is stored at the
+ * position of the median. Ranges of only a few points are searched linearly.
+ * Once the top levels have produced enough independent ranges these are
+ * split concurrently.
+ *
+ * The tree refers to the points it was created with, so they must neither be
+ * modified nor destroyed as long as the tree is in use.
+ */
+class PointsExport KDTree
+{
+public:
+    using index_type = std::size_t;
+
+    explicit KDTree(const std::vector<Base::Vector3f>& pnts);
+    /// Uses the points of \a kernel in its local coordinate system
+    explicit KDTree(const PointKernel& kernel);
+
+    std::size_t size() const
+    {
+        return indices.size();
+    }
+
+    /** @name Queries */
+    //@{
+    /// Returns the indices of the \a k nearest points, the closest point first
+    std::vector<index_type> findNearest(const Base::Vector3f& pnt, std::size_t k) const;
+    /// Returns the indices of all points closer than \a radius in no particular order
+    std::vector<index_type> findInRadius(const Base::Vector3f& pnt, float radius) const;
+    /// Runs findNearest() for all of \a pnts concurrently
+    std::vector<std::vector<index_type>> findNearest(const std::vector<Base::Vector3f>& pnts,
+                                                     std::size_t k) const;
+    /// Runs findInRadius() for all of \a pnts concurrently
+    std::vector<std::vector<index_type>> findInRadius(const std::vector<Base::Vector3f>& pnts,
+                                                      float radius) const;
+    //@}
+
+private:
+    struct Range
+    {
+        index_type first;
+        index_type last;
+    };
+
+    void build();
+    void buildRange(index_type first, index_type last);
+    index_type splitRange(index_type first, index_type last);
+
+    template<typename Visitor>
+    void search(index_type first, index_type last, const Base::Vector3f& pnt, Visitor& visitor) const;
+
+private:
+    const std::vector<Base::Vector3f>& points;
+    std::vector<index_type> indices;
+    std::vector<std::uint8_t> axes;
+};
+
+}  // namespace Points
+
+
+#endif  // POINTS_KDTREE_H
@@ -0,0 +1,159 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2025 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <queue>
+#include <Eigen/Eigenvalues>
+#include <QtConcurrentMap>
+
+#include "KDTree.h"
+#include "NormalEstimation.h"
+
+
+using namespace Points;
+
+NormalEstimation::NormalEstimation(const PointKernel& kernel)
+    : points(kernel.getBasicPoints())
+{}
+
+std::vector<Base::Vector3f> NormalEstimation::perform() const
+{
+    KDTree tree(points);
+
+    std::vector<Base::Vector3f> normals(points.size());
+    const Base::Vector3f* first = normals.data();
+    QtConcurrent::blockingMap(normals, [&](Base::Vector3f& normal) {
+        auto index = static_cast<std::size_t>(&normal - first);
+        std::vector<std::size_t> neighbours = tree.findNearest(points[index], kSearch);
+        if (neighbours.size() < 3) {
+            return;
+        }
+
+        // coordinates relative to the point keep the covariance accurate far
+        // away from the origin
+        const Base::Vector3f& origin = points[index];
+        Eigen::Vector3d mean = Eigen::Vector3d::Zero();
+        for (std::size_t it : neighbours) {
+            Base::Vector3f pnt = points[it] - origin;
+            mean += Eigen::Vector3d(pnt.x, pnt.y, pnt.z);
+        }
+        mean /= static_cast<double>(neighbours.size());
+
+        Eigen::Matrix3d cov = Eigen::Matrix3d::Zero();
+        for (std::size_t it : neighbours) {
+            Base::Vector3f pnt = points[it] - origin;
+            Eigen::Vector3d dir = Eigen::Vector3d(pnt.x, pnt.y, pnt.z) - mean;
+            cov += dir * dir.transpose();
+        }
+
+        // the eigenvalues are sorted in increasing order
+        Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> eig(cov);
+        Eigen::Vector3d dir = eig.eigenvectors().col(0);
+        normal.Set(static_cast<float>(dir.x()),
+                   static_cast<float>(dir.y()),
+                   static_cast<float>(dir.z()));
+        normal.Normalize();
+    });
+
+    if (orient) {
+        orientNormals(tree, normals);
+    }
+
+    return normals;
+}
+
+void NormalEstimation::orientNormals(const KDTree& tree, std::vector<Base::Vector3f>& normals) const
+{
+    if (points.empty()) {
+        return;
+    }
+
+    Base::Vector3d center;
+    for (const auto& it : points) {
+        center += Base::Vector3d(it.x, it.y, it.z);
+    }
+    center /= static_cast<double>(points.size());
+    Base::Vector3f centroid(static_cast<float>(center.x),
+                            static_cast<float>(center.y),
+                            static_cast<float>(center.z));
+
+    // The farthest point from the centroid that isn't reached yet is the seed of
+    // the next connected part. Its normal is made to point away from the centroid.
+    std::vector<std::size_t> seeds(points.size());
+    std::iota(seeds.begin(), seeds.end(), 0);
+    std::sort(seeds.begin(), seeds.end(), [&](std::size_t lhs, std::size_t rhs) {
+        return Base::DistanceP2(points[lhs], centroid) > Base::DistanceP2(points[rhs], centroid);
+    });
+
+    // Greedily pass the orientation on along the edges between neighbours that
+    // have the most parallel normals, i.e. along a maximum spanning tree
+    struct Edge
+    {
+        float weight;
+        std::size_t from;
+        std::size_t to;
+        bool operator<(const Edge& other) const
+        {
+            return weight < other.weight;
+        }
+    };
+
+    std::vector<char> visited(points.size(), 0);
+    std::priority_queue<Edge> queue;
+    auto addNeighbours = [&](std::size_t index) {
+        for (std::size_t it : tree.findNearest(points[index], kSearch)) {
+            if (!visited[it] && normals[it].Sqr() > 0.0F) {
+                queue.push({std::fabs(normals[index] * normals[it]), index, it});
+            }
+        }
+    };
+
+    for (std::size_t seed : seeds) {
+        if (visited[seed] || normals[seed].Sqr() == 0.0F) {
+            continue;
+        }
+
+        visited[seed] = 1;
+        if (normals[seed] * (points[seed] - centroid) < 0.0F) {
+            normals[seed] = -normals[seed];
+        }
+        addNeighbours(seed);
+
+        while (!queue.empty()) {
+            Edge edge = queue.top();
+            queue.pop();
+            if (visited[edge.to]) {
+                continue;
+            }
+
+            visited[edge.to] = 1;
+            if (normals[edge.from] * normals[edge.to] < 0.0F) {
+                normals[edge.to] = -normals[edge.to];
+            }
+            addNeighbours(edge.to);
+        }
+    }
+}
@@ -0,0 +1,81 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2025 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+#ifndef POINTS_NORMALESTIMATION_H
+#define POINTS_NORMALESTIMATION_H
+
+#include <vector>
+
+#include <Base/Vector3D.h>
+
+#include "Points.h"
+
+
+namespace Points
+{
+class KDTree;
+
+/**
+ * Estimates the normals of a point cloud without any external library.
+ *
+ * The normal of a point is the direction of least variance of its k nearest
+ * neighbours, which are searched with a KDTree. The normals are computed
+ * concurrently. Optionally they are flipped afterwards to point to the same
+ * side of the surface: starting from the outermost point of each connected
+ * part the orientation is passed on along the neighbours whose normals are
+ * most parallel.
+ */
+class PointsExport NormalEstimation
+{
+public:
+    explicit NormalEstimation(const PointKernel& kernel);
+
+    /// Number of neighbours used to fit a plane through a point
+    void setKSearch(std::size_t k)
+    {
+        kSearch = k;
+    }
+    /// Makes the normals point to the same side of the surface
+    void setOrientNormals(bool on)
+    {
+        orient = on;
+    }
+
+    /** Returns one normal per point in the local coordinate system of the
+     * point kernel. Points with less than three neighbours get a null vector.
+     */
+    std::vector<Base::Vector3f> perform() const;
+
+private:
+    void orientNormals(const KDTree& tree, std::vector<Base::Vector3f>& normals) const;
+
+private:
+    const std::vector<Base::Vector3f>& points;
+    std::size_t kSearch {10};
+    bool orient {true};
+};
+
+}  // namespace Points
+
+
+#endif  // POINTS_NORMALESTIMATION_H
@@ -56,6 +56,28 @@ class Points(object):
     def fromValid(self) -> Any:
         """Get a new point object from points with valid coordinates (i.e. that are not NaN)"""
         ...
+
+    @constmethod
+    def nearestNeighbours(self) -> Any:
+        """nearestNeighbours(points, k) -> list
+Return for each of the given points the indices of the k nearest points,
+the closest point first. The queries are processed in parallel."""
+        ...
+
+    @constmethod
+    def neighboursInRadius(self) -> Any:
+        """neighboursInRadius(points, radius) -> list
+Return for each of the given points the indices of all points within radius.
+The queries are processed in parallel."""
+        ...
+
+    @constmethod
+    def estimateNormals(self) -> Any:
+        """estimateNormals([k=10, orient=True]) -> list
+Estimate the normal of each point from a plane fitted through its k nearest
+neighbours. If orient is True the normals are flipped to point to the same
+side of the surface."""
+        ...
     CountPoints: Final[int]
     """Return the number of vertices of the points object."""
 
@@ -27,8 +27,13 @@
 #ifdef FC_OS_LINUX
 #include <unistd.h>
 #endif
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <memory>
 #include <sstream>
+#include <unordered_map>
+#include <QtConcurrentMap>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/lexical_cast.hpp>
@@ -41,7 +46,9 @@
 #include <Base/FileInfo.h>
 #include <Base/Sequencer.h>
 #include <Base/Stream.h>
+#include <Base/Swap.h>
 
+#include "ChunkedPoints.h"
 #include "PointsAlgos.h"
 #include <E57Format.h>
 
@@ -136,6 +143,11 @@ void Reader::clear()
     normals.clear();
 }
 
+void Reader::setPointStore(ChunkedPointStore* store)
+{
+    pointStore = store;
+}
+
 const PointKernel& Reader::getPoints() const
 {
     return points;
@@ -181,7 +193,7 @@ bool Reader::isStructured() const
     return (width > 1 && height > 1);
 }
 
-int Reader::getWidth() const
+std::int64_t Reader::getWidth() const
 {
     return width;
 }
@@ -247,90 +259,182 @@ public:
 
 using ConverterPtr = std::shared_ptr<Converter>;
 
-class DataStreambuf: public std::streambuf
+/// Decodes the fields of binary point records straight from a memory block
+/*!
+ * The header of a file is compiled into a list of typed fields with their
+ * offset and stride, so a value is fetched without going through a stream.
+ * Records can be stored point by point or field by field (\a columnMajor).
+ */
+class BinaryPointData
 {
 public:
-    explicit DataStreambuf(const std::vector<char>& data)
-        : _buffer(data)
-        , _end(int(data.size()))
+    enum class Type
+    {
+        Int8,
+        UInt8,
+        Int16,
+        UInt16,
+        Int32,
+        UInt32,
+        Float32,
+        Float64
+    };
+
+    BinaryPointData(Eigen::Index numPoints, bool bigEndian, bool columnMajor)
+        : numPoints(numPoints)
+        , swap(bigEndian)
+        , columnMajor(columnMajor)
     {}
-    ~DataStreambuf() override = default;
 
-protected:
-    int_type uflow() override
+    void addField(Type type)
     {
-        if (_cur == _end) {
-            return traits_type::eof();
+        std::size_t size = sizeOf(type);
+        Field field {type, 0, 0};
+        if (columnMajor) {
+            field.offset = recordSize * static_cast<std::size_t>(numPoints);
+            field.stride = size;
         }
-
-        return static_cast<DataStreambuf::int_type>(_buffer[_cur++]) & 0x000000ff;
-    }
-    int_type underflow() override
-    {
-        if (_cur == _end) {
-            return traits_type::eof();
+        else {
+            field.offset = recordSize;
         }
-
-        return static_cast<DataStreambuf::int_type>(_buffer[_cur]) & 0x000000ff;
-    }
-    int_type pbackfail(int_type ch) override
-    {
-        if (_cur == _beg || (ch != traits_type::eof() && ch != _buffer[_cur - 1])) {
-            return traits_type::eof();
+        fields.push_back(field);
+        recordSize += size;
+        if (!columnMajor) {
+            for (auto& it : fields) {
+                it.stride = recordSize;
+            }
         }
-
-        return static_cast<DataStreambuf::int_type>(_buffer[--_cur]) & 0x000000ff;
     }
-    std::streamsize showmanyc() override
+
+    /// The number of bytes of all points
+    std::size_t getDataSize() const
     {
-        return _end - _cur;
+        return recordSize * static_cast<std::size_t>(numPoints);
     }
-    pos_type seekoff(std::streambuf::off_type off,
-                     std::ios_base::seekdir way,
-                     std::ios_base::openmode mode = std::ios::in | std::ios::out) override
+
+    /// Reads the data of all points with a single read
+    void read(std::istream& inp)
     {
-        (void)mode;
-        int p_pos = -1;
-        if (way == std::ios_base::beg) {
-            p_pos = _beg;
-        }
-        else if (way == std::ios_base::end) {
-            p_pos = _end;
-        }
-        else if (way == std::ios_base::cur) {
-            p_pos = _cur;
+        std::streamoff ulSize = 0;
+        std::streamoff ulCurr = 0;
+        std::streambuf* buf = inp.rdbuf();
+        if (buf) {
+            ulCurr = buf->pubseekoff(0, std::ios::cur, std::ios::in);
+            ulSize = buf->pubseekoff(0, std::ios::end, std::ios::in);
+            buf->pubseekoff(ulCurr, std::ios::beg, std::ios::in);
+            if (ulCurr + static_cast<std::streamoff>(getDataSize()) > ulSize) {
+                throw Base::BadFormatError("File expects too many elements");
+            }
         }
 
-        if (p_pos > _end) {
-            return traits_type::eof();
+        data.resize(getDataSize());
+        inp.read(data.data(), static_cast<std::streamsize>(data.size()));
+        if (!inp) {
+            throw Base::BadFormatError("File expects too many elements");
         }
+    }
 
-        if (((p_pos + off) > _end) || ((p_pos + off) < _beg)) {
-            return traits_type::eof();
+    /// Reads the next \a count point records, replacing the previously read ones
+    void readBlock(std::istream& inp, Eigen::Index count)
+    {
+        data.resize(recordSize * static_cast<std::size_t>(count));
+        inp.read(data.data(), static_cast<std::streamsize>(data.size()));
+        if (!inp) {
+            throw Base::BadFormatError("File expects too many elements");
         }
+    }
 
-        _cur = p_pos + off;
+    /// Takes the data of all points from an already decoded block
+    void setData(std::vector<char>&& block)
+    {
+        if (block.size() < getDataSize()) {
+            throw Base::BadFormatError("File expects too many elements");
+        }
+        data = std::move(block);
+    }
 
-        return ((p_pos + off) - _beg);
+    double operator()(Eigen::Index row, Eigen::Index col) const
+    {
+        const Field& field = fields[col];
+        const char* ptr = data.data() + field.offset + static_cast<std::size_t>(row) * field.stride;
+        switch (field.type) {
+            case Type::Int8:
+                return value<int8_t>(ptr);
+            case Type::UInt8:
+                return value<uint8_t>(ptr);
+            case Type::Int16:
+                return value<int16_t>(ptr);
+            case Type::UInt16:
+                return value<uint16_t>(ptr);
+            case Type::Int32:
+                return value<int32_t>(ptr);
+            case Type::UInt32:
+                return value<uint32_t>(ptr);
+            case Type::Float32:
+                return value<float>(ptr);
+            case Type::Float64:
+                return value<double>(ptr);
+        }
+        return 0.0;
     }
-    pos_type seekpos(std::streambuf::pos_type pos,
-                     std::ios_base::openmode which = std::ios::in | std::ios::out) override
+
+private:
+    static std::size_t sizeOf(Type type)
     {
-        (void)which;
-        return seekoff(pos, std::ios_base::beg);
+        switch (type) {
+            case Type::Int8:
+            case Type::UInt8:
+                return 1;
+            case Type::Int16:
+            case Type::UInt16:
+                return 2;
+            case Type::Int32:
+            case Type::UInt32:
+            case Type::Float32:
+                return 4;
+            case Type::Float64:
+                return 8;
+        }
+        return 0;
+    }
+
+    template<typename T>
+    double value(const char* ptr) const
+    {
+        T c;
+        std::memcpy(&c, ptr, sizeof(T));
+        if (swap) {
+            Base::SwapEndian(c);
+        }
+        return static_cast<double>(c);
     }
 
-public:
-    DataStreambuf(const DataStreambuf&) = delete;
-    DataStreambuf(DataStreambuf&&) = delete;
-    DataStreambuf& operator=(const DataStreambuf&) = delete;
-    DataStreambuf& operator=(DataStreambuf&&) = delete;
+    struct Field
+    {
+        Type type;
+        std::size_t offset;
+        std::size_t stride;
+    };
 
-private:
-    const std::vector<char>& _buffer;
-    int _beg {0}, _end {0}, _cur {0};
+    Eigen::Index numPoints;
+    bool swap;
+    bool columnMajor;
+    std::size_t recordSize {0};
+    std::vector<Field> fields;
+    std::vector<char> data;
 };
 
+// Resizes \a values to \a count and sets each element to func(index) concurrently
+template<typename T, typename Func>
+void fillParallel(std::vector<T>& values, Eigen::Index count, Func func)
+{
+    values.resize(static_cast<std::size_t>(count));
+    const T* first = values.data();
+    QtConcurrent::blockingMap(values, [first, &func](T& value) {
+        value = func(static_cast<Eigen::Index>(&value - first));
+    });
+}
+
 // NOLINTBEGIN
 // Taken from https://github.com/PointCloudLibrary/pcl/blob/master/io/src/lzf.cpp
 unsigned int
@@ -563,17 +667,6 @@ void PlyReader::read(const std::string& filename)
     this->width = numPoints;
     this->height = 1;
 
-    Eigen::MatrixXd data(numPoints, fields.size());
-    if (format == "ascii") {
-        readAscii(inp, offset, data);
-    }
-    else if (format == "binary_little_endian") {
-        readBinary(false, inp, offset, types, sizes, data);
-    }
-    else if (format == "binary_big_endian") {
-        readBinary(true, inp, offset, types, sizes, data);
-    }
-
     std::vector<std::string>::iterator it;
     Eigen::Index max_size = std::numeric_limits<Eigen::Index>::max();
 
@@ -666,55 +759,90 @@ void PlyReader::read(const std::string& filename)
     bool hasIntensity = (greyvalue != max_size);
     bool hasColor = (red != max_size && green != max_size && blue != max_size);
 
-    if (hasData) {
-        points.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            points.push_back(Base::Vector3d(data(i, x), data(i, y), data(i, z)));
+    auto transfer = [&](const auto& data) {
+        if (hasData) {
+            fillParallel(points.getBasicPoints(), numPoints, [&](Eigen::Index i) {
+                return Base::Vector3f(static_cast<float>(data(i, x)),
+                                      static_cast<float>(data(i, y)),
+                                      static_cast<float>(data(i, z)));
+            });
         }
-    }
 
-    if (hasData && hasNormal) {
-        normals.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            normals.emplace_back(data(i, normal_x), data(i, normal_y), data(i, normal_z));
+        if (hasData && hasNormal) {
+            fillParallel(normals, numPoints, [&](Eigen::Index i) {
+                return Base::Vector3f(static_cast<float>(data(i, normal_x)),
+                                      static_cast<float>(data(i, normal_y)),
+                                      static_cast<float>(data(i, normal_z)));
+            });
         }
-    }
 
-    if (hasData && hasIntensity) {
-        intensity.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            intensity.push_back(static_cast<float>(data(i, greyvalue)));
+        if (hasData && hasIntensity) {
+            fillParallel(intensity, numPoints, [&](Eigen::Index i) {
+                return static_cast<float>(data(i, greyvalue));
+            });
         }
-    }
 
-    if (hasData && hasColor) {
-        colors.reserve(numPoints);
-        float a = 1.0;
-        if (types[red] == "uchar") {
-            for (Eigen::Index i = 0; i < numPoints; i++) {
-                float r = static_cast<float>(data(i, red));
-                float g = static_cast<float>(data(i, green));
-                float b = static_cast<float>(data(i, blue));
-                if (alpha != max_size) {
-                    a = static_cast<float>(data(i, alpha));
-                }
-                colors.emplace_back(static_cast<float>(r) / 255.0F,
-                                    static_cast<float>(g) / 255.0F,
-                                    static_cast<float>(b) / 255.0F,
-                                    static_cast<float>(a) / 255.0F);
+        if (hasData && hasColor) {
+            if (types[red] == "uchar") {
+                fillParallel(colors, numPoints, [&](Eigen::Index i) {
+                    float a = 1.0F;
+                    if (alpha != max_size) {
+                        a = static_cast<float>(data(i, alpha));
+                    }
+                    return Base::Color(static_cast<float>(data(i, red)) / 255.0F,
+                                       static_cast<float>(data(i, green)) / 255.0F,
+                                       static_cast<float>(data(i, blue)) / 255.0F,
+                                       a / 255.0F);
+                });
+            }
+            else if (types[red] == "float") {
+                fillParallel(colors, numPoints, [&](Eigen::Index i) {
+                    float a = 1.0F;
+                    if (alpha != max_size) {
+                        a = static_cast<float>(data(i, alpha));
+                    }
+                    return Base::Color(static_cast<float>(data(i, red)),
+                                       static_cast<float>(data(i, green)),
+                                       static_cast<float>(data(i, blue)),
+                                       a);
+                });
             }
         }
-        else if (types[red] == "float") {
-            for (Eigen::Index i = 0; i < numPoints; i++) {
-                float r = static_cast<float>(data(i, red));
-                float g = static_cast<float>(data(i, green));
-                float b = static_cast<float>(data(i, blue));
-                if (alpha != max_size) {
-                    a = static_cast<float>(data(i, alpha));
+    };
+
+    if (format == "ascii") {
+        Eigen::MatrixXd data(numPoints, fields.size());
+        readAscii(inp, offset, data);
+        transfer(data);
+    }
+    else if (format == "binary_little_endian" || format == "binary_big_endian") {
+        BinaryPointData data(numPoints, format == "binary_big_endian", false);
+        if (pointStore) {
+            // only the positions are needed, so decode the points block by block
+            addFields(types, sizes, data);
+            inp.seekg(static_cast<std::streamoff>(offset), std::ios::cur);
+            const Eigen::Index blockSize = 65536;
+            for (Eigen::Index first = 0; hasData && first < numPoints; first += blockSize) {
+                Eigen::Index count = std::min(blockSize, numPoints - first);
+                data.readBlock(inp, count);
+                for (Eigen::Index i = 0; i < count; i++) {
+                    pointStore->add(Base::Vector3f(static_cast<float>(data(i, x)),
+                                                   static_cast<float>(data(i, y)),
+                                                   static_cast<float>(data(i, z))));
                 }
-                colors.emplace_back(r, g, b, a);
             }
         }
+        else {
+            readBinary(inp, offset, types, sizes, data);
+            transfer(data);
+        }
+    }
+
+    // ASCII data has been read as a whole and is handed over afterwards
+    if (pointStore && points.size() > 0) {
+        pointStore->add(points.getBasicPoints());
+        points.clear();
+        clear();
     }
 }
 
@@ -921,36 +1049,20 @@ void PlyReader::readAscii(std::istream& inp, std::size_t offset, Eigen::MatrixXd
     }
 }
 
-void PlyReader::readBinary(bool swapByteOrder,
-                           std::istream& inp,
-                           std::size_t offset,
-                           const std::vector<std::string>& types,
-                           const std::vector<int>& sizes,
-                           Eigen::MatrixXd& data)
+void PlyReader::addFields(const std::vector<std::string>& types,
+                          const std::vector<int>& sizes,
+                          BinaryPointData& data)
 {
-    Eigen::Index numPoints = data.rows();
-    Eigen::Index numFields = data.cols();
-
-    int neededSize = 0;
-    ConverterPtr convert_float32(new ConverterT<float>);
-    ConverterPtr convert_float64(new ConverterT<double>);
-    ConverterPtr convert_int8(new ConverterT<int8_t>);
-    ConverterPtr convert_uint8(new ConverterT<uint8_t>);
-    ConverterPtr convert_int16(new ConverterT<int16_t>);
-    ConverterPtr convert_uint16(new ConverterT<uint16_t>);
-    ConverterPtr convert_int32(new ConverterT<int32_t>);
-    ConverterPtr convert_uint32(new ConverterT<uint32_t>);
-
-    std::vector<ConverterPtr> converters;
-    for (Eigen::Index j = 0; j < numFields; j++) {
+    using Type = BinaryPointData::Type;
+    for (std::size_t j = 0; j < types.size(); j++) {
         const std::string& t = types[j];
         switch (sizes[j]) {
             case 1:
                 if (t == "char" || t == "int8") {
-                    converters.push_back(convert_int8);
+                    data.addField(Type::Int8);
                 }
                 else if (t == "uchar" || t == "uint8") {
-                    converters.push_back(convert_uint8);
+                    data.addField(Type::UInt8);
                 }
                 else {
                     throw Base::BadFormatError("Unexpected type");
@@ -958,10 +1070,10 @@ void PlyReader::readBinary(bool swapByteOrder,
                 break;
             case 2:
                 if (t == "short" || t == "int16") {
-                    converters.push_back(convert_int16);
+                    data.addField(Type::Int16);
                 }
                 else if (t == "ushort" || t == "uint16") {
-                    converters.push_back(convert_uint16);
+                    data.addField(Type::UInt16);
                 }
                 else {
                     throw Base::BadFormatError("Unexpected type");
@@ -969,13 +1081,13 @@ void PlyReader::readBinary(bool swapByteOrder,
                 break;
             case 4:
                 if (t == "int" || t == "int32") {
-                    converters.push_back(convert_int32);
+                    data.addField(Type::Int32);
                 }
                 else if (t == "uint" || t == "uint32") {
-                    converters.push_back(convert_uint32);
+                    data.addField(Type::UInt32);
                 }
                 else if (t == "float" || t == "float32") {
-                    converters.push_back(convert_float32);
+                    data.addField(Type::Float32);
                 }
                 else {
                     throw Base::BadFormatError("Unexpected type");
@@ -983,7 +1095,7 @@ void PlyReader::readBinary(bool swapByteOrder,
                 break;
             case 8:
                 if (t == "double" || t == "float64") {
-                    converters.push_back(convert_float64);
+                    data.addField(Type::Float64);
                 }
                 else {
                     throw Base::BadFormatError("Unexpected type");
@@ -992,30 +1104,20 @@ void PlyReader::readBinary(bool swapByteOrder,
             default:
                 throw Base::BadFormatError("Unexpected type");
         }
-
-        neededSize += converters.back()->getSizeOf();
     }
+}
 
-    std::streamoff ulSize = 0;
-    std::streamoff ulCurr = 0;
-    std::streambuf* buf = inp.rdbuf();
-    if (buf) {
-        ulCurr = buf->pubseekoff(static_cast<std::streamoff>(offset), std::ios::cur, std::ios::in);
-        ulSize = buf->pubseekoff(0, std::ios::end, std::ios::in);
-        buf->pubseekoff(ulCurr, std::ios::beg, std::ios::in);
-        if (ulCurr + neededSize * static_cast<std::streamoff>(numPoints) > ulSize) {
-            throw Base::BadFormatError("File expects too many elements");
-        }
-    }
+void PlyReader::readBinary(std::istream& inp,
+                           std::size_t offset,
+                           const std::vector<std::string>& types,
+                           const std::vector<int>& sizes,
+                           BinaryPointData& data)
+{
+    addFields(types, sizes, data);
 
-    Base::InputStream str(inp);
-    str.setByteOrder(swapByteOrder ? Base::Stream::BigEndian : Base::Stream::LittleEndian);
-    for (Eigen::Index i = 0; i < numPoints; i++) {
-        for (Eigen::Index j = 0; j < numFields; j++) {
-            double value = converters[j]->toDouble(str);
-            data(i, j) = value;
-        }
-    }
+    // skip the elements before the vertices
+    inp.seekg(static_cast<std::streamoff>(offset), std::ios::cur);
+    data.read(inp);
 }
 
 // ----------------------------------------------------------------------------
@@ -1037,33 +1139,6 @@ void PcdReader::read(const std::string& filename)
     std::vector<int> sizes;
     Eigen::Index numPoints = Eigen::Index(readHeader(inp, format, fields, types, sizes));
 
-    Eigen::MatrixXd data(numPoints, fields.size());
-    if (format == "ascii") {
-        readAscii(inp, data);
-    }
-    else if (format == "binary") {
-        readBinary(false, inp, types, sizes, data);
-    }
-    else if (format == "binary_compressed") {
-        unsigned int c {};
-        unsigned int u {};
-        Base::InputStream str(inp);
-        str >> c >> u;
-
-        std::vector<char> compressed(c);
-        inp.read(compressed.data(), c);
-        std::vector<char> uncompressed(u);
-        if (lzfDecompress(compressed.data(), c, uncompressed.data(), u) == u) {
-            DataStreambuf ibuf(uncompressed);
-            std::istream istr(nullptr);
-            istr.rdbuf(&ibuf);
-            readBinary(true, istr, types, sizes, data);
-        }
-        else {
-            throw Base::BadFormatError("Failed to decompress binary data");
-        }
-    }
-
     std::vector<std::string>::iterator it;
     Eigen::Index max_size = std::numeric_limits<Eigen::Index>::max();
 
@@ -1141,48 +1216,82 @@ void PcdReader::read(const std::string& filename)
     bool hasIntensity = (greyvalue != max_size);
     bool hasColor = (rgba != max_size);
 
-    if (hasData) {
-        points.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            points.push_back(Base::Vector3d(data(i, x), data(i, y), data(i, z)));
+    auto transfer = [&](const auto& data) {
+        if (hasData) {
+            fillParallel(points.getBasicPoints(), numPoints, [&](Eigen::Index i) {
+                return Base::Vector3f(static_cast<float>(data(i, x)),
+                                      static_cast<float>(data(i, y)),
+                                      static_cast<float>(data(i, z)));
+            });
+        }
+
+        if (hasData && hasNormal) {
+            fillParallel(normals, numPoints, [&](Eigen::Index i) {
+                return Base::Vector3f(static_cast<float>(data(i, normal_x)),
+                                      static_cast<float>(data(i, normal_y)),
+                                      static_cast<float>(data(i, normal_z)));
+            });
+        }
+
+        if (hasData && hasIntensity) {
+            fillParallel(intensity, numPoints, [&](Eigen::Index i) {
+                return static_cast<float>(data(i, greyvalue));
+            });
+        }
+
+        if (hasData && hasColor) {
+            if (types[rgba] == "U") {
+                fillParallel(colors, numPoints, [&](Eigen::Index i) {
+                    uint32_t packed = static_cast<uint32_t>(data(i, rgba));
+                    Base::Color col;
+                    col.setPackedARGB(packed);
+                    return col;
+                });
+            }
+            else if (types[rgba] == "F") {
+                static_assert(sizeof(float) == sizeof(uint32_t),
+                              "float and uint32_t have different sizes");
+                fillParallel(colors, numPoints, [&](Eigen::Index i) {
+                    float f = static_cast<float>(data(i, rgba));
+                    uint32_t packed {};
+                    std::memcpy(&packed, &f, sizeof(packed));
+                    Base::Color col;
+                    col.setPackedARGB(packed);
+                    return col;
+                });
+            }
         }
-    }
+    };
 
-    if (hasData && hasNormal) {
-        normals.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            normals.emplace_back(data(i, normal_x), data(i, normal_y), data(i, normal_z));
-        }
+    if (format == "ascii") {
+        Eigen::MatrixXd data(numPoints, fields.size());
+        readAscii(inp, data);
+        transfer(data);
     }
-
-    if (hasData && hasIntensity) {
-        intensity.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            intensity.push_back(data(i, greyvalue));
-        }
+    else if (format == "binary") {
+        BinaryPointData data(numPoints, false, false);
+        readBinary(inp, types, sizes, data);
+        transfer(data);
     }
+    else if (format == "binary_compressed") {
+        unsigned int c {};
+        unsigned int u {};
+        Base::InputStream str(inp);
+        str >> c >> u;
 
-    if (hasData && hasColor) {
-        colors.reserve(numPoints);
-        if (types[rgba] == "U") {
-            for (Eigen::Index i = 0; i < numPoints; i++) {
-                uint32_t packed = static_cast<uint32_t>(data(i, rgba));
-                Base::Color col;
-                col.setPackedARGB(packed);
-                colors.emplace_back(col);
-            }
+        std::vector<char> compressed(c);
+        inp.read(compressed.data(), c);
+        std::vector<char> uncompressed(u);
+        if (lzfDecompress(compressed.data(), c, uncompressed.data(), u) == u) {
+            compressed.clear();
+            compressed.shrink_to_fit();
+            BinaryPointData data(numPoints, false, true);
+            addFields(types, sizes, data);
+            data.setData(std::move(uncompressed));
+            transfer(data);
         }
-        else if (types[rgba] == "F") {
-            static_assert(sizeof(float) == sizeof(uint32_t),
-                          "float and uint32_t have different sizes");
-            for (Eigen::Index i = 0; i < numPoints; i++) {
-                float f = static_cast<float>(data(i, rgba));
-                uint32_t packed {};
-                std::memcpy(&packed, &f, sizeof(packed));
-                Base::Color col;
-                col.setPackedARGB(packed);
-                colors.emplace_back(col);
-            }
+        else {
+            throw Base::BadFormatError("Failed to decompress binary data");
         }
     }
 }
@@ -1286,35 +1395,20 @@ void PcdReader::readAscii(std::istream& inp, Eigen::MatrixXd& data)
     }
 }
 
-void PcdReader::readBinary(bool transpose,
-                           std::istream& inp,
-                           const std::vector<std::string>& types,
-                           const std::vector<int>& sizes,
-                           Eigen::MatrixXd& data)
+void PcdReader::addFields(const std::vector<std::string>& types,
+                          const std::vector<int>& sizes,
+                          BinaryPointData& data)
 {
-    Eigen::Index numPoints = data.rows();
-    Eigen::Index numFields = data.cols();
-
-    int neededSize = 0;
-    ConverterPtr convert_float32(new ConverterT<float>);
-    ConverterPtr convert_float64(new ConverterT<double>);
-    ConverterPtr convert_int8(new ConverterT<int8_t>);
-    ConverterPtr convert_uint8(new ConverterT<uint8_t>);
-    ConverterPtr convert_int16(new ConverterT<int16_t>);
-    ConverterPtr convert_uint16(new ConverterT<uint16_t>);
-    ConverterPtr convert_int32(new ConverterT<int32_t>);
-    ConverterPtr convert_uint32(new ConverterT<uint32_t>);
-
-    std::vector<ConverterPtr> converters;
-    for (Eigen::Index j = 0; j < numFields; j++) {
+    using Type = BinaryPointData::Type;
+    for (std::size_t j = 0; j < types.size(); j++) {
         char t = types[j][0];
         switch (sizes[j]) {
             case 1:
                 if (t == 'I') {
-                    converters.push_back(convert_int8);
+                    data.addField(Type::Int8);
                 }
                 else if (t == 'U') {
-                    converters.push_back(convert_uint8);
+                    data.addField(Type::UInt8);
                 }
                 else {
                     throw Base::BadFormatError("Unexpected type");
@@ -1322,10 +1416,10 @@ void PcdReader::readBinary(bool transpose,
                 break;
             case 2:
                 if (t == 'I') {
-                    converters.push_back(convert_int16);
+                    data.addField(Type::Int16);
                 }
                 else if (t == 'U') {
-                    converters.push_back(convert_uint16);
+                    data.addField(Type::UInt16);
                 }
                 else {
                     throw Base::BadFormatError("Unexpected type");
@@ -1333,13 +1427,13 @@ void PcdReader::readBinary(bool transpose,
                 break;
             case 4:
                 if (t == 'I') {
-                    converters.push_back(convert_int32);
+                    data.addField(Type::Int32);
                 }
                 else if (t == 'U') {
-                    converters.push_back(convert_uint32);
+                    data.addField(Type::UInt32);
                 }
                 else if (t == 'F') {
-                    converters.push_back(convert_float32);
+                    data.addField(Type::Float32);
                 }
                 else {
                     throw Base::BadFormatError("Unexpected type");
@@ -1347,7 +1441,7 @@ void PcdReader::readBinary(bool transpose,
                 break;
             case 8:
                 if (t == 'F') {
-                    converters.push_back(convert_float64);
+                    data.addField(Type::Float64);
                 }
                 else {
                     throw Base::BadFormatError("Unexpected type");
@@ -1356,39 +1450,16 @@ void PcdReader::readBinary(bool transpose,
             default:
                 throw Base::BadFormatError("Unexpected type");
         }
-
-        neededSize += converters.back()->getSizeOf();
-    }
-
-    std::streamoff ulSize = 0;
-    std::streamoff ulCurr = 0;
-    std::streambuf* buf = inp.rdbuf();
-    if (buf) {
-        ulCurr = buf->pubseekoff(0, std::ios::cur, std::ios::in);
-        ulSize = buf->pubseekoff(0, std::ios::end, std::ios::in);
-        buf->pubseekoff(ulCurr, std::ios::beg, std::ios::in);
-        if (ulCurr + neededSize * static_cast<std::streamoff>(numPoints) > ulSize) {
-            throw Base::BadFormatError("File expects too many elements");
-        }
     }
+}
 
-    Base::InputStream str(inp);
-    if (transpose) {
-        for (Eigen::Index j = 0; j < numFields; j++) {
-            for (Eigen::Index i = 0; i < numPoints; i++) {
-                double value = converters[j]->toDouble(str);
-                data(i, j) = value;
-            }
-        }
-    }
-    else {
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            for (Eigen::Index j = 0; j < numFields; j++) {
-                double value = converters[j]->toDouble(str);
-                data(i, j) = value;
-            }
-        }
-    }
+void PcdReader::readBinary(std::istream& inp,
+                           const std::vector<std::string>& types,
+                           const std::vector<int>& sizes,
+                           BinaryPointData& data)
+{
+    addFields(types, sizes, data);
+    data.read(inp);
 }
 
 // ----------------------------------------------------------------------------
@@ -1398,12 +1469,22 @@ namespace
 class E57ReaderImp
 {
 public:
-    E57ReaderImp(const std::string& filename, bool color, bool state, double distance)
+    E57ReaderImp(const std::string& filename,
+                 bool color,
+                 bool state,
+                 double distance,
+                 double voxelSize,
+                 ChunkedPointStore* store)
         : imfi(filename, "r")
+        , pointStore {store}
         , useColor {color}
         , checkState {state}
         , minDistance {distance}
-    {}
+    {
+        if (voxelSize > 0.0) {
+            voxels = std::make_unique<VoxelGridFilter>(voxelSize);
+        }
+    }
 
     void read()
     {
@@ -1412,6 +1493,18 @@ public:
             e57::VectorNode data3D(root.get("data3D"));
             readData3D(data3D);
         }
+
+        if (voxels) {
+            voxels->getPoints(points, colors, intensity, normals);
+            if (pointStore) {
+                // only the positions are kept in the store
+                pointStore->add(points.getBasicPoints());
+                points.clear();
+                colors.clear();
+                intensity.clear();
+                normals.clear();
+            }
+        }
     }
 
     std::vector<Base::Color> getColors() const
@@ -1646,6 +1739,11 @@ private:
         bool hasState = proto.inv_state && checkState;
         bool filter = false;
 
+        std::vector<Base::Vector3d> blockPoints;
+        std::vector<Base::Color> blockColors;
+        std::vector<float> blockIntensity;
+        std::vector<Base::Vector3f> blockNormals;
+
         while ((count = cvr.read())) {
             for (size_t i = 0; i < count; ++i) {
                 filter = false;
@@ -1664,8 +1762,26 @@ private:
                 }
                 if (!filter) {
                     cnt_pts++;
-                    points.push_back(pt);
                     last = pt;
+                    if (voxels) {
+                        blockPoints.push_back(pt);
+                        if (hasColor) {
+                            blockColors.push_back(getColor(proto, i));
+                        }
+                        if (hasItensity) {
+                            blockIntensity.push_back(static_cast<float>(proto.intensity[i]));
+                        }
+                        if (hasNormal) {
+                            blockNormals.push_back(
+                                getNormal(proto, i, hasPlacement, plm.getRotation()));
+                        }
+                        continue;
+                    }
+                    if (pointStore) {
+                        pointStore->add(Base::convertTo<Base::Vector3f>(pt));
+                        continue;
+                    }
+                    points.push_back(pt);
                     if (hasColor) {
                         colors.push_back(getColor(proto, i));
                     }
@@ -1677,6 +1793,19 @@ private:
                     }
                 }
             }
+
+            // the reader's buffers are small, so gather several of them before merging
+            if (voxels && blockPoints.size() >= voxel_block_size) {
+                voxels->add(blockPoints, blockColors, blockIntensity, blockNormals);
+                blockPoints.clear();
+                blockColors.clear();
+                blockIntensity.clear();
+                blockNormals.clear();
+            }
+        }
+
+        if (voxels) {
+            voxels->add(blockPoints, blockColors, blockIntensity, blockNormals);
         }
     }
 
@@ -1766,10 +1895,13 @@ private:
 
 private:
     e57::ImageFile imfi;
+    ChunkedPointStore* pointStore;
+    std::unique_ptr<VoxelGridFilter> voxels;
     bool useColor;
     bool checkState;
     double minDistance;
     const size_t buf_size = 1024;
+    const size_t voxel_block_size = 65536;
     std::vector<Base::Color> colors;
     std::vector<float> intensity;
     PointKernel points;
@@ -1786,13 +1918,13 @@ E57Reader::E57Reader(bool Color, bool State, double Distance)
 void E57Reader::read(const std::string& filename)
 {
     try {
-        E57ReaderImp reader(filename, useColor, checkState, minDistance);
+        E57ReaderImp reader(filename, useColor, checkState, minDistance, voxelSize, pointStore);
         reader.read();
         points = reader.getPoints();
         normals = reader.getNormals();
         colors = reader.getColors();
         intensity = reader.getItensity();
-        width = points.size();
+        width = static_cast<std::int64_t>(pointStore ? pointStore->size() : points.size());
         height = 1;
     }
     catch (const Base::BadFormatError&) {
@@ -1803,6 +1935,186 @@ void E57Reader::read(const std::string& filename)
     }
 }
 
+void E57Reader::setVoxelSize(double size)
+{
+    voxelSize = size;
+}
+
+// ----------------------------------------------------------------------------
+
+class VoxelGridFilter::Private
+{
+public:
+    struct Key
+    {
+        int64_t x, y, z;
+        bool operator==(const Key&) const = default;
+    };
+
+    struct KeyHash
+    {
+        std::size_t operator()(const Key& key) const
+        {
+            auto x = static_cast<uint64_t>(key.x) * 73856093U;
+            auto y = static_cast<uint64_t>(key.y) * 19349663U;
+            auto z = static_cast<uint64_t>(key.z) * 83492791U;
+            return static_cast<std::size_t>(x ^ y ^ z);
+        }
+    };
+
+    struct Cell
+    {
+        Base::Vector3d point;
+        Base::Vector3d normal;
+        std::array<double, 4> color {};
+        double intensity {0.0};
+        std::size_t count {0};
+    };
+
+    struct Shard
+    {
+        std::unordered_map<Key, std::size_t, KeyHash> index;
+        std::vector<Cell> cells;
+    };
+
+    struct Entry
+    {
+        Key key;
+        std::size_t shard;
+    };
+
+    // The cells are distributed over a fixed number of shards that are filled
+    // concurrently. This way the result doesn't depend on the number of threads.
+    static constexpr std::size_t NumShards = 64;
+
+    explicit Private(double size)
+        : cellSize {size}
+        , shards(NumShards)
+    {}
+
+    Key getKey(const Base::Vector3d& pnt) const
+    {
+        return {static_cast<int64_t>(std::floor(pnt.x / cellSize)),
+                static_cast<int64_t>(std::floor(pnt.y / cellSize)),
+                static_cast<int64_t>(std::floor(pnt.z / cellSize))};
+    }
+
+    double cellSize;
+    bool hasColors {true};
+    bool hasIntensity {true};
+    bool hasNormals {true};
+    std::vector<Shard> shards;
+};
+
+VoxelGridFilter::VoxelGridFilter(double cellSize)
+    : d(std::make_unique<Private>(cellSize))
+{}
+
+VoxelGridFilter::~VoxelGridFilter() = default;
+
+void VoxelGridFilter::add(const std::vector<Base::Vector3d>& pnts,
+                          const std::vector<Base::Color>& cols,
+                          const std::vector<float>& inty,
+                          const std::vector<Base::Vector3f>& nors)
+{
+    d->hasColors = d->hasColors && cols.size() == pnts.size();
+    d->hasIntensity = d->hasIntensity && inty.size() == pnts.size();
+    d->hasNormals = d->hasNormals && nors.size() == pnts.size();
+
+    std::vector<Private::Entry> entries;
+    fillParallel(entries, static_cast<Eigen::Index>(pnts.size()), [this, &pnts](Eigen::Index i) {
+        Private::Key key = d->getKey(pnts[i]);
+        return Private::Entry {key, Private::KeyHash()(key) % Private::NumShards};
+    });
+
+    // bucket the points by shard with a counting sort that keeps their order
+    std::array<std::size_t, Private::NumShards + 1> offsets {};
+    for (const auto& it : entries) {
+        offsets[it.shard + 1]++;
+    }
+    for (std::size_t i = 1; i <= Private::NumShards; i++) {
+        offsets[i] += offsets[i - 1];
+    }
+    std::vector<std::size_t> order(entries.size());
+    std::array<std::size_t, Private::NumShards> next {};
+    std::copy(offsets.begin(), offsets.end() - 1, next.begin());
+    for (std::size_t i = 0; i < entries.size(); i++) {
+        order[next[entries[i].shard]++] = i;
+    }
+
+    // every shard only merges the points of its own cells, so no locking is needed
+    const Private::Shard* first = d->shards.data();
+    QtConcurrent::blockingMap(d->shards, [&](Private::Shard& shard) {
+        auto id = static_cast<std::size_t>(&shard - first);
+        for (std::size_t pos = offsets[id]; pos < offsets[id + 1]; pos++) {
+            std::size_t i = order[pos];
+            auto it = shard.index.try_emplace(entries[i].key, shard.cells.size());
+            if (it.second) {
+                shard.cells.emplace_back();
+            }
+
+            Private::Cell& cell = shard.cells[it.first->second];
+            cell.point += pnts[i];
+            cell.count++;
+            if (d->hasColors) {
+                cell.color[0] += cols[i].r;
+                cell.color[1] += cols[i].g;
+                cell.color[2] += cols[i].b;
+                cell.color[3] += cols[i].a;
+            }
+            if (d->hasIntensity) {
+                cell.intensity += inty[i];
+            }
+            if (d->hasNormals) {
+                cell.normal += Base::convertTo<Base::Vector3d>(nors[i]);
+            }
+        }
+    });
+}
+
+std::size_t VoxelGridFilter::size() const
+{
+    std::size_t count = 0;
+    for (const auto& it : d->shards) {
+        count += it.cells.size();
+    }
+    return count;
+}
+
+void VoxelGridFilter::getPoints(PointKernel& pnts,
+                                std::vector<Base::Color>& cols,
+                                std::vector<float>& inty,
+                                std::vector<Base::Vector3f>& nors) const
+{
+    pnts.clear();
+    cols.clear();
+    inty.clear();
+    nors.clear();
+
+    std::size_t count = size();
+    pnts.reserve(count);
+    for (const auto& shard : d->shards) {
+        for (const auto& cell : shard.cells) {
+            double weight = 1.0 / static_cast<double>(cell.count);
+            pnts.push_back(cell.point * weight);
+            if (d->hasColors) {
+                cols.emplace_back(static_cast<float>(cell.color[0] * weight),
+                                  static_cast<float>(cell.color[1] * weight),
+                                  static_cast<float>(cell.color[2] * weight),
+                                  static_cast<float>(cell.color[3] * weight));
+            }
+            if (d->hasIntensity) {
+                inty.push_back(static_cast<float>(cell.intensity * weight));
+            }
+            if (d->hasNormals) {
+                Base::Vector3d normal = cell.normal;
+                normal.Normalize();
+                nors.push_back(Base::convertTo<Base::Vector3f>(normal));
+            }
+        }
+    }
+}
+
 // ----------------------------------------------------------------------------
 
 Writer::Writer(const PointKernel& p)
@@ -25,6 +25,8 @@
 #ifndef _PointsAlgos_h_
 #define _PointsAlgos_h_
 
+#include <cstdint>
+#include <memory>
 #include <Eigen/Core>
 
 #include "Points.h"
@@ -33,6 +35,8 @@
 
 namespace Points
 {
+class BinaryPointData;
+class ChunkedPointStore;
 
 /** The Points algorithms container class
  */
@@ -47,6 +51,42 @@ public:
     static void LoadAscii(PointKernel&, const char* FileName);
 };
 
+/** Merges all points that fall into the same cell of a regular grid into a
+ * single point whose position, color, intensity and normal are the averages of
+ * the merged points. The points can be added block by block while they are
+ * read, so duplicates of overlapping scans are removed on the fly.
+ */
+class PointsExport VoxelGridFilter
+{
+public:
+    explicit VoxelGridFilter(double cellSize);
+    ~VoxelGridFilter();
+
+    /** Adds a block of points. Colors, intensities or normals are only kept if
+     * they are given for all points of all blocks.
+     */
+    void add(const std::vector<Base::Vector3d>& pnts,
+             const std::vector<Base::Color>& cols,
+             const std::vector<float>& inty,
+             const std::vector<Base::Vector3f>& nors);
+    /// Number of occupied cells
+    std::size_t size() const;
+    /// Returns one point per occupied cell
+    void getPoints(PointKernel& pnts,
+                   std::vector<Base::Color>& cols,
+                   std::vector<float>& inty,
+                   std::vector<Base::Vector3f>& nors) const;
+
+    VoxelGridFilter(const VoxelGridFilter&) = delete;
+    VoxelGridFilter(VoxelGridFilter&&) = delete;
+    VoxelGridFilter& operator=(const VoxelGridFilter&) = delete;
+    VoxelGridFilter& operator=(VoxelGridFilter&&) = delete;
+
+private:
+    class Private;
+    std::unique_ptr<Private> d;
+};
+
 class PointsExport Reader
 {
 public:
@@ -64,8 +104,12 @@ public:
     const std::vector<Base::Vector3f>& getNormals() const;
     bool hasNormals() const;
     bool isStructured() const;
-    int getWidth() const;
+    std::int64_t getWidth() const;
     int getHeight() const;
+    /** Readers that support it pass the points to \a store while reading them
+     * instead of keeping them in getPoints(). Only the positions are kept then.
+     */
+    void setPointStore(ChunkedPointStore* store);
 
     Reader(const Reader&) = delete;
     Reader(Reader&&) = delete;
@@ -78,8 +122,9 @@ protected:
     std::vector<float> intensity;
     std::vector<Base::Color> colors;
     std::vector<Base::Vector3f> normals;
-    int width {0};
+    std::int64_t width {0};
     int height {1};
+    ChunkedPointStore* pointStore {nullptr};
     // NOLINTEND
 };
 
@@ -104,12 +149,14 @@ private:
                            std::vector<std::string>& types,
                            std::vector<int>& sizes);
     void readAscii(std::istream&, std::size_t offset, Eigen::MatrixXd& data);
-    void readBinary(bool swapByteOrder,
-                    std::istream&,
+    void addFields(const std::vector<std::string>& types,
+                   const std::vector<int>& sizes,
+                   BinaryPointData& data);
+    void readBinary(std::istream&,
                     std::size_t offset,
                     const std::vector<std::string>& types,
                     const std::vector<int>& sizes,
-                    Eigen::MatrixXd& data);
+                    BinaryPointData& data);
 };
 
 class PointsExport PcdReader: public Reader
@@ -125,11 +172,13 @@ private:
                            std::vector<std::string>& types,
                            std::vector<int>& sizes);
     void readAscii(std::istream&, Eigen::MatrixXd& data);
-    void readBinary(bool transpose,
-                    std::istream&,
+    void addFields(const std::vector<std::string>& types,
+                   const std::vector<int>& sizes,
+                   BinaryPointData& data);
+    void readBinary(std::istream&,
                     const std::vector<std::string>& types,
                     const std::vector<int>& sizes,
-                    Eigen::MatrixXd& data);
+                    BinaryPointData& data);
 };
 
 class PointsExport E57Reader: public Reader
@@ -137,10 +186,13 @@ class PointsExport E57Reader: public Reader
 public:
     E57Reader(bool Color, bool State, double Distance);
     void read(const std::string& filename) override;
+    /// Merges the points of each cell of a grid with the given edge length, a value <= 0 disables it
+    void setVoxelSize(double size);
 
 protected:
     bool useColor, checkState;
     double minDistance;
+    double voxelSize {-1.0};
 };
 
 class PointsExport Writer
@@ -30,6 +30,8 @@
 #include <Base/GeometryPyCXX.h>
 #include <Base/VectorPy.h>
 
+#include "KDTree.h"
+#include "NormalEstimation.h"
 #include "Points.h"
 // inclusion of the generated files (generated out of PointsPy.xml)
 #include "PointsPy.h"
@@ -242,6 +244,130 @@ PyObject* PointsPy::fromValid(PyObject* args) const
     }
 }
 
+namespace
+{
+std::vector<Base::Vector3f> toLocalPoints(const PointKernel& kernel, const Py::Sequence& list)
+{
+    Base::Matrix4D mat = kernel.getTransform();
+    mat.inverse();
+
+    std::vector<Base::Vector3f> pnts;
+    pnts.reserve(list.size());
+    Py::Type vType(Base::getTypeAsObject(&Base::VectorPy::Type));
+    for (Py::Sequence::iterator it = list.begin(); it != list.end(); ++it) {
+        Base::Vector3d pnt;
+        if ((*it).isType(vType)) {
+            pnt = Py::Vector(*it).toVector();
+        }
+        else {
+            Py::Tuple tuple(*it);
+            pnt.x = (double)Py::Float(tuple[0]);
+            pnt.y = (double)Py::Float(tuple[1]);
+            pnt.z = (double)Py::Float(tuple[2]);
+        }
+        pnts.push_back(Base::convertTo<Base::Vector3f>(mat * pnt));
+    }
+    return pnts;
+}
+
+Py::List toIndexList(const std::vector<std::vector<KDTree::index_type>>& indices)
+{
+    Py::List list;
+    for (const auto& it : indices) {
+        Py::List item;
+        for (KDTree::index_type index : it) {
+            item.append(Py::Long(static_cast<unsigned long>(index)));
+        }
+        list.append(item);
+    }
+    return list;
+}
+}  // namespace
+
+PyObject* PointsPy::nearestNeighbours(PyObject* args) const
+{
+    PyObject* obj {};
+    int k {};
+    if (!PyArg_ParseTuple(args, "Oi", &obj, &k)) {
+        return nullptr;
+    }
+
+    if (k < 1) {
+        PyErr_SetString(PyExc_ValueError, "k must be positive");
+        return nullptr;
+    }
+
+    try {
+        const PointKernel* kernel = getPointKernelPtr();
+        std::vector<Base::Vector3f> pnts = toLocalPoints(*kernel, Py::Sequence(obj));
+        KDTree tree(*kernel);
+        return Py::new_reference_to(toIndexList(tree.findNearest(pnts, std::size_t(k))));
+    }
+    catch (const Py::Exception&) {
+        PyErr_SetString(PyExc_TypeError,
+                        "either expect\n"
+                        "-- [Vector,...] \n"
+                        "-- [(x,y,z),...]");
+        return nullptr;
+    }
+}
+
+PyObject* PointsPy::neighboursInRadius(PyObject* args) const
+{
+    PyObject* obj {};
+    double radius {};
+    if (!PyArg_ParseTuple(args, "Od", &obj, &radius)) {
+        return nullptr;
+    }
+
+    try {
+        const PointKernel* kernel = getPointKernelPtr();
+        std::vector<Base::Vector3f> pnts = toLocalPoints(*kernel, Py::Sequence(obj));
+        KDTree tree(*kernel);
+        return Py::new_reference_to(
+            toIndexList(tree.findInRadius(pnts, static_cast<float>(radius))));
+    }
+    catch (const Py::Exception&) {
+        PyErr_SetString(PyExc_TypeError,
+                        "either expect\n"
+                        "-- [Vector,...] \n"
+                        "-- [(x,y,z),...]");
+        return nullptr;
+    }
+}
+
+PyObject* PointsPy::estimateNormals(PyObject* args) const
+{
+    int k = 10;
+    PyObject* orient = Py_True;
+    if (!PyArg_ParseTuple(args, "|iO!", &k, &PyBool_Type, &orient)) {
+        return nullptr;
+    }
+
+    if (k < 3) {
+        PyErr_SetString(PyExc_ValueError, "k must be at least 3");
+        return nullptr;
+    }
+
+    const PointKernel* kernel = getPointKernelPtr();
+    NormalEstimation estimate(*kernel);
+    estimate.setKSearch(std::size_t(k));
+    estimate.setOrientNormals(Base::asBoolean(orient));
+    std::vector<Base::Vector3f> normals = estimate.perform();
+
+    Base::Matrix4D mat = kernel->getTransform();
+    mat.setCol(3, Base::Vector3d());
+    Py::List list;
+    for (const auto& it : normals) {
+        Base::Vector3d normal = mat * Base::convertTo<Base::Vector3d>(it);
+        if (normal.Sqr() > 0.0) {
+            normal.Normalize();
+        }
+        list.append(Py::Vector(normal));
+    }
+    return Py::new_reference_to(list);
+}
+
 Py::Long PointsPy::getCountPoints() const
 {
     return Py::Long((long)getPointKernelPtr()->size());
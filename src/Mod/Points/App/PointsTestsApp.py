@@ -0,0 +1,90 @@
+# SPDX-License-Identifier: LGPL-2.1-or-later
+
+import random
+import unittest
+
+import FreeCAD
+import Points
+
+# ---------------------------------------------------------------------------
+# define the functions to test the FreeCAD points module
+# ---------------------------------------------------------------------------
+
+
+class PointsNeighbourTestCases(unittest.TestCase):
+    def setUp(self):
+        rand = random.Random(42)
+        self.points = Points.Points(
+            [
+                FreeCAD.Vector(rand.uniform(0, 10), rand.uniform(0, 10), rand.uniform(0, 10))
+                for _ in range(1000)
+            ]
+        )
+        self.queries = [
+            FreeCAD.Vector(rand.uniform(-1, 11), rand.uniform(-1, 11), rand.uniform(-1, 11))
+            for _ in range(50)
+        ]
+
+    def distances(self, query):
+        """Returns the distances of all points to query"""
+        return [(p - query).Length for p in self.points.Points]
+
+    def testNearestNeighbours(self):
+        k = 8
+        result = self.points.nearestNeighbours(self.queries, k)
+        self.assertEqual(len(result), len(self.queries))
+        for query, indices in zip(self.queries, result):
+            dist = self.distances(query)
+            expected = sorted(dist)[:k]
+            self.assertEqual(len(indices), k)
+            self.assertEqual(len(set(indices)), k)
+            # compare the distances so that ties may come in any order
+            for index, value in zip(indices, expected):
+                self.assertAlmostEqual(dist[index], value, places=4)
+
+    def testNeighboursInRadius(self):
+        radius = 1.5
+        result = self.points.neighboursInRadius(self.queries, radius)
+        self.assertEqual(len(result), len(self.queries))
+        for query, indices in zip(self.queries, result):
+            dist = self.distances(query)
+            self.assertEqual(len(set(indices)), len(indices))
+            # points on the sphere may be found or not due to rounding
+            inside = {i for i, d in enumerate(dist) if d < radius - 1e-4}
+            self.assertTrue(inside.issubset(indices))
+            for index in indices:
+                self.assertLessEqual(dist[index], radius + 1e-4)
+
+    def testQueriesWithPlacement(self):
+        plm = FreeCAD.Placement(FreeCAD.Vector(5, -3, 2), FreeCAD.Rotation(30, 40, 50))
+        self.points.Placement = plm
+        global_points = self.points.Points
+        indices = self.points.nearestNeighbours(global_points[:10], 1)
+        self.assertEqual([i[0] for i in indices], list(range(10)))
+        for index, found in enumerate(self.points.neighboursInRadius(global_points[:10], 1e-3)):
+            self.assertIn(index, found)
+
+    def testEstimateNormalsOnPlane(self):
+        normal = FreeCAD.Vector(-0.5, -0.2, 1).normalize()
+        plane = Points.Points(
+            [FreeCAD.Vector(x, y, 0.5 * x + 0.2 * y) for x in range(30) for y in range(30)]
+        )
+
+        normals = plane.estimateNormals(10, False)
+        self.assertEqual(len(normals), plane.CountPoints)
+        for n in normals:
+            self.assertAlmostEqual(abs(n.dot(normal)), 1.0, places=4)
+
+        # oriented normals all point to the same side of the plane
+        normals = plane.estimateNormals(10, True)
+        signs = {n.dot(normal) > 0 for n in normals}
+        self.assertEqual(len(signs), 1)
+        for n in normals:
+            self.assertAlmostEqual(abs(n.dot(normal)), 1.0, places=4)
+
+        # the normals follow the placement
+        plm = FreeCAD.Placement(FreeCAD.Vector(), FreeCAD.Rotation(FreeCAD.Vector(1, 0, 0), 90))
+        plane.Placement = plm
+        normal = plm.Rotation.multVec(normal)
+        for n in plane.estimateNormals(10, False):
+            self.assertAlmostEqual(abs(n.dot(normal)), 1.0, places=4)
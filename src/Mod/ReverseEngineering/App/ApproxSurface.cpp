@@ -22,24 +22,25 @@
  *                                                                         *
  ***************************************************************************/
 
-#include <QFuture>
-#include <QFutureWatcher>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <thread>
 #include <QtConcurrentMap>
+#include <Eigen/SparseCholesky>
+#include <Eigen/SparseQR>
 
 #include <Geom_BSplineSurface.hxx>
 #include <Precision.hxx>
-#include <math_Gauss.hxx>
-#include <math_Householder.hxx>
+#include <math_Matrix.hxx>
 
 #include <Base/Sequencer.h>
-#include <Base/Tools.h>
 #include <Mod/Mesh/App/Core/Approximation.h>
 
 #include "ApproxSurface.h"
 
 
 using namespace Reen;
-namespace sp = std::placeholders;
 
 // SplineBasisfunction
 
@@ -869,10 +870,10 @@ BSplineParameterCorrection::BSplineParameterCorrection(unsigned usUOrder,
     : ParameterCorrection(usUOrder, usVOrder, usUCtrlpoints, usVCtrlpoints)
     , _clUSpline(usUCtrlpoints + usUOrder)
     , _clVSpline(usVCtrlpoints + usVOrder)
-    , _clSmoothMatrix(0, usUCtrlpoints * usVCtrlpoints - 1, 0, usUCtrlpoints * usVCtrlpoints - 1)
-    , _clFirstMatrix(0, usUCtrlpoints * usVCtrlpoints - 1, 0, usUCtrlpoints * usVCtrlpoints - 1)
-    , _clSecondMatrix(0, usUCtrlpoints * usVCtrlpoints - 1, 0, usUCtrlpoints * usVCtrlpoints - 1)
-    , _clThirdMatrix(0, usUCtrlpoints * usVCtrlpoints - 1, 0, usUCtrlpoints * usVCtrlpoints - 1)
+    , _clSmoothMatrix(usUCtrlpoints * usVCtrlpoints, usUCtrlpoints * usVCtrlpoints)
+    , _clFirstMatrix(usUCtrlpoints * usVCtrlpoints, usUCtrlpoints * usVCtrlpoints)
+    , _clSecondMatrix(usUCtrlpoints * usVCtrlpoints, usUCtrlpoints * usVCtrlpoints)
+    , _clThirdMatrix(usUCtrlpoints * usVCtrlpoints, usUCtrlpoints * usVCtrlpoints)
 {
     Init();
 }
@@ -882,10 +883,10 @@ void BSplineParameterCorrection::Init()
     // Initializations
     _pvcUVParam = nullptr;
     _pvcPoints = nullptr;
-    _clFirstMatrix.Init(0.0);
-    _clSecondMatrix.Init(0.0);
-    _clThirdMatrix.Init(0.0);
-    _clSmoothMatrix.Init(0.0);
+    _clFirstMatrix.setZero();
+    _clSecondMatrix.setZero();
+    _clThirdMatrix.setZero();
+    _clSmoothMatrix.setZero();
 
     /* Calculate the knot vectors */
     unsigned usUMax = _usUCtrlpoints - _usUOrder + 1;
@@ -957,15 +958,192 @@ void BSplineParameterCorrection::SetVKnots(const std::vector<double>& afKnots)
     _clVSpline.SetKnots(_vVKnots, _vVMults, _usVOrder);
 }
 
+namespace Reen
+{
+// Accumulates the normal equations of the least-squares fit. A point only
+// influences the uOrder x vOrder poles of its knot span, so the product of two
+// basis functions vanishes unless the poles are less than an order apart in
+// both directions. Only this band is stored for each pole.
+class NormalEquations
+{
+public:
+    NormalEquations(int uPoles, int vPoles, int uOrder, int vOrder)
+        : uPoles(uPoles)
+        , vPoles(vPoles)
+        , uOrder(uOrder)
+        , vOrder(vOrder)
+        , uBand(2 * uOrder - 1)
+        , vBand(2 * vOrder - 1)
+        , band(static_cast<std::size_t>(uPoles) * static_cast<std::size_t>(vPoles)
+                   * static_cast<std::size_t>(uBand) * static_cast<std::size_t>(vBand),
+               0.0)
+        , rhs(Eigen::MatrixX3d::Zero(uPoles * vPoles, 3))
+    {}
+
+    // uFirst and vFirst are the indices of the first poles of the knot span
+    void add(int uFirst,
+             int vFirst,
+             const TColStd_Array1OfReal& basisU,
+             const TColStd_Array1OfReal& basisV,
+             const gp_Pnt& pnt)
+    {
+        for (int a = 0; a < uOrder; a++) {
+            for (int b = 0; b < vOrder; b++) {
+                double value = basisU(a) * basisV(b);
+                int row = (uFirst + a) * vPoles + vFirst + b;
+                rhs(row, 0) += value * pnt.X();
+                rhs(row, 1) += value * pnt.Y();
+                rhs(row, 2) += value * pnt.Z();
+
+                double* entries = &band[static_cast<std::size_t>(row) * uBand * vBand];
+                for (int c = 0; c < uOrder; c++) {
+                    double* line = entries + (c - a + uOrder - 1) * vBand + vOrder - 1 - b;
+                    double valueU = value * basisU(c);
+                    for (int d = 0; d < vOrder; d++) {
+                        line[d] += valueU * basisV(d);
+                    }
+                }
+            }
+        }
+    }
+
+    void add(const NormalEquations& other)
+    {
+        std::transform(band.begin(),
+                       band.end(),
+                       other.band.begin(),
+                       band.begin(),
+                       std::plus<>());
+        rhs += other.rhs;
+    }
+
+    Eigen::SparseMatrix<double> matrix() const
+    {
+        std::vector<Eigen::Triplet<double>> triplets;
+        triplets.reserve(band.size());
+        auto it = band.begin();
+        for (int row = 0; row < uPoles * vPoles; row++) {
+            int j = row / vPoles;
+            int k = row % vPoles;
+            for (int c = 0; c < uBand; c++) {
+                for (int d = 0; d < vBand; d++, ++it) {
+                    // entries outside the grid of poles are never touched
+                    if (*it != 0.0) {
+                        int col = (j + c - uOrder + 1) * vPoles + k + d - vOrder + 1;
+                        triplets.emplace_back(row, col, *it);
+                    }
+                }
+            }
+        }
+
+        Eigen::SparseMatrix<double> mat(uPoles * vPoles, uPoles * vPoles);
+        mat.setFromTriplets(triplets.begin(), triplets.end());
+        return mat;
+    }
+
+    const Eigen::MatrixX3d& rightHandSide() const
+    {
+        return rhs;
+    }
+
+private:
+    int uPoles;
+    int vPoles;
+    int uOrder;
+    int vOrder;
+    int uBand;
+    int vBand;
+    std::vector<double> band;
+    Eigen::MatrixX3d rhs;
+};
+}  // namespace Reen
+
+namespace
+{
+// Splits the points into one block per thread
+int countBlocks(int numPoints)
+{
+    int numThreads = static_cast<int>(std::max(1U, std::thread::hardware_concurrency()));
+    return std::max(1, std::min(numThreads, numPoints));
+}
+
+// Returns the range [first, last) of the points of a block
+std::pair<int, int> blockRange(int block, int numBlocks, int numPoints)
+{
+    auto first = static_cast<std::int64_t>(numPoints) * block / numBlocks;
+    auto last = static_cast<std::int64_t>(numPoints) * (block + 1) / numBlocks;
+    return {static_cast<int>(first), static_cast<int>(last)};
+}
+
+// Returns the range [first, last) of the poles that are less than an order
+// apart from the given pole
+std::pair<unsigned, unsigned> bandRange(unsigned pole, unsigned order, unsigned numPoles)
+{
+    unsigned first = pole + 1 > order ? pole + 1 - order : 0;
+    unsigned last = std::min(pole + order, numPoles);
+    return {first, last};
+}
+
+std::size_t bandSize(unsigned order, unsigned numPoles)
+{
+    std::size_t size = 0;
+    for (unsigned pole = 0; pole < numPoles; pole++) {
+        auto [first, last] = bandRange(pole, order, numPoles);
+        size += last - first;
+    }
+    return size;
+}
+
+// Dense copies of the smoothing matrices for the old accessors
+const math_Matrix& toDense(const Eigen::SparseMatrix<double>& clMat,
+                           std::unique_ptr<math_Matrix>& pclDense)
+{
+    auto rows = static_cast<int>(clMat.rows());
+    auto cols = static_cast<int>(clMat.cols());
+    pclDense = std::make_unique<math_Matrix>(0, rows - 1, 0, cols - 1, 0.0);
+    for (int k = 0; k < clMat.outerSize(); k++) {
+        for (Eigen::SparseMatrix<double>::InnerIterator it(clMat, k); it; ++it) {
+            (*pclDense)(static_cast<int>(it.row()), static_cast<int>(it.col())) = it.value();
+        }
+    }
+    return *pclDense;
+}
+
+Eigen::SparseMatrix<double> toSparse(const math_Matrix& rclMat)
+{
+    std::vector<Eigen::Triplet<double>> triplets;
+    for (int i = rclMat.LowerRow(); i <= rclMat.UpperRow(); i++) {
+        for (int j = rclMat.LowerCol(); j <= rclMat.UpperCol(); j++) {
+            if (rclMat(i, j) != 0.0) {
+                triplets.emplace_back(i - rclMat.LowerRow(), j - rclMat.LowerCol(), rclMat(i, j));
+            }
+        }
+    }
+
+    Eigen::SparseMatrix<double> clMat(rclMat.RowNumber(), rclMat.ColNumber());
+    clMat.setFromTriplets(triplets.begin(), triplets.end());
+    return clMat;
+}
+}  // namespace
+
 void BSplineParameterCorrection::DoParameterCorrection(int iIter)
 {
     int i = 0;
     double fMaxDiff = 0.0, fMaxScalar = 1.0;
     double fWeight = _fSmoothInfluence;
+    int numPoints = _pvcPoints->Length();
+    int numBlocks = countBlocks(numPoints);
 
     Base::SequencerLauncher seq("Calc surface...",
-                                static_cast<size_t>(iIter)
-                                    * static_cast<size_t>(_pvcPoints->Length()));
+                                static_cast<size_t>(iIter) * static_cast<size_t>(numPoints));
+
+    // The smallest angle between the surface normal and the error vector and the
+    // largest change of the parameters of a block of points
+    struct Deviation
+    {
+        double maxScalar {1.0};
+        double maxDiff {0.0};
+    };
 
     do {
         fMaxScalar = 1.0;
@@ -979,50 +1157,62 @@ void BSplineParameterCorrection::DoParameterCorrection(int iIter)
                                                                              _usUOrder - 1,
                                                                              _usVOrder - 1);
 
-        for (int ii = _pvcPoints->Lower(); ii <= _pvcPoints->Upper(); ii++) {
-            double fDeltaU, fDeltaV, fU, fV;
-            const gp_Pnt& pnt = (*_pvcPoints)(ii);
-            gp_Vec P(pnt.X(), pnt.Y(), pnt.Z());
-            gp_Pnt PntX;
-            gp_Vec Xu, Xv, Xuv, Xuu, Xvv;
-            // Calculate the first two derivatives and point at (u,v)
-            gp_Pnt2d& uvValue = (*_pvcUVParam)(ii);
-            pclBSplineSurf->D2(uvValue.X(), uvValue.Y(), PntX, Xu, Xv, Xuu, Xvv, Xuv);
-            gp_Vec X(PntX.X(), PntX.Y(), PntX.Z());
-            gp_Vec ErrorVec = X - P;
-
-            // Calculate Xu x Xv the normal in X(u,v)
-            gp_Dir clNormal = Xu ^ Xv;
-
-            // Check, if X = P
-            if (!(X.IsEqual(P, 0.001, 0.001))) {
-                ErrorVec.Normalize();
-                if (fabs(clNormal * ErrorVec) < fMaxScalar) {
-                    fMaxScalar = fabs(clNormal * ErrorVec);
+        // The evaluation of a Geom_BSplineSurface doesn't modify it so that the
+        // points can be corrected concurrently
+        std::vector<Deviation> deviations(numBlocks);
+        const Deviation* firstBlock = deviations.data();
+        QtConcurrent::blockingMap(deviations, [&](Deviation& dev) {
+            auto [first, last] =
+                blockRange(static_cast<int>(&dev - firstBlock), numBlocks, numPoints);
+            for (int ii = _pvcPoints->Lower() + first; ii < _pvcPoints->Lower() + last; ii++) {
+                double fDeltaU, fDeltaV, fU, fV;
+                const gp_Pnt& pnt = (*_pvcPoints)(ii);
+                gp_Vec P(pnt.X(), pnt.Y(), pnt.Z());
+                gp_Pnt PntX;
+                gp_Vec Xu, Xv, Xuv, Xuu, Xvv;
+                // Calculate the first two derivatives and point at (u,v)
+                gp_Pnt2d& uvValue = (*_pvcUVParam)(ii);
+                pclBSplineSurf->D2(uvValue.X(), uvValue.Y(), PntX, Xu, Xv, Xuu, Xvv, Xuv);
+                gp_Vec X(PntX.X(), PntX.Y(), PntX.Z());
+                gp_Vec ErrorVec = X - P;
+
+                // Calculate Xu x Xv the normal in X(u,v)
+                gp_Dir clNormal = Xu ^ Xv;
+
+                // Check, if X = P
+                if (!(X.IsEqual(P, 0.001, 0.001))) {
+                    ErrorVec.Normalize();
+                    if (fabs(clNormal * ErrorVec) < dev.maxScalar) {
+                        dev.maxScalar = fabs(clNormal * ErrorVec);
+                    }
                 }
-            }
 
-            fDeltaU = ((P - X) * Xu) / ((P - X) * Xuu - Xu * Xu);
-            if (fabs(fDeltaU) < Precision::Confusion()) {
-                fDeltaU = 0.0;
-            }
-            fDeltaV = ((P - X) * Xv) / ((P - X) * Xvv - Xv * Xv);
-            if (fabs(fDeltaV) < Precision::Confusion()) {
-                fDeltaV = 0.0;
-            }
+                fDeltaU = ((P - X) * Xu) / ((P - X) * Xuu - Xu * Xu);
+                if (fabs(fDeltaU) < Precision::Confusion()) {
+                    fDeltaU = 0.0;
+                }
+                fDeltaV = ((P - X) * Xv) / ((P - X) * Xvv - Xv * Xv);
+                if (fabs(fDeltaV) < Precision::Confusion()) {
+                    fDeltaV = 0.0;
+                }
 
-            // Replace old u/v values with new ones
-            fU = uvValue.X() - fDeltaU;
-            fV = uvValue.Y() - fDeltaV;
-            if (fU <= 1.0 && fU >= 0.0 && fV <= 1.0 && fV >= 0.0) {
-                uvValue.SetX(fU);
-                uvValue.SetY(fV);
-                fMaxDiff = std::max<double>(fabs(fDeltaU), fMaxDiff);
-                fMaxDiff = std::max<double>(fabs(fDeltaV), fMaxDiff);
+                // Replace old u/v values with new ones
+                fU = uvValue.X() - fDeltaU;
+                fV = uvValue.Y() - fDeltaV;
+                if (fU <= 1.0 && fU >= 0.0 && fV <= 1.0 && fV >= 0.0) {
+                    uvValue.SetX(fU);
+                    uvValue.SetY(fV);
+                    dev.maxDiff = std::max<double>(fabs(fDeltaU), dev.maxDiff);
+                    dev.maxDiff = std::max<double>(fabs(fDeltaV), dev.maxDiff);
+                }
             }
+        });
 
-            seq.next();
+        for (const auto& it : deviations) {
+            fMaxScalar = std::min<double>(it.maxScalar, fMaxScalar);
+            fMaxDiff = std::max<double>(it.maxDiff, fMaxDiff);
         }
+        seq.setProgress(static_cast<size_t>(i + 1) * static_cast<size_t>(numPoints));
 
         if (_bSmoothing) {
             fWeight *= 0.5f;
@@ -1036,77 +1226,94 @@ void BSplineParameterCorrection::DoParameterCorrection(int iIter)
     } while (i < iIter && fMaxDiff > Precision::Confusion() && fMaxScalar < 0.99);
 }
 
-bool BSplineParameterCorrection::SolveWithoutSmoothing()
+void BSplineParameterCorrection::CalcNormalEquations(Eigen::SparseMatrix<double>& clMat,
+                                                     Eigen::MatrixX3d& clRhs)
 {
-    unsigned ulSize = _pvcPoints->Length();
-    unsigned ulDim = _usUCtrlpoints * _usVCtrlpoints;
-    math_Matrix M(0, ulSize - 1, 0, ulDim - 1);
-    math_Matrix Xx(0, ulDim - 1, 0, 0);
-    math_Matrix Xy(0, ulDim - 1, 0, 0);
-    math_Matrix Xz(0, ulDim - 1, 0, 0);
-    math_Vector bx(0, ulSize - 1);
-    math_Vector by(0, ulSize - 1);
-    math_Vector bz(0, ulSize - 1);
-
-    // Determining the coefficient matrix of the overdetermined LGS
-    for (unsigned i = 0; i < ulSize; i++) {
-        const gp_Pnt2d& uvValue = (*_pvcUVParam)(i);
-        double fU = uvValue.X();
-        double fV = uvValue.Y();
-        unsigned ulIdx = 0;
-
-        // Pre-calculation of the values of the base functions
-        std::vector<double> basisU(_usUCtrlpoints);
-        for (unsigned j = 0; j < _usUCtrlpoints; j++) {
-            basisU[j] = _clUSpline.BasisFunction(j, fU);
-        }
-        std::vector<double> basisV(_usVCtrlpoints);
-        for (unsigned k = 0; k < _usVCtrlpoints; k++) {
-            basisV[k] = _clVSpline.BasisFunction(k, fV);
+    int uOrder = static_cast<int>(_usUOrder);
+    int vOrder = static_cast<int>(_usVOrder);
+    int numPoints = _pvcPoints->Length();
+    int numBlocks = countBlocks(numPoints);
+
+    std::vector<NormalEquations> blocks(numBlocks,
+                                        NormalEquations(static_cast<int>(_usUCtrlpoints),
+                                                        static_cast<int>(_usVCtrlpoints),
+                                                        uOrder,
+                                                        vOrder));
+    const NormalEquations* firstBlock = blocks.data();
+    QtConcurrent::blockingMap(blocks, [&](NormalEquations& equations) {
+        auto [first, last] =
+            blockRange(static_cast<int>(&equations - firstBlock), numBlocks, numPoints);
+        TColStd_Array1OfReal basisU(0, uOrder - 1);
+        TColStd_Array1OfReal basisV(0, vOrder - 1);
+        for (int i = first; i < last; i++) {
+            const gp_Pnt2d& uvValue = (*_pvcUVParam)(_pvcUVParam->Lower() + i);
+            // the knot span of a parameter outside the knot vector is undefined
+            double fU =
+                std::clamp(uvValue.X(), _vUKnots(_vUKnots.Lower()), _vUKnots(_vUKnots.Upper()));
+            double fV =
+                std::clamp(uvValue.Y(), _vVKnots(_vVKnots.Lower()), _vVKnots(_vVKnots.Upper()));
+
+            // Only the basis functions of the knot span are non-zero
+            int uSpan = _clUSpline.FindSpan(fU);
+            int vSpan = _clVSpline.FindSpan(fV);
+            _clUSpline.AllBasisFunctions(fU, basisU);
+            _clVSpline.AllBasisFunctions(fV, basisV);
+            equations.add(uSpan - uOrder + 1,
+                          vSpan - vOrder + 1,
+                          basisU,
+                          basisV,
+                          (*_pvcPoints)(_pvcPoints->Lower() + i));
         }
+    });
 
-        for (unsigned j = 0; j < _usUCtrlpoints; j++) {
-            double valueU = basisU[j];
-            if (valueU == 0.0) {
-                for (unsigned k = 0; k < _usVCtrlpoints; k++) {
-                    M(i, ulIdx) = 0.0;
-                    ulIdx++;
-                }
-            }
-            else {
-                for (unsigned k = 0; k < _usVCtrlpoints; k++) {
-                    M(i, ulIdx) = valueU * basisV[k];
-                    ulIdx++;
-                }
-            }
-        }
+    for (std::size_t i = 1; i < blocks.size(); i++) {
+        blocks.front().add(blocks[i]);
     }
 
-    // Determine the right side
-    for (int ii = _pvcPoints->Lower(); ii <= _pvcPoints->Upper(); ii++) {
-        const gp_Pnt& pnt = (*_pvcPoints)(ii);
-        bx(ii) = pnt.X();
-        by(ii) = pnt.Y();
-        bz(ii) = pnt.Z();
+    clMat = blocks.front().matrix();
+    clRhs = blocks.front().rightHandSide();
+}
+
+bool BSplineParameterCorrection::SolveNormalEquations(const Eigen::SparseMatrix<double>& clMat,
+                                                      const Eigen::MatrixX3d& clRhs)
+{
+    // The system matrix is symmetric and positive definite as long as every
+    // pole is influenced by enough points
+    Eigen::MatrixX3d X;
+    bool solved = false;
+    Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> solver(clMat);
+    if (solver.info() == Eigen::Success) {
+        // a singular matrix doesn't make the decomposition fail but gives
+        // (almost) zero pivots
+        const Eigen::VectorXd& D = solver.vectorD();
+        double eps = Eigen::NumTraits<double>::dummy_precision();
+        if (D.size() > 0 && D.minCoeff() > eps * D.cwiseAbs().maxCoeff()) {
+            X = solver.solve(clRhs);
+            solved = solver.info() == Eigen::Success && X.allFinite();
+        }
     }
 
-    // Solve the over-determined LGS with Householder-Transformation
-    math_Householder hhX(M, bx);
-    math_Householder hhY(M, by);
-    math_Householder hhZ(M, bz);
+    if (!solved) {
+        // Too few points for some of the poles, fall back to the rank revealing
+        // QR decomposition
+        Eigen::SparseMatrix<double> clQRMat = clMat;
+        clQRMat.makeCompressed();
+        Eigen::SparseQR<Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int>> qr(clQRMat);
+        if (qr.info() != Eigen::Success) {
+            // LGS could not be solved
+            return false;
+        }
 
-    if (!(hhX.IsDone() && hhY.IsDone() && hhZ.IsDone())) {
-        // LGS could not be solved
-        return false;
+        X = qr.solve(clRhs);
+        if (qr.info() != Eigen::Success || !X.allFinite()) {
+            return false;
+        }
     }
-    Xx = hhX.AllValues();
-    Xy = hhY.AllValues();
-    Xz = hhZ.AllValues();
 
-    unsigned ulIdx = 0;
+    Eigen::Index ulIdx = 0;
     for (unsigned j = 0; j < _usUCtrlpoints; j++) {
         for (unsigned k = 0; k < _usVCtrlpoints; k++) {
-            _vCtrlPntsOfSurf(j, k) = gp_Pnt(Xx(ulIdx, 0), Xy(ulIdx, 0), Xz(ulIdx, 0));
+            _vCtrlPntsOfSurf(j, k) = gp_Pnt(X(ulIdx, 0), X(ulIdx, 1), X(ulIdx, 2));
             ulIdx++;
         }
     }
@@ -1114,157 +1321,25 @@ bool BSplineParameterCorrection::SolveWithoutSmoothing()
     return true;
 }
 
-namespace Reen
-{
-class ScalarProduct
+bool BSplineParameterCorrection::SolveWithoutSmoothing()
 {
-public:
-    explicit ScalarProduct(const math_Matrix& mat)
-        : mat(mat)
-    {}
-    std::vector<double> multiply(int col) const
-    {
-        math_Vector vec = mat.Col(col);
-        std::vector<double> out(mat.ColNumber());
-        for (int n = mat.LowerCol(); n <= mat.UpperCol(); n++) {
-            out[n] = vec * mat.Col(n);
-        }
-        return out;
-    }
+    Eigen::SparseMatrix<double> MTM;
+    Eigen::MatrixX3d MTb;
+    CalcNormalEquations(MTM, MTb);
 
-private:
-    const math_Matrix& mat;
-};
-}  // namespace Reen
+    return SolveNormalEquations(MTM, MTb);
+}
 
 bool BSplineParameterCorrection::SolveWithSmoothing(double fWeight)
 {
-    unsigned ulSize = _pvcPoints->Length();
-    unsigned ulDim = _usUCtrlpoints * _usVCtrlpoints;
-    math_Matrix M(0, ulSize - 1, 0, ulDim - 1);
-    math_Vector Xx(0, ulDim - 1);
-    math_Vector Xy(0, ulDim - 1);
-    math_Vector Xz(0, ulDim - 1);
-    math_Vector bx(0, ulSize - 1);
-    math_Vector by(0, ulSize - 1);
-    math_Vector bz(0, ulSize - 1);
-    math_Vector Mbx(0, ulDim - 1);
-    math_Vector Mby(0, ulDim - 1);
-    math_Vector Mbz(0, ulDim - 1);
-
-    // Determining the coefficient matrix of the overdetermined LGS
-    for (unsigned i = 0; i < ulSize; i++) {
-        const gp_Pnt2d& uvValue = (*_pvcUVParam)(i);
-        double fU = uvValue.X();
-        double fV = uvValue.Y();
-        int ulIdx = 0;
-
-        // Pre-calculation of the values of the basis functions
-        std::vector<double> basisU(_usUCtrlpoints);
-        for (unsigned j = 0; j < _usUCtrlpoints; j++) {
-            basisU[j] = _clUSpline.BasisFunction(j, fU);
-        }
-        std::vector<double> basisV(_usVCtrlpoints);
-        for (unsigned k = 0; k < _usVCtrlpoints; k++) {
-            basisV[k] = _clVSpline.BasisFunction(k, fV);
-        }
+    Eigen::SparseMatrix<double> MTM;
+    Eigen::MatrixX3d MTb;
+    CalcNormalEquations(MTM, MTb);
 
-        for (unsigned j = 0; j < _usUCtrlpoints; j++) {
-            double valueU = basisU[j];
-            if (valueU == 0.0) {
-                for (unsigned k = 0; k < _usVCtrlpoints; k++) {
-                    M(i, ulIdx) = 0.0;
-                    ulIdx++;
-                }
-            }
-            else {
-                for (unsigned k = 0; k < _usVCtrlpoints; k++) {
-                    M(i, ulIdx) = valueU * basisV[k];
-                    ulIdx++;
-                }
-            }
-        }
-    }
-
-    // The product of its transform and itself results in the quadratic
-    // system matrix (slowly)
-#if 0
-    math_Matrix MTM = M.TMultiply(M);
-#elif 0
-    math_Matrix MTM(0, ulDim - 1, 0, ulDim - 1);
-    for (unsigned m = 0; m < ulDim; m++) {
-        math_Vector Mm = M.Col(m);
-        for (unsigned n = m; n < ulDim; n++) {
-            MTM(m, n) = MTM(n, m) = Mm * M.Col(n);
-        }
-    }
-#else  // multi-threaded
-    std::vector<int> columns(ulDim);
-    std::generate(columns.begin(), columns.end(), Base::iotaGen<int>(0));
-    ScalarProduct scalar(M);
-    // NOLINTBEGIN
-    QFuture<std::vector<double>> future =
-        QtConcurrent::mapped(columns, std::bind(&ScalarProduct::multiply, &scalar, sp::_1));
-    // NOLINTEND
-    QFutureWatcher<std::vector<double>> watcher;
-    watcher.setFuture(future);
-    watcher.waitForFinished();
-
-    math_Matrix MTM(0, ulDim - 1, 0, ulDim - 1);
-    int rowIndex = 0;
-    for (const auto& it : future) {
-        int colIndex = 0;
-        for (std::vector<double>::const_iterator jt = it.begin(); jt != it.end();
-             ++jt, colIndex++) {
-            MTM(rowIndex, colIndex) = *jt;
-        }
-        rowIndex++;
-    }
-#endif
-
-    // Determine the right side
-    for (int ii = _pvcPoints->Lower(); ii <= _pvcPoints->Upper(); ii++) {
-        const gp_Pnt& pnt = (*_pvcPoints)(ii);
-        bx(ii) = pnt.X();
-        by(ii) = pnt.Y();
-        bz(ii) = pnt.Z();
-    }
-    for (unsigned i = 0; i < ulDim; i++) {
-        math_Vector Mi = M.Col(i);
-        Mbx(i) = Mi * bx;
-        Mby(i) = Mi * by;
-        Mbz(i) = Mi * bz;
-    }
-
-    // Solve the LGS with the LU decomposition
-    math_Gauss mgGaussX(MTM + fWeight * _clSmoothMatrix);
-    math_Gauss mgGaussY(MTM + fWeight * _clSmoothMatrix);
-    math_Gauss mgGaussZ(MTM + fWeight * _clSmoothMatrix);
-
-    mgGaussX.Solve(Mbx, Xx);
-    if (!mgGaussX.IsDone()) {
-        return false;
-    }
+    // The smoothing terms only couple poles within the band of the system matrix
+    MTM += fWeight * _clSmoothMatrix;
 
-    mgGaussY.Solve(Mby, Xy);
-    if (!mgGaussY.IsDone()) {
-        return false;
-    }
-
-    mgGaussZ.Solve(Mbz, Xz);
-    if (!mgGaussZ.IsDone()) {
-        return false;
-    }
-
-    unsigned ulIdx = 0;
-    for (unsigned j = 0; j < _usUCtrlpoints; j++) {
-        for (unsigned k = 0; k < _usVCtrlpoints; k++) {
-            _vCtrlPntsOfSurf(j, k) = gp_Pnt(Xx(ulIdx), Xy(ulIdx), Xz(ulIdx));
-            ulIdx++;
-        }
-    }
-
-    return true;
+    return SolveNormalEquations(MTM, MTb);
 }
 
 void BSplineParameterCorrection::CalcSmoothingTerms(bool bRecalc,
@@ -1274,10 +1349,8 @@ void BSplineParameterCorrection::CalcSmoothingTerms(bool bRecalc,
 {
     if (bRecalc) {
         Base::SequencerLauncher seq("Initializing...",
-                                    static_cast<size_t>(3) * static_cast<size_t>(_usUCtrlpoints)
-                                        * static_cast<size_t>(_usUCtrlpoints)
-                                        * static_cast<size_t>(_usVCtrlpoints)
-                                        * static_cast<size_t>(_usVCtrlpoints));
+                                    static_cast<size_t>(3) * bandSize(_usUOrder, _usUCtrlpoints)
+                                        * bandSize(_usVOrder, _usVCtrlpoints));
         CalcFirstSmoothMatrix(seq);
         CalcSecondSmoothMatrix(seq);
         CalcThirdSmoothMatrix(seq);
@@ -1288,60 +1361,73 @@ void BSplineParameterCorrection::CalcSmoothingTerms(bool bRecalc,
 
 void BSplineParameterCorrection::CalcFirstSmoothMatrix(Base::SequencerLauncher& seq)
 {
+    std::vector<Eigen::Triplet<double>> triplets;
     unsigned m = 0;
     for (unsigned k = 0; k < _usUCtrlpoints; k++) {
         for (unsigned l = 0; l < _usVCtrlpoints; l++) {
-            unsigned n = 0;
+            auto [iBegin, iEnd] = bandRange(k, _usUOrder, _usUCtrlpoints);
+            auto [jBegin, jEnd] = bandRange(l, _usVOrder, _usVCtrlpoints);
 
-            for (unsigned i = 0; i < _usUCtrlpoints; i++) {
-                for (unsigned j = 0; j < _usVCtrlpoints; j++) {
-                    _clFirstMatrix(m, n) = _clUSpline.GetIntegralOfProductOfBSplines(i, k, 1, 1)
+            for (unsigned i = iBegin; i < iEnd; i++) {
+                for (unsigned j = jBegin; j < jEnd; j++) {
+                    unsigned n = i * _usVCtrlpoints + j;
+                    double value = _clUSpline.GetIntegralOfProductOfBSplines(i, k, 1, 1)
                             * _clVSpline.GetIntegralOfProductOfBSplines(j, l, 0, 0)
                         + _clUSpline.GetIntegralOfProductOfBSplines(i, k, 0, 0)
                             * _clVSpline.GetIntegralOfProductOfBSplines(j, l, 1, 1);
+                    triplets.emplace_back(m, n, value);
                     seq.next();
-                    n++;
                 }
             }
             m++;
         }
     }
+
+    _clFirstMatrix.setFromTriplets(triplets.begin(), triplets.end());
 }
 
 void BSplineParameterCorrection::CalcSecondSmoothMatrix(Base::SequencerLauncher& seq)
 {
+    std::vector<Eigen::Triplet<double>> triplets;
     unsigned m = 0;
     for (unsigned k = 0; k < _usUCtrlpoints; k++) {
         for (unsigned l = 0; l < _usVCtrlpoints; l++) {
-            unsigned n = 0;
+            auto [iBegin, iEnd] = bandRange(k, _usUOrder, _usUCtrlpoints);
+            auto [jBegin, jEnd] = bandRange(l, _usVOrder, _usVCtrlpoints);
 
-            for (unsigned i = 0; i < _usUCtrlpoints; i++) {
-                for (unsigned j = 0; j < _usVCtrlpoints; j++) {
-                    _clSecondMatrix(m, n) = _clUSpline.GetIntegralOfProductOfBSplines(i, k, 2, 2)
+            for (unsigned i = iBegin; i < iEnd; i++) {
+                for (unsigned j = jBegin; j < jEnd; j++) {
+                    unsigned n = i * _usVCtrlpoints + j;
+                    double value = _clUSpline.GetIntegralOfProductOfBSplines(i, k, 2, 2)
                             * _clVSpline.GetIntegralOfProductOfBSplines(j, l, 0, 0)
                         + 2 * _clUSpline.GetIntegralOfProductOfBSplines(i, k, 1, 1)
                             * _clVSpline.GetIntegralOfProductOfBSplines(j, l, 1, 1)
                         + _clUSpline.GetIntegralOfProductOfBSplines(i, k, 0, 0)
                             * _clVSpline.GetIntegralOfProductOfBSplines(j, l, 2, 2);
+                    triplets.emplace_back(m, n, value);
                     seq.next();
-                    n++;
                 }
             }
             m++;
         }
     }
+
+    _clSecondMatrix.setFromTriplets(triplets.begin(), triplets.end());
 }
 
 void BSplineParameterCorrection::CalcThirdSmoothMatrix(Base::SequencerLauncher& seq)
 {
+    std::vector<Eigen::Triplet<double>> triplets;
     unsigned m = 0;
     for (unsigned k = 0; k < _usUCtrlpoints; k++) {
         for (unsigned l = 0; l < _usVCtrlpoints; l++) {
-            unsigned n = 0;
+            auto [iBegin, iEnd] = bandRange(k, _usUOrder, _usUCtrlpoints);
+            auto [jBegin, jEnd] = bandRange(l, _usVOrder, _usVCtrlpoints);
 
-            for (unsigned i = 0; i < _usUCtrlpoints; i++) {
-                for (unsigned j = 0; j < _usVCtrlpoints; j++) {
-                    _clThirdMatrix(m, n) = _clUSpline.GetIntegralOfProductOfBSplines(i, k, 3, 3)
+            for (unsigned i = iBegin; i < iEnd; i++) {
+                for (unsigned j = jBegin; j < jEnd; j++) {
+                    unsigned n = i * _usVCtrlpoints + j;
+                    double value = _clUSpline.GetIntegralOfProductOfBSplines(i, k, 3, 3)
                             * _clVSpline.GetIntegralOfProductOfBSplines(j, l, 0, 0)
                         + _clUSpline.GetIntegralOfProductOfBSplines(i, k, 3, 1)
                             * _clVSpline.GetIntegralOfProductOfBSplines(j, l, 0, 2)
@@ -1357,13 +1443,15 @@ void BSplineParameterCorrection::CalcThirdSmoothMatrix(Base::SequencerLauncher&
                             * _clVSpline.GetIntegralOfProductOfBSplines(j, l, 1, 3)
                         + _clUSpline.GetIntegralOfProductOfBSplines(i, k, 0, 0)
                             * _clVSpline.GetIntegralOfProductOfBSplines(j, l, 3, 3);
+                    triplets.emplace_back(m, n, value);
                     seq.next();
-                    n++;
                 }
             }
             m++;
         }
     }
+
+    _clThirdMatrix.setFromTriplets(triplets.begin(), triplets.end());
 }
 
 void BSplineParameterCorrection::EnableSmoothing(bool bSmooth, double fSmoothInfl)
@@ -1389,30 +1477,63 @@ void BSplineParameterCorrection::EnableSmoothing(bool bSmooth,
 
 const math_Matrix& BSplineParameterCorrection::GetFirstSmoothMatrix() const
 {
-    return _clFirstMatrix;
+    return toDense(_clFirstMatrix, _pclDenseFirstMatrix);
 }
 
 const math_Matrix& BSplineParameterCorrection::GetSecondSmoothMatrix() const
 {
-    return _clSecondMatrix;
+    return toDense(_clSecondMatrix, _pclDenseSecondMatrix);
 }
 
 const math_Matrix& BSplineParameterCorrection::GetThirdSmoothMatrix() const
 {
-    return _clThirdMatrix;
+    return toDense(_clThirdMatrix, _pclDenseThirdMatrix);
 }
 
 void BSplineParameterCorrection::SetFirstSmoothMatrix(const math_Matrix& rclMat)
 {
-    _clFirstMatrix = rclMat;
+    _clFirstMatrix = toSparse(rclMat);
 }
 
 void BSplineParameterCorrection::SetSecondSmoothMatrix(const math_Matrix& rclMat)
 {
-    _clSecondMatrix = rclMat;
+    _clSecondMatrix = toSparse(rclMat);
 }
 
 void BSplineParameterCorrection::SetThirdSmoothMatrix(const math_Matrix& rclMat)
+{
+    _clThirdMatrix = toSparse(rclMat);
+}
+
+const Eigen::SparseMatrix<double>& BSplineParameterCorrection::GetFirstSparseSmoothMatrix() const
+{
+    return _clFirstMatrix;
+}
+
+const Eigen::SparseMatrix<double>& BSplineParameterCorrection::GetSecondSparseSmoothMatrix() const
+{
+    return _clSecondMatrix;
+}
+
+const Eigen::SparseMatrix<double>& BSplineParameterCorrection::GetThirdSparseSmoothMatrix() const
+{
+    return _clThirdMatrix;
+}
+
+void BSplineParameterCorrection::SetFirstSparseSmoothMatrix(
+    const Eigen::SparseMatrix<double>& rclMat)
+{
+    _clFirstMatrix = rclMat;
+}
+
+void BSplineParameterCorrection::SetSecondSparseSmoothMatrix(
+    const Eigen::SparseMatrix<double>& rclMat)
+{
+    _clSecondMatrix = rclMat;
+}
+
+void BSplineParameterCorrection::SetThirdSparseSmoothMatrix(
+    const Eigen::SparseMatrix<double>& rclMat)
 {
     _clThirdMatrix = rclMat;
 }
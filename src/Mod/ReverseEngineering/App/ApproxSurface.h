@@ -25,6 +25,7 @@
 #ifndef REEN_APPROXSURFACE_H
 #define REEN_APPROXSURFACE_H
 
+#include <memory>
 #include <Geom_BSplineSurface.hxx>
 #include <TColStd_Array1OfInteger.hxx>
 #include <TColStd_Array1OfReal.hxx>
@@ -32,6 +33,7 @@
 #include <TColgp_Array1OfPnt2d.hxx>
 #include <TColgp_Array2OfPnt.hxx>
 #include <math_Matrix.hxx>
+#include <Eigen/SparseCore>
 
 #include <Base/Vector3D.h>
 #include <Mod/ReverseEngineering/ReverseEngineeringGlobal.h>
@@ -406,16 +408,31 @@ protected:
     void DoParameterCorrection(int iIter) override;
 
     /**
-     * Solve an overdetermined LGS with the help of the Householder-Tansformation
+     * Solve an overdetermined LGS in the least-squares sense by its normal equations
      */
     bool SolveWithoutSmoothing() override;
 
     /**
-     * Solve a regular system of equations by LU decomposition. Depending on the weighting,
+     * Solve the normal equations of the overdetermined LGS. Depending on the weighting,
      * smoothing terms are included
      */
     bool SolveWithSmoothing(double fWeight) override;
 
+    /**
+     * Sets up the normal equations M^T*M*X = M^T*b of the overdetermined LGS.
+     * Since a point only influences the poles of its knot span the products of
+     * the basis functions are only calculated for these poles. The points are
+     * split into blocks that are processed concurrently.
+     */
+    void CalcNormalEquations(Eigen::SparseMatrix<double>& clMat, Eigen::MatrixX3d& clRhs);
+
+    /**
+     * Solves the normal equations with a sparse Cholesky decomposition and
+     * sets the control points
+     */
+    bool SolveNormalEquations(const Eigen::SparseMatrix<double>& clMat,
+                              const Eigen::MatrixX3d& clRhs);
+
 public:
     /**
      * Setting the knot vector
@@ -429,16 +446,19 @@ public:
 
     /**
      * Returns the first matrix of smoothing terms, if calculated
+     * The dense matrix is created from the sparse one on every call.
      */
     virtual const math_Matrix& GetFirstSmoothMatrix() const;
 
     /**
      * Returns the second matrix of smoothing terms, if calculated
+     * The dense matrix is created from the sparse one on every call.
      */
     virtual const math_Matrix& GetSecondSmoothMatrix() const;
 
     /**
      * Returns the third matrix of smoothing terms, if calculated
+     * The dense matrix is created from the sparse one on every call.
      */
     virtual const math_Matrix& GetThirdSmoothMatrix() const;
 
@@ -457,6 +477,36 @@ public:
      */
     virtual void SetThirdSmoothMatrix(const math_Matrix& rclMat);
 
+    /**
+     * Returns the first matrix of smoothing terms as it is used by the solver
+     */
+    const Eigen::SparseMatrix<double>& GetFirstSparseSmoothMatrix() const;
+
+    /**
+     * Returns the second matrix of smoothing terms as it is used by the solver
+     */
+    const Eigen::SparseMatrix<double>& GetSecondSparseSmoothMatrix() const;
+
+    /**
+     * Returns the third matrix of smoothing terms as it is used by the solver
+     */
+    const Eigen::SparseMatrix<double>& GetThirdSparseSmoothMatrix() const;
+
+    /**
+     * Sets the first matrix of the smoothing terms
+     */
+    void SetFirstSparseSmoothMatrix(const Eigen::SparseMatrix<double>& rclMat);
+
+    /**
+     * Sets the second matrix of smoothing terms
+     */
+    void SetSecondSparseSmoothMatrix(const Eigen::SparseMatrix<double>& rclMat);
+
+    /**
+     * Sets the third matrix of smoothing terms
+     */
+    void SetThirdSparseSmoothMatrix(const Eigen::SparseMatrix<double>& rclMat);
+
     /**
      * Use smoothing-terms
      */
@@ -472,6 +522,8 @@ protected:
     /**
      * Calculates the matrix for the smoothing terms
      * (see U.Dietz dissertation)
+     * The integrals of the products of two basis functions vanish unless the poles
+     * are less than an order apart, so the matrices are sparse.
      */
     virtual void CalcSmoothingTerms(bool bRecalc, double fFirst, double fSecond, double fThird);
 
@@ -495,10 +547,13 @@ protected:
 protected:
     BSplineBasis _clUSpline;      //! B-spline basic function in the u-direction
     BSplineBasis _clVSpline;      //! B-spline basic function in the v-direction
-    math_Matrix _clSmoothMatrix;  //! Matrix of smoothing functionals
-    math_Matrix _clFirstMatrix;   //! Matrix of the 1st smoothing functionals
-    math_Matrix _clSecondMatrix;  //! Matrix of the 2nd smoothing functionals
-    math_Matrix _clThirdMatrix;   //! Matrix of the 3rd smoothing functionals
+    Eigen::SparseMatrix<double> _clSmoothMatrix;  //! Matrix of smoothing functionals
+    Eigen::SparseMatrix<double> _clFirstMatrix;   //! Matrix of the 1st smoothing functionals
+    Eigen::SparseMatrix<double> _clSecondMatrix;  //! Matrix of the 2nd smoothing functionals
+    Eigen::SparseMatrix<double> _clThirdMatrix;   //! Matrix of the 3rd smoothing functionals
+    mutable std::unique_ptr<math_Matrix> _pclDenseFirstMatrix;   //! Dense copies for the getters
+    mutable std::unique_ptr<math_Matrix> _pclDenseSecondMatrix;  //! Dense copies for the getters
+    mutable std::unique_ptr<math_Matrix> _pclDenseThirdMatrix;   //! Dense copies for the getters
 };
 
 }  // namespace Reen
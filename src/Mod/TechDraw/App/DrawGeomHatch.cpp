@@ -21,28 +21,33 @@
  ***************************************************************************/
 
 
+# include <algorithm>
+# include <cmath>
 # include <iomanip>
 # include <limits>
 # include <sstream>
+# include <utility>
 
 #include <Bnd_Box.hxx>
-#include <BRep_Builder.hxx>
-#include <Mod/Part/App/FCBRepAlgoAPI_Common.h>
+#include <BRep_Tool.hxx>
+#include <BRepAdaptor_Curve.hxx>
 #include <BRepBndLib.hxx>
 #include <BRepBuilderAPI_MakeEdge.hxx>
 #include <BRepBuilderAPI_MakeFace.hxx>
 #include <BRepBuilderAPI_MakeVertex.hxx>
 #include <BRepBuilderAPI_Transform.hxx>
+#include <BRepTools_WireExplorer.hxx>
+#include <GCPnts_TangentialDeflection.hxx>
 #include <gp_Pln.hxx>
 #include <gp_Pnt.hxx>
 #include <Precision.hxx>
-#include <TopExp.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopoDS.hxx>
 #include <TopoDS_Vertex.hxx>
 #include <TopoDS_Wire.hxx>
 #include <TopoDS_Edge.hxx>
 #include <TopoDS_Face.hxx>
-#include <TopoDS_Compound.hxx>
-#include <TopTools_IndexedMapOfShape.hxx>
+#include <QtConcurrentMap>
 
 #include <App/Application.h>
 #include <App/Document.h>
@@ -297,6 +302,180 @@ std::vector<LineSet> DrawGeomHatch::getTrimmedLines(DrawViewPart* source, std::v
     );
 }
 
+namespace {
+// the boundary is approximated within this fraction of the face size
+constexpr double RelativeDeflection = 1.0e-4;
+constexpr double AngularDeflection = 0.05;
+
+using HatchSegment = std::pair<Base::Vector3d, Base::Vector3d>;
+
+//! approximate each wire of the face by a closed polygon. The edges are walked in wire order
+//! and every edge starts at the end of the previous one, so the tolerance gaps between edges
+//! can't let a hatch line cross the boundary an odd number of times.
+std::vector<HatchSegment> discretizeBoundary(const TopoDS_Face& face, double deflection)
+{
+    std::vector<HatchSegment> segments;
+    for (TopExp_Explorer wires(face, TopAbs_WIRE); wires.More(); wires.Next()) {
+        const TopoDS_Wire& wire = TopoDS::Wire(wires.Current());
+        std::vector<Base::Vector3d> polygon;
+        for (BRepTools_WireExplorer expl(wire, face); expl.More(); expl.Next()) {
+            const TopoDS_Edge& edge = expl.Current();
+            if (BRep_Tool::Degenerated(edge)) {
+                continue;
+            }
+            BRepAdaptor_Curve adapt(edge);
+            GCPnts_TangentialDeflection points(adapt, AngularDeflection, deflection);
+            bool reversed = edge.Orientation() == TopAbs_REVERSED;
+            int count = points.NbPoints();
+            // the first point of the edge is the last point of its predecessor
+            for (int i = polygon.empty() ? 1 : 2; i <= count; i++) {
+                gp_Pnt pnt = points.Value(reversed ? count - i + 1 : i);
+                polygon.emplace_back(pnt.X(), pnt.Y(), 0.0);
+            }
+        }
+        if (polygon.size() < 3) {
+            continue;
+        }
+        // the end of the last edge is the start of the first one
+        polygon.back() = polygon.front();
+        for (size_t i = 1; i < polygon.size(); i++) {
+            segments.emplace_back(polygon[i - 1], polygon[i]);
+        }
+    }
+    return segments;
+}
+
+//! clip the lines of one PAT line family against the discretized boundary of a face.
+//! All boundary segments are intersected with the lines they cross in one pass, then each line
+//! sorts its crossings and cuts the inside spans into dashes concurrently.
+std::vector<HatchSegment> clipHatchLines(PATLineSpec hatchLine,
+                                         const std::vector<HatchSegment>& boundary,
+                                         double scale,
+                                         double rotation,
+                                         const Base::Vector3d& hatchOffset)
+{
+    const size_t MaxNumberOfEdges = Preferences::getPreferenceGroup("PAT")->GetInt("MaxSeg", 10000l);
+
+    double interval = hatchLine.getInterval() * scale;
+    if (scale == 0. || interval == 0. || boundary.empty()) {
+        return {};
+    }
+    double offset = hatchLine.getOffset() * scale;
+    Base::Vector3d origin = hatchLine.getOrigin() * scale;
+    origin.RotateZ(Base::toRadians(rotation));
+    origin += Base::Vector3d(hatchOffset.x, hatchOffset.y, 0.);
+
+    const double hatchAngle = Base::toRadians(hatchLine.getAngle() + rotation);
+    Base::Vector3d hatchDirection(cos(hatchAngle), sin(hatchAngle), 0.);
+    Base::Vector3d hatchPerpendicular(-hatchDirection.y, hatchDirection.x, 0.);
+    Base::Vector3d hatchIntervalAndOffset = offset * hatchDirection + interval * hatchPerpendicular;
+
+    // the dashes of one repeat of the pattern as spans along the line
+    std::vector<double> dashParams = hatchLine.getDashParms().get();
+    std::vector<std::pair<double, double>> dashes;
+    double globalDashStep = 0.;
+    for (double len : dashParams) {
+        len *= scale;
+        if (len > 0.) {
+            dashes.emplace_back(globalDashStep, globalDashStep + len);
+        }
+        globalDashStep += std::abs(len);
+    }
+    const bool solid = dashParams.empty();
+    if (!solid && globalDashStep == 0.) {
+        return {};
+    }
+
+    // In these coordinates line i of the family is s == i and t is the distance along the
+    // line. A segment crosses line i if s(start) <= i < s(end) or the other way round, so
+    // a vertex on a line is counted once if the boundary passes through it and an even
+    // number of times if it only touches the line.
+    struct Coords
+    {
+        double s;
+        double t;
+    };
+    auto toCoords = [&](const Base::Vector3d& pnt) {
+        Base::Vector3d dir = pnt - origin;
+        return Coords {dir.Dot(hatchPerpendicular) / interval, dir.Dot(hatchDirection)};
+    };
+
+    std::vector<std::pair<Coords, Coords>> coords;
+    coords.reserve(boundary.size());
+    double minS = std::numeric_limits<double>::max();
+    double maxS = -std::numeric_limits<double>::max();
+    for (auto& seg : boundary) {
+        coords.emplace_back(toCoords(seg.first), toCoords(seg.second));
+        minS = std::min({minS, coords.back().first.s, coords.back().second.s});
+        maxS = std::max({maxS, coords.back().first.s, coords.back().second.s});
+    }
+
+    const double firstLine = std::ceil(minS);
+    const double numLines = std::ceil(maxS) - firstLine;
+    if (numLines <= 0. || numLines > static_cast<double>(MaxNumberOfEdges)) {
+        return {};
+    }
+
+    struct ScanLine
+    {
+        std::vector<double> crossings;
+        std::vector<HatchSegment> segments;
+    };
+    std::vector<ScanLine> lines(static_cast<size_t>(numLines));
+    for (auto& [start, end] : coords) {
+        double lo = std::min(start.s, end.s);
+        double hi = std::max(start.s, end.s);
+        for (double i = std::ceil(lo); i < hi; i += 1.) {
+            double t = start.t + (end.t - start.t) * (i - start.s) / (end.s - start.s);
+            // the origin of each line is shifted by the offset of the pattern
+            lines[static_cast<size_t>(i - firstLine)].crossings.push_back(t - i * offset);
+        }
+    }
+
+    const ScanLine* first = lines.data();
+    QtConcurrent::blockingMap(lines, [&](ScanLine& line) {
+        double index = firstLine + static_cast<double>(&line - first);
+        Base::Vector3d lineOrigin = origin + index * hatchIntervalAndOffset;
+        auto addSegment = [&](double from, double to) {
+            if (to - from > Precision::Confusion()) {
+                line.segments.emplace_back(lineOrigin + from * hatchDirection,
+                                           lineOrigin + to * hatchDirection);
+            }
+        };
+
+        // a line that doesn't enter and leave the face equally often passes through a gap in
+        // the boundary, its spans can't be told from the gaps between them
+        if (line.crossings.size() % 2 != 0) {
+            return;
+        }
+        std::sort(line.crossings.begin(), line.crossings.end());
+        for (size_t k = 1; k < line.crossings.size(); k += 2) {
+            double from = line.crossings[k - 1];
+            double to = line.crossings[k];
+            if (solid) {
+                addSegment(from, to);
+                continue;
+            }
+            for (double j = std::floor(from / globalDashStep); j * globalDashStep < to; j += 1.) {
+                double repeat = j * globalDashStep;
+                for (auto& dash : dashes) {
+                    addSegment(std::max(from, repeat + dash.first), std::min(to, repeat + dash.second));
+                }
+            }
+        }
+    });
+
+    std::vector<HatchSegment> result;
+    for (auto& line : lines) {
+        result.insert(result.end(), line.segments.begin(), line.segments.end());
+        if (result.size() > MaxNumberOfEdges) {
+            return {};
+        }
+    }
+    return result;
+}
+}  // namespace
+
 std::vector<LineSet> DrawGeomHatch::getTrimmedLines(DrawViewPart* source,
                                                     std::vector<LineSet> lineSets,
                                                     TopoDS_Face f,
@@ -312,68 +491,47 @@ std::vector<LineSet> DrawGeomHatch::getTrimmedLines(DrawViewPart* source,
         return result;
     }
 
-    TopoDS_Face face = f;
+    if (f.IsNull()) {
+        return result;
+    }
 
     Bnd_Box bBox;
-    BRepBndLib::AddOptimal(face, bBox);
+    BRepBndLib::AddOptimal(f, bBox);
     bBox.SetGap(0.0);
-    gp_Vec translateVector(hatchOffset.x, hatchOffset.y, 0.);
-    auto cornerMin = bBox.CornerMin().Translated(-translateVector);
-    auto cornerMax = bBox.CornerMax().Translated(-translateVector);
-    bBox = Bnd_Box(cornerMin, cornerMax);
+    if (bBox.IsVoid()) {
+        return result;
+    }
 
-    for (auto& ls: lineSets) {
-        PATLineSpec hl = ls.getPATLineSpec();
-        std::vector<TopoDS_Edge> candidates = DrawGeomHatch::makeEdgeOverlay(hl, bBox, scale, hatchRotation);   //completely cover face bbox with lines
-
-        //make Compound for this linespec
-        BRep_Builder builder;
-        TopoDS_Compound gridComp;
-        builder.MakeCompound(gridComp);
-        for (auto& c: candidates) {
-           builder.Add(gridComp, c);
-        }
+    //the boundary is discretized once and shared by all line specs instead of intersecting
+    //a grid of edges with the face in a boolean operation
+    double deflection = std::max(Precision::Confusion(), sqrt(bBox.SquareExtent()) * RelativeDeflection);
+    std::vector<HatchSegment> boundary = discretizeBoundary(f, deflection);
 
-        TopoDS_Shape grid = gridComp;
-        gp_Trsf xGridTranslate;
-        xGridTranslate.SetTranslation(Base::convertTo<gp_Vec>(hatchOffset));
-        BRepBuilderAPI_Transform mkTransTranslate(grid, xGridTranslate, true);
-        grid = mkTransTranslate.Shape();
-
-        //Common(Compound, Face)
-        FCBRepAlgoAPI_Common mkCommon(face, grid);
-        if (!mkCommon.IsDone() ||
-            mkCommon.Shape().IsNull()) {
-            return result;
-        }
-        TopoDS_Shape common = mkCommon.Shape();
+    for (auto& ls: lineSets) {
+        std::vector<HatchSegment> segments =
+            clipHatchLines(ls.getPATLineSpec(), boundary, scale, hatchRotation, hatchOffset);
 
         //save the boundingBox of hatch pattern
         Bnd_Box overlayBox;
         overlayBox.SetGap(0.0);
-        BRepBndLib::AddOptimal(common, overlayBox);
-        ls.setBBox(overlayBox);
 
-        //get resulting edges
+        //only the final segments become edges
         std::vector<TopoDS_Edge> resultEdges;
-        TopTools_IndexedMapOfShape mapOfEdges;
-        TopExp::MapShapes(common, TopAbs_EDGE, mapOfEdges);
-        for ( int i = 1 ; i <= mapOfEdges.Extent() ; i++ ) {           //remember, TopExp makes no promises about the order it finds edges
-            const TopoDS_Edge& edge = TopoDS::Edge(mapOfEdges(i));
-            if (edge.IsNull()) {
-                continue;
-            }
-            resultEdges.push_back(edge);
-        }
-
         std::vector<TechDraw::BaseGeomPtr> resultGeoms;
-        for (auto& e: resultEdges) {
+        resultEdges.reserve(segments.size());
+        resultGeoms.reserve(segments.size());
+        for (auto& [start, end]: segments) {
+            overlayBox.Add(gp_Pnt(start.x, start.y, start.z));
+            overlayBox.Add(gp_Pnt(end.x, end.y, end.z));
+            TopoDS_Edge e = makeLine(start, end);
+            resultEdges.push_back(e);
             TechDraw::BaseGeomPtr base = BaseGeom::baseFactory(e);
             if (!base) {
                 throw Base::ValueError("DGH::getTrimmedLines - baseFactory failed");
             }
             resultGeoms.push_back(base);
         }
+        ls.setBBox(overlayBox);
         ls.setEdges(resultEdges);
         ls.setGeoms(resultGeoms);
         result.push_back(ls);
@@ -82,6 +82,8 @@ public:
     static std::vector<LineSet> getTrimmedLines(DrawViewPart* dvp, std::vector<LineSet> lineSets, int iface,
                                                 double scale, double hatchRotation = 0.0,
                                                 Base::Vector3d hatchOffset = Base::Vector3d(0.0, 0.0, 0.0));
+    //! clips the pattern lines against the discretized face boundary, edges are only made
+    //! for the resulting segments
     static std::vector<LineSet> getTrimmedLines(DrawViewPart* source,
                                                 std::vector<LineSet> lineSets,
                                                 TopoDS_Face face,
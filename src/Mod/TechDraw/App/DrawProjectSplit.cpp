@@ -446,6 +446,9 @@ std::vector<TopoDS_Edge> DrawProjectSplit::scrubEdges(std::vector<TopoDS_Edge>&
         edgeList.Append(edge);
     }
 
+    // The general fuse finds the intersecting pairs of edges with its own
+    // bounding box tree, so unlike findFacesOld() this doesn't need
+    // findOverlappingBoxes().
     BOPAlgo_Builder bopBuilder;
     bopBuilder.SetArguments(edgeList);
     bopBuilder.SetFuzzyValue(FUZZYADJUST*EWTOLERANCE);
@@ -592,13 +595,25 @@ std::vector<TopoDS_Edge> DrawProjectSplit::removeOverlapEdges(const std::vector<
     std::vector<TopoDS_Edge> overlapEdges;
     std::vector<bool> skipThisEdge(inEdges.size(), false);
     int edgeCount = inEdges.size();
+
+    //only edges with intersecting boxes can overlap, so find these pairs once instead of
+    //checking every pair of edges
+    std::vector<Bnd_Box> boxes(edgeCount);
+    for (int iEdge = 0; iEdge < edgeCount; iEdge++) {
+        BRepBndLib::Add(inEdges.at(iEdge), boxes.at(iEdge));
+        boxes.at(iEdge).SetGap(0.1);
+    }
+    std::vector<std::vector<int>> candidates(edgeCount);
+    for (auto& [first, second] : findOverlappingBoxes(boxes)) {
+        candidates.at(first).push_back(second);
+    }
+
     int ie0 = 0;
     for (; ie0 < edgeCount; ie0++) {
         if (skipThisEdge.at(ie0)) {
             continue;
         }
-        int ie1 = ie0 + 1;
-        for (; ie1 < edgeCount; ie1++) {
+        for (int ie1 : candidates.at(ie0)) {
             if (skipThisEdge.at(ie1)) {
                 continue;
             }
@@ -715,6 +730,44 @@ bool DrawProjectSplit::boxesIntersect(const TopoDS_Edge &edge0, const TopoDS_Edg
     return true;
 }
 
+//! find all pairs of boxes that intersect by sweeping over the boxes sorted by their lower
+//! X bound. The pairs are sorted and the first index of each pair is the smaller one.
+std::vector<std::pair<int, int>> DrawProjectSplit::findOverlappingBoxes(const std::vector<Bnd_Box>& boxes)
+{
+    int boxCount = boxes.size();
+    std::vector<int> order;
+    std::vector<double> xMin(boxCount), xMax(boxCount);
+    for (int iBox = 0; iBox < boxCount; iBox++) {
+        if (boxes.at(iBox).IsVoid()) {
+            continue;
+        }
+        double yMin, zMin, yMax, zMax;
+        boxes.at(iBox).Get(xMin.at(iBox), yMin, zMin, xMax.at(iBox), yMax, zMax);
+        order.push_back(iBox);
+    }
+    std::sort(order.begin(), order.end(), [&xMin](int i0, int i1) {
+        return xMin.at(i0) < xMin.at(i1);
+    });
+
+    std::vector<std::pair<int, int>> result;
+    std::vector<int> active;        //boxes that may still reach the current one in X
+    for (int current : order) {
+        auto last = std::remove_if(active.begin(), active.end(), [&](int iBox) {
+            return xMax.at(iBox) < xMin.at(current);
+        });
+        active.erase(last, active.end());
+        for (int iBox : active) {
+            if (!boxes.at(iBox).IsOut(boxes.at(current))) {
+                result.emplace_back(std::min(iBox, current), std::max(iBox, current));
+            }
+        }
+        active.push_back(current);
+    }
+
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
 //this is an aid to debugging and isn't used in normal processing.
 void DrawProjectSplit::dumpVertexMap(vertexMap verts)
 {
@@ -36,6 +36,7 @@
 
 class gp_Pnt;
 class gp_Ax2;
+class Bnd_Box;
 
 namespace TechDraw
 {
@@ -130,6 +131,7 @@ public:
                                               const TopoDS_Edge& e1);
     static bool                     boxesIntersect(const TopoDS_Edge& e0,
                                                    const TopoDS_Edge& e1);
+    static std::vector<std::pair<int, int>> findOverlappingBoxes(const std::vector<Bnd_Box>& boxes);
     static void dumpVertexMap(vertexMap verts);
 
 };
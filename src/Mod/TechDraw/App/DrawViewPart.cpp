@@ -607,60 +607,35 @@ void DrawViewPart::findFacesOld(const std::vector<BaseGeomPtr> &goEdges)
 
     //HLR algo does not provide all edge intersections for edge endpoints.
     //need to split long edges touched by Vertex of another edge
-    std::vector<splitPoint> splits;
-    std::vector<TopoDS_Edge>::iterator itOuter = nonZero.begin();
-    int iOuter = 0;
-    for (; itOuter != nonZero.end(); ++itOuter, iOuter++) {//*** itOuter != nonZero.end() - 1
-        TopoDS_Vertex v1 = TopExp::FirstVertex((*itOuter));
-        TopoDS_Vertex v2 = TopExp::LastVertex((*itOuter));
-        Bnd_Box sOuter;
-        BRepBndLib::AddOptimal(*itOuter, sOuter);
-        sOuter.SetGap(0.1);
-        if (sOuter.IsVoid()) {
-            continue;
-        }
-        if (DrawUtil::isZeroEdge(*itOuter)) {
+    //only edges whose bboxes intersect can touch, so these pairs are found in one sweep
+    std::vector<Bnd_Box> boxes(nonZero.size());
+    for (size_t iEdge = 0; iEdge < nonZero.size(); iEdge++) {
+        if (DrawUtil::isZeroEdge(nonZero.at(iEdge))) {
             continue;                   //skip zero length edges. shouldn't happen ;)
         }
-        int iInner = 0;
-        std::vector<TopoDS_Edge>::iterator itInner = nonZero.begin();//***sb itOuter + 1;
-        for (; itInner != nonZero.end(); ++itInner, iInner++) {
-            if (iInner == iOuter) {
-                continue;
-            }
-            if (DrawUtil::isZeroEdge((*itInner))) {
-                continue;//skip zero length edges. shouldn't happen ;)
-            }
-
-            Bnd_Box sInner;
-            BRepBndLib::AddOptimal(*itInner, sInner);
-            sInner.SetGap(0.1);
-            if (sInner.IsVoid()) {
-                continue;
-            }
-            if (sOuter.IsOut(sInner)) {//bboxes of edges don't intersect, don't bother
-                continue;
-            }
+        BRepBndLib::AddOptimal(nonZero.at(iEdge), boxes.at(iEdge));
+        boxes.at(iEdge).SetGap(0.1);
+    }
 
+    std::vector<splitPoint> splits;
+    auto addSplits = [&](int iInner, int iOuter) {
+        for (TopoDS_Vertex v : {TopExp::FirstVertex(nonZero.at(iOuter)),
+                                TopExp::LastVertex(nonZero.at(iOuter))}) {
             double param = -1;
-            if (DrawProjectSplit::isOnEdge((*itInner), v1, param, false)) {
-                gp_Pnt pnt1 = BRep_Tool::Pnt(v1);
-                splitPoint s1;
-                s1.i = iInner;
-                s1.v = Base::Vector3d(pnt1.X(), pnt1.Y(), pnt1.Z());
-                s1.param = param;
-                splits.push_back(s1);
+            if (DrawProjectSplit::isOnEdge(nonZero.at(iInner), v, param, false)) {
+                gp_Pnt pnt = BRep_Tool::Pnt(v);
+                splitPoint s;
+                s.i = iInner;
+                s.v = Base::Vector3d(pnt.X(), pnt.Y(), pnt.Z());
+                s.param = param;
+                splits.push_back(s);
             }
-            if (DrawProjectSplit::isOnEdge((*itInner), v2, param, false)) {
-                gp_Pnt pnt2 = BRep_Tool::Pnt(v2);
-                splitPoint s2;
-                s2.i = iInner;
-                s2.v = Base::Vector3d(pnt2.X(), pnt2.Y(), pnt2.Z());
-                s2.param = param;
-                splits.push_back(s2);
-            }
-        }//inner loop
-    }    //outer loop
+        }
+    };
+    for (auto& [first, second] : DrawProjectSplit::findOverlappingBoxes(boxes)) {
+        addSplits(first, second);
+        addSplits(second, first);
+    }
 
     std::vector<splitPoint> sorted = DrawProjectSplit::sortSplits(splits, true);
     auto last = std::unique(sorted.begin(), sorted.end(),
@@ -26,8 +26,10 @@
 //**************************************************************************
 
 
+# include <algorithm>
 # include <cmath>
 # include <limits>
+# include <set>
 # include <sstream>
 # include <BRep_Tool.hxx>
 # include <BRepBuilderAPI_MakeWire.hxx>
@@ -269,25 +271,19 @@ std::vector<TopoDS_Vertex> EdgeWalker:: makeUniqueVList(std::vector<TopoDS_Edge>
 {
 //    Base::Console().message("TRACE - EW::makeUniqueVList() - edgesIn: %d\n", edges.size());
     std::vector<TopoDS_Vertex> uniqueVert;
+    VertexWelder welder(EWTOLERANCE);
     for(auto& e:edges) {
         Base::Vector3d v1 = DrawUtil::vertex2Vector(TopExp::FirstVertex(e));
         Base::Vector3d v2 = DrawUtil::vertex2Vector(TopExp::LastVertex(e));
-        bool addv1 = true;
-        bool addv2 = true;
         //check if we've already added this vertex
-        for (const auto& v: uniqueVert) {
-            Base::Vector3d v3d = DrawUtil::vertex2Vector(v);
-            if (v3d.IsEqual(v1, EWTOLERANCE)) {
-                addv1 = false;
-            }
-            if (v3d.IsEqual(v2, EWTOLERANCE)) {
-                addv2 = false;
-            }
-        }
+        bool addv1 = welder.find(v1) == std::numeric_limits<std::size_t>::max();
+        bool addv2 = welder.find(v2) == std::numeric_limits<std::size_t>::max();
         if (addv1) {
+            welder.add(v1);
             uniqueVert.push_back(TopExp::FirstVertex(e));
         }
         if (addv2) {
+            welder.add(v2);
             uniqueVert.push_back(TopExp::LastVertex(e));
         }
     }
@@ -301,15 +297,20 @@ std::vector<WalkerEdge> EdgeWalker::makeWalkerEdges(std::vector<TopoDS_Edge> edg
 {
 //    Base::Console().message("TRACE - EW::makeWalkerEdges() - edges: %d  verts: %d\n", edges.size(), verts.size());
     m_saveInEdges = edges;
+    VertexWelder welder(EWTOLERANCE);
+    for (const auto& v : verts) {
+        welder.add(DrawUtil::vertex2Vector(v));
+    }
+
     std::vector<WalkerEdge> walkerEdges;
     for (const auto& e:edges) {
-        TopoDS_Vertex edgeVertex1 = TopExp::FirstVertex(e);
-        TopoDS_Vertex edgeVertex2 = TopExp::LastVertex(e);
-        std::size_t vertex1Index = findUniqueVert(edgeVertex1, verts);
+        Base::Vector3d edgeVertex1 = DrawUtil::vertex2Vector(TopExp::FirstVertex(e));
+        Base::Vector3d edgeVertex2 = DrawUtil::vertex2Vector(TopExp::LastVertex(e));
+        std::size_t vertex1Index = welder.find(edgeVertex1);
         if (vertex1Index == std::numeric_limits<std::size_t>::max()) {
             continue;
         }
-        std::size_t vertex2Index = findUniqueVert(edgeVertex2, verts);
+        std::size_t vertex2Index = welder.find(edgeVertex2);
         if (vertex2Index == std::numeric_limits<std::size_t>::max()) {
             continue;
         }
@@ -365,8 +366,21 @@ std::vector<TopoDS_Wire> EdgeWalker::sortStrip(std::vector<TopoDS_Wire> fw, bool
 std::vector<TopoDS_Wire> EdgeWalker::sortWiresBySize(std::vector<TopoDS_Wire>& w, bool ascend)
 {
     //Base::Console().message("TRACE - EW::sortWiresBySize()\n");
-    std::vector<TopoDS_Wire> wires = w;
-    std::sort(wires.begin(), wires.end(), EdgeWalker::wireCompare);
+    //compute each area once instead of in every comparison
+    std::vector<std::pair<double, std::size_t>> areas;
+    areas.reserve(w.size());
+    for (std::size_t i = 0; i < w.size(); i++) {
+        areas.emplace_back(ShapeAnalysis::ContourArea(w[i]), i);
+    }
+    std::sort(areas.begin(), areas.end(), [](const auto& a1, const auto& a2) {
+        return a1.first > a2.first;
+    });
+
+    std::vector<TopoDS_Wire> wires;
+    wires.reserve(w.size());
+    for (auto& area : areas) {
+        wires.push_back(w[area.second]);
+    }
     if (ascend) {
         std::reverse(wires.begin(), wires.end());
     }
@@ -386,36 +400,38 @@ std::vector<embedItem> EdgeWalker::makeEmbedding(const std::vector<TopoDS_Edge>
 {
 //    Base::Console().message("TRACE - EW::makeEmbedding(edges: %d, verts: %d)\n",
 //                            edges.size(), uniqueVList.size());
-    std::vector<embedItem> result;
+    VertexWelder welder(EWTOLERANCE);
+    for (const auto& v : uniqueVList) {
+        welder.add(DrawUtil::vertex2Vector(v));
+    }
 
-    std::size_t iVert = 0;
-    //make an embedItem for each vertex in uniqueVList
-    //for each vertex v
-    //  find all the edges that have v as first or last vertex
-    for (auto& v: uniqueVList) {
-        TopoDS_Vertex cv = v;               //v is const but we need non-const for vertexEqual
-        std::size_t iEdge = 0;
-        std::vector<incidenceItem> iiList;
-        for (auto& e: edges) {
-            double angle = 0;
-            TopoDS_Vertex edgeVertex1 = TopExp::FirstVertex(e);
-            TopoDS_Vertex edgeVertex2 = TopExp::LastVertex(e);
-            if (DrawUtil::vertexEqual(cv, edgeVertex1)) {
-                angle = DrawUtil::incidenceAngleAtVertex(e,v,EWTOLERANCE);
-                incidenceItem ii(iEdge, angle, m_saveWalkerEdges[iEdge].ed);
-                iiList.push_back(ii);
-            } else if (DrawUtil::vertexEqual(cv, edgeVertex2)) {
-                angle = DrawUtil::incidenceAngleAtVertex(e,v,EWTOLERANCE);
-                incidenceItem ii(iEdge, angle, m_saveWalkerEdges[iEdge].ed);
-                iiList.push_back(ii);
+    //make an embedItem for each vertex in uniqueVList and add each edge to the
+    //incidence lists of its first and last vertex
+    std::vector<std::vector<incidenceItem>> iiLists(uniqueVList.size());
+    std::size_t iEdge = 0;
+    for (auto& e: edges) {
+        std::size_t iVert1 = welder.find(DrawUtil::vertex2Vector(TopExp::FirstVertex(e)));
+        std::size_t iVert2 = welder.find(DrawUtil::vertex2Vector(TopExp::LastVertex(e)));
+        for (std::size_t iVert : {iVert1, iVert2}) {
+            if (iVert >= uniqueVList.size()) {
+                continue;
+            }
+            double angle = DrawUtil::incidenceAngleAtVertex(e, uniqueVList[iVert], EWTOLERANCE);
+            iiLists[iVert].emplace_back(iEdge, angle, m_saveWalkerEdges[iEdge].ed);
+            if (iVert1 == iVert2) {
+                break;      //closed edge
             }
-            iEdge++;
-       }
-       //sort incidenceList by angle
-       iiList = embedItem::sortIncidenceList(iiList,  false);
-       embedItem embed(iVert, iiList);
-       result.push_back(embed);
-       iVert++;
+        }
+        iEdge++;
+    }
+
+    std::vector<embedItem> result;
+    result.reserve(iiLists.size());
+    std::size_t iVert = 0;
+    for (auto& iiList : iiLists) {
+        //sort incidenceList by angle
+        result.emplace_back(iVert, embedItem::sortIncidenceList(iiList, false));
+        iVert++;
     }
     return result;
 }
@@ -515,21 +531,17 @@ std::size_t ewWire::size(void)
 ewWireList ewWireList::removeDuplicateWires()
 {
     ewWireList result;
-    if (wires.empty()) {
-        return result;
-    }
-    result.push_back(*(wires.begin()));                //save the first ewWire
-    std::vector<ewWire>::iterator iWire = (wires.begin()) + 1;    //starting with second
-    for (; iWire != wires.end(); iWire++) {
-        bool addToResult = true;
-        for (auto& w:result.wires) {
-            if ((*iWire).isEqual(w))  {             //already in result?
-                addToResult = false;
-                break;
-            }
+    //a wire is identified by the sorted indices of its edges
+    std::set<std::vector<std::size_t>> usedEdgeSets;
+    for (auto& w : wires) {
+        std::vector<std::size_t> edgeSet;
+        edgeSet.reserve(w.wedges.size());
+        for (auto& we : w.wedges) {
+            edgeSet.push_back(we.idx);
         }
-        if (addToResult) {
-            result.push_back((*iWire));
+        std::sort(edgeSet.begin(), edgeSet.end());
+        if (usedEdgeSets.insert(std::move(edgeSet)).second) {       //not in result yet
+            result.push_back(w);
         }
     }
     return result;
@@ -545,6 +557,63 @@ std::size_t ewWireList::size(void)
     return wires.size();
 }
 
+//*************************************
+//* VertexWelder Methods
+//*************************************
+
+VertexWelder::VertexWelder(double tolerance)
+    : m_tolerance(tolerance)
+{
+}
+
+VertexWelder::Cell VertexWelder::cellOf(const Base::Vector3d& point) const
+{
+    return {static_cast<long long>(std::floor(point.x / m_tolerance)),
+            static_cast<long long>(std::floor(point.y / m_tolerance)),
+            static_cast<long long>(std::floor(point.z / m_tolerance))};
+}
+
+std::size_t VertexWelder::CellHash::operator()(const Cell& cell) const
+{
+    std::size_t hash = 0;
+    for (long long value : cell) {
+        hash = hash * 1000003 ^ std::hash<long long>()(value);
+    }
+    return hash;
+}
+
+std::size_t VertexWelder::find(const Base::Vector3d& point) const
+{
+    //a point within tolerance is at most one cell away in each direction
+    std::size_t result = std::numeric_limits<std::size_t>::max();
+    Cell center = cellOf(point);
+    Cell cell;
+    for (cell[0] = center[0] - 1; cell[0] <= center[0] + 1; cell[0]++) {
+        for (cell[1] = center[1] - 1; cell[1] <= center[1] + 1; cell[1]++) {
+            for (cell[2] = center[2] - 1; cell[2] <= center[2] + 1; cell[2]++) {
+                auto it = m_cells.find(cell);
+                if (it == m_cells.end()) {
+                    continue;
+                }
+                for (std::size_t index : it->second) {
+                    if (index < result && m_points[index].IsEqual(point, m_tolerance)) {
+                        result = index;
+                        break;      //indices in a cell are ascending
+                    }
+                }
+            }
+        }
+    }
+    return result;
+}
+
+std::size_t VertexWelder::add(const Base::Vector3d& point)
+{
+    m_points.push_back(point);
+    m_cells[cellOf(point)].push_back(m_points.size() - 1);
+    return m_points.size() - 1;
+}
+
 //*************************************
 //* embedItem Methods
 //*************************************
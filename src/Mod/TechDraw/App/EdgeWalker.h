@@ -28,6 +28,8 @@
 #ifndef TECHDRAW_EDGEWALKER_H
 #define TECHDRAW_EDGEWALKER_H
 
+#include <array>
+#include <unordered_map>
 #include <vector>
 
 #include <boost/graph/adjacency_list.hpp>
@@ -39,6 +41,7 @@
 #include <TopoDS_Vertex.hxx>
 #include <TopoDS_Wire.hxx>
 
+#include <Base/Vector3D.h>
 #include <Mod/TechDraw/TechDrawGlobal.h>
 
 
@@ -148,6 +151,31 @@ public:
     static std::vector<incidenceItem> sortIncidenceList (std::vector<incidenceItem> &list, bool ascend);
 };
 
+//! welds points that are within a tolerance of each other. Each point is hashed into a cell
+//! of the tolerance size, so only the neighbouring cells have to be searched.
+class TechDrawExport VertexWelder
+{
+public:
+    explicit VertexWelder(double tolerance);
+
+    //! index of the first point within tolerance or std::numeric_limits<std::size_t>::max()
+    std::size_t find(const Base::Vector3d& point) const;
+    std::size_t add(const Base::Vector3d& point);
+    std::size_t size() const { return m_points.size(); }
+
+private:
+    using Cell = std::array<long long, 3>;
+    struct CellHash
+    {
+        std::size_t operator()(const Cell& cell) const;
+    };
+    Cell cellOf(const Base::Vector3d& point) const;
+
+    double m_tolerance;
+    std::vector<Base::Vector3d> m_points;
+    std::unordered_map<Cell, std::vector<std::size_t>, CellHash> m_cells;
+};
+
 
 class TechDrawExport EdgeWalker
 {
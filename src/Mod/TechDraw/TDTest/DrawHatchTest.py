@@ -5,6 +5,9 @@ import FreeCAD
 import os
 import unittest
 
+import Part
+import TechDraw
+
 
 class DrawHatchTest(unittest.TestCase):
     def setUp(self):
@@ -53,6 +56,38 @@ class DrawHatchTest(unittest.TestCase):
 
         self.assertTrue("Up-to-date" in hatch.State)
 
+    def testGeomHatchClipping(self):
+        """Tests geom hatch lines clipped to a face with holes match a boolean common"""
+        face = Part.makePlane(100, 60, FreeCAD.Vector(2, 1, 0))
+        circle = Part.Face(Part.Wire(Part.makeCircle(10, FreeCAD.Vector(30, 30, 0))))
+        square = Part.makePlane(20, 20, FreeCAD.Vector(60, 20, 0))
+        face = face.cut([circle, square]).Faces[0]
+        self.assertEqual(len(face.Wires), 3)
+
+        patFile = os.path.join(FreeCAD.getResourceDir(), "Mod", "TechDraw", "PAT", "FCPAT.pat")
+        hatch = TechDraw.makeGeomHatch(face, 1.0, "Diagonal4", patFile)
+
+        # the 45 degree lines of Diagonal4 are 4mm apart and pass through the origin
+        interval = 4.0
+        direction = FreeCAD.Vector(1, 1, 0).normalize()
+        perpendicular = FreeCAD.Vector(-1, 1, 0).normalize()
+        length = 2 * face.BoundBox.DiagonalLength
+        lines = []
+        for i in range(-40, 41):
+            center = perpendicular * (i * interval)
+            lines.append(Part.makeLine(center - direction * length, center + direction * length))
+        common = face.common(Part.Compound(lines))
+
+        self.assertEqual(len(hatch.Edges), len(common.Edges))
+        self.assertTrue(hatch.BoundBox.isValid())
+        for attr in ("XMin", "YMin", "XMax", "YMax"):
+            self.assertAlmostEqual(
+                getattr(hatch.BoundBox, attr), getattr(common.BoundBox, attr), delta=0.01
+            )
+        self.assertAlmostEqual(
+            sum(e.Length for e in hatch.Edges), sum(e.Length for e in common.Edges), delta=0.1
+        )
+
 
 if __name__ == "__main__":
     unittest.main()
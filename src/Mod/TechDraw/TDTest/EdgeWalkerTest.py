@@ -0,0 +1,89 @@
+#!/usr/bin/env python3
+
+# face finding on synthetic dense line drawings
+# set FREECAD_RUN_BENCHMARKS to also run the large drawings and print the run times
+
+
+import os
+import time
+import unittest
+
+import FreeCAD
+import Part
+import TechDraw
+
+Benchmark = bool(os.environ.get("FREECAD_RUN_BENCHMARKS"))
+
+
+def makeGrid(count):
+    """Returns count horizontal and vertical crossing lines and the number of faces"""
+    edges = []
+    for i in range(count):
+        edges.append(Part.makeLine(FreeCAD.Vector(0, i, 0),
+                                   FreeCAD.Vector(count - 1, i, 0)))
+        edges.append(Part.makeLine(FreeCAD.Vector(i, 0, 0),
+                                   FreeCAD.Vector(i, count - 1, 0)))
+    # all cells plus the outline
+    return edges, (count - 1) ** 2 + 1
+
+
+def makeBricks(rows, columns):
+    """Returns a brick wall where lines end on other lines and the number of faces"""
+    edges = []
+    for row in range(rows + 1):
+        edges.append(Part.makeLine(FreeCAD.Vector(0, row, 0),
+                                   FreeCAD.Vector(columns, row, 0)))
+    bricks = 0
+    for row in range(rows):
+        joints = [0.0, float(columns)]
+        shift = 0.5 * (row % 2)
+        joints += [column + shift for column in range(1, columns) if row % 2 == 0]
+        joints += [column + shift for column in range(columns) if row % 2 == 1]
+        for x in joints:
+            edges.append(Part.makeLine(FreeCAD.Vector(x, row, 0),
+                                       FreeCAD.Vector(x, row + 1, 0)))
+        bricks += len(joints) - 1
+    # all bricks plus the outline
+    return edges, bricks + 1
+
+
+class EdgeWalkerTest(unittest.TestCase):
+    def walk(self, name, edges):
+        """Runs the edge walker on edges and reports the run time when benchmarking"""
+        start = time.perf_counter()
+        wires = TechDraw.edgeWalker(edges, True)
+        elapsed = time.perf_counter() - start
+        if Benchmark:
+            print("EdgeWalker {}: {} lines, {} faces in {:.3f} s".format(
+                name, len(edges), len(wires), elapsed))
+        return wires
+
+    def testGridCase(self):
+        """Tests that a grid of crossing lines is split into its cells"""
+        edges, faces = makeGrid(40)
+        wires = self.walk("grid", edges)
+        self.assertEqual(len(wires), faces)
+
+    def testBrickCase(self):
+        """Tests a brick pattern where lines end on other lines"""
+        edges, faces = makeBricks(30, 30)
+        wires = self.walk("bricks", edges)
+        self.assertEqual(len(wires), faces)
+
+    @unittest.skipUnless(Benchmark, "FREECAD_RUN_BENCHMARKS not set")
+    def testLargeGridCase(self):
+        """Benchmarks a grid of 400 lines with about 40000 cells"""
+        edges, faces = makeGrid(200)
+        wires = self.walk("large grid", edges)
+        self.assertEqual(len(wires), faces)
+
+    @unittest.skipUnless(Benchmark, "FREECAD_RUN_BENCHMARKS not set")
+    def testLargeBrickCase(self):
+        """Benchmarks a brick wall of 150 rows with about 22500 bricks"""
+        edges, faces = makeBricks(150, 150)
+        wires = self.walk("large bricks", edges)
+        self.assertEqual(len(wires), faces)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,64 @@
+# SPDX-License-Identifier: LGPL-2.1-or-later
+"""**************************************************************************
+*                                                                          *
+*   This file is part of FreeCAD.                                          *
+*                                                                          *
+*   FreeCAD is free software: you can redistribute it and/or modify it     *
+*   under the terms of the GNU Lesser General Public License as            *
+*   published by the Free Software Foundation, either version 2.1 of the   *
+*   License, or (at your option) any later version.                        *
+*                                                                          *
+*   FreeCAD is distributed in the hope that it will be useful, but         *
+*   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+*   Lesser General Public License for more details.                        *
+*                                                                          *
+*   You should have received a copy of the GNU Lesser General Public       *
+*   License along with FreeCAD. If not, see                                *
+*   <https://www.gnu.org/licenses/>.                                       *
+*                                                                          *
+***************************************************************************/"""
+
+import FreeCAD, FreeCADGui, unittest
+
+# ---------------------------------------------------------------------------
+# define the functions to test the drawing of link arrays
+# ---------------------------------------------------------------------------
+
+
+class TestLinkViewInstances(unittest.TestCase):
+    def setUp(self):
+        self.doc = FreeCAD.newDocument("TestLinkView")
+        self.obj = self.doc.addObject("App::FeaturePython", "Feature")
+        self.param = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/View")
+        self.threshold = self.param.GetInt("LinkArrayInstanceThreshold", 1000)
+        self.param.SetInt("LinkArrayInstanceThreshold", 4)
+        self.view = FreeCADGui.LinkView()
+        self.view.setLink(self.obj)
+
+    def tearDown(self):
+        self.view.reset()
+        self.param.SetInt("LinkArrayInstanceThreshold", self.threshold)
+        FreeCAD.closeDocument("TestLinkView")
+
+    def countNodes(self):
+        """Returns the number of element switches and instance groups under the root"""
+        root = self.view.RootNode
+        names = [root.getChild(i).getTypeId().getName().getString() for i in range(root.getNumChildren())]
+        return names.count("Switch"), names.count("SoFCInstanceGroup")
+
+    def testGrowAndShrinkOverThreshold(self):
+        """Tests that elements move into and out of the instance group with the array size"""
+        self.view.Count = 3
+        self.assertEqual(self.countNodes(), (3, 0))
+
+        # Only the element with a material override keeps its own nodes
+        self.view.setMaterial({1: FreeCAD.Material()})
+        self.view.Count = 5
+        self.assertEqual(self.countNodes(), (1, 1))
+
+        self.view.setMaterial({1: None})
+        self.assertEqual(self.countNodes(), (0, 1))
+
+        self.view.Count = 2
+        self.assertEqual(self.countNodes(), (2, 0))
@@ -9,6 +9,7 @@
 #include <App/Document.h>
 #include <App/DocumentObject.h>
 #include <App/GeoFeatureGroupExtension.h>
+#include <App/ObjectIdentifier.h>
 #include <Base/Interpreter.h>
 
 using namespace App;
@@ -155,4 +156,33 @@ TEST_F(DocumentObjectTest, getSubObjectList)
     EXPECT_EQ(sizesFlatten[1], strlen(fuseName) + strlen(boxName) + 2);
 }
 
+TEST_F(DocumentObjectTest, getPropertyByName)
+{
+    auto obj = _doc->addObject("App::VarSet");
+    auto prop = obj->addDynamicProperty("App::PropertyInteger", "Variable");
+
+    EXPECT_EQ(obj->getPropertyByName("Label"), &obj->Label);
+    EXPECT_EQ(obj->getPropertyByName("Variable"), prop);
+    EXPECT_EQ(obj->getPropertyByName("NoSuchProperty"), nullptr);
+}
+
+TEST_F(DocumentObjectTest, resolvePropertyOfOtherObject)
+{
+    auto varSet1 = _doc->addObject("App::VarSet");
+    auto varSet2 = _doc->addObject("App::VarSet");
+    auto group = _doc->addObject("App::DocumentObjectGroup");
+
+    App::ObjectIdentifier path(varSet1, "Label");
+    EXPECT_EQ(path.getProperty(), &varSet1->Label);
+    EXPECT_EQ(path.getProperty(), &varSet1->Label);
+
+    // Same type, the static property must be looked up in the new object
+    path.setDocumentObjectName(varSet2);
+    EXPECT_EQ(path.getProperty(), &varSet2->Label);
+
+    // Different type
+    path.setDocumentObjectName(group);
+    EXPECT_EQ(path.getProperty(), &group->Label);
+}
+
 // NOLINTEND(readability-magic-numbers, cppcoreguidelines-avoid-magic-numbers)
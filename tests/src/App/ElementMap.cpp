@@ -2,6 +2,11 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+
 #include <App/Application.h>
 #include <App/ElementMap.h>
 #include <src/App/InitApplication.h>
@@ -63,6 +68,15 @@ protected:
         App::GetApplication().closeDocument(_docName.c_str());
     }
 
+    // The ids of saved and restored element maps are only reset when a document is saved or
+    // restored
+    void resetElementMapIds()
+    {
+        auto doc = App::GetApplication().getDocument(_docName.c_str());
+        App::GetApplication().signalStartSaveDocument(*doc, std::string());
+        App::GetApplication().signalStartRestoreDocument(*doc);
+    }
+
     std::string _docName;
     Data::ElementIDRefs _sid;
     QVector<App::StringIDRef>* _sids;
@@ -294,6 +308,208 @@ TEST_F(ElementMapTest, findIndexedName)
     EXPECT_EQ(findResult2, mappedName2);
 }
 
+TEST_F(ElementMapTest, findMappedNameWithPostfix)
+{
+    // Arrange
+    // The same name split differently into data and postfix must still be found
+    Data::ElementMap elementMap;
+    Data::IndexedName element("Edge", 1);
+    Data::MappedName mappedName = Data::MappedName("TEST") + ";POSTFIX";
+    elementMap.setElementName(element, mappedName, 0);
+
+    // Act
+    auto findResult = elementMap.find(Data::MappedName("TEST;POSTFIX"));
+    auto findResult2 = elementMap.find(Data::MappedName("TEST;") + "POSTFIX");
+
+    // Assert
+    EXPECT_EQ(findResult, element);
+    EXPECT_EQ(findResult2, element);
+}
+
+TEST_F(ElementMapTest, getAllIsSorted)
+{
+    // Arrange
+    Data::ElementMap elementMap;
+    for (int i = 1; i <= 20; ++i) {
+        Data::IndexedName element("Edge", i);
+        elementMap.setElementName(element, Data::MappedName("TEST" + std::to_string(i)), 0);
+    }
+
+    // Act
+    auto all = elementMap.getAll();
+
+    // Assert
+    ASSERT_EQ(all.size(), 20);
+    for (std::size_t i = 1; i < all.size(); ++i) {
+        EXPECT_LT(all[i - 1].name, all[i].name);
+    }
+}
+
+TEST_F(ElementMapTest, saveAndRestoreBinary)
+{
+    // Arrange
+    auto elementMap = std::make_shared<Data::ElementMap>();
+    Data::IndexedName face1("Face", 1);
+    Data::IndexedName edge1("Edge", 1);
+    Data::IndexedName edge2("Edge", 2);
+    elementMap->setElementName(face1, Data::MappedName(face1), 0);
+    elementMap->setElementName(edge1, Data::MappedName("TEST"), 0);
+    elementMap->setElementName(edge1, Data::MappedName("ANOTHERTEST"), 0);
+    elementMap->setElementName(edge2, Data::MappedName(Data::MappedName("TEST2"), ";POST"), 0);
+    std::stringstream stream;
+
+    // Act
+    elementMap->saveBinary(stream);
+    auto restored = std::make_shared<Data::ElementMap>()->restoreBinary(_hasher, stream);
+
+    // Assert
+    auto expected = elementMap->getAll();
+    auto result = restored->getAll();
+    ASSERT_EQ(result.size(), expected.size());
+    for (std::size_t i = 0; i < result.size(); ++i) {
+        EXPECT_EQ(result[i].name, expected[i].name);
+        EXPECT_EQ(result[i].index, expected[i].index);
+    }
+    EXPECT_EQ(stream.peek(), std::char_traits<char>::eof());
+}
+
+TEST_F(ElementMapTest, saveAndRestoreBinaryWithChildMaps)
+{
+    // Arrange
+    resetElementMapIds();
+    LessComplexPart box(1L, "Box", _hasher);
+    LessComplexPart parent(2L, "Parent", _hasher);
+    Data::IndexedName edge1("Edge", 1);
+    Data::ElementIDRefs sids;
+    Data::MappedName hashed =
+        parent.elementMapPtr->hashElementName(Data::MappedName("Face1;:H1,F;:H2:3,E"), sids);
+    ASSERT_FALSE(sids.isEmpty());
+    parent.elementMapPtr->setElementName(edge1, hashed, parent.Tag, &sids);
+    // both children share the element map of the box
+    Data::ElementMap::MappedChildElements childOne = {
+        Data::IndexedName("Ping", 1),
+        2,
+        7,
+        3L,
+        box.elementMapPtr,
+        QByteArray("abcdefghij"),  // postfix must be 10 or more bytes to invoke hasher
+        _sid};
+    Data::ElementMap::MappedChildElements childTwo =
+        {Data::IndexedName("Pong", 2), 2, 7, 4L, box.elementMapPtr, QByteArray("abc"), _sid};
+    parent.elementMapPtr->addChildElements(parent.Tag, {childOne, childTwo});
+    parent.elementMapPtr->hashChildMaps(parent.Tag);
+    parent.elementMapPtr->beforeSave(_hasher);
+    std::stringstream text;
+    std::stringstream binary;
+
+    // Act
+    parent.elementMapPtr->save(text);
+    parent.elementMapPtr->saveBinary(binary);
+    resetElementMapIds();
+    auto fromText = std::make_shared<Data::ElementMap>()->restore(_hasher, text);
+    resetElementMapIds();
+    auto fromBinary = std::make_shared<Data::ElementMap>()->restoreBinary(_hasher, binary);
+
+    // Assert
+    auto expected = fromText->getAll();
+    auto result = fromBinary->getAll();
+    ASSERT_EQ(result.size(), expected.size());
+    for (std::size_t i = 0; i < result.size(); ++i) {
+        EXPECT_EQ(result[i].name, expected[i].name);
+        EXPECT_EQ(result[i].index, expected[i].index);
+    }
+    Data::ElementIDRefs restoredSids;
+    EXPECT_EQ(fromBinary->find(edge1, &restoredSids), hashed);
+    EXPECT_EQ(restoredSids.size(), sids.size());
+
+    auto expectedChildren = fromText->getChildElements();
+    auto children = fromBinary->getChildElements();
+    ASSERT_EQ(children.size(), 2);
+    ASSERT_EQ(children.size(), expectedChildren.size());
+    for (std::size_t i = 0; i < children.size(); ++i) {
+        EXPECT_EQ(children[i].indexedName, expectedChildren[i].indexedName);
+        EXPECT_EQ(children[i].count, expectedChildren[i].count);
+        EXPECT_EQ(children[i].offset, expectedChildren[i].offset);
+        EXPECT_EQ(children[i].tag, expectedChildren[i].tag);
+        EXPECT_EQ(children[i].postfix, expectedChildren[i].postfix);
+        EXPECT_EQ(children[i].sids.size(), expectedChildren[i].sids.size());
+        ASSERT_TRUE(children[i].elementMap);
+        EXPECT_EQ(children[i].elementMap->size(), box.elementMapPtr->size());
+    }
+    // the shared child map is written and restored once
+    EXPECT_EQ(children[0].elementMap, children[1].elementMap);
+    EXPECT_EQ(binary.peek(), std::char_traits<char>::eof());
+}
+
+TEST_F(ElementMapTest, restoreBinarySkipsRestoredMaps)
+{
+    // Arrange
+    resetElementMapIds();
+    LessComplexPart box(1L, "Box", _hasher);
+    LessComplexPart parent(2L, "Parent", _hasher);
+    Data::ElementMap::MappedChildElements child =
+        {Data::IndexedName("Ping", 1), 2, 7, 3L, box.elementMapPtr, QByteArray("abc"), _sid};
+    parent.elementMapPtr->addChildElements(parent.Tag, {child});
+    parent.elementMapPtr->beforeSave(_hasher);
+    std::stringstream first;
+    std::stringstream second;
+    parent.elementMapPtr->saveBinary(first);
+    parent.elementMapPtr->saveBinary(second);
+
+    // Act
+    resetElementMapIds();
+    auto restored = std::make_shared<Data::ElementMap>()->restoreBinary(_hasher, first);
+    auto again = std::make_shared<Data::ElementMap>()->restoreBinary(_hasher, second);
+
+    // Assert
+    EXPECT_EQ(again, restored);
+    EXPECT_EQ(second.peek(), std::char_traits<char>::eof());
+}
+
+TEST_F(ElementMapTest, binaryRestoreTiming)
+{
+    if (!std::getenv("FREECAD_RUN_BENCHMARKS")) {
+        GTEST_SKIP() << "FREECAD_RUN_BENCHMARKS not set";
+    }
+
+    // Arrange
+    constexpr int count = 200000;
+    auto elementMap = std::make_shared<Data::ElementMap>();
+    for (int i = 1; i <= count; ++i) {
+        Data::IndexedName face("Face", i);
+        Data::IndexedName edge("Edge", i);
+        elementMap->setElementName(face, Data::MappedName(face), 1);
+        elementMap->setElementName(edge,
+                                   Data::MappedName(Data::MappedName(face), ";:H1:7,E;:M2;FUS"),
+                                   1);
+    }
+    std::stringstream text;
+    std::stringstream binary;
+    elementMap->save(text);
+    elementMap->saveBinary(binary);
+
+    // Act
+    auto time = [](auto&& func) {
+        auto start = std::chrono::steady_clock::now();
+        func();
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+    resetElementMapIds();
+    double textTime = time([&] {
+        std::make_shared<Data::ElementMap>()->restore(_hasher, text);
+    });
+    resetElementMapIds();
+    double binaryTime = time([&] {
+        std::make_shared<Data::ElementMap>()->restoreBinary(_hasher, binary);
+    });
+
+    // Assert
+    std::cout << "Restoring " << 2 * count << " names: " << text.str().size() << " bytes of text in "
+              << textTime << " s, " << binary.str().size() << " bytes of binary in " << binaryTime
+              << " s" << std::endl;
+    EXPECT_LT(binary.str().size(), text.str().size());
+}
+
 TEST_F(ElementMapTest, findAll)
 {
     // Arrange
@@ -8,7 +8,10 @@
 #include <App/StringIDPy.h>
 
 #include <QCryptographicHash>
+#include <algorithm>
 #include <array>
+#include <thread>
+#include <vector>
 
 class StringIDTest: public ::testing::Test
 {
@@ -1586,3 +1589,57 @@ TEST_F(StringHasherTest, compact)  // NOLINT
     // Assert
     EXPECT_EQ(0, Hasher()->count());
 }
+
+TEST_F(StringHasherTest, getIDConcurrently)  // NOLINT
+{
+    // Arrange
+    const int threadCount {8};
+    const int nameCount {1000};
+    auto hasher = Hasher();
+    std::vector<std::vector<long>> results(threadCount, std::vector<long>(nameCount));
+
+    // Act
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < nameCount; ++i) {
+                // Each thread walks the names in a different order
+                int index = (i + t * nameCount / threadCount) % nameCount;
+                auto name = std::string("Name") + std::to_string(index);
+                auto id = hasher->getID(name.c_str());
+                results[t][index] = id.value();
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Assert
+    EXPECT_EQ(nameCount, hasher->size());
+    for (int t = 1; t < threadCount; ++t) {
+        EXPECT_EQ(results[0], results[t]);
+    }
+    std::vector<long> ids = results[0];
+    std::sort(ids.begin(), ids.end());
+    EXPECT_EQ(1, ids.front());
+    EXPECT_EQ(nameCount, ids.back());
+    EXPECT_EQ(ids.end(), std::unique(ids.begin(), ids.end()));
+}
+
+TEST_F(StringHasherTest, getIDReusesFreedLastID)  // NOLINT
+{
+    // Arrange
+    auto first = Hasher()->getID("first");
+    Hasher()->getID("second");  // Not referenced, removed by compact()
+
+    // Act
+    Hasher()->compact();
+    auto third = Hasher()->getID("third");
+
+    // Assert
+    EXPECT_EQ(1, first.value());
+    EXPECT_EQ(2, third.value());
+    EXPECT_EQ(third, Hasher()->getID(2));
+    EXPECT_EQ(2, Hasher()->size());
+}
@@ -0,0 +1,110 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+
+#include <Inventor/SbViewportRegion.h>
+#include <Inventor/SoDB.h>
+#include <Inventor/SoPickedPoint.h>
+#include <Inventor/actions/SoGetBoundingBoxAction.h>
+#include <Inventor/actions/SoRayPickAction.h>
+#include <Inventor/nodes/SoCube.h>
+#include <Inventor/nodes/SoSeparator.h>
+#include <Gui/Inventor/SoFCInstanceGroup.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class SoFCInstanceGroupTest: public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        SoDB::init();
+        Gui::SoFCInstanceDetail::initClass();
+        Gui::SoFCInstanceGroup::initClass();
+    }
+
+    // Three unit cubes along the x-axis of which the middle one is hidden
+    void SetUp() override
+    {
+        root = new SoSeparator;
+        root->ref();
+        group = new Gui::SoFCInstanceGroup;
+        group->addChild(new SoCube);
+        root->addChild(group);
+
+        for (int i = 0; i < 3; i++) {
+            SbMatrix mat;
+            mat.setTranslate(SbVec3f(10.0F * static_cast<float>(i), 0.0F, 0.0F));
+            group->matrix.set1Value(i, mat);
+        }
+        group->hidden.set1Value(0, false);
+        group->hidden.set1Value(1, true);
+        group->hidden.set1Value(2, false);
+    }
+
+    void TearDown() override
+    {
+        root->unref();
+    }
+
+    int pickInstance(float x)
+    {
+        SoRayPickAction action(SbViewportRegion(100, 100));
+        action.setRay(SbVec3f(x, 0.0F, 10.0F), SbVec3f(0.0F, 0.0F, -1.0F));
+        action.apply(root);
+        SoPickedPoint* pp = action.getPickedPoint();
+        if (!pp) {
+            return -1;
+        }
+        auto det = pp->getDetail(group);
+        if (!det || !det->isOfType(Gui::SoFCInstanceDetail::getClassTypeId())) {
+            return -2;
+        }
+        return static_cast<const Gui::SoFCInstanceDetail*>(det)->getIndex();
+    }
+
+    SoSeparator* root {};
+    Gui::SoFCInstanceGroup* group {};
+};
+
+TEST_F(SoFCInstanceGroupTest, TestBoundingBox)
+{
+    SoGetBoundingBoxAction action(SbViewportRegion(100, 100));
+    action.apply(root);
+    SbBox3f box = action.getBoundingBox();
+    EXPECT_FLOAT_EQ(box.getMin()[0], -1.0F);
+    EXPECT_FLOAT_EQ(box.getMax()[0], 21.0F);
+}
+
+TEST_F(SoFCInstanceGroupTest, TestPickInstance)
+{
+    EXPECT_EQ(pickInstance(0.0F), 0);
+    EXPECT_EQ(pickInstance(20.0F), 2);
+}
+
+TEST_F(SoFCInstanceGroupTest, TestPickHiddenInstance)
+{
+    EXPECT_EQ(pickInstance(10.0F), -1);
+
+    group->hidden.set1Value(1, false);
+    EXPECT_EQ(pickInstance(10.0F), 1);
+}
+
+TEST_F(SoFCInstanceGroupTest, TestPickAllInstances)
+{
+    // A ray along the x-axis enters and leaves both visible cubes
+    SoRayPickAction action(SbViewportRegion(100, 100));
+    action.setRay(SbVec3f(-10.0F, 0.0F, 0.0F), SbVec3f(1.0F, 0.0F, 0.0F));
+    action.setPickAll(true);
+    action.apply(root);
+    const SoPickedPointList& points = action.getPickedPointList();
+    ASSERT_EQ(points.getLength(), 4);
+    for (int i = 0; i < points.getLength(); i++) {
+        auto det = points[i]->getDetail(group);
+        ASSERT_TRUE(det && det->isOfType(Gui::SoFCInstanceDetail::getClassTypeId()));
+        int index = static_cast<const Gui::SoFCInstanceDetail*>(det)->getIndex();
+        EXPECT_EQ(index, points[i]->getPoint()[0] < 10.0F ? 0 : 2);
+    }
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
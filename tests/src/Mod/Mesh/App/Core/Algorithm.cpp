@@ -0,0 +1,114 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <Mod/Mesh/App/Core/Algorithm.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class AlgorithmTest: public ::testing::Test
+{
+protected:
+    // A closed, slightly irregular cylinder built of rings of points
+    static MeshCore::MeshKernel CreateCylinder()
+    {
+        const int rings = 6;
+        const int segments = 8;
+        MeshCore::MeshPointArray points;
+        for (int j = 0; j < rings; j++) {
+            for (int i = 0; i < segments; i++) {
+                double angle = 2.0 * M_PI * i / segments;
+                float radius = 1.0F + 0.1F * static_cast<float>((i + j) % 3);
+                points.emplace_back(radius * static_cast<float>(std::cos(angle)),
+                                    radius * static_cast<float>(std::sin(angle)),
+                                    static_cast<float>(j));
+            }
+        }
+
+        MeshCore::MeshFacetArray facets;
+        for (int j = 0; j < rings - 1; j++) {
+            for (int i = 0; i < segments; i++) {
+                MeshCore::PointIndex p0 = j * segments + i;
+                MeshCore::PointIndex p1 = j * segments + (i + 1) % segments;
+                MeshCore::PointIndex p2 = p1 + segments;
+                MeshCore::PointIndex p3 = p0 + segments;
+                facets.emplace_back(p0, p1, p2);
+                facets.emplace_back(p0, p2, p3);
+            }
+        }
+
+        MeshCore::MeshKernel kernel;
+        kernel.Adopt(points, facets, true);
+        return kernel;
+    }
+
+    template<class Set, class Span>
+    static bool IsEqual(const Set& set, const Span& span)
+    {
+        return set.size() == span.size() && std::equal(span.begin(), span.end(), set.begin());
+    }
+};
+
+TEST_F(AlgorithmTest, TestCompactPointToFacets)
+{
+    MeshCore::MeshKernel kernel = CreateCylinder();
+    MeshCore::MeshRefPointToFacets ref(kernel);
+    MeshCore::MeshCompactPointToFacets compact(kernel);
+
+    ASSERT_EQ(compact.size(), kernel.CountPoints());
+    for (MeshCore::PointIndex pos = 0; pos < kernel.CountPoints(); pos++) {
+        EXPECT_TRUE(IsEqual(ref[pos], compact[pos]));
+        EXPECT_EQ(ref.NeighbourPoints(pos), compact.NeighbourPoints(pos));
+        EXPECT_EQ(ref.GetNormal(pos), compact.GetNormal(pos));
+    }
+
+    EXPECT_EQ(ref.GetIndices(0, 9), compact.GetIndices(0, 9));
+    EXPECT_EQ(ref.GetIndices(0, 1, 9), compact.GetIndices(0, 1, 9));
+    EXPECT_EQ(ref.NeighbourPoints({0, 1}, 2), compact.NeighbourPoints({0, 1}, 2));
+}
+
+TEST_F(AlgorithmTest, TestCompactFacetToFacets)
+{
+    MeshCore::MeshKernel kernel = CreateCylinder();
+    MeshCore::MeshRefFacetToFacets ref(kernel);
+    MeshCore::MeshCompactFacetToFacets compact(kernel, 4);
+
+    ASSERT_EQ(compact.size(), kernel.CountFacets());
+    for (MeshCore::FacetIndex pos = 0; pos < kernel.CountFacets(); pos++) {
+        EXPECT_TRUE(IsEqual(ref[pos], compact[pos]));
+    }
+
+    EXPECT_EQ(ref.GetIndices(0, 3), compact.GetIndices(0, 3));
+}
+
+TEST_F(AlgorithmTest, TestCompactDegeneratedFacet)
+{
+    MeshCore::MeshPointArray points;
+    points.emplace_back(0.0F, 0.0F, 0.0F);
+    points.emplace_back(1.0F, 0.0F, 0.0F);
+    points.emplace_back(0.0F, 1.0F, 0.0F);
+    MeshCore::MeshFacetArray facets;
+    facets.emplace_back(0, 1, 2);
+    facets.emplace_back(0, 1, 1);
+
+    MeshCore::MeshKernel kernel;
+    kernel.Adopt(points, facets, false);
+    MeshCore::MeshRefPointToFacets ref(kernel);
+    MeshCore::MeshCompactPointToFacets compact(kernel);
+
+    // the degenerated facet is listed only once for its repeated point
+    ASSERT_EQ(compact[1].size(), 2);
+    for (MeshCore::PointIndex pos = 0; pos < kernel.CountPoints(); pos++) {
+        EXPECT_TRUE(IsEqual(ref[pos], compact[pos]));
+    }
+}
+
+TEST_F(AlgorithmTest, TestCompactEmptyMesh)
+{
+    MeshCore::MeshKernel kernel;
+    EXPECT_EQ(MeshCore::MeshCompactPointToFacets(kernel).size(), 0);
+    EXPECT_EQ(MeshCore::MeshCompactFacetToFacets(kernel).size(), 0);
+    EXPECT_EQ(MeshCore::MeshCompactPointToPoints(kernel).size(), 0);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
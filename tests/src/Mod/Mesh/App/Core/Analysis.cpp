@@ -0,0 +1,97 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <Mod/Mesh/App/Core/Analysis.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class MeshAnalysisTest: public ::testing::Test
+{
+protected:
+    // A closed tetrahedron
+    static MeshCore::MeshKernel CreateTetrahedron()
+    {
+        Base::Vector3f p0 {0, 0, 0};
+        Base::Vector3f p1 {1, 0, 0};
+        Base::Vector3f p2 {0, 1, 0};
+        Base::Vector3f p3 {0, 0, 1};
+
+        MeshCore::MeshKernel kernel;
+        kernel.AddFacet(MeshCore::MeshGeomFacet(p0, p2, p1));
+        kernel.AddFacet(MeshCore::MeshGeomFacet(p0, p1, p3));
+        kernel.AddFacet(MeshCore::MeshGeomFacet(p1, p2, p3));
+        kernel.AddFacet(MeshCore::MeshGeomFacet(p2, p0, p3));
+        return kernel;
+    }
+};
+
+TEST_F(MeshAnalysisTest, TestEmptyMesh)
+{
+    MeshCore::MeshKernel kernel;
+    MeshCore::MeshAnalysis analysis(kernel);
+    MeshCore::MeshDefectSummary summary = analysis.Evaluate();
+    EXPECT_TRUE(summary.IsValid());
+}
+
+TEST_F(MeshAnalysisTest, TestValidMesh)
+{
+    MeshCore::MeshKernel kernel = CreateTetrahedron();
+    MeshCore::MeshAnalysis analysis(kernel);
+    MeshCore::MeshDefectSummary summary = analysis.Evaluate();
+    EXPECT_TRUE(summary.IsValid());
+    EXPECT_EQ(summary.CountDefects(), 0);
+}
+
+TEST_F(MeshAnalysisTest, TestDuplicatedFacets)
+{
+    MeshCore::MeshKernel kernel = CreateTetrahedron();
+    MeshCore::MeshPointArray points = kernel.GetPoints();
+    MeshCore::MeshFacetArray facets = kernel.GetFacets();
+    facets.push_back(facets[0]);
+    kernel.Adopt(points, facets, true);
+
+    MeshCore::MeshAnalysis analysis(kernel);
+    MeshCore::MeshDefects checks =
+        MeshCore::MeshDefect::DuplicatedFacets | MeshCore::MeshDefect::NonManifoldEdges;
+    MeshCore::MeshDefectSummary summary = analysis.Evaluate(checks);
+    ASSERT_EQ(summary.duplicatedFacets.size(), 1);
+    EXPECT_EQ(summary.duplicatedFacets[0], 4);
+    EXPECT_EQ(summary.nonManifoldEdges.size(), 3);
+    EXPECT_TRUE(summary.degeneratedFacets.empty());
+}
+
+TEST_F(MeshAnalysisTest, TestInvalidIndices)
+{
+    MeshCore::MeshKernel kernel = CreateTetrahedron();
+    MeshCore::MeshPointArray points = kernel.GetPoints();
+    MeshCore::MeshFacetArray facets = kernel.GetFacets();
+    facets[2]._aulPoints[1] = 10;
+    kernel.Adopt(points, facets, false);
+
+    MeshCore::MeshAnalysis analysis(kernel);
+    MeshCore::MeshDefectSummary summary = analysis.Evaluate();
+    ASSERT_EQ(summary.invalidFacets.size(), 1);
+    EXPECT_EQ(summary.invalidFacets[0], 2);
+}
+
+TEST_F(MeshAnalysisTest, TestSelfIntersection)
+{
+    MeshCore::MeshKernel kernel;
+    kernel.AddFacet(MeshCore::MeshGeomFacet(Base::Vector3f(0, 0, 0),
+                                            Base::Vector3f(2, 0, 0),
+                                            Base::Vector3f(0, 2, 0)));
+    kernel.AddFacet(MeshCore::MeshGeomFacet(Base::Vector3f(0.5F, 0.5F, -1),
+                                            Base::Vector3f(0.5F, 0.5F, 1),
+                                            Base::Vector3f(1.5F, 0.5F, 0)));
+
+    MeshCore::MeshAnalysis analysis(kernel);
+    analysis.SetThreads(2);
+    MeshCore::MeshDefectSummary summary =
+        analysis.Evaluate(MeshCore::MeshDefect::SelfIntersections);
+    ASSERT_EQ(summary.selfIntersections.size(), 1);
+    EXPECT_EQ(summary.selfIntersections[0].first, 0);
+    EXPECT_EQ(summary.selfIntersections[0].second, 1);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
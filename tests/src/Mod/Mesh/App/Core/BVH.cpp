@@ -0,0 +1,89 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <Mod/Mesh/App/Core/BVH.h>
+#include <Mod/Mesh/App/Core/Evaluation.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class BVHTest: public ::testing::Test
+{
+protected:
+    // A strip of small triangles crossed by one large triangle
+    static MeshCore::MeshKernel CreateAnisotropicMesh()
+    {
+        MeshCore::MeshKernel kernel;
+        for (int i = 0; i < 100; i++) {
+            float x = 0.1F * static_cast<float>(i);
+            kernel.AddFacet(MeshCore::MeshGeomFacet(Base::Vector3f(x, 0, 0),
+                                                    Base::Vector3f(x + 0.1F, 0, 0),
+                                                    Base::Vector3f(x, 0.1F, 0)));
+        }
+        kernel.AddFacet(MeshCore::MeshGeomFacet(Base::Vector3f(-100, 0.02F, -100),
+                                                Base::Vector3f(100, 0.02F, -100),
+                                                Base::Vector3f(0, 0.02F, 100)));
+        return kernel;
+    }
+};
+
+TEST_F(BVHTest, TestEmpty)
+{
+    MeshCore::MeshKernel kernel;
+    MeshCore::MeshFacetBVH bvh(kernel);
+    EXPECT_EQ(bvh.CountNodes(), 0);
+    EXPECT_FALSE(bvh.HasSelfIntersections());
+}
+
+TEST_F(BVHTest, TestTreeStructure)
+{
+    MeshCore::MeshKernel kernel = CreateAnisotropicMesh();
+    MeshCore::MeshFacetBVH bvh(kernel);
+    EXPECT_GT(bvh.CountNodes(), 1);
+    EXPECT_LT(bvh.GetDepth(), 20);
+}
+
+TEST_F(BVHTest, TestSelfIntersections)
+{
+    MeshCore::MeshKernel kernel = CreateAnisotropicMesh();
+    MeshCore::MeshFacetBVH bvh(kernel, 4);
+    EXPECT_TRUE(bvh.HasSelfIntersections());
+
+    std::vector<MeshCore::MeshFacetBVH::FacetPair> pairs;
+    bvh.GetSelfIntersections(pairs);
+    EXPECT_EQ(pairs.size(), 100);
+    for (const auto& it : pairs) {
+        EXPECT_LT(it.first, it.second);
+        EXPECT_EQ(it.second, 100);
+    }
+
+    MeshCore::MeshEvalSelfIntersection eval(kernel);
+    EXPECT_FALSE(eval.Evaluate());
+}
+
+TEST_F(BVHTest, TestIntersectionOfTwoMeshes)
+{
+    MeshCore::MeshKernel kernel1;
+    kernel1.AddFacet(MeshCore::MeshGeomFacet(Base::Vector3f(0, 0, 0),
+                                             Base::Vector3f(2, 0, 0),
+                                             Base::Vector3f(0, 2, 0)));
+    MeshCore::MeshKernel kernel2;
+    kernel2.AddFacet(MeshCore::MeshGeomFacet(Base::Vector3f(0.5F, 0.5F, 5),
+                                             Base::Vector3f(0.5F, 0.5F, 6),
+                                             Base::Vector3f(1.5F, 0.5F, 5)));
+    kernel2.AddFacet(MeshCore::MeshGeomFacet(Base::Vector3f(0.5F, 0.5F, -1),
+                                             Base::Vector3f(0.5F, 0.5F, 1),
+                                             Base::Vector3f(1.5F, 0.5F, 0)));
+
+    MeshCore::MeshFacetBVH bvh1(kernel1);
+    MeshCore::MeshFacetBVH bvh2(kernel2);
+    EXPECT_TRUE(bvh1.HasIntersections(bvh2));
+
+    std::vector<MeshCore::MeshFacetBVH::FacetPair> pairs;
+    bvh1.GetIntersections(bvh2, pairs);
+    ASSERT_EQ(pairs.size(), 1);
+    EXPECT_EQ(pairs[0].first, 0);
+    EXPECT_EQ(pairs[0].second, 1);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
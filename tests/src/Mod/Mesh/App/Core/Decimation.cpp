@@ -0,0 +1,88 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <Mod/Mesh/App/Core/Decimation.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class DecimationTest: public ::testing::Test
+{
+protected:
+    static constexpr int Size = 50;
+
+    // A slightly curved grid
+    void SetUp() override
+    {
+        MeshCore::MeshPointArray points;
+        for (int j = 0; j < Size; j++) {
+            for (int i = 0; i < Size; i++) {
+                float x = static_cast<float>(i);
+                float y = static_cast<float>(j);
+                points.emplace_back(x, y, 0.01F * x * x);
+            }
+        }
+
+        MeshCore::MeshFacetArray facets;
+        for (int j = 0; j < Size - 1; j++) {
+            for (int i = 0; i < Size - 1; i++) {
+                MeshCore::PointIndex p0 = j * Size + i;
+                MeshCore::PointIndex p1 = p0 + 1;
+                MeshCore::PointIndex p2 = p0 + Size + 1;
+                MeshCore::PointIndex p3 = p0 + Size;
+                facets.emplace_back(p0, p1, p2);
+                facets.emplace_back(p0, p2, p3);
+            }
+        }
+
+        kernel.Adopt(points, facets, true);
+    }
+
+    void checkResult(const Base::BoundBox3f& box) const
+    {
+        std::size_t numPoints = kernel.CountPoints();
+        for (const auto& it : kernel.GetFacets()) {
+            for (auto index : it._aulPoints) {
+                EXPECT_LT(index, numPoints);
+            }
+        }
+
+        // border vertices may only move along the border
+        Base::BoundBox3f bbox = kernel.GetBoundBox();
+        EXPECT_NEAR(bbox.MinX, box.MinX, 1.0F);
+        EXPECT_NEAR(bbox.MaxX, box.MaxX, 1.0F);
+        EXPECT_NEAR(bbox.MinY, box.MinY, 1.0F);
+        EXPECT_NEAR(bbox.MaxY, box.MaxY, 1.0F);
+    }
+
+    MeshCore::MeshKernel kernel;
+};
+
+TEST_F(DecimationTest, TestTargetSize)
+{
+    Base::BoundBox3f box = kernel.GetBoundBox();
+    std::size_t count = kernel.CountFacets();
+    int target = static_cast<int>(count / 4);
+
+    MeshCore::MeshSimplify simplify(kernel);
+    simplify.simplify(target);
+
+    EXPECT_GT(kernel.CountFacets(), 0);
+    EXPECT_LE(kernel.CountFacets(), static_cast<std::size_t>(target));
+    checkResult(box);
+}
+
+TEST_F(DecimationTest, TestTolerance)
+{
+    Base::BoundBox3f box = kernel.GetBoundBox();
+    std::size_t count = kernel.CountFacets();
+
+    MeshCore::MeshSimplify simplify(kernel);
+    simplify.simplify(0.1F, 0.5F);
+
+    EXPECT_GT(kernel.CountFacets(), 0);
+    EXPECT_LT(kernel.CountFacets(), count);
+    checkResult(box);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
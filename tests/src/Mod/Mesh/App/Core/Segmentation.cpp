@@ -0,0 +1,132 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <Mod/Mesh/App/Core/Segmentation.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class SegmentationTest: public ::testing::Test
+{
+protected:
+    static constexpr int Size = 40;
+
+    // A planar grid whose points get a curvature pattern of flat and curved stripes
+    void SetUp() override
+    {
+        MeshCore::MeshPointArray points;
+        for (int j = 0; j < Size; j++) {
+            for (int i = 0; i < Size; i++) {
+                points.emplace_back(static_cast<float>(i), static_cast<float>(j), 0.0F);
+
+                MeshCore::CurvatureInfo info {};
+                float curv = ((i / 5) % 2 == 0 && j % 13 != 0) ? 0.0F : 1.0F;
+                info.fMaxCurvature = curv;
+                info.fMinCurvature = curv;
+                curvature.push_back(info);
+            }
+        }
+
+        MeshCore::MeshFacetArray facets;
+        for (int j = 0; j < Size - 1; j++) {
+            for (int i = 0; i < Size - 1; i++) {
+                MeshCore::PointIndex p0 = j * Size + i;
+                MeshCore::PointIndex p1 = p0 + 1;
+                MeshCore::PointIndex p2 = p0 + Size + 1;
+                MeshCore::PointIndex p3 = p0 + Size;
+                facets.emplace_back(p0, p1, p2);
+                facets.emplace_back(p0, p2, p3);
+            }
+        }
+
+        kernel.Adopt(points, facets, true);
+    }
+
+    std::vector<MeshCore::MeshSegment> FindSegments(bool parallel)
+    {
+        std::vector<MeshCore::MeshSurfaceSegmentPtr> segm;
+        segm.emplace_back(
+            std::make_shared<MeshCore::MeshCurvaturePlanarSegment>(curvature, 5, 0.1F));
+        segm.emplace_back(
+            std::make_shared<MeshCore::MeshCurvatureSphericalSegment>(curvature, 5, 0.1F, 1.0F));
+
+        MeshCore::MeshSegmentAlgorithm finder(kernel);
+        finder.FindSegments(segm, parallel);
+
+        std::vector<MeshCore::MeshSegment> result;
+        for (const auto& it : segm) {
+            const auto& data = it->GetSegments();
+            result.insert(result.end(), data.begin(), data.end());
+        }
+        return result;
+    }
+
+    MeshCore::MeshKernel kernel;
+    std::vector<MeshCore::CurvatureInfo> curvature;
+};
+
+TEST_F(SegmentationTest, TestCurvatureSegments)
+{
+    std::vector<MeshCore::MeshSegment> serial = FindSegments(false);
+    EXPECT_GT(serial.size(), 2);
+
+    std::size_t count = 0;
+    for (const auto& it : serial) {
+        count += it.size();
+    }
+    EXPECT_LE(count, kernel.CountFacets());
+}
+
+TEST_F(SegmentationTest, TestParallelIsEqualToSerial)
+{
+    std::vector<MeshCore::MeshSegment> serial = FindSegments(false);
+    std::vector<MeshCore::MeshSegment> parallel = FindSegments(true);
+    EXPECT_EQ(serial, parallel);
+}
+
+TEST_F(SegmentationTest, TestPlaneFitSegment)
+{
+    std::vector<MeshCore::MeshSurfaceSegmentPtr> segm;
+    auto plane = std::make_shared<MeshCore::MeshDistanceGenericSurfaceFitSegment>(
+        new MeshCore::PlaneSurfaceFit,
+        kernel,
+        10,
+        0.01F);
+    segm.push_back(plane);
+
+    MeshCore::MeshSegmentAlgorithm finder(kernel);
+    finder.FindSegments(segm, true);
+
+    ASSERT_EQ(plane->GetSegments().size(), 1);
+    EXPECT_EQ(plane->GetSegments().front().size(), kernel.CountFacets());
+}
+
+TEST_F(SegmentationTest, TestFixedSurfaceSegment)
+{
+    auto findSegments = [this](bool parallel) {
+        // only the stripe 2 <= x <= 6 is within the tolerance of the tilted plane
+        Base::Vector3f base(4.0F, 0.0F, 0.0F);
+        Base::Vector3f normal(1.0F, 0.0F, 1.0F);
+        normal.Normalize();
+        auto plane = std::make_shared<MeshCore::MeshDistanceGenericSurfaceFitSegment>(
+            new MeshCore::PlaneSurfaceFit(base, normal),
+            kernel,
+            5,
+            1.5F);
+        EXPECT_TRUE(plane->IsFacetTestLocal());
+
+        std::vector<MeshCore::MeshSurfaceSegmentPtr> segm;
+        segm.push_back(plane);
+        MeshCore::MeshSegmentAlgorithm finder(kernel);
+        finder.FindSegments(segm, parallel);
+        return plane->GetSegments();
+    };
+
+    std::vector<MeshCore::MeshSegment> serial = findSegments(false);
+    std::vector<MeshCore::MeshSegment> parallel = findSegments(true);
+    ASSERT_EQ(serial.size(), 1);
+    EXPECT_EQ(serial.front().size(), 2 * 4 * (Size - 1));
+    EXPECT_EQ(serial, parallel);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -0,0 +1,119 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <Mod/Mesh/App/Core/Algorithm.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <Mod/Mesh/App/Core/Smoothing.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class SmoothingTest: public ::testing::Test
+{
+protected:
+    static constexpr int Size = 10;
+
+    // A planar grid of Size x Size points whose inner points are lifted alternately
+    static MeshCore::MeshKernel CreateNoisyGrid()
+    {
+        MeshCore::MeshPointArray points;
+        for (int j = 0; j < Size; j++) {
+            for (int i = 0; i < Size; i++) {
+                bool border = i == 0 || j == 0 || i == Size - 1 || j == Size - 1;
+                float z = border ? 0.0F : ((i + j) % 2 == 0 ? 0.1F : -0.1F);
+                points.emplace_back(static_cast<float>(i), static_cast<float>(j), z);
+            }
+        }
+
+        MeshCore::MeshFacetArray facets;
+        for (int j = 0; j < Size - 1; j++) {
+            for (int i = 0; i < Size - 1; i++) {
+                MeshCore::PointIndex p0 = j * Size + i;
+                MeshCore::PointIndex p1 = p0 + 1;
+                MeshCore::PointIndex p2 = p0 + Size + 1;
+                MeshCore::PointIndex p3 = p0 + Size;
+                facets.emplace_back(p0, p1, p2);
+                facets.emplace_back(p0, p2, p3);
+            }
+        }
+
+        MeshCore::MeshKernel kernel;
+        kernel.Adopt(points, facets, true);
+        return kernel;
+    }
+
+    static float MaxHeight(const MeshCore::MeshKernel& kernel)
+    {
+        float height = 0.0F;
+        for (const auto& it : kernel.GetPoints()) {
+            height = std::max(height, std::fabs(it.z));
+        }
+        return height;
+    }
+};
+
+TEST_F(SmoothingTest, TestCompactPointToPoints)
+{
+    MeshCore::MeshKernel kernel = CreateNoisyGrid();
+    MeshCore::MeshRefPointToPoints ref(kernel);
+    MeshCore::MeshCompactPointToPoints compact(kernel, 4);
+
+    ASSERT_EQ(compact.size(), kernel.CountPoints());
+    for (MeshCore::PointIndex pos = 0; pos < kernel.CountPoints(); pos++) {
+        auto neighbours = compact[pos];
+        std::vector<MeshCore::PointIndex> expected(ref[pos].begin(), ref[pos].end());
+        EXPECT_EQ(compact.CountNeighbours(pos), expected.size());
+        EXPECT_TRUE(std::equal(neighbours.begin(), neighbours.end(), expected.begin()));
+    }
+}
+
+TEST_F(SmoothingTest, TestLaplaceKeepsBorder)
+{
+    MeshCore::MeshKernel kernel = CreateNoisyGrid();
+    MeshCore::MeshPointArray points = kernel.GetPoints();
+
+    MeshCore::LaplaceSmoothing smooth(kernel);
+    smooth.Smooth(10);
+
+    EXPECT_LT(MaxHeight(kernel), 0.01F);
+    for (int i = 0; i < Size; i++) {
+        EXPECT_EQ(kernel.GetPoint(i), points[i]);
+    }
+}
+
+TEST_F(SmoothingTest, TestTaubin)
+{
+    MeshCore::MeshKernel kernel = CreateNoisyGrid();
+    MeshCore::TaubinSmoothing smooth(kernel);
+    smooth.Smooth(20);
+    EXPECT_LT(MaxHeight(kernel), 0.05F);
+}
+
+TEST_F(SmoothingTest, TestPlaneFit)
+{
+    MeshCore::MeshKernel kernel = CreateNoisyGrid();
+    MeshCore::PlaneFitSmoothing smooth(kernel);
+    smooth.Smooth(10);
+    EXPECT_LT(MaxHeight(kernel), 0.1F);
+}
+
+TEST_F(SmoothingTest, TestSmoothPoints)
+{
+    MeshCore::MeshKernel kernel = CreateNoisyGrid();
+    MeshCore::MeshPointArray points = kernel.GetPoints();
+
+    // smoothing a single point only moves this point, listing it twice doesn't matter
+    MeshCore::PointIndex index = 4 * Size + 4;
+    MeshCore::LaplaceSmoothing smooth(kernel);
+    smooth.SmoothPoints(1, {index, index});
+
+    for (MeshCore::PointIndex pos = 0; pos < kernel.CountPoints(); pos++) {
+        if (pos == index) {
+            EXPECT_LT(std::fabs(kernel.GetPoint(pos).z), std::fabs(points[pos].z));
+        }
+        else {
+            EXPECT_EQ(kernel.GetPoint(pos), points[pos]);
+        }
+    }
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -3,6 +3,7 @@
 #include <gtest/gtest.h>
 #include <Base/FileInfo.h>
 #include <Base/Interpreter.h>
+#include <Base/Stream.h>
 #include <App/Document.h>
 #include <App/Part.h>
 #include <src/App/InitApplication.h>
@@ -149,4 +150,47 @@ TEST_F(ExporterTest, TestMeshesInPart)
     EXPECT_DOUBLE_EQ(bbox.MinZ, -3.0);
     EXPECT_DOUBLE_EQ(bbox.MaxZ, 9.0);
 }
+
+TEST_F(ExporterTest, TestStreamBinarySTL)
+{
+    Base::Placement plm;
+    plm.setPosition(Base::Vector3d(10, 5, 2));
+    setPlacementTo2ndCube(plm);
+
+    // add extra scope because the file will be completed when destroying the exporter
+    {
+        Mesh::ExporterSTL exporter(getFileName(), MeshCore::MeshIO::Format::BSTL);
+        EXPECT_EQ(exporter.addObjects(getObjects(), 0.1F), 2);
+    }
+
+    Mesh::MeshObject kernel;
+    EXPECT_TRUE(kernel.load(getFileName().c_str()));
+    EXPECT_EQ(kernel.countFacets(), 24);
+    auto bbox = kernel.getBoundBox();
+    EXPECT_DOUBLE_EQ(bbox.MinX, -5.0);
+    EXPECT_DOUBLE_EQ(bbox.MaxX, 15.0);
+    EXPECT_DOUBLE_EQ(bbox.MinZ, -5.0);
+    EXPECT_DOUBLE_EQ(bbox.MaxZ, 7.0);
+}
+
+TEST_F(ExporterTest, TestStreamAsciiSTL)
+{
+    {
+        Mesh::ExporterSTL exporter(getFileName(), MeshCore::MeshIO::Format::ASTL);
+        exporter.setParallel(false);
+        EXPECT_EQ(exporter.addObjects(getObjects(), 0.1F), 2);
+    }
+
+    // the solid is named after the first object
+    Base::FileInfo fi(getFileName());
+    Base::ifstream str(fi, std::ios::in);
+    std::string line;
+    std::getline(str, line);
+    EXPECT_EQ(line, "solid Cube1");
+    str.close();
+
+    Mesh::MeshObject kernel;
+    EXPECT_TRUE(kernel.load(getFileName().c_str()));
+    EXPECT_EQ(kernel.countFacets(), 24);
+}
 // NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -0,0 +1,208 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstring>
+#include <tuple>
+#include <Base/FileInfo.h>
+#include <Base/Stream.h>
+#include <Mod/Points/App/ChunkedPoints.h>
+#include <Mod/Points/App/PointsAlgos.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class ChunkedPointsTest: public ::testing::Test
+{
+protected:
+    // A regular grid of 20 x 20 x 5 points
+    void SetUp() override
+    {
+        for (int i = 0; i < 20; i++) {
+            for (int j = 0; j < 20; j++) {
+                for (int k = 0; k < 5; k++) {
+                    points.emplace_back(1.5F * static_cast<float>(i) - 7.0F,
+                                        0.7F * static_cast<float>(j) + 100.0F,
+                                        3.0F * static_cast<float>(k));
+                }
+            }
+        }
+    }
+
+    static void sort(std::vector<Base::Vector3f>& pts)
+    {
+        std::sort(pts.begin(), pts.end(), [](const Base::Vector3f& p, const Base::Vector3f& q) {
+            return std::tie(p.x, p.y, p.z) < std::tie(q.x, q.y, q.z);
+        });
+    }
+
+    std::vector<Base::Vector3f> points;
+};
+
+TEST_F(ChunkedPointsTest, TestChunksHoldAllPoints)
+{
+    Points::ChunkedPointStore store(64, 16, 256);
+    store.add(points);
+
+    EXPECT_EQ(store.size(), points.size());
+    EXPECT_GT(store.countChunks(), 1);
+
+    std::size_t onDisk = 0;
+    std::vector<Base::Vector3f> chunked;
+    for (std::size_t i = 0; i < store.countChunks(); i++) {
+        if (!store.isChunkInMemory(i)) {
+            onDisk++;
+        }
+
+        Points::PointKernel chunk = store.getChunk(i);
+        EXPECT_EQ(chunk.size(), store.getChunkSize(i));
+        Base::BoundBox3f cell = store.getChunkBoundBox(i);
+        for (const auto& it : chunk.getBasicPoints()) {
+            EXPECT_TRUE(cell.IsInBox(it));
+            chunked.push_back(it);
+        }
+    }
+
+    EXPECT_GT(onDisk, 0);
+    sort(points);
+    sort(chunked);
+    EXPECT_EQ(points, chunked);
+}
+
+TEST_F(ChunkedPointsTest, TestChunkIterator)
+{
+    Points::ChunkedPointStore store(64, 16, 256);
+    store.add(points);
+
+    std::size_t count = 0;
+    std::size_t numChunks = 0;
+    for (const auto& it : store) {
+        count += it.size();
+        numChunks++;
+    }
+
+    EXPECT_EQ(count, points.size());
+    EXPECT_EQ(numChunks, store.countChunks());
+}
+
+TEST_F(ChunkedPointsTest, TestLevelOfDetail)
+{
+    Points::ChunkedPointStore store(64, 16, 256);
+    store.add(points);
+
+    EXPECT_EQ(store.getLevelOfDetail(0).size(), 16);
+
+    std::size_t last = 0;
+    for (unsigned int depth = 0; depth <= store.getDepth(); depth++) {
+        std::size_t size = store.getLevelOfDetail(depth).size();
+        EXPECT_GE(size, last);
+        EXPECT_LE(size, points.size());
+        last = size;
+    }
+
+    Base::BoundBox3f box(Base::Vector3f(-7.0F, 100.0F, 0.0F), 1.0F);
+    EXPECT_LT(store.getLevelOfDetail(store.getDepth(), box).size(), last);
+}
+
+TEST_F(ChunkedPointsTest, TestSwapFileReuse)
+{
+    // chunks that are split after they were moved to disk leave their ranges
+    // of the swap file behind, which must be reused
+    Points::ChunkedPointStore store(64, 16, 256);
+    std::vector<Base::Vector3f> all;
+    for (int i = 0; i < 10; i++) {
+        store.add(points);
+        all.insert(all.end(), points.begin(), points.end());
+    }
+
+    EXPECT_GT(store.getSwapSize(), 0);
+    EXPECT_LE(store.getSwapSize(), store.size() * sizeof(Base::Vector3f));
+
+    std::vector<Base::Vector3f> chunked;
+    for (const auto& it : store) {
+        const auto& pts = it.getBasicPoints();
+        chunked.insert(chunked.end(), pts.begin(), pts.end());
+    }
+
+    sort(all);
+    sort(chunked);
+    EXPECT_EQ(all, chunked);
+}
+
+TEST_F(ChunkedPointsTest, TestGetPoints)
+{
+    Points::ChunkedPointStore store(64, 16, 256);
+    store.add(points);
+
+    EXPECT_EQ(store.getPoints(points.size()).size(), points.size());
+
+    std::size_t size = store.getPoints(100).size();
+    EXPECT_GT(size, 0);
+    EXPECT_LE(size, 100);
+    EXPECT_EQ(store.getPoints(5).size(), 5);
+}
+
+TEST_F(ChunkedPointsTest, TestClear)
+{
+    Points::ChunkedPointStore store(64, 16, 256);
+    store.add(points);
+    store.clear();
+
+    EXPECT_EQ(store.size(), 0);
+    EXPECT_EQ(store.countChunks(), 0);
+    EXPECT_TRUE(store.getLevelOfDetail(0).empty());
+
+    store.add(points);
+    EXPECT_EQ(store.size(), points.size());
+}
+
+TEST_F(ChunkedPointsTest, TestReadBinaryPLY)
+{
+    Base::FileInfo fi(Base::FileInfo::getTempFileName());
+    {
+        Base::ofstream out(fi, std::ios::out | std::ios::binary);
+        out << "ply\n"
+            << "format binary_little_endian 1.0\n"
+            << "element vertex " << points.size() << "\n"
+            << "property float x\n"
+            << "property float y\n"
+            << "property float z\n"
+            << "property uchar red\n"
+            << "end_header\n";
+
+        auto writeFloat = [&out](float value) {
+            uint32_t bits {};
+            std::memcpy(&bits, &value, sizeof(bits));
+            for (int shift = 0; shift <= 24; shift += 8) {
+                out.put(static_cast<char>((bits >> shift) & 0xff));
+            }
+        };
+        for (const auto& it : points) {
+            writeFloat(it.x);
+            writeFloat(it.y);
+            writeFloat(it.z);
+            out.put(0);
+        }
+    }
+
+    Points::ChunkedPointStore store(64, 16, 256);
+    Points::PlyReader reader;
+    reader.setPointStore(&store);
+    reader.read(fi.filePath());
+    fi.deleteFile();
+
+    EXPECT_EQ(reader.getPoints().size(), 0);
+    EXPECT_FALSE(reader.hasColors());
+    ASSERT_EQ(store.size(), points.size());
+
+    std::vector<Base::Vector3f> chunked;
+    for (const auto& it : store) {
+        const auto& pts = it.getBasicPoints();
+        chunked.insert(chunked.end(), pts.begin(), pts.end());
+    }
+
+    sort(points);
+    sort(chunked);
+    EXPECT_EQ(points, chunked);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
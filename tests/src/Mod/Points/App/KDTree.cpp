@@ -0,0 +1,159 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <Mod/Points/App/KDTree.h>
+#include <Mod/Points/App/NormalEstimation.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class KDTreeTest: public ::testing::Test
+{
+protected:
+    // Random points in a cube and query points around it
+    void SetUp() override
+    {
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<float> dist(-10.0F, 10.0F);
+        for (int i = 0; i < 2000; i++) {
+            points.emplace_back(dist(rng), dist(rng), dist(rng));
+        }
+        for (int i = 0; i < 50; i++) {
+            queries.emplace_back(1.2F * dist(rng), 1.2F * dist(rng), 1.2F * dist(rng));
+        }
+    }
+
+    std::vector<std::size_t> bruteForceNearest(const Base::Vector3f& pnt, std::size_t k) const
+    {
+        std::vector<std::size_t> indices(points.size());
+        std::iota(indices.begin(), indices.end(), 0);
+        std::partial_sort(indices.begin(),
+                          indices.begin() + k,
+                          indices.end(),
+                          [&](std::size_t lhs, std::size_t rhs) {
+                              return Base::DistanceP2(pnt, points[lhs])
+                                  < Base::DistanceP2(pnt, points[rhs]);
+                          });
+        indices.resize(k);
+        return indices;
+    }
+
+    std::vector<Base::Vector3f> points;
+    std::vector<Base::Vector3f> queries;
+};
+
+TEST_F(KDTreeTest, TestFindNearest)
+{
+    Points::KDTree tree(points);
+    EXPECT_EQ(tree.size(), points.size());
+
+    for (const auto& pnt : queries) {
+        std::vector<std::size_t> found = tree.findNearest(pnt, 7);
+        std::vector<std::size_t> expected = bruteForceNearest(pnt, 7);
+        ASSERT_EQ(found.size(), expected.size());
+        for (std::size_t i = 0; i < found.size(); i++) {
+            EXPECT_FLOAT_EQ(Base::DistanceP2(pnt, points[found[i]]),
+                            Base::DistanceP2(pnt, points[expected[i]]));
+        }
+    }
+}
+
+TEST_F(KDTreeTest, TestFindInRadius)
+{
+    Points::KDTree tree(points);
+
+    for (const auto& pnt : queries) {
+        std::vector<std::size_t> found = tree.findInRadius(pnt, 2.5F);
+        std::sort(found.begin(), found.end());
+
+        std::vector<std::size_t> expected;
+        for (std::size_t i = 0; i < points.size(); i++) {
+            if (Base::DistanceP2(pnt, points[i]) <= 2.5F * 2.5F) {
+                expected.push_back(i);
+            }
+        }
+        EXPECT_EQ(found, expected);
+    }
+}
+
+TEST_F(KDTreeTest, TestBatchQueries)
+{
+    Points::KDTree tree(points);
+
+    auto nearest = tree.findNearest(queries, 5);
+    auto inRadius = tree.findInRadius(queries, 3.0F);
+    ASSERT_EQ(nearest.size(), queries.size());
+    ASSERT_EQ(inRadius.size(), queries.size());
+    for (std::size_t i = 0; i < queries.size(); i++) {
+        EXPECT_EQ(nearest[i], tree.findNearest(queries[i], 5));
+        EXPECT_EQ(inRadius[i], tree.findInRadius(queries[i], 3.0F));
+    }
+}
+
+TEST_F(KDTreeTest, TestFewPoints)
+{
+    std::vector<Base::Vector3f> few(points.begin(), points.begin() + 3);
+    Points::KDTree tree(few);
+    EXPECT_EQ(tree.findNearest(queries.front(), 10).size(), 3);
+
+    std::vector<Base::Vector3f> none;
+    Points::KDTree empty(none);
+    EXPECT_TRUE(empty.findNearest(queries.front(), 10).empty());
+    EXPECT_TRUE(empty.findInRadius(queries.front(), 10.0F).empty());
+}
+
+TEST_F(KDTreeTest, TestNormalsOfPlane)
+{
+    std::vector<Base::Vector3f> plane;
+    for (int i = 0; i < 30; i++) {
+        for (int j = 0; j < 30; j++) {
+            plane.emplace_back(static_cast<float>(i), static_cast<float>(j), 0.0F);
+        }
+    }
+    Points::PointKernel kernel;
+    kernel.swap(plane);
+
+    Points::NormalEstimation estimate(kernel);
+    estimate.setKSearch(8);
+    std::vector<Base::Vector3f> normals = estimate.perform();
+    ASSERT_EQ(normals.size(), kernel.size());
+
+    // all normals must point to the same side
+    float side = normals.front().z;
+    for (const auto& it : normals) {
+        EXPECT_FLOAT_EQ(std::fabs(it.z), 1.0F);
+        EXPECT_GT(it.z * side, 0.0F);
+    }
+}
+
+TEST_F(KDTreeTest, TestNormalsOfSphere)
+{
+    std::vector<Base::Vector3f> sphere;
+    const double pi = std::acos(-1.0);
+    for (int i = 0; i < 60; i++) {
+        for (int j = 0; j < 30; j++) {
+            double theta = pi * (j + 0.5) / 30.0;
+            double phi = 2.0 * pi * i / 60.0;
+            sphere.emplace_back(static_cast<float>(5.0 * std::sin(theta) * std::cos(phi)),
+                                static_cast<float>(5.0 * std::sin(theta) * std::sin(phi)),
+                                static_cast<float>(5.0 * std::cos(theta)));
+        }
+    }
+    Points::PointKernel kernel;
+    kernel.swap(sphere);
+
+    Points::NormalEstimation estimate(kernel);
+    estimate.setKSearch(8);
+    std::vector<Base::Vector3f> normals = estimate.perform();
+
+    // the outermost point of the sphere makes all normals point outwards
+    const auto& pnts = kernel.getBasicPoints();
+    for (std::size_t i = 0; i < normals.size(); i++) {
+        EXPECT_GT(normals[i] * pnts[i], 0.0F);
+    }
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -1,7 +1,10 @@
 // SPDX-License-Identifier: LGPL-2.1-or-later
 
 #include <gtest/gtest.h>
+#include <cstring>
+#include <Base/Exception.h>
 #include <Base/FileInfo.h>
+#include <Base/Stream.h>
 #include <Mod/Points/App/Points.h>
 #include <Mod/Points/App/PointsAlgos.h>
 
@@ -240,4 +243,133 @@ TEST_F(PointsTest, TestPCDStructured)
     EXPECT_EQ(reader.getWidth(), 4);
     EXPECT_EQ(reader.getHeight(), 2);
 }
+
+TEST_F(PointsTest, TestBinaryBigEndianPLY)
+{
+    std::string name = getFileName();
+    {
+        Base::FileInfo fi(name);
+        Base::ofstream out(fi, std::ios::out | std::ios::binary);
+        out << "ply\n"
+            << "format binary_big_endian 1.0\n"
+            << "element vertex 2\n"
+            << "property float x\n"
+            << "property float y\n"
+            << "property float z\n"
+            << "property uchar red\n"
+            << "property uchar green\n"
+            << "property uchar blue\n"
+            << "end_header\n";
+
+        auto writeFloat = [&out](float value) {
+            uint32_t bits {};
+            std::memcpy(&bits, &value, sizeof(bits));
+            for (int shift = 24; shift >= 0; shift -= 8) {
+                out.put(static_cast<char>((bits >> shift) & 0xff));
+            }
+        };
+        writeFloat(1.0F);
+        writeFloat(2.0F);
+        writeFloat(3.0F);
+        out.put(static_cast<char>(255));
+        out.put(0);
+        out.put(0);
+        writeFloat(-4.0F);
+        writeFloat(5.5F);
+        writeFloat(6.0F);
+        out.put(0);
+        out.put(0);
+        out.put(static_cast<char>(255));
+    }
+
+    Points::PlyReader reader;
+    reader.read(name);
+
+    EXPECT_TRUE(reader.hasColors());
+    EXPECT_FALSE(reader.hasNormals());
+    ASSERT_EQ(reader.getPoints().size(), 2);
+    EXPECT_EQ(reader.getPoints().getPoint(0), Base::Vector3d(1.0, 2.0, 3.0));
+    EXPECT_EQ(reader.getPoints().getPoint(1), Base::Vector3d(-4.0, 5.5, 6.0));
+    ASSERT_EQ(reader.getColors().size(), 2);
+    EXPECT_FLOAT_EQ(reader.getColors()[0].r, 1.0F);
+    EXPECT_FLOAT_EQ(reader.getColors()[0].b, 0.0F);
+    EXPECT_FLOAT_EQ(reader.getColors()[1].r, 0.0F);
+    EXPECT_FLOAT_EQ(reader.getColors()[1].b, 1.0F);
+}
+
+TEST_F(PointsTest, TestTruncatedBinaryPLY)
+{
+    std::string name = getFileName();
+    {
+        Base::FileInfo fi(name);
+        Base::ofstream out(fi, std::ios::out | std::ios::binary);
+        out << "ply\n"
+            << "format binary_little_endian 1.0\n"
+            << "element vertex 10\n"
+            << "property double x\n"
+            << "property double y\n"
+            << "property double z\n"
+            << "end_header\n";
+        double value = 1.0;
+        out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    Points::PlyReader reader;
+    EXPECT_THROW(reader.read(name), Base::BadFormatError);
+}
+TEST_F(PointsTest, TestVoxelGridFilter)
+{
+    std::vector<Base::Vector3d> pnts {Base::Vector3d(0.1, 0.1, 0.1),
+                                      Base::Vector3d(0.3, 0.5, 0.9),
+                                      Base::Vector3d(1.5, 0.1, 0.1)};
+    std::vector<Base::Color> cols {Base::Color(1, 0, 0), Base::Color(0, 0, 1), Base::Color(0, 1, 0)};
+    std::vector<float> inty {0.2F, 0.4F, 1.0F};
+    std::vector<Base::Vector3f> nors {Base::Vector3f(0, 0, 1),
+                                      Base::Vector3f(1, 0, 0),
+                                      Base::Vector3f(0, 1, 0)};
+
+    // adding the same block twice must not add any cells
+    Points::VoxelGridFilter filter(1.0);
+    filter.add(pnts, cols, inty, nors);
+    filter.add(pnts, cols, inty, nors);
+    EXPECT_EQ(filter.size(), 2);
+
+    Points::PointKernel kernel;
+    std::vector<Base::Color> colors;
+    std::vector<float> intensity;
+    std::vector<Base::Vector3f> normals;
+    filter.getPoints(kernel, colors, intensity, normals);
+    ASSERT_EQ(kernel.size(), 2);
+    ASSERT_EQ(colors.size(), 2);
+    ASSERT_EQ(intensity.size(), 2);
+    ASSERT_EQ(normals.size(), 2);
+
+    std::size_t index = kernel.getPoint(0).x < 1.0 ? 0 : 1;
+    EXPECT_EQ(kernel.getPoint(index), Base::Vector3d(0.2, 0.3, 0.5));
+    EXPECT_FLOAT_EQ(colors[index].r, 0.5F);
+    EXPECT_FLOAT_EQ(colors[index].b, 0.5F);
+    EXPECT_FLOAT_EQ(intensity[index], 0.3F);
+    EXPECT_FLOAT_EQ(normals[index].Length(), 1.0F);
+}
+
+TEST_F(PointsTest, TestVoxelGridFilterMissingProperties)
+{
+    std::vector<Base::Vector3d> pnts {Base::Vector3d(0.1, 0.1, 0.1), Base::Vector3d(2.1, 0.1, 0.1)};
+    std::vector<Base::Color> cols(2);
+
+    Points::VoxelGridFilter filter(1.0);
+    filter.add(pnts, cols, {}, {});
+    filter.add({Base::Vector3d(4.1, 0.1, 0.1)}, {}, {}, {});
+
+    Points::PointKernel kernel;
+    std::vector<Base::Color> colors;
+    std::vector<float> intensity;
+    std::vector<Base::Vector3f> normals;
+    filter.getPoints(kernel, colors, intensity, normals);
+    EXPECT_EQ(kernel.size(), 3);
+    EXPECT_TRUE(colors.empty());
+    EXPECT_TRUE(intensity.empty());
+    EXPECT_TRUE(normals.empty());
+}
+
 // NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -0,0 +1,87 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <Geom_BSplineSurface.hxx>
+#include <TColgp_Array1OfPnt.hxx>
+#include <Mod/ReverseEngineering/App/ApproxSurface.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class ApproxSurfaceTest: public ::testing::Test
+{
+protected:
+    // A bicubic polynomial surface over the unit square, which a bicubic
+    // B-spline surface can represent exactly
+    static double height(double x, double y)
+    {
+        return x * x * x - 2.0 * x * x * y + 0.5 * y * y * y + x * y - 0.3 * x;
+    }
+
+    static TColgp_Array1OfPnt grid(int numX, int numY)
+    {
+        TColgp_Array1OfPnt points(0, numX * numY - 1);
+        int index = 0;
+        for (int i = 0; i < numX; i++) {
+            for (int j = 0; j < numY; j++) {
+                double x = static_cast<double>(i) / (numX - 1);
+                double y = static_cast<double>(j) / (numY - 1);
+                points(index++) = gp_Pnt(x, y, height(x, y));
+            }
+        }
+        return points;
+    }
+
+    static Handle(Geom_BSplineSurface) fit(const TColgp_Array1OfPnt& points, unsigned poles)
+    {
+        Reen::BSplineParameterCorrection pc(4, 4, poles, poles);
+        pc.SetUV(Base::Vector3d(1, 0, 0), Base::Vector3d(0, 1, 0));
+        return pc.CreateSurface(points, 0, false, 1.0);
+    }
+
+    // With the given u/v directions the parameters of a point are its x and y
+    static double maxDeviation(const Handle(Geom_BSplineSurface)& surf,
+                               const TColgp_Array1OfPnt& points)
+    {
+        double maxDist = 0.0;
+        for (int i = points.Lower(); i <= points.Upper(); i++) {
+            const gp_Pnt& pnt = points(i);
+            maxDist = std::max(maxDist, surf->Value(pnt.X(), pnt.Y()).Distance(pnt));
+        }
+        return maxDist;
+    }
+};
+
+TEST_F(ApproxSurfaceTest, TestFitBicubicSurface)
+{
+    TColgp_Array1OfPnt points = grid(21, 21);
+    Handle(Geom_BSplineSurface) surf = fit(points, 6);
+    ASSERT_FALSE(surf.IsNull());
+
+    EXPECT_LT(maxDeviation(surf, points), 1e-7);
+
+    // also between the data points
+    double maxDist = 0.0;
+    for (int i = 0; i <= 10; i++) {
+        for (int j = 0; j <= 10; j++) {
+            double x = 0.05 + 0.09 * i;
+            double y = 0.05 + 0.09 * j;
+            maxDist = std::max(maxDist, std::fabs(surf->Value(x, y).Z() - height(x, y)));
+        }
+    }
+    EXPECT_LT(maxDist, 1e-7);
+}
+
+TEST_F(ApproxSurfaceTest, TestFitWithTooFewDistinctParameters)
+{
+    // Only five distinct x values for eight poles in u-direction make the
+    // normal equations singular, but the points can still be fitted exactly
+    TColgp_Array1OfPnt points = grid(5, 21);
+    Handle(Geom_BSplineSurface) surf = fit(points, 8);
+    ASSERT_FALSE(surf.IsNull());
+
+    EXPECT_LT(maxDeviation(surf, points), 1e-6);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)